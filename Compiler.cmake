@@ -90,6 +90,8 @@ set(angle_translator_sources
     "src/compiler/translator/SymbolTable_autogen.h"
     "src/compiler/translator/SymbolUniqueId.cpp"
     "src/compiler/translator/SymbolUniqueId.h"
+    "src/compiler/translator/TranslationCache.cpp"
+    "src/compiler/translator/TranslationCache.h"
     "src/compiler/translator/TranslatorESSL.h"
     "src/compiler/translator/TranslatorGLSL.h"
     "src/compiler/translator/TranslatorHLSL.h"
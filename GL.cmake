@@ -55,6 +55,8 @@ set(gl_backend_sources
     "src/libANGLE/renderer/gl/ShaderGL.h"
     "src/libANGLE/renderer/gl/StateManagerGL.cpp"
     "src/libANGLE/renderer/gl/StateManagerGL.h"
+    "src/libANGLE/renderer/gl/StreamingBufferGL.cpp"
+    "src/libANGLE/renderer/gl/StreamingBufferGL.h"
     "src/libANGLE/renderer/gl/SurfaceGL.cpp"
     "src/libANGLE/renderer/gl/SurfaceGL.h"
     "src/libANGLE/renderer/gl/SyncGL.cpp"
@@ -129,6 +131,8 @@ if(is_android OR is_linux OR is_chromeos)
         "src/libANGLE/renderer/gl/egl/DeviceEGL.h"
         "src/libANGLE/renderer/gl/egl/DisplayEGL.cpp"
         "src/libANGLE/renderer/gl/egl/DisplayEGL.h"
+        "src/libANGLE/renderer/gl/egl/DmaBufImageCacheEGL.cpp"
+        "src/libANGLE/renderer/gl/egl/DmaBufImageCacheEGL.h"
         "src/libANGLE/renderer/gl/egl/DmaBufImageSiblingEGL.cpp"
         "src/libANGLE/renderer/gl/egl/DmaBufImageSiblingEGL.h"
         "src/libANGLE/renderer/gl/egl/ExternalImageSiblingEGL.h"
@@ -164,6 +164,7 @@ set(libangle_image_util_headers
 
 set(libangle_image_util_sources
     "src/image_util/copyimage.cpp"
+    "src/image_util/generatemip.cpp"
     "src/image_util/imageformats.cpp"
     "src/image_util/loadimage.cpp"
     "src/image_util/loadimage_astc.cpp"
@@ -245,6 +246,7 @@ set(libangle_includes
 set(libangle_headers
     "src/libANGLE/AttributeMap.h"
     "src/libANGLE/BlobCache.h"
+    "src/libANGLE/BlobCacheDiskStore.h"
     "src/libANGLE/Buffer.h"
     "src/libANGLE/Caps.h"
     "src/libANGLE/Compiler.h"
@@ -391,6 +393,7 @@ set(libangle_headers
 set(libangle_sources
     "src/libANGLE/AttributeMap.cpp"
     "src/libANGLE/BlobCache.cpp"
+    "src/libANGLE/BlobCacheDiskStore.cpp"
     "src/libANGLE/Buffer.cpp"
     "src/libANGLE/Caps.cpp"
     "src/libANGLE/Compiler.cpp"
@@ -26,7 +26,7 @@
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 327
+#define ANGLE_SH_VERSION 329
 
 enum ShShaderSpec
 {
@@ -428,6 +428,16 @@ struct ShCompileOptions
     // Use fragment shaders to compute and set coverage mask based on the alpha value
     uint64_t emulateAlphaToCoverage : 1;
 
+    // Record the time taken by each AST transformation.  Can be queried by calling
+    // sh::GetCompilePassStatistics().
+    uint64_t collectPassStatistics : 1;
+
+    // Look the shader up in a process-wide cache of translations, keyed by the shader source,
+    // the compiler's type, spec, output and resources, and these options.  On a hit, the
+    // translated code and reflection are copied from the cache instead of compiling the shader
+    // again.  Ignored for HLSL and MSL output and with collectPassStatistics.
+    uint64_t cacheTranslation : 1;
+
     ShCompileOptionsMetal metal;
     ShPixelLocalStorageOptions pls;
 };
@@ -699,6 +709,25 @@ namespace sh
 using BinaryBlob       = std::vector<uint32_t>;
 using ShaderBinaryBlob = std::vector<uint8_t>;
 
+// Time taken by one of the AST transformations of a compilation.  Transformations that the shader
+// has nothing for are skipped, and recorded with a time of zero.
+struct CompilePassStatistics
+{
+    const char *name;
+    double timeSeconds;
+    bool skipped;
+};
+
+// Usage of the translation cache, used by compilations with the cacheTranslation option.
+struct TranslationCacheStatistics
+{
+    uint64_t hits;
+    uint64_t misses;
+    // Number of translations in the cache, and the approximate memory they take.
+    size_t entryCount;
+    size_t size;
+};
+
 //
 // Driver must call this first, once, before doing any other compiler operations.
 // If the function succeeds, the return value is true, else false.
@@ -896,6 +925,12 @@ GLenum GetGeometryShaderOutputPrimitiveType(const ShHandle handle);
 int GetGeometryShaderInvocations(const ShHandle handle);
 int GetGeometryShaderMaxVertices(const ShHandle handle);
 unsigned int GetShaderSharedMemorySize(const ShHandle handle);
+
+// Returns the time taken by each AST transformation of the last compilation, in the order they
+// ran.  Empty unless the collectPassStatistics compile option was set.
+// Parameters:
+// handle: Specifies the compiler
+const std::vector<CompilePassStatistics> &GetCompilePassStatistics(const ShHandle handle);
 int GetTessControlShaderVertices(const ShHandle handle);
 GLenum GetTessGenMode(const ShHandle handle);
 GLenum GetTessGenSpacing(const ShHandle handle);
@@ -906,6 +941,14 @@ GLenum GetTessGenPointMode(const ShHandle handle);
 // gl::BlendEquationType, and can only include bits from KHR_blend_equation_advanced.
 uint32_t GetAdvancedBlendEquations(const ShHandle handle);
 
+// Returns the usage of the translation cache since the process started, or since the last call to
+// ClearTranslationCache.
+TranslationCacheStatistics GetTranslationCacheStatistics();
+
+// Drops all the translations from the cache, and resets its statistics.  The cache is also
+// emptied by Finalize.
+void ClearTranslationCache();
+
 //
 // Helper function to identify specs that are based on the WebGL spec.
 //
@@ -509,6 +509,44 @@ struct FeaturesGL : FeatureSetBase
         "supportsShaderPixelLocalStorageEXT", FeatureCategory::OpenGLFeatures,
         "Backend GL context supports EXT_shader_pixel_local_storage extension", &members,
         "http://anglebug.com/7279"};
+
+    FeatureInfo streamClientArraysThroughRingBuffer = {
+        "streamClientArraysThroughRingBuffer",
+        FeatureCategory::OpenGLFeatures,
+        "Sub-allocate streamed client arrays from a ring of buffers instead of one buffer",
+        &members,
+    };
+
+    FeatureInfo useNativeMultiDraw = {
+        "useNativeMultiDraw",
+        FeatureCategory::OpenGLFeatures,
+        "Forward multi-draw calls that don't use gl_DrawID to the native multi-draw functions",
+        &members,
+    };
+
+    FeatureInfo uploadTextureDataThroughStagingBuffers = {
+        "uploadTextureDataThroughStagingBuffers",
+        FeatureCategory::OpenGLFeatures,
+        "Copy large texture uploads from client memory into a ring of pixel unpack buffers "
+        "in chunks, so that copying a chunk overlaps the transfer of the previous one",
+        &members,
+    };
+
+    FeatureInfo deferDefaultUniformUpdates = {
+        "deferDefaultUniformUpdates",
+        FeatureCategory::OpenGLFeatures,
+        "Keep a copy of default-block uniform values and upload the changed ones to the "
+        "native program at draw time, instead of on every glUniform call",
+        &members,
+    };
+
+    FeatureInfo reuseDmaBufImages = {
+        "reuseDmaBufImages",
+        FeatureCategory::OpenGLFeatures,
+        "Reuse the native EGL image of a dma-buf that is imported again with the same "
+        "layout, instead of creating a new one for every import",
+        &members,
+    };
 };
 
 inline FeaturesGL::FeaturesGL()  = default;
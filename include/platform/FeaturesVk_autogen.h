@@ -891,6 +891,13 @@ struct FeaturesVk : FeatureSetBase
         "SecondaryCommandPools when using VulkanSecondaryCommandBuffer. ",
         &members,
     };
+
+    FeatureInfo asyncEtcTextureDecode = {
+        "asyncEtcTextureDecode",
+        FeatureCategory::VulkanFeatures,
+        "Decode ETC2/EAC texture uploads on worker threads and wait for the result when the update is flushed",
+        &members,
+    };
 };
 
 inline FeaturesVk::FeaturesVk()  = default;
@@ -121,6 +121,13 @@ struct FrontendFeatures : FeatureSetBase
     FeatureInfo disableProgramCaching = {"disableProgramCaching", FeatureCategory::FrontendFeatures,
                                          "Disables saving programs to the cache", &members,
                                          "http://anglebug.com/1423136"};
+
+    FeatureInfo uncompressedBlobCache = {
+        "uncompressedBlobCache",
+        FeatureCategory::FrontendFeatures,
+        "Store program and shader binaries in the blob cache uncompressed with a checksum, trading memory for faster cache hits",
+        &members,
+    };
 };
 
 inline FrontendFeatures::FrontendFeatures()  = default;
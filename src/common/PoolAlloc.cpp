@@ -13,6 +13,11 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <mutex>
+
+#include "anglebase/no_destructor.h"
+#include "common/aligned_memory.h"
 #include "common/angleutils.h"
 #include "common/debug.h"
 #include "common/mathutil.h"
@@ -153,6 +158,82 @@ class PageHeader
     Allocation *lastAllocation;
 #    endif
 };
+
+namespace
+{
+// Granularity of pages.  Translator allocations are made from a large number of pages, which
+// benefit from being backed by whole OS pages (and by transparent huge pages where available).
+constexpr size_t kOSPageSize = 4 * 1024;
+
+// Memory kept in the free list of each allocator.
+constexpr size_t kMaxFreeListSize = 1024 * 1024;
+
+// Number of pages kept by the process-wide page cache; 4MB with the default page size.
+constexpr size_t kMaxCachedPageCount = 512;
+
+// Single pages are allocated with AlignedAlloc, multi-page allocations with new[].
+PageHeader *AllocatePage(size_t pageSize)
+{
+    return reinterpret_cast<PageHeader *>(AlignedAlloc(pageSize, kOSPageSize));
+}
+
+void FreePage(PageHeader *page)
+{
+    if (page->pageCount > 1)
+    {
+        delete[] reinterpret_cast<char *>(page);
+    }
+    else
+    {
+        AlignedFree(page);
+    }
+}
+
+// Pages of the default size that allocators no longer need.  The translator creates an allocator
+// per compiler, so without this cache the pages of every new compiler would be freshly allocated
+// and faulted in.  Only pages of the default size are kept, as allocators with other page sizes
+// cannot use them.
+class PageCache : angle::NonCopyable
+{
+  public:
+    PageHeader *acquire()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        PageHeader *page = mPages;
+        if (page != nullptr)
+        {
+            mPages = page->nextPage;
+            --mPageCount;
+        }
+        return page;
+    }
+
+    // Returns false if the cache is full, in which case the caller frees the page.
+    bool release(PageHeader *page)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mPageCount >= kMaxCachedPageCount)
+        {
+            return false;
+        }
+        page->nextPage = mPages;
+        mPages         = page;
+        ++mPageCount;
+        return true;
+    }
+
+  private:
+    std::mutex mMutex;
+    PageHeader *mPages = nullptr;
+    size_t mPageCount  = 0;
+};
+
+PageCache &GetPageCache()
+{
+    static angle::base::NoDestructor<PageCache> sPageCache;
+    return *sPageCache;
+}
+}  // anonymous namespace
 #endif
 
 //
@@ -164,9 +245,12 @@ PoolAllocator::PoolAllocator(int growthIncrement, int allocationAlignment)
 #if !defined(ANGLE_DISABLE_POOL_ALLOC)
       mPageSize(growthIncrement),
       mFreeList(nullptr),
+      mFreePageCount(0),
+      mMaxFreePageCount(0),
       mInUseList(nullptr),
       mNumCalls(0),
       mTotalBytes(0),
+      mPageMemoryInUse(0),
 #endif
       mLocked(false)
 {
@@ -196,13 +280,10 @@ void PoolAllocator::initialize(int pageSize, int alignment)
 #if !defined(ANGLE_DISABLE_POOL_ALLOC)
     }
     //
-    // Don't allow page sizes we know are smaller than all common
-    // OS page sizes.
+    // Use whole OS pages.
     //
-    if (mPageSize < 4 * 1024)
-    {
-        mPageSize = 4 * 1024;
-    }
+    mPageSize         = rx::roundUpPow2(std::max(mPageSize, kOSPageSize), kOSPageSize);
+    mMaxFreePageCount = kMaxFreeListSize / mPageSize;
 
     //
     // A large mCurrentPageOffset indicates a new page needs to
@@ -222,17 +303,22 @@ PoolAllocator::~PoolAllocator()
     {
         PageHeader *next = mInUseList->nextPage;
         mInUseList->~PageHeader();
-        delete[] reinterpret_cast<char *>(mInUseList);
+        FreePage(mInUseList);
         mInUseList = next;
     }
     // We should not check the guard blocks
     // here, because we did it already when the block was
     // placed into the free list.
     //
+    // The free pages are given to other allocators through the page cache.
+    //
     while (mFreeList)
     {
         PageHeader *next = mFreeList->nextPage;
-        delete[] reinterpret_cast<char *>(mFreeList);
+        if (mPageSize != kDefaultPageSize || !GetPageCache().release(mFreeList))
+        {
+            FreePage(mFreeList);
+        }
         mFreeList = next;
     }
 #else  // !defined(ANGLE_DISABLE_POOL_ALLOC)
@@ -309,7 +395,8 @@ void PoolAllocator::pop()
         PageHeader *nextInUse = mInUseList->nextPage;
         if (mInUseList->pageCount > 1)
         {
-            delete[] reinterpret_cast<char *>(mInUseList);
+            mPageMemoryInUse -= mInUseList->pageCount * mPageSize;
+            FreePage(mInUseList);
         }
         else
         {
@@ -318,8 +405,8 @@ void PoolAllocator::pop()
             // was last used. (crbug.com/1419798)
             __asan_unpoison_memory_region(mInUseList, mPageSize);
 #    endif
-            mInUseList->nextPage = mFreeList;
-            mFreeList            = mInUseList;
+            mPageMemoryInUse -= mPageSize;
+            releasePage(mInUseList);
         }
         mInUseList = nextInUse;
     }
@@ -399,6 +486,9 @@ void *PoolAllocator::allocate(size_t numBytes)
         new (memory) PageHeader(mInUseList, (numBytesToAlloc + mPageSize - 1) / mPageSize);
         mInUseList = memory;
 
+        mPageMemoryInUse += mInUseList->pageCount * mPageSize;
+        mStatistics.highWaterMark = std::max(mStatistics.highWaterMark, mPageMemoryInUse);
+
         // Make next allocation come from a new page
         mCurrentPageOffset = mPageSize;
 
@@ -426,26 +516,18 @@ void *PoolAllocator::allocate(size_t numBytes)
 #if !defined(ANGLE_DISABLE_POOL_ALLOC)
 uint8_t *PoolAllocator::allocateNewPage(size_t numBytes)
 {
-    // Need a simple page to allocate from.  Pick a page from the free list, if any.  Otherwise need
-    // to make the allocation.
-    PageHeader *memory;
-    if (mFreeList)
+    PageHeader *memory = acquirePage();
+    if (memory == nullptr)
     {
-        memory    = mFreeList;
-        mFreeList = mFreeList->nextPage;
-    }
-    else
-    {
-        memory = reinterpret_cast<PageHeader *>(::new char[mPageSize]);
-        if (memory == nullptr)
-        {
-            return nullptr;
-        }
+        return nullptr;
     }
     // Use placement-new to initialize header
     new (memory) PageHeader(mInUseList, 1);
     mInUseList = memory;
 
+    mPageMemoryInUse += mPageSize;
+    mStatistics.highWaterMark = std::max(mStatistics.highWaterMark, mPageMemoryInUse);
+
     // Leave room for the page header.
     mCurrentPageOffset      = mPageHeaderSkip;
     uint8_t *currentPagePtr = reinterpret_cast<uint8_t *>(mInUseList) + mCurrentPageOffset;
@@ -460,6 +542,51 @@ uint8_t *PoolAllocator::allocateNewPage(size_t numBytes)
     return reinterpret_cast<uint8_t *>(mInUseList) + mPageHeaderSkip + preAllocationPadding;
 }
 
+PageHeader *PoolAllocator::acquirePage()
+{
+    // Need a simple page to allocate from.  Pick a page from the free list, if any, or one that
+    // another allocator no longer needs.  Otherwise need to make the allocation.
+    PageHeader *page = mFreeList;
+    if (page != nullptr)
+    {
+        mFreeList = page->nextPage;
+        --mFreePageCount;
+    }
+    else if (mPageSize == kDefaultPageSize)
+    {
+        page = GetPageCache().acquire();
+    }
+
+    if (page != nullptr)
+    {
+        ++mStatistics.pagesRecycled;
+        return page;
+    }
+
+    page = AllocatePage(mPageSize);
+    if (page != nullptr)
+    {
+        ++mStatistics.pagesAllocated;
+    }
+    return page;
+}
+
+void PoolAllocator::releasePage(PageHeader *page)
+{
+    if (mFreePageCount < mMaxFreePageCount)
+    {
+        page->nextPage = mFreeList;
+        mFreeList      = page;
+        ++mFreePageCount;
+        return;
+    }
+
+    if (mPageSize != kDefaultPageSize || !GetPageCache().release(page))
+    {
+        FreePage(page);
+    }
+}
+
 void *PoolAllocator::initializeAllocation(uint8_t *memory, size_t numBytes)
 {
 #    if defined(ANGLE_POOL_ALLOC_GUARD_BLOCKS)
@@ -39,6 +39,19 @@ namespace angle
 class Allocation;
 class PageHeader;
 
+// Statistics of the memory used by a PoolAllocator.  With ANGLE_DISABLE_POOL_ALLOC, no pages are
+// used and the statistics stay zero.
+struct PoolAllocatorStatistics
+{
+    // The most memory used by pages at any one time, including multi-page allocations.
+    size_t highWaterMark = 0;
+    // Number of single pages that were allocated from the OS.
+    size_t pagesAllocated = 0;
+    // Number of single pages that were reused instead, either from the allocator's own free pages
+    // or from the pages given back by other allocators.
+    size_t pagesRecycled = 0;
+};
+
 //
 // There are several stacks.  One is to track the pushing and popping
 // of the user, and not yet implemented.  The others are simply a
@@ -50,18 +63,28 @@ class PageHeader;
 // re-use.
 //
 // The "page size" used is not, nor must it match, the underlying OS
-// page size.  But, having it be about that size or equal to a set of
-// pages is likely most optimal.
+// page size.  It is however rounded up to a multiple of the OS page size,
+// and pages are aligned to OS pages, so that no page shares an OS page (or
+// a transparent huge page) with unrelated heap memory.
+//
+// A bounded number of free pages is kept by each allocator.  Pages of the
+// default size beyond that, and those of allocators that are destroyed, are
+// given to a process-wide cache, also bounded, from which other allocators
+// take pages before allocating new ones.  This way, the allocators of
+// compilers created one after the other reuse the same, already faulted in,
+// memory.
 //
 class PoolAllocator : angle::NonCopyable
 {
   public:
-    static const int kDefaultAlignment = sizeof(void *);
+    static const int kDefaultAlignment       = sizeof(void *);
+    static constexpr size_t kDefaultPageSize = 8 * 1024;
     //
     // Create PoolAllocator. If alignment is set to 1 byte then fastAllocate()
     //  function can be used to make allocations with less overhead.
     //
-    PoolAllocator(int growthIncrement = 8 * 1024, int allocationAlignment = kDefaultAlignment);
+    PoolAllocator(int growthIncrement = kDefaultPageSize,
+                  int allocationAlignment = kDefaultAlignment);
 
     //
     // Don't call the destructor just to free up the memory, call pop()
@@ -132,6 +155,8 @@ class PoolAllocator : angle::NonCopyable
     void lock();
     void unlock();
 
+    const PoolAllocatorStatistics &getStatistics() const { return mStatistics; }
+
   private:
     size_t mAlignment;  // all returned allocations will be aligned at
                         // this granularity, which will be a power of 2
@@ -145,6 +170,11 @@ class PoolAllocator : angle::NonCopyable
 
     // Slow path of allocation when we have to get a new page.
     uint8_t *allocateNewPage(size_t numBytes);
+    // Get a single page, from the free list, the process-wide page cache, or the OS, in that order.
+    PageHeader *acquirePage();
+    // Give a single page that is no longer used to the free list, or if the free list is full, to
+    // the process-wide page cache.
+    void releasePage(PageHeader *page);
     // Track allocations if and only if we're using guard blocks
     void *initializeAllocation(uint8_t *memory, size_t numBytes);
 
@@ -158,8 +188,10 @@ class PoolAllocator : angle::NonCopyable
     // any) will align to pointer size by extension (since mAlignment is made aligned to at least
     // pointer size).
     size_t mCurrentPageOffset;
-    // List of popped memory
+    // List of popped memory, and its length.  The length is limited to mMaxFreePageCount.
     PageHeader *mFreeList;
+    size_t mFreePageCount;
+    size_t mMaxFreePageCount;
     // List of all memory currently being used.  The head of this list is where allocations are
     // currently being made from.
     PageHeader *mInUseList;
@@ -169,10 +201,15 @@ class PoolAllocator : angle::NonCopyable
     int mNumCalls;       // just an interesting statistic
     size_t mTotalBytes;  // just an interesting statistic
 
+    // Memory currently used by the pages in mInUseList, to track the high-water mark.
+    size_t mPageMemoryInUse;
+
 #else  // !defined(ANGLE_DISABLE_POOL_ALLOC)
     std::vector<std::vector<void *>> mStack;
 #endif
 
+    PoolAllocatorStatistics mStatistics;
+
     bool mLocked;
 };
 
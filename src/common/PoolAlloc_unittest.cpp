@@ -50,6 +50,55 @@ TEST(PoolAllocatorTest, Interface)
     poolAllocator.popAll();
 }
 
+#if !defined(ANGLE_DISABLE_POOL_ALLOC)
+// Verify that popped pages are reused, also by allocators created after the previous ones are
+// destroyed, and that this shows in the statistics.
+TEST(PoolAllocatorTest, PageReuse)
+{
+    constexpr size_t kAllocationSize  = 1024;
+    constexpr size_t kAllocationCount = 64;
+
+    {
+        PoolAllocator poolAllocator;
+        poolAllocator.push();
+        for (size_t i = 0; i < kAllocationCount; ++i)
+        {
+            EXPECT_NE(nullptr, poolAllocator.allocate(kAllocationSize));
+        }
+        poolAllocator.pop();
+
+        const size_t pagesUsed = poolAllocator.getStatistics().pagesAllocated +
+                                 poolAllocator.getStatistics().pagesRecycled;
+        EXPECT_GT(pagesUsed, 0u);
+        EXPECT_GE(poolAllocator.getStatistics().highWaterMark, kAllocationSize * kAllocationCount);
+
+        // Making the same allocations again reuses the popped pages.
+        const size_t pagesAllocated = poolAllocator.getStatistics().pagesAllocated;
+        poolAllocator.push();
+        for (size_t i = 0; i < kAllocationCount; ++i)
+        {
+            EXPECT_NE(nullptr, poolAllocator.allocate(kAllocationSize));
+        }
+        poolAllocator.pop();
+
+        EXPECT_EQ(pagesAllocated, poolAllocator.getStatistics().pagesAllocated);
+        EXPECT_EQ(pagesUsed * 2, poolAllocator.getStatistics().pagesAllocated +
+                                     poolAllocator.getStatistics().pagesRecycled);
+    }
+
+    // A new allocator takes the pages of the destroyed one instead of allocating new ones.
+    PoolAllocator poolAllocator;
+    poolAllocator.push();
+    for (size_t i = 0; i < kAllocationCount; ++i)
+    {
+        EXPECT_NE(nullptr, poolAllocator.allocate(kAllocationSize));
+    }
+    EXPECT_EQ(0u, poolAllocator.getStatistics().pagesAllocated);
+    EXPECT_GT(poolAllocator.getStatistics().pagesRecycled, 0u);
+    poolAllocator.pop();
+}
+#endif
+
 #if !defined(ANGLE_POOL_ALLOC_GUARD_BLOCKS)
 // Verify allocations are correctly aligned for different alignments
 class PoolAllocatorAlignmentTest : public testing::TestWithParam<int>
@@ -215,6 +215,36 @@ struct VulkanPerfCounters
     ANGLE_VK_PERF_COUNTERS_X(ANGLE_DECLARE_PERF_COUNTER)
 };
 
+// Native binding calls made by the GL back-end (glBind*, glActiveTexture, glUseProgram and
+// glUniformBlockBinding), and calls skipped because the object was already bound.  Other state
+// calls are not counted.  Likewise for native glUniform calls, and uniform array elements set to
+// the value they already had.
+#define ANGLE_GL_PERF_COUNTERS_X(FN) \
+    FN(stateCallsIssuedTotal)        \
+    FN(stateCallsIssuedPerFrame)     \
+    FN(stateCallsElidedTotal)        \
+    FN(stateCallsElidedPerFrame)     \
+    FN(uniformCallsIssuedTotal)      \
+    FN(uniformCallsIssuedPerFrame)   \
+    FN(uniformUpdatesElidedTotal)    \
+    FN(uniformUpdatesElidedPerFrame)
+
+struct OpenGLPerfCounters
+{
+    ANGLE_GL_PERF_COUNTERS_X(ANGLE_DECLARE_PERF_COUNTER)
+};
+
+// Non-instanced glDrawElements calls that skipped validation because they repeat the last validated
+// draw with nothing changed since, and calls that were validated in full.
+#define ANGLE_FRONTEND_PERF_COUNTERS_X(FN) \
+    FN(drawValidationKeyHits)              \
+    FN(drawValidationKeyMisses)
+
+struct FrontendPerfCounters
+{
+    ANGLE_FRONTEND_PERF_COUNTERS_X(ANGLE_DECLARE_PERF_COUNTER)
+};
+
 #undef ANGLE_DECLARE_PERF_COUNTER
 
 }  // namespace angle
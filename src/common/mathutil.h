@@ -198,6 +198,8 @@ inline bool supportsSSE2()
             supports = (info[3] >> 26) & 1;
         }
     }
+#    elif defined(__GNUC__)
+    supports = __builtin_cpu_supports("sse2");
 #    endif  // defined(ANGLE_PLATFORM_WINDOWS) && !defined(_M_ARM) && !defined(_M_ARM64)
     checked = true;
     return supports;
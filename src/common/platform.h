@@ -107,6 +107,11 @@
 #    define ANGLE_USE_SSE
 #endif
 
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define ANGLE_USE_NEON
+#endif
+
 // Mips and arm devices need to include stddef for size_t.
 #if defined(__mips__) || defined(__arm__) || defined(__aarch64__)
 #    include <stddef.h>
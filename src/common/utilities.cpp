@@ -18,6 +18,9 @@
 #include "common/platform.h"
 #include "common/string_utils.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <set>
 
 #if defined(ANGLE_ENABLE_WINDOWS_UWP)
@@ -29,72 +32,592 @@
 
 namespace
 {
+// The following functions compute the range of the longest prefix of the indices they can with
+// vector instructions, and return the number of indices processed.  The minimum and maximum are
+// folded into |minOut| and |maxOut|, and the number of primitive restart indices, which are
+// excluded from the maximum, is added to |restartCountOut|.  The restart indices are the largest
+// values of each type, so they never lower the minimum.  If |copyOut| is not null, the indices are
+// also copied to it.  The callers process the remaining indices with the scalar code.
+
+template <typename T, size_t N>
+void ReduceLanes(const T (&minLanes)[N], const T (&maxLanes)[N], T *minOut, T *maxOut)
+{
+    for (size_t lane = 0; lane < N; ++lane)
+    {
+        *minOut = std::min(*minOut, minLanes[lane]);
+        *maxOut = std::max(*maxOut, maxLanes[lane]);
+    }
+}
+
+size_t ComputeIndexRangeSIMD(const uint8_t *indices,
+                             size_t count,
+                             bool primitiveRestartEnabled,
+                             uint8_t *minOut,
+                             uint8_t *maxOut,
+                             size_t *restartCountOut,
+                             uint8_t *copyOut)
+{
+    size_t i = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i restart = _mm_set1_epi8(-1);
+        const __m128i one     = _mm_set1_epi8(1);
+        __m128i minIndex      = _mm_set1_epi8(-1);
+        __m128i maxIndex      = _mm_setzero_si128();
+        __m128i restartCount  = _mm_setzero_si128();
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&indices[i]));
+            if (copyOut != nullptr)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(&copyOut[i]), values);
+            }
+            minIndex = _mm_min_epu8(minIndex, values);
+            if (primitiveRestartEnabled)
+            {
+                // The restart indices are counted in the two 64-bit lanes of |restartCount|.
+                __m128i isRestart = _mm_cmpeq_epi8(values, restart);
+                restartCount      = _mm_add_epi64(
+                    restartCount, _mm_sad_epu8(_mm_and_si128(isRestart, one), _mm_setzero_si128()));
+                values = _mm_andnot_si128(isRestart, values);
+            }
+            maxIndex = _mm_max_epu8(maxIndex, values);
+        }
+
+        uint8_t minLanes[16];
+        uint8_t maxLanes[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(minLanes), minIndex);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(maxLanes), maxIndex);
+        ReduceLanes(minLanes, maxLanes, minOut, maxOut);
+
+        uint64_t restartLanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(restartLanes), restartCount);
+        *restartCountOut += static_cast<size_t>(restartLanes[0] + restartLanes[1]);
+    }
+#elif defined(ANGLE_USE_NEON)
+    const uint8x16_t restart = vdupq_n_u8(0xFF);
+    uint8x16_t minIndex      = vdupq_n_u8(0xFF);
+    uint8x16_t maxIndex      = vdupq_n_u8(0);
+    uint64x2_t restartCount  = vdupq_n_u64(0);
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16_t values = vld1q_u8(&indices[i]);
+        if (copyOut != nullptr)
+        {
+            vst1q_u8(&copyOut[i], values);
+        }
+        minIndex = vminq_u8(minIndex, values);
+        if (primitiveRestartEnabled)
+        {
+            uint8x16_t isRestart = vceqq_u8(values, restart);
+            uint16x8_t restarts  = vpaddlq_u8(vshrq_n_u8(isRestart, 7));
+            restartCount = vaddq_u64(restartCount, vpaddlq_u32(vpaddlq_u16(restarts)));
+            values       = vbicq_u8(values, isRestart);
+        }
+        maxIndex = vmaxq_u8(maxIndex, values);
+    }
+
+    uint8_t minLanes[16];
+    uint8_t maxLanes[16];
+    vst1q_u8(minLanes, minIndex);
+    vst1q_u8(maxLanes, maxIndex);
+    ReduceLanes(minLanes, maxLanes, minOut, maxOut);
+    *restartCountOut += vgetq_lane_u64(restartCount, 0) + vgetq_lane_u64(restartCount, 1);
+#endif
+    return i;
+}
+
+size_t ComputeIndexRangeSIMD(const uint16_t *indices,
+                             size_t count,
+                             bool primitiveRestartEnabled,
+                             uint16_t *minOut,
+                             uint16_t *maxOut,
+                             size_t *restartCountOut,
+                             uint16_t *copyOut)
+{
+    size_t i = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        // SSE2 only has signed 16-bit min and max, so the indices are biased by the sign bit.
+        const __m128i bias    = _mm_set1_epi16(-0x8000);
+        const __m128i restart = _mm_set1_epi16(-1);
+        const __m128i one     = _mm_set1_epi16(1);
+        __m128i minIndex      = _mm_set1_epi16(0x7FFF);
+        __m128i maxIndex      = bias;
+        __m128i restartCount  = _mm_setzero_si128();
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&indices[i]));
+            if (copyOut != nullptr)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(&copyOut[i]), values);
+            }
+            minIndex = _mm_min_epi16(minIndex, _mm_xor_si128(values, bias));
+            if (primitiveRestartEnabled)
+            {
+                // The comparison is -1 for restart indices, which are counted negated in the
+                // four 32-bit lanes of |restartCount|.
+                __m128i isRestart = _mm_cmpeq_epi16(values, restart);
+                restartCount      = _mm_sub_epi32(restartCount, _mm_madd_epi16(isRestart, one));
+                values            = _mm_andnot_si128(isRestart, values);
+            }
+            maxIndex = _mm_max_epi16(maxIndex, _mm_xor_si128(values, bias));
+        }
+
+        uint16_t minLanes[8];
+        uint16_t maxLanes[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(minLanes), _mm_xor_si128(minIndex, bias));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(maxLanes), _mm_xor_si128(maxIndex, bias));
+        ReduceLanes(minLanes, maxLanes, minOut, maxOut);
+
+        uint32_t restartLanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(restartLanes), restartCount);
+        *restartCountOut += static_cast<size_t>(restartLanes[0]) + restartLanes[1] +
+                            restartLanes[2] + restartLanes[3];
+    }
+#elif defined(ANGLE_USE_NEON)
+    const uint16x8_t restart = vdupq_n_u16(0xFFFF);
+    uint16x8_t minIndex      = vdupq_n_u16(0xFFFF);
+    uint16x8_t maxIndex      = vdupq_n_u16(0);
+    uint64x2_t restartCount  = vdupq_n_u64(0);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint16x8_t values = vld1q_u16(&indices[i]);
+        if (copyOut != nullptr)
+        {
+            vst1q_u16(&copyOut[i], values);
+        }
+        minIndex = vminq_u16(minIndex, values);
+        if (primitiveRestartEnabled)
+        {
+            uint16x8_t isRestart = vceqq_u16(values, restart);
+            restartCount =
+                vaddq_u64(restartCount, vpaddlq_u32(vpaddlq_u16(vshrq_n_u16(isRestart, 15))));
+            values = vbicq_u16(values, isRestart);
+        }
+        maxIndex = vmaxq_u16(maxIndex, values);
+    }
+
+    uint16_t minLanes[8];
+    uint16_t maxLanes[8];
+    vst1q_u16(minLanes, minIndex);
+    vst1q_u16(maxLanes, maxIndex);
+    ReduceLanes(minLanes, maxLanes, minOut, maxOut);
+    *restartCountOut += vgetq_lane_u64(restartCount, 0) + vgetq_lane_u64(restartCount, 1);
+#endif
+    return i;
+}
+
+size_t ComputeIndexRangeSIMD(const uint32_t *indices,
+                             size_t count,
+                             bool primitiveRestartEnabled,
+                             uint32_t *minOut,
+                             uint32_t *maxOut,
+                             size_t *restartCountOut,
+                             uint32_t *copyOut)
+{
+    size_t i = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        // SSE2 has no 32-bit min and max, so they are done with signed comparisons of the indices
+        // biased by the sign bit.
+        const __m128i bias    = _mm_set1_epi32(INT32_MIN);
+        const __m128i restart = _mm_set1_epi32(-1);
+        __m128i minIndex      = _mm_set1_epi32(INT32_MAX);
+        __m128i maxIndex      = bias;
+        __m128i restartCount  = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&indices[i]));
+            if (copyOut != nullptr)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(&copyOut[i]), values);
+            }
+
+            __m128i biased    = _mm_xor_si128(values, bias);
+            __m128i isSmaller = _mm_cmpgt_epi32(minIndex, biased);
+            minIndex          = _mm_or_si128(_mm_and_si128(isSmaller, biased),
+                                             _mm_andnot_si128(isSmaller, minIndex));
+
+            if (primitiveRestartEnabled)
+            {
+                // The comparison is -1 for restart indices, which are counted negated in the
+                // four 32-bit lanes of |restartCount|.
+                __m128i isRestart = _mm_cmpeq_epi32(values, restart);
+                restartCount      = _mm_sub_epi32(restartCount, isRestart);
+                biased            = _mm_xor_si128(_mm_andnot_si128(isRestart, values), bias);
+            }
+            __m128i isLarger = _mm_cmpgt_epi32(biased, maxIndex);
+            maxIndex         = _mm_or_si128(_mm_and_si128(isLarger, biased),
+                                            _mm_andnot_si128(isLarger, maxIndex));
+        }
+
+        uint32_t minLanes[4];
+        uint32_t maxLanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(minLanes), _mm_xor_si128(minIndex, bias));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(maxLanes), _mm_xor_si128(maxIndex, bias));
+        ReduceLanes(minLanes, maxLanes, minOut, maxOut);
+
+        uint32_t restartLanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(restartLanes), restartCount);
+        *restartCountOut += static_cast<size_t>(restartLanes[0]) + restartLanes[1] +
+                            restartLanes[2] + restartLanes[3];
+    }
+#elif defined(ANGLE_USE_NEON)
+    const uint32x4_t restart = vdupq_n_u32(0xFFFFFFFF);
+    uint32x4_t minIndex      = vdupq_n_u32(0xFFFFFFFF);
+    uint32x4_t maxIndex      = vdupq_n_u32(0);
+    uint64x2_t restartCount  = vdupq_n_u64(0);
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32x4_t values = vld1q_u32(&indices[i]);
+        if (copyOut != nullptr)
+        {
+            vst1q_u32(&copyOut[i], values);
+        }
+        minIndex = vminq_u32(minIndex, values);
+        if (primitiveRestartEnabled)
+        {
+            uint32x4_t isRestart = vceqq_u32(values, restart);
+            restartCount = vaddq_u64(restartCount, vpaddlq_u32(vshrq_n_u32(isRestart, 31)));
+            values       = vbicq_u32(values, isRestart);
+        }
+        maxIndex = vmaxq_u32(maxIndex, values);
+    }
+
+    uint32_t minLanes[4];
+    uint32_t maxLanes[4];
+    vst1q_u32(minLanes, minIndex);
+    vst1q_u32(maxLanes, maxIndex);
+    ReduceLanes(minLanes, maxLanes, minOut, maxOut);
+    *restartCountOut += vgetq_lane_u64(restartCount, 0) + vgetq_lane_u64(restartCount, 1);
+#endif
+    return i;
+}
 
 template <class IndexType>
 gl::IndexRange ComputeTypedIndexRange(const IndexType *indices,
                                       size_t count,
                                       bool primitiveRestartEnabled,
-                                      GLuint primitiveRestartIndex)
+                                      GLuint primitiveRestartIndex,
+                                      IndexType *copyOut)
 {
     ASSERT(count > 0);
 
-    IndexType minIndex                = 0;
-    IndexType maxIndex                = 0;
-    size_t nonPrimitiveRestartIndices = 0;
+    IndexType minIndex  = std::numeric_limits<IndexType>::max();
+    IndexType maxIndex  = 0;
+    size_t restartCount = 0;
+
+    size_t i = ComputeIndexRangeSIMD(indices, count, primitiveRestartEnabled, &minIndex, &maxIndex,
+                                     &restartCount, copyOut);
+    size_t nonPrimitiveRestartIndices = i - restartCount;
+
+    // Loop over the rest of the indices
+    for (; i < count; i++)
+    {
+        if (copyOut != nullptr)
+        {
+            copyOut[i] = indices[i];
+        }
+        if (primitiveRestartEnabled && indices[i] == primitiveRestartIndex)
+        {
+            continue;
+        }
+        if (minIndex > indices[i])
+        {
+            minIndex = indices[i];
+        }
+        if (maxIndex < indices[i])
+        {
+            maxIndex = indices[i];
+        }
+        nonPrimitiveRestartIndices++;
+    }
+
+    if (nonPrimitiveRestartIndices == 0)
+    {
+        return gl::IndexRange(0, 0, 0);
+    }
+
+    return gl::IndexRange(static_cast<size_t>(minIndex), static_cast<size_t>(maxIndex),
+                          nonPrimitiveRestartIndices);
+}
+
+size_t GetIndexTypeSize(gl::DrawElementsType indexType)
+{
+    switch (indexType)
+    {
+        case gl::DrawElementsType::UnsignedByte:
+            return sizeof(GLubyte);
+        case gl::DrawElementsType::UnsignedShort:
+            return sizeof(GLushort);
+        case gl::DrawElementsType::UnsignedInt:
+            return sizeof(GLuint);
+        default:
+            UNREACHABLE();
+            return 0;
+    }
+}
+
+// The following functions widen the longest prefix of the indices they can with vector
+// instructions, and return the number of indices converted.  If |rewritePrimitiveRestartIndex| is
+// set, the primitive restart index of the source type is widened to that of the destination type,
+// which is done by filling the upper half of each index with its comparison with the restart
+// index.  The callers convert the remaining indices with the scalar code.
+
+size_t ConvertIndicesSIMD(const uint8_t *input,
+                          size_t count,
+                          bool rewritePrimitiveRestartIndex,
+                          uint16_t *output)
+{
+    size_t i = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i restart = _mm_set1_epi8(-1);
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&input[i]));
+            __m128i upper  = rewritePrimitiveRestartIndex ? _mm_cmpeq_epi8(values, restart)
+                                                          : _mm_setzero_si128();
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&output[i]),
+                             _mm_unpacklo_epi8(values, upper));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&output[i + 8]),
+                             _mm_unpackhi_epi8(values, upper));
+        }
+    }
+#elif defined(ANGLE_USE_NEON)
+    const uint8x16_t restart = vdupq_n_u8(0xFF);
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16_t values = vld1q_u8(&input[i]);
+        uint8x16_t upper =
+            rewritePrimitiveRestartIndex ? vceqq_u8(values, restart) : vdupq_n_u8(0);
+        uint8x16x2_t widened = vzipq_u8(values, upper);
+        vst1q_u16(&output[i], vreinterpretq_u16_u8(widened.val[0]));
+        vst1q_u16(&output[i + 8], vreinterpretq_u16_u8(widened.val[1]));
+    }
+#endif
+    return i;
+}
+
+size_t ConvertIndicesSIMD(const uint16_t *input,
+                          size_t count,
+                          bool rewritePrimitiveRestartIndex,
+                          uint32_t *output)
+{
+    size_t i = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i restart = _mm_set1_epi16(-1);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&input[i]));
+            __m128i upper  = rewritePrimitiveRestartIndex ? _mm_cmpeq_epi16(values, restart)
+                                                          : _mm_setzero_si128();
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&output[i]),
+                             _mm_unpacklo_epi16(values, upper));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&output[i + 4]),
+                             _mm_unpackhi_epi16(values, upper));
+        }
+    }
+#elif defined(ANGLE_USE_NEON)
+    const uint16x8_t restart = vdupq_n_u16(0xFFFF);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint16x8_t values = vld1q_u16(&input[i]);
+        uint16x8_t upper =
+            rewritePrimitiveRestartIndex ? vceqq_u16(values, restart) : vdupq_n_u16(0);
+        uint16x8x2_t widened = vzipq_u16(values, upper);
+        vst1q_u32(&output[i], vreinterpretq_u32_u16(widened.val[0]));
+        vst1q_u32(&output[i + 4], vreinterpretq_u32_u16(widened.val[1]));
+    }
+#endif
+    return i;
+}
+
+size_t ConvertIndicesSIMD(const uint8_t *input,
+                          size_t count,
+                          bool rewritePrimitiveRestartIndex,
+                          uint32_t *output)
+{
+    size_t i = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i restart = _mm_set1_epi8(-1);
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&input[i]));
+            __m128i upper  = rewritePrimitiveRestartIndex ? _mm_cmpeq_epi8(values, restart)
+                                                          : _mm_setzero_si128();
+
+            __m128i lower16   = _mm_unpacklo_epi8(values, upper);
+            __m128i upper16   = _mm_unpackhi_epi8(values, upper);
+            __m128i lowerMask = _mm_unpacklo_epi8(upper, upper);
+            __m128i upperMask = _mm_unpackhi_epi8(upper, upper);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&output[i]),
+                             _mm_unpacklo_epi16(lower16, lowerMask));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&output[i + 4]),
+                             _mm_unpackhi_epi16(lower16, lowerMask));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&output[i + 8]),
+                             _mm_unpacklo_epi16(upper16, upperMask));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&output[i + 12]),
+                             _mm_unpackhi_epi16(upper16, upperMask));
+        }
+    }
+#elif defined(ANGLE_USE_NEON)
+    const uint8x16_t restart = vdupq_n_u8(0xFF);
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16_t values = vld1q_u8(&input[i]);
+        uint8x16_t upper =
+            rewritePrimitiveRestartIndex ? vceqq_u8(values, restart) : vdupq_n_u8(0);
+        uint8x16x2_t widened16 = vzipq_u8(values, upper);
+        uint8x16x2_t masks16   = vzipq_u8(upper, upper);
+        for (int half = 0; half < 2; ++half)
+        {
+            uint16x8x2_t widened32 = vzipq_u16(vreinterpretq_u16_u8(widened16.val[half]),
+                                               vreinterpretq_u16_u8(masks16.val[half]));
+            vst1q_u32(&output[i + half * 8], vreinterpretq_u32_u16(widened32.val[0]));
+            vst1q_u32(&output[i + half * 8 + 4], vreinterpretq_u32_u16(widened32.val[1]));
+        }
+    }
+#endif
+    return i;
+}
+
+template <typename InputType, typename OutputType>
+void ConvertTypedIndices(const InputType *input,
+                         size_t count,
+                         bool rewritePrimitiveRestartIndex,
+                         OutputType *output)
+{
+    size_t i = ConvertIndicesSIMD(input, count, rewritePrimitiveRestartIndex, output);
 
-    if (primitiveRestartEnabled)
+    constexpr InputType kInputRestartIndex = gl::GetPrimitiveRestartIndexFromType<InputType>();
+    constexpr OutputType kOutputRestartIndex =
+        gl::GetPrimitiveRestartIndexFromType<OutputType>();
+    for (; i < count; i++)
     {
-        // Find the first non-primitive restart index to initialize the min and max values
-        size_t i = 0;
-        for (; i < count; i++)
+        output[i] = rewritePrimitiveRestartIndex && input[i] == kInputRestartIndex
+                        ? kOutputRestartIndex
+                        : static_cast<OutputType>(input[i]);
+    }
+}
+
+// The following functions skip the longest prefix of the indices they can with vector
+// instructions that has no primitive restart index, and return the number of indices skipped.  The
+// callers find the restart index in the remaining indices with the scalar code.
+
+size_t SkipNonPrimitiveRestartIndicesSIMD(const uint8_t *indices, size_t count)
+{
+    size_t i = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i restart = _mm_set1_epi8(-1);
+        for (; i + 16 <= count; i += 16)
         {
-            if (indices[i] != primitiveRestartIndex)
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&indices[i]));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(values, restart)) != 0)
             {
-                minIndex = indices[i];
-                maxIndex = indices[i];
-                nonPrimitiveRestartIndices++;
                 break;
             }
         }
+    }
+#elif defined(ANGLE_USE_NEON)
+    const uint8x16_t restart = vdupq_n_u8(0xFF);
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16_t isRestart = vceqq_u8(vld1q_u8(&indices[i]), restart);
+        uint8x8_t anyRestart = vorr_u8(vget_low_u8(isRestart), vget_high_u8(isRestart));
+        if (vget_lane_u64(vreinterpret_u64_u8(anyRestart), 0) != 0)
+        {
+            break;
+        }
+    }
+#endif
+    return i;
+}
 
-        // Loop over the rest of the indices
-        for (; i < count; i++)
+size_t SkipNonPrimitiveRestartIndicesSIMD(const uint16_t *indices, size_t count)
+{
+    size_t i = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i restart = _mm_set1_epi16(-1);
+        for (; i + 8 <= count; i += 8)
         {
-            if (indices[i] != primitiveRestartIndex)
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&indices[i]));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(values, restart)) != 0)
             {
-                if (minIndex > indices[i])
-                {
-                    minIndex = indices[i];
-                }
-                if (maxIndex < indices[i])
-                {
-                    maxIndex = indices[i];
-                }
-                nonPrimitiveRestartIndices++;
+                break;
             }
         }
     }
-    else
+#elif defined(ANGLE_USE_NEON)
+    const uint16x8_t restart = vdupq_n_u16(0xFFFF);
+    for (; i + 8 <= count; i += 8)
     {
-        minIndex                   = indices[0];
-        maxIndex                   = indices[0];
-        nonPrimitiveRestartIndices = count;
+        uint16x8_t isRestart  = vceqq_u16(vld1q_u16(&indices[i]), restart);
+        uint16x4_t anyRestart = vorr_u16(vget_low_u16(isRestart), vget_high_u16(isRestart));
+        if (vget_lane_u64(vreinterpret_u64_u16(anyRestart), 0) != 0)
+        {
+            break;
+        }
+    }
+#endif
+    return i;
+}
 
-        for (size_t i = 1; i < count; i++)
+size_t SkipNonPrimitiveRestartIndicesSIMD(const uint32_t *indices, size_t count)
+{
+    size_t i = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i restart = _mm_set1_epi32(-1);
+        for (; i + 4 <= count; i += 4)
         {
-            if (minIndex > indices[i])
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&indices[i]));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(values, restart)) != 0)
             {
-                minIndex = indices[i];
-            }
-            if (maxIndex < indices[i])
-            {
-                maxIndex = indices[i];
+                break;
             }
         }
     }
+#elif defined(ANGLE_USE_NEON)
+    const uint32x4_t restart = vdupq_n_u32(0xFFFFFFFF);
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32x4_t isRestart  = vceqq_u32(vld1q_u32(&indices[i]), restart);
+        uint32x2_t anyRestart = vorr_u32(vget_low_u32(isRestart), vget_high_u32(isRestart));
+        if (vget_lane_u64(vreinterpret_u64_u32(anyRestart), 0) != 0)
+        {
+            break;
+        }
+    }
+#endif
+    return i;
+}
 
-    return gl::IndexRange(static_cast<size_t>(minIndex), static_cast<size_t>(maxIndex),
-                          nonPrimitiveRestartIndices);
+template <typename IndexType>
+size_t FindTypedPrimitiveRestartIndex(const IndexType *indices, size_t count)
+{
+    constexpr IndexType kRestartIndex = gl::GetPrimitiveRestartIndexFromType<IndexType>();
+
+    size_t i = SkipNonPrimitiveRestartIndicesSIMD(indices, count);
+    while (i < count && indices[i] != kRestartIndex)
+    {
+        i++;
+    }
+    return i;
 }
 
 }  // anonymous namespace
@@ -708,23 +1231,165 @@ IndexRange ComputeIndexRange(DrawElementsType indexType,
     switch (indexType)
     {
         case DrawElementsType::UnsignedByte:
-            return ComputeTypedIndexRange(static_cast<const GLubyte *>(indices), count,
-                                          primitiveRestartEnabled,
-                                          GetPrimitiveRestartIndex(indexType));
+            return ComputeTypedIndexRange<GLubyte>(static_cast<const GLubyte *>(indices), count,
+                                                   primitiveRestartEnabled,
+                                                   GetPrimitiveRestartIndex(indexType), nullptr);
+        case DrawElementsType::UnsignedShort:
+            return ComputeTypedIndexRange<GLushort>(static_cast<const GLushort *>(indices), count,
+                                                    primitiveRestartEnabled,
+                                                    GetPrimitiveRestartIndex(indexType), nullptr);
+        case DrawElementsType::UnsignedInt:
+            return ComputeTypedIndexRange<GLuint>(static_cast<const GLuint *>(indices), count,
+                                                  primitiveRestartEnabled,
+                                                  GetPrimitiveRestartIndex(indexType), nullptr);
+        default:
+            UNREACHABLE();
+            return IndexRange();
+    }
+}
+
+IndexRange CopyIndicesAndComputeRange(DrawElementsType indexType,
+                                      const GLvoid *indices,
+                                      size_t count,
+                                      bool primitiveRestartEnabled,
+                                      GLvoid *output)
+{
+    switch (indexType)
+    {
+        case DrawElementsType::UnsignedByte:
+            return ComputeTypedIndexRange(
+                static_cast<const GLubyte *>(indices), count, primitiveRestartEnabled,
+                GetPrimitiveRestartIndex(indexType), static_cast<GLubyte *>(output));
         case DrawElementsType::UnsignedShort:
-            return ComputeTypedIndexRange(static_cast<const GLushort *>(indices), count,
-                                          primitiveRestartEnabled,
-                                          GetPrimitiveRestartIndex(indexType));
+            return ComputeTypedIndexRange(
+                static_cast<const GLushort *>(indices), count, primitiveRestartEnabled,
+                GetPrimitiveRestartIndex(indexType), static_cast<GLushort *>(output));
         case DrawElementsType::UnsignedInt:
-            return ComputeTypedIndexRange(static_cast<const GLuint *>(indices), count,
-                                          primitiveRestartEnabled,
-                                          GetPrimitiveRestartIndex(indexType));
+            return ComputeTypedIndexRange(
+                static_cast<const GLuint *>(indices), count, primitiveRestartEnabled,
+                GetPrimitiveRestartIndex(indexType), static_cast<GLuint *>(output));
         default:
             UNREACHABLE();
             return IndexRange();
     }
 }
 
+void ConvertIndices(DrawElementsType sourceType,
+                    DrawElementsType destinationType,
+                    const GLvoid *input,
+                    size_t count,
+                    GLvoid *output,
+                    bool rewritePrimitiveRestartIndex)
+{
+    if (sourceType == destinationType)
+    {
+        memcpy(output, input, count * GetIndexTypeSize(sourceType));
+        return;
+    }
+
+    switch (sourceType)
+    {
+        case DrawElementsType::UnsignedByte:
+            if (destinationType == DrawElementsType::UnsignedShort)
+            {
+                ConvertTypedIndices(static_cast<const GLubyte *>(input), count,
+                                    rewritePrimitiveRestartIndex, static_cast<GLushort *>(output));
+            }
+            else
+            {
+                ASSERT(destinationType == DrawElementsType::UnsignedInt);
+                ConvertTypedIndices(static_cast<const GLubyte *>(input), count,
+                                    rewritePrimitiveRestartIndex, static_cast<GLuint *>(output));
+            }
+            break;
+        case DrawElementsType::UnsignedShort:
+            ASSERT(destinationType == DrawElementsType::UnsignedInt);
+            ConvertTypedIndices(static_cast<const GLushort *>(input), count,
+                                rewritePrimitiveRestartIndex, static_cast<GLuint *>(output));
+            break;
+        default:
+            UNREACHABLE();
+            break;
+    }
+}
+
+size_t FindPrimitiveRestartIndex(DrawElementsType indexType, const GLvoid *indices, size_t count)
+{
+    switch (indexType)
+    {
+        case DrawElementsType::UnsignedByte:
+            return FindTypedPrimitiveRestartIndex(static_cast<const GLubyte *>(indices), count);
+        case DrawElementsType::UnsignedShort:
+            return FindTypedPrimitiveRestartIndex(static_cast<const GLushort *>(indices), count);
+        case DrawElementsType::UnsignedInt:
+            return FindTypedPrimitiveRestartIndex(static_cast<const GLuint *>(indices), count);
+        default:
+            UNREACHABLE();
+            return count;
+    }
+}
+
+size_t GetLineLoopWithRestartIndexCount(DrawElementsType indexType,
+                                        const GLvoid *indices,
+                                        size_t count)
+{
+    const uint8_t *input    = static_cast<const uint8_t *>(indices);
+    const size_t indexBytes = GetIndexTypeSize(indexType);
+
+    // Every non-empty loop is written with its first index repeated at the end, followed by a
+    // restart index unless it is the last loop.
+    size_t outputCount = 0;
+    size_t loopStart   = 0;
+    while (loopStart < count)
+    {
+        size_t loopEnd = loopStart + FindPrimitiveRestartIndex(indexType,
+                                                               input + loopStart * indexBytes,
+                                                               count - loopStart);
+        if (loopEnd > loopStart)
+        {
+            outputCount += loopEnd - loopStart + (loopEnd < count ? 2 : 1);
+        }
+        loopStart = loopEnd + 1;
+    }
+    return outputCount;
+}
+
+void CopyLineLoopIndicesWithRestart(DrawElementsType sourceType,
+                                    DrawElementsType destinationType,
+                                    const GLvoid *input,
+                                    size_t count,
+                                    GLvoid *output)
+{
+    const uint8_t *inputBytes     = static_cast<const uint8_t *>(input);
+    uint8_t *outputBytes          = static_cast<uint8_t *>(output);
+    const size_t sourceBytes      = GetIndexTypeSize(sourceType);
+    const size_t destinationBytes = GetIndexTypeSize(destinationType);
+
+    size_t loopStart = 0;
+    while (loopStart < count)
+    {
+        const uint8_t *loop = inputBytes + loopStart * sourceBytes;
+        size_t loopLength   = FindPrimitiveRestartIndex(sourceType, loop, count - loopStart);
+        if (loopLength > 0)
+        {
+            // The loop has no restart index, so it is converted as is, and closed with its first
+            // index.
+            ConvertIndices(sourceType, destinationType, loop, loopLength, outputBytes, false);
+            outputBytes += loopLength * destinationBytes;
+            ConvertIndices(sourceType, destinationType, loop, 1, outputBytes, false);
+            outputBytes += destinationBytes;
+
+            if (loopStart + loopLength < count)
+            {
+                // The restart index of every type has all bits set.
+                memset(outputBytes, 0xFF, destinationBytes);
+                outputBytes += destinationBytes;
+            }
+        }
+        loopStart += loopLength + 1;
+    }
+}
+
 GLuint GetPrimitiveRestartIndex(DrawElementsType indexType)
 {
     switch (indexType)
@@ -81,6 +81,40 @@ IndexRange ComputeIndexRange(DrawElementsType indexType,
                              size_t count,
                              bool primitiveRestartEnabled);
 
+// Copies the indices to |output| and returns their range as ComputeIndexRange does, reading the
+// indices only once.
+IndexRange CopyIndicesAndComputeRange(DrawElementsType indexType,
+                                      const GLvoid *indices,
+                                      size_t count,
+                                      bool primitiveRestartEnabled,
+                                      GLvoid *output);
+
+// Converts the indices to |destinationType|, which must be at least as wide as |sourceType|.  If
+// |rewritePrimitiveRestartIndex| is set, the primitive restart index of the source type is
+// converted to that of the destination type.
+void ConvertIndices(DrawElementsType sourceType,
+                    DrawElementsType destinationType,
+                    const GLvoid *input,
+                    size_t count,
+                    GLvoid *output,
+                    bool rewritePrimitiveRestartIndex);
+
+// Returns the position of the first primitive restart index in the indices, or |count| if there is
+// none.
+size_t FindPrimitiveRestartIndex(DrawElementsType indexType, const GLvoid *indices, size_t count);
+
+// Line loops with primitive restart are drawn as line strips, closing each loop by repeating its
+// first index before the restart index that ends it.  Returns the number of indices written by
+// CopyLineLoopIndicesWithRestart.
+size_t GetLineLoopWithRestartIndexCount(DrawElementsType indexType,
+                                        const GLvoid *indices,
+                                        size_t count);
+void CopyLineLoopIndicesWithRestart(DrawElementsType sourceType,
+                                    DrawElementsType destinationType,
+                                    const GLvoid *input,
+                                    size_t count,
+                                    GLvoid *output);
+
 // Get the primitive restart index value for the given index type.
 GLuint GetPrimitiveRestartIndex(DrawElementsType indexType);
 
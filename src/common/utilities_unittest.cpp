@@ -177,4 +177,273 @@ TEST(ParseArrayIndex, ArrayIndexOutOfRange)
     EXPECT_EQ(15u, nameLengthWithoutArrayIndex);
 }
 
+// Computes the range of |indices| one index at a time, for comparison with ComputeIndexRange.
+template <typename T>
+gl::IndexRange ReferenceIndexRange(const std::vector<T> &indices,
+                                   size_t first,
+                                   size_t count,
+                                   bool primitiveRestartEnabled)
+{
+    size_t minIndex    = std::numeric_limits<size_t>::max();
+    size_t maxIndex    = 0;
+    size_t vertexCount = 0;
+    for (size_t i = first; i < first + count; ++i)
+    {
+        if (primitiveRestartEnabled && indices[i] == std::numeric_limits<T>::max())
+        {
+            continue;
+        }
+        minIndex = std::min<size_t>(minIndex, indices[i]);
+        maxIndex = std::max<size_t>(maxIndex, indices[i]);
+        vertexCount++;
+    }
+    return vertexCount == 0 ? gl::IndexRange(0, 0, 0)
+                            : gl::IndexRange(minIndex, maxIndex, vertexCount);
+}
+
+template <typename T>
+void CheckComputeIndexRange(gl::DrawElementsType type)
+{
+    // Random indices, with some primitive restart indices, and the largest and smallest values
+    // placed at different positions to exercise every vector lane.
+    std::vector<T> indices(300);
+    uint32_t state = 1;
+    for (T &index : indices)
+    {
+        state = state * 1664525u + 1013904223u;
+        index = static_cast<T>(state ^ (state >> 16));
+        if ((state >> 4) % 11 == 0)
+        {
+            index = std::numeric_limits<T>::max();
+        }
+    }
+
+    for (bool primitiveRestartEnabled : {false, true})
+    {
+        for (size_t first : {0, 1, 3, 5})
+        {
+            for (size_t count : {1, 2, 7, 8, 15, 16, 17, 31, 64, 100, 295})
+            {
+                gl::IndexRange expected =
+                    ReferenceIndexRange(indices, first, count, primitiveRestartEnabled);
+                gl::IndexRange actual = gl::ComputeIndexRange(type, indices.data() + first, count,
+                                                              primitiveRestartEnabled);
+                EXPECT_EQ(expected.start, actual.start) << first << " " << count;
+                EXPECT_EQ(expected.end, actual.end) << first << " " << count;
+                EXPECT_EQ(expected.vertexIndexCount, actual.vertexIndexCount)
+                    << first << " " << count;
+            }
+        }
+    }
+
+    // Only primitive restart indices.
+    std::vector<T> restartIndices(40, std::numeric_limits<T>::max());
+    gl::IndexRange range = gl::ComputeIndexRange(type, restartIndices.data(), 40, true);
+    EXPECT_EQ(0u, range.vertexIndexCount);
+    range = gl::ComputeIndexRange(type, restartIndices.data(), 40, false);
+    EXPECT_EQ(std::numeric_limits<T>::max(), range.start);
+    EXPECT_EQ(40u, range.vertexIndexCount);
+}
+
+// Test that ComputeIndexRange matches a one index at a time reference for all the index types,
+// with and without primitive restart, over counts and offsets that exercise both the vector loops
+// and the scalar remainders.
+TEST(ComputeIndexRange, MatchesReference)
+{
+    CheckComputeIndexRange<GLubyte>(gl::DrawElementsType::UnsignedByte);
+    CheckComputeIndexRange<GLushort>(gl::DrawElementsType::UnsignedShort);
+    CheckComputeIndexRange<GLuint>(gl::DrawElementsType::UnsignedInt);
+}
+
+// Random indices with some primitive restart indices, including runs of them and one at the start.
+template <typename T>
+std::vector<T> MakeIndicesWithRestarts(size_t count)
+{
+    std::vector<T> indices(count);
+    uint32_t state = 7;
+    for (T &index : indices)
+    {
+        state = state * 1664525u + 1013904223u;
+        index = static_cast<T>(state ^ (state >> 16));
+        if ((state >> 4) % 13 == 0)
+        {
+            index = std::numeric_limits<T>::max();
+        }
+    }
+    indices[0]  = std::numeric_limits<T>::max();
+    indices[50] = std::numeric_limits<T>::max();
+    indices[51] = std::numeric_limits<T>::max();
+    return indices;
+}
+
+template <typename T>
+void CheckCopyIndicesAndComputeRange(gl::DrawElementsType type)
+{
+    std::vector<T> indices = MakeIndicesWithRestarts<T>(300);
+    for (bool primitiveRestartEnabled : {false, true})
+    {
+        for (size_t first : {0, 1, 3})
+        {
+            for (size_t count : {1, 7, 8, 16, 17, 100, 295})
+            {
+                std::vector<T> copy(count, 0);
+                gl::IndexRange expected = gl::ComputeIndexRange(type, indices.data() + first, count,
+                                                                primitiveRestartEnabled);
+                gl::IndexRange actual   = gl::CopyIndicesAndComputeRange(
+                    type, indices.data() + first, count, primitiveRestartEnabled, copy.data());
+                EXPECT_EQ(expected.start, actual.start) << first << " " << count;
+                EXPECT_EQ(expected.end, actual.end) << first << " " << count;
+                EXPECT_EQ(expected.vertexIndexCount, actual.vertexIndexCount)
+                    << first << " " << count;
+                EXPECT_TRUE(std::equal(copy.begin(), copy.end(), indices.begin() + first))
+                    << first << " " << count;
+            }
+        }
+    }
+}
+
+// Test that CopyIndicesAndComputeRange copies the indices and computes the same range as
+// ComputeIndexRange.
+TEST(CopyIndicesAndComputeRange, MatchesComputeIndexRange)
+{
+    CheckCopyIndicesAndComputeRange<GLubyte>(gl::DrawElementsType::UnsignedByte);
+    CheckCopyIndicesAndComputeRange<GLushort>(gl::DrawElementsType::UnsignedShort);
+    CheckCopyIndicesAndComputeRange<GLuint>(gl::DrawElementsType::UnsignedInt);
+}
+
+template <typename In, typename Out>
+void CheckConvertIndices(gl::DrawElementsType sourceType, gl::DrawElementsType destinationType)
+{
+    std::vector<In> indices = MakeIndicesWithRestarts<In>(300);
+    for (bool rewritePrimitiveRestartIndex : {false, true})
+    {
+        for (size_t first : {0, 1, 3})
+        {
+            for (size_t count : {1, 4, 7, 8, 15, 16, 17, 33, 295})
+            {
+                std::vector<Out> expected(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    In index    = indices[first + i];
+                    expected[i] = rewritePrimitiveRestartIndex &&
+                                          index == std::numeric_limits<In>::max()
+                                      ? std::numeric_limits<Out>::max()
+                                      : static_cast<Out>(index);
+                }
+
+                std::vector<Out> actual(count, 0);
+                gl::ConvertIndices(sourceType, destinationType, indices.data() + first, count,
+                                   actual.data(), rewritePrimitiveRestartIndex);
+                EXPECT_EQ(expected, actual) << first << " " << count;
+            }
+        }
+    }
+}
+
+// Test that ConvertIndices matches a one index at a time conversion for every widening, with and
+// without rewriting the primitive restart indices.
+TEST(ConvertIndices, MatchesReference)
+{
+    CheckConvertIndices<GLubyte, GLubyte>(gl::DrawElementsType::UnsignedByte,
+                                          gl::DrawElementsType::UnsignedByte);
+    CheckConvertIndices<GLubyte, GLushort>(gl::DrawElementsType::UnsignedByte,
+                                           gl::DrawElementsType::UnsignedShort);
+    CheckConvertIndices<GLubyte, GLuint>(gl::DrawElementsType::UnsignedByte,
+                                         gl::DrawElementsType::UnsignedInt);
+    CheckConvertIndices<GLushort, GLuint>(gl::DrawElementsType::UnsignedShort,
+                                          gl::DrawElementsType::UnsignedInt);
+}
+
+template <typename T>
+void CheckFindPrimitiveRestartIndex(gl::DrawElementsType type)
+{
+    std::vector<T> indices(200, 5);
+    EXPECT_EQ(200u, gl::FindPrimitiveRestartIndex(type, indices.data(), indices.size()));
+
+    for (size_t restartPosition : {0, 1, 3, 4, 7, 8, 15, 16, 17, 100, 199})
+    {
+        indices[restartPosition] = std::numeric_limits<T>::max();
+        EXPECT_EQ(restartPosition,
+                  gl::FindPrimitiveRestartIndex(type, indices.data(), indices.size()));
+        EXPECT_EQ(restartPosition,
+                  gl::FindPrimitiveRestartIndex(type, indices.data(), restartPosition));
+        indices[restartPosition] = 5;
+    }
+}
+
+// Test that FindPrimitiveRestartIndex finds the restart index in every vector lane and in the
+// scalar remainder.
+TEST(FindPrimitiveRestartIndex, FindsFirstRestartIndex)
+{
+    CheckFindPrimitiveRestartIndex<GLubyte>(gl::DrawElementsType::UnsignedByte);
+    CheckFindPrimitiveRestartIndex<GLushort>(gl::DrawElementsType::UnsignedShort);
+    CheckFindPrimitiveRestartIndex<GLuint>(gl::DrawElementsType::UnsignedInt);
+}
+
+// Writes the line strips for a line loop with primitive restart one index at a time, for comparison
+// with CopyLineLoopIndicesWithRestart.
+template <typename In, typename Out>
+std::vector<Out> ReferenceLineLoopIndices(const In *indices, size_t count)
+{
+    std::vector<Out> strips;
+    size_t loopStart = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (indices[i] != std::numeric_limits<In>::max())
+        {
+            strips.push_back(static_cast<Out>(indices[i]));
+            continue;
+        }
+        if (i > loopStart)
+        {
+            strips.push_back(static_cast<Out>(indices[loopStart]));
+            strips.push_back(std::numeric_limits<Out>::max());
+        }
+        loopStart = i + 1;
+    }
+    if (count > loopStart)
+    {
+        strips.push_back(static_cast<Out>(indices[loopStart]));
+    }
+    return strips;
+}
+
+template <typename In, typename Out>
+void CheckLineLoopIndicesWithRestart(gl::DrawElementsType sourceType,
+                                     gl::DrawElementsType destinationType)
+{
+    std::vector<In> indices = MakeIndicesWithRestarts<In>(300);
+    for (size_t first : {0, 1, 3})
+    {
+        for (size_t count : {1, 2, 16, 49, 50, 51, 52, 100, 297})
+        {
+            std::vector<Out> expected =
+                ReferenceLineLoopIndices<In, Out>(indices.data() + first, count);
+            ASSERT_EQ(expected.size(), gl::GetLineLoopWithRestartIndexCount(
+                                           sourceType, indices.data() + first, count))
+                << first << " " << count;
+
+            std::vector<Out> actual(expected.size(), 0);
+            gl::CopyLineLoopIndicesWithRestart(sourceType, destinationType,
+                                               indices.data() + first, count, actual.data());
+            EXPECT_EQ(expected, actual) << first << " " << count;
+        }
+    }
+}
+
+// Test that the line loops with primitive restart are closed the same as one index at a time.
+TEST(LineLoopIndicesWithRestart, MatchesReference)
+{
+    CheckLineLoopIndicesWithRestart<GLubyte, GLubyte>(gl::DrawElementsType::UnsignedByte,
+                                                      gl::DrawElementsType::UnsignedByte);
+    CheckLineLoopIndicesWithRestart<GLubyte, GLushort>(gl::DrawElementsType::UnsignedByte,
+                                                       gl::DrawElementsType::UnsignedShort);
+    CheckLineLoopIndicesWithRestart<GLubyte, GLuint>(gl::DrawElementsType::UnsignedByte,
+                                                     gl::DrawElementsType::UnsignedInt);
+    CheckLineLoopIndicesWithRestart<GLushort, GLuint>(gl::DrawElementsType::UnsignedShort,
+                                                      gl::DrawElementsType::UnsignedInt);
+    CheckLineLoopIndicesWithRestart<GLuint, GLuint>(gl::DrawElementsType::UnsignedInt,
+                                                    gl::DrawElementsType::UnsignedInt);
+}
+
 }  // anonymous namespace
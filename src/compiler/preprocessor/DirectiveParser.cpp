@@ -375,6 +375,10 @@ void DirectiveParser::parseDefine(Token *token)
         mDiagnostics->report(Diagnostics::PP_MACRO_REDEFINED, token->location, macro->name);
         return;
     }
+    if (macro->type == Macro::kTypeFunc)
+    {
+        macro->cacheParameterIndices();
+    }
     mMacroSet->insert(std::make_pair(macro->name, macro));
 }
 
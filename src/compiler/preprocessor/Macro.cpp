@@ -25,6 +25,28 @@ bool Macro::equals(const Macro &other) const
            (replacements == other.replacements);
 }
 
+void Macro::cacheParameterIndices()
+{
+    parameterIndices.assign(replacements.size(), -1);
+    for (size_t i = 0; i < replacements.size(); ++i)
+    {
+        const Token &repl = replacements[i];
+        if (repl.type != Token::IDENTIFIER)
+        {
+            continue;
+        }
+
+        for (size_t param = 0; param < parameters.size(); ++param)
+        {
+            if (parameters[param] == repl.text)
+            {
+                parameterIndices[i] = static_cast<int>(param);
+                break;
+            }
+        }
+    }
+}
+
 void PredefineMacro(MacroSet *macroSet, const char *name, int value)
 {
     Token token;
@@ -7,9 +7,9 @@
 #ifndef COMPILER_PREPROCESSOR_MACRO_H_
 #define COMPILER_PREPROCESSOR_MACRO_H_
 
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace angle
@@ -34,6 +34,10 @@ struct Macro
     ~Macro();
     bool equals(const Macro &other) const;
 
+    // Looks up the parameter named by each replacement token, so expanding the macro does not need
+    // to search the parameters for every token.
+    void cacheParameterIndices();
+
     bool predefined;
     mutable bool disabled;
     mutable int expansionCount;
@@ -42,9 +46,13 @@ struct Macro
     std::string name;
     Parameters parameters;
     Replacements replacements;
+
+    // For each replacement token, the index of the parameter it names, or -1 if it is not a
+    // parameter.  Set by cacheParameterIndices().
+    std::vector<int> parameterIndices;
 };
 
-typedef std::map<std::string, std::shared_ptr<Macro>> MacroSet;
+typedef std::unordered_map<std::string, std::shared_ptr<Macro>> MacroSet;
 
 void PredefineMacro(MacroSet *macroSet, const char *name, int value);
 
@@ -7,7 +7,6 @@
 #include "compiler/preprocessor/MacroExpander.h"
 
 #include <GLSLANG/ShaderLang.h>
-#include <algorithm>
 
 #include "common/debug.h"
 #include "compiler/preprocessor/DiagnosticsBase.h"
@@ -93,6 +92,7 @@ MacroExpander::MacroExpander(Lexer *lexer,
       mMacroSet(macroSet),
       mDiagnostics(diagnostics),
       mParseDefined(parseDefined),
+      mHasReserveToken(false),
       mTotalTokensInContexts(0),
       mSettings(settings),
       mDeferReenablingMacros(false)
@@ -105,6 +105,10 @@ MacroExpander::~MacroExpander()
     {
         delete context;
     }
+    for (MacroContext *context : mFreeContexts)
+    {
+        delete context;
+    }
 }
 
 void MacroExpander::lex(Token *token)
@@ -193,10 +197,10 @@ void MacroExpander::lex(Token *token)
 
 void MacroExpander::getToken(Token *token)
 {
-    if (mReserveToken.get())
+    if (mHasReserveToken)
     {
-        *token = *mReserveToken;
-        mReserveToken.reset();
+        *token           = mReserveToken;
+        mHasReserveToken = false;
         return;
     }
 
@@ -208,7 +212,7 @@ void MacroExpander::getToken(Token *token)
 
     if (!mContextStack.empty())
     {
-        *token = mContextStack.back()->get();
+        mContextStack.back()->get(token);
     }
     else
     {
@@ -223,12 +227,13 @@ void MacroExpander::ungetToken(const Token &token)
     {
         MacroContext *context = mContextStack.back();
         context->unget();
-        ASSERT(context->replacements[context->index] == token);
+        ASSERT((*context->tokens)[context->index].text == token.text);
     }
     else
     {
-        ASSERT(!mReserveToken.get());
-        mReserveToken.reset(new Token(token));
+        ASSERT(!mHasReserveToken);
+        mReserveToken    = token;
+        mHasReserveToken = true;
     }
 }
 
@@ -250,18 +255,19 @@ bool MacroExpander::pushMacro(std::shared_ptr<Macro> macro, const Token &identif
     ASSERT(identifier.type == Token::IDENTIFIER);
     ASSERT(identifier.text == macro->name);
 
-    std::vector<Token> replacements;
-    if (!expandMacro(*macro, identifier, &replacements))
+    MacroContext *context = allocateContext();
+    if (!expandMacro(*macro, identifier, context))
+    {
+        releaseContext(context);
         return false;
+    }
 
     // Macro is disabled for expansion until it is popped off the stack.
     macro->disabled = true;
 
-    MacroContext *context = new MacroContext;
-    context->macro        = macro;
-    context->replacements.swap(replacements);
+    context->macro = macro;
     mContextStack.push_back(context);
-    mTotalTokensInContexts += context->replacements.size();
+    mTotalTokensInContexts += context->size();
     return true;
 }
 
@@ -284,16 +290,36 @@ void MacroExpander::popMacro()
         context->macro->disabled = false;
     }
     context->macro->expansionCount--;
-    mTotalTokensInContexts -= context->replacements.size();
-    delete context;
+    mTotalTokensInContexts -= context->size();
+    releaseContext(context);
+}
+
+MacroExpander::MacroContext *MacroExpander::allocateContext()
+{
+    if (mFreeContexts.empty())
+    {
+        return new MacroContext;
+    }
+
+    MacroContext *context = mFreeContexts.back();
+    mFreeContexts.pop_back();
+    return context;
+}
+
+void MacroExpander::releaseContext(MacroContext *context)
+{
+    // Keep the storage of the replacements for the next expansion.
+    context->macro.reset();
+    context->index  = 0;
+    context->tokens = nullptr;
+    context->replacements.clear();
+    mFreeContexts.push_back(context);
 }
 
 bool MacroExpander::expandMacro(const Macro &macro,
                                 const Token &identifier,
-                                std::vector<Token> *replacements)
+                                MacroContext *context)
 {
-    replacements->clear();
-
     // In the case of an object-like macro, the replacement list gets its location
     // from the identifier, but in the case of a function-like macro, the replacement
     // list gets its location from the closing parenthesis of the macro invocation.
@@ -301,22 +327,22 @@ bool MacroExpander::expandMacro(const Macro &macro,
     SourceLocation replacementLocation = identifier.location;
     if (macro.type == Macro::kTypeObj)
     {
-        replacements->assign(macro.replacements.begin(), macro.replacements.end());
+        context->tokens = &macro.replacements;
 
         if (macro.predefined)
         {
             const char kLine[] = "__LINE__";
             const char kFile[] = "__FILE__";
 
-            ASSERT(replacements->size() == 1);
-            Token &repl = replacements->front();
-            if (macro.name == kLine)
-            {
-                repl.text = ToString(identifier.location.line);
-            }
-            else if (macro.name == kFile)
+            ASSERT(macro.replacements.size() == 1);
+            if (macro.name == kLine || macro.name == kFile)
             {
-                repl.text = ToString(identifier.location.file);
+                context->replacements = macro.replacements;
+                context->tokens       = &context->replacements;
+
+                Token &repl = context->replacements.front();
+                repl.text   = ToString(macro.name == kLine ? identifier.location.line
+                                                           : identifier.location.file);
             }
         }
     }
@@ -328,21 +354,15 @@ bool MacroExpander::expandMacro(const Macro &macro,
         if (!collectMacroArgs(macro, identifier, &args, &replacementLocation))
             return false;
 
-        replaceMacroParams(macro, args, replacements);
+        replaceMacroParams(macro, args, &context->replacements);
+        context->tokens = &context->replacements;
     }
 
-    for (std::size_t i = 0; i < replacements->size(); ++i)
-    {
-        Token &repl = replacements->at(i);
-        if (i == 0)
-        {
-            // The first token in the replacement list inherits the padding
-            // properties of the identifier token.
-            repl.setAtStartOfLine(identifier.atStartOfLine());
-            repl.setHasLeadingSpace(identifier.hasLeadingSpace());
-        }
-        repl.location = replacementLocation;
-    }
+    // The first token in the replacement list inherits the padding properties of the identifier
+    // token.
+    context->location        = replacementLocation;
+    context->atStartOfLine   = identifier.atStartOfLine();
+    context->hasLeadingSpace = identifier.hasLeadingSpace();
     return true;
 }
 
@@ -475,24 +495,13 @@ void MacroExpander::replaceMacroParams(const Macro &macro,
         }
 
         const Token &repl = macro.replacements[i];
-        if (repl.type != Token::IDENTIFIER)
-        {
-            replacements->push_back(repl);
-            continue;
-        }
-
-        // TODO(alokp): Optimize this.
-        // There is no need to search for macro params every time.
-        // The param index can be cached with the replacement token.
-        Macro::Parameters::const_iterator iter =
-            std::find(macro.parameters.begin(), macro.parameters.end(), repl.text);
-        if (iter == macro.parameters.end())
+        const int iArg    = macro.parameterIndices[i];
+        if (iArg < 0)
         {
             replacements->push_back(repl);
             continue;
         }
 
-        std::size_t iArg    = std::distance(macro.parameters.begin(), iter);
         const MacroArg &arg = args[iArg];
         if (arg.empty())
         {
@@ -506,18 +515,32 @@ void MacroExpander::replaceMacroParams(const Macro &macro,
     }
 }
 
-MacroExpander::MacroContext::MacroContext() : macro(0), index(0) {}
+MacroExpander::MacroContext::MacroContext()
+    : macro(0), index(0), tokens(nullptr), atStartOfLine(false), hasLeadingSpace(false)
+{}
 
 MacroExpander::MacroContext::~MacroContext() {}
 
 bool MacroExpander::MacroContext::empty() const
 {
-    return index == replacements.size();
+    return index == tokens->size();
+}
+
+size_t MacroExpander::MacroContext::size() const
+{
+    return tokens->size();
 }
 
-const Token &MacroExpander::MacroContext::get()
+void MacroExpander::MacroContext::get(Token *token)
 {
-    return replacements[index++];
+    *token          = (*tokens)[index];
+    token->location = location;
+    if (index == 0)
+    {
+        token->setAtStartOfLine(atStartOfLine);
+        token->setHasLeadingSpace(hasLeadingSpace);
+    }
+    ++index;
 }
 
 void MacroExpander::MacroContext::unget()
@@ -13,6 +13,7 @@
 #include "compiler/preprocessor/Lexer.h"
 #include "compiler/preprocessor/Macro.h"
 #include "compiler/preprocessor/Preprocessor.h"
+#include "compiler/preprocessor/Token.h"
 
 namespace angle
 {
@@ -21,7 +22,6 @@ namespace pp
 {
 
 class Diagnostics;
-struct SourceLocation;
 
 class MacroExpander : public Lexer
 {
@@ -43,7 +43,8 @@ class MacroExpander : public Lexer
     bool pushMacro(std::shared_ptr<Macro> macro, const Token &identifier);
     void popMacro();
 
-    bool expandMacro(const Macro &macro, const Token &identifier, std::vector<Token> *replacements);
+    struct MacroContext;
+    bool expandMacro(const Macro &macro, const Token &identifier, MacroContext *context);
 
     typedef std::vector<Token> MacroArg;
     bool collectMacroArgs(const Macro &macro,
@@ -59,21 +60,38 @@ class MacroExpander : public Lexer
         MacroContext();
         ~MacroContext();
         bool empty() const;
-        const Token &get();
+        size_t size() const;
+        void get(Token *token);
         void unget();
 
         std::shared_ptr<Macro> macro;
         std::size_t index;
+
+        // The tokens the macro expands to.  This is the replacement list of the macro itself,
+        // unless it had arguments or __LINE__ / __FILE__ substituted in |replacements|.
+        const std::vector<Token> *tokens;
         std::vector<Token> replacements;
+
+        // Given to the tokens as they are read, instead of copying the replacement list to set
+        // them.  The padding only applies to the first token.
+        SourceLocation location;
+        bool atStartOfLine;
+        bool hasLeadingSpace;
     };
 
+    MacroContext *allocateContext();
+    void releaseContext(MacroContext *context);
+
     Lexer *mLexer;
     MacroSet *mMacroSet;
     Diagnostics *mDiagnostics;
     bool mParseDefined;
 
-    std::unique_ptr<Token> mReserveToken;
+    Token mReserveToken;
+    bool mHasReserveToken;
     std::vector<MacroContext *> mContextStack;
+    // Contexts of macros that finished expanding, reused for the next expansions.
+    std::vector<MacroContext *> mFreeContexts;
     size_t mTotalTokensInContexts;
 
     PreprocessorSettings mSettings;
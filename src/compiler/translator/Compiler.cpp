@@ -14,6 +14,7 @@
 #include "common/CompiledShaderState.h"
 #include "common/PackedEnums.h"
 #include "common/angle_version_info.h"
+#include "common/system_utils.h"
 
 #include "compiler/translator/CallDAG.h"
 #include "compiler/translator/CollectVariables.h"
@@ -338,8 +339,64 @@ bool ValidateFragColorAndFragData(GLenum shaderType,
     return true;
 }
 
+size_t GetVariableMemorySize(const ShaderVariable &variable)
+{
+    size_t size = sizeof(variable) + variable.name.size() + variable.mappedName.size() +
+                  variable.structOrBlockName.size() + variable.mappedStructOrBlockName.size();
+    for (const ShaderVariable &field : variable.fields)
+    {
+        size += GetVariableMemorySize(field);
+    }
+    return size;
+}
+
+size_t GetVariablesMemorySize(const std::vector<ShaderVariable> &variables)
+{
+    size_t size = 0;
+    for (const ShaderVariable &variable : variables)
+    {
+        size += GetVariableMemorySize(variable);
+    }
+    return size;
+}
+
+size_t GetBlocksMemorySize(const std::vector<InterfaceBlock> &blocks)
+{
+    size_t size = 0;
+    for (const InterfaceBlock &block : blocks)
+    {
+        size += sizeof(block) + block.name.size() + block.mappedName.size() +
+                block.instanceName.size() + GetVariablesMemorySize(block.fields);
+    }
+    return size;
+}
+
 }  // namespace
 
+TCompileResults::TCompileResults()  = default;
+TCompileResults::~TCompileResults() = default;
+
+size_t TCompileResults::getMemorySize() const
+{
+    // The size of a binary sink is counted in words.
+    const size_t objSize = infoSink.obj.isBinary()
+                               ? infoSink.obj.getBinary().size() * sizeof(uint32_t)
+                               : static_cast<size_t>(infoSink.obj.size());
+
+    size_t size = sizeof(*this) + static_cast<size_t>(infoSink.info.size()) +
+                  static_cast<size_t>(infoSink.debug.size()) + objSize;
+    size += GetVariablesMemorySize(attributes) + GetVariablesMemorySize(outputVariables) +
+            GetVariablesMemorySize(uniforms) + GetVariablesMemorySize(inputVaryings) +
+            GetVariablesMemorySize(outputVaryings) + GetVariablesMemorySize(sharedVariables);
+    size += GetBlocksMemorySize(interfaceBlocks) + GetBlocksMemorySize(uniformBlocks) +
+            GetBlocksMemorySize(shaderStorageBlocks);
+    for (const auto &name : nameMap)
+    {
+        size += name.first.size() + name.second.size();
+    }
+    return size;
+}
+
 TShHandleBase::TShHandleBase()
 {
     allocator.push();
@@ -725,6 +782,26 @@ void TCompiler::enableValidateNoMoreTransformations()
     mValidateASTOptions.validateNoMoreTransformations = true;
 }
 
+template <typename Pass>
+bool TCompiler::runPass(const char *name, bool isNeeded, Pass &&pass)
+{
+    if (!mCompileOptions.collectPassStatistics)
+    {
+        return !isNeeded || pass();
+    }
+
+    if (!isNeeded)
+    {
+        mPassStatistics.push_back({name, 0.0, true});
+        return true;
+    }
+
+    double startTime = angle::GetCurrentSystemTime();
+    bool result      = pass();
+    mPassStatistics.push_back({name, angle::GetCurrentSystemTime() - startTime, false});
+    return result;
+}
+
 bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
                                     const TParseContext &parseContext,
                                     const ShCompileOptions &compileOptions)
@@ -781,7 +858,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     // Fold expressions that could not be folded before validation that was done as a part of
     // parsing.
-    if (!FoldExpressions(this, root, &mDiagnostics))
+    if (!runPass("FoldExpressions", true,
+                 [&]() { return FoldExpressions(this, root, &mDiagnostics); }))
     {
         return false;
     }
@@ -802,7 +880,7 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     //      invalid ESSL.
     //   3. Any unreachable statement after a discard, return, break or continue.
     // After this empty declarations are not allowed in the AST.
-    if (!PruneNoOps(this, root, &mSymbolTable))
+    if (!runPass("PruneNoOps", true, [&]() { return PruneNoOps(this, root, &mSymbolTable); }))
     {
         return false;
     }
@@ -856,7 +934,7 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
         return false;
     }
 
-    if (!pruneUnusedFunctions(root))
+    if (!runPass("PruneUnusedFunctions", true, [&]() { return pruneUnusedFunctions(root); }))
     {
         return false;
     }
@@ -1004,39 +1082,54 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
                                  ? IntermNodePatternMatcher::kScalarizedVecOrMatConstructor
                                  : 0;
 
+    // The passes below only rewrite loops, multi declarations, sequence operators, .length() calls
+    // and switch statements, so they are skipped for shaders that don't use them.  These are noted
+    // while parsing, and the passes above don't introduce any, except for the loops that
+    // DeferGlobalInitializers may generate to initialize arrays.
+    const bool hasLoops =
+        parseContext.hasLoops() ||
+        (enableNonConstantInitializers && initializeLocalsAndGlobals && canUseLoopsToInitialize);
+
     // Split multi declarations and remove calls to array length().
     // Note that SimplifyLoopConditions needs to be run before any other AST transformations
     // that may need to generate new statements from loop conditions or loop expressions.
-    if (!SimplifyLoopConditions(this, root,
-                                IntermNodePatternMatcher::kMultiDeclaration |
-                                    IntermNodePatternMatcher::kArrayLengthMethod |
-                                    simplifyScalarized,
-                                &getSymbolTable()))
+    if (!runPass("SimplifyLoopConditions", hasLoops, [&]() {
+            return SimplifyLoopConditions(this, root,
+                                          IntermNodePatternMatcher::kMultiDeclaration |
+                                              IntermNodePatternMatcher::kArrayLengthMethod |
+                                              simplifyScalarized,
+                                          &getSymbolTable());
+        }))
     {
         return false;
     }
 
     // Note that separate declarations need to be run before other AST transformations that
     // generate new statements from expressions.
-    if (!SeparateDeclarations(this, root, &getSymbolTable()))
+    if (!runPass("SeparateDeclarations", parseContext.hasMultiDeclarations(),
+                 [&]() { return SeparateDeclarations(this, root, &getSymbolTable()); }))
     {
         return false;
     }
     mValidateASTOptions.validateMultiDeclarations = true;
 
-    if (!SplitSequenceOperator(this, root,
-                               IntermNodePatternMatcher::kArrayLengthMethod | simplifyScalarized,
-                               &getSymbolTable()))
+    if (!runPass("SplitSequenceOperator", parseContext.hasSequenceOperator(), [&]() {
+            return SplitSequenceOperator(
+                this, root, IntermNodePatternMatcher::kArrayLengthMethod | simplifyScalarized,
+                &getSymbolTable());
+        }))
     {
         return false;
     }
 
-    if (!RemoveArrayLengthMethod(this, root))
+    if (!runPass("RemoveArrayLengthMethod", parseContext.hasArrayLengthMethod(),
+                 [&]() { return RemoveArrayLengthMethod(this, root); }))
     {
         return false;
     }
 
-    if (!RemoveUnreferencedVariables(this, root, &mSymbolTable))
+    if (!runPass("RemoveUnreferencedVariables", true,
+                 [&]() { return RemoveUnreferencedVariables(this, root, &mSymbolTable); }))
     {
         return false;
     }
@@ -1047,7 +1140,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // left switch statements that only contained an empty declaration inside the final case in an
     // invalid state. Relies on that PruneNoOps and RemoveUnreferencedVariables have already been
     // run.
-    if (!PruneEmptyCases(this, root))
+    if (!runPass("PruneEmptyCases", parseContext.hasSwitchStatements(),
+                 [&]() { return PruneEmptyCases(this, root); }))
     {
         return false;
     }
@@ -1304,6 +1398,19 @@ bool TCompiler::compile(const char *const shaderStrings[],
 
         if (compileOptions.objectCode)
         {
+            // Text output is usually somewhat larger than the source, because of the added
+            // declarations and the name prefixes.  Reserve room for it up front so the sink doesn't
+            // grow repeatedly while the tree is written out.
+            if (!IsOutputVulkan(mOutputType))
+            {
+                size_t sourceLength = 0;
+                for (size_t stringIndex = 0; stringIndex < numStrings; ++stringIndex)
+                {
+                    sourceLength += strlen(shaderStrings[stringIndex]);
+                }
+                mInfoSink.obj.reserve(sourceLength * 2);
+            }
+
             PerformanceDiagnostics perfDiagnostics(&mDiagnostics);
             if (!translate(root, compileOptions, &perfDiagnostics))
             {
@@ -1533,6 +1640,8 @@ void TCompiler::clearResults()
     mCullDistanceRedeclared = false;
     mClipDistanceUsed       = false;
 
+    mPassStatistics.clear();
+
     mGeometryShaderInputPrimitiveType  = EptUndefined;
     mGeometryShaderOutputPrimitiveType = EptUndefined;
     mGeometryShaderInvocations         = 0;
@@ -1553,6 +1662,114 @@ void TCompiler::clearResults()
     mSymbolTable.clearCompilationResults();
 }
 
+void TCompiler::getResults(TCompileResults *results) const
+{
+    results->infoSink      = mInfoSink;
+    results->shaderVersion = mShaderVersion;
+
+    results->attributes          = mAttributes;
+    results->outputVariables     = mOutputVariables;
+    results->uniforms            = mUniforms;
+    results->inputVaryings       = mInputVaryings;
+    results->outputVaryings      = mOutputVaryings;
+    results->sharedVariables     = mSharedVariables;
+    results->interfaceBlocks     = mInterfaceBlocks;
+    results->uniformBlocks       = mUniformBlocks;
+    results->shaderStorageBlocks = mShaderStorageBlocks;
+
+    results->earlyFragmentTestsSpecified = mEarlyFragmentTestsSpecified;
+    results->hasDiscard                  = mHasDiscard;
+    results->enablesPerSampleShading     = mEnablesPerSampleShading;
+    results->specConstUsageBits          = mSpecConstUsageBits;
+
+    results->computeShaderLocalSizeDeclared = mComputeShaderLocalSizeDeclared;
+    results->computeShaderLocalSize         = mComputeShaderLocalSize;
+    results->numViews                       = mNumViews;
+
+    results->clipDistanceSize       = mClipDistanceSize;
+    results->cullDistanceSize       = mCullDistanceSize;
+    results->clipDistanceRedeclared = mClipDistanceRedeclared;
+    results->cullDistanceRedeclared = mCullDistanceRedeclared;
+    results->clipDistanceUsed       = mClipDistanceUsed;
+
+    results->geometryShaderMaxVertices         = mGeometryShaderMaxVertices;
+    results->geometryShaderInvocations         = mGeometryShaderInvocations;
+    results->geometryShaderInputPrimitiveType  = mGeometryShaderInputPrimitiveType;
+    results->geometryShaderOutputPrimitiveType = mGeometryShaderOutputPrimitiveType;
+
+    results->tessControlShaderOutputVertices        = mTessControlShaderOutputVertices;
+    results->tessEvaluationShaderInputPrimitiveType = mTessEvaluationShaderInputPrimitiveType;
+    results->tessEvaluationShaderInputOrderingType  = mTessEvaluationShaderInputOrderingType;
+    results->tessEvaluationShaderInputPointType     = mTessEvaluationShaderInputPointType;
+
+    results->tessEvaluationShaderInputVertexSpacingType =
+        mTessEvaluationShaderInputVertexSpacingType;
+
+    results->hasAnyPreciseType            = mHasAnyPreciseType;
+    results->advancedBlendEquations       = mAdvancedBlendEquations;
+    results->hasPixelLocalStorageUniforms = mHasPixelLocalStorageUniforms;
+
+    results->nameMap = mNameMap;
+    results->pragma  = mPragma;
+}
+
+void TCompiler::setResults(const TCompileResults &results, const ShCompileOptions &compileOptions)
+{
+    // As if the results were produced by compiling with |compileOptions|.
+    mCompileOptions = compileOptions;
+
+    clearResults();
+
+    mInfoSink      = results.infoSink;
+    mShaderVersion = results.shaderVersion;
+
+    mAttributes          = results.attributes;
+    mOutputVariables     = results.outputVariables;
+    mUniforms            = results.uniforms;
+    mInputVaryings       = results.inputVaryings;
+    mOutputVaryings      = results.outputVaryings;
+    mSharedVariables     = results.sharedVariables;
+    mInterfaceBlocks     = results.interfaceBlocks;
+    mUniformBlocks       = results.uniformBlocks;
+    mShaderStorageBlocks = results.shaderStorageBlocks;
+    mVariablesCollected  = true;
+
+    mEarlyFragmentTestsSpecified = results.earlyFragmentTestsSpecified;
+    mHasDiscard                  = results.hasDiscard;
+    mEnablesPerSampleShading     = results.enablesPerSampleShading;
+    mSpecConstUsageBits          = results.specConstUsageBits;
+
+    mComputeShaderLocalSizeDeclared = results.computeShaderLocalSizeDeclared;
+    mComputeShaderLocalSize         = results.computeShaderLocalSize;
+    mNumViews                       = results.numViews;
+
+    mClipDistanceSize       = results.clipDistanceSize;
+    mCullDistanceSize       = results.cullDistanceSize;
+    mClipDistanceRedeclared = results.clipDistanceRedeclared;
+    mCullDistanceRedeclared = results.cullDistanceRedeclared;
+    mClipDistanceUsed       = results.clipDistanceUsed;
+
+    mGeometryShaderMaxVertices         = results.geometryShaderMaxVertices;
+    mGeometryShaderInvocations         = results.geometryShaderInvocations;
+    mGeometryShaderInputPrimitiveType  = results.geometryShaderInputPrimitiveType;
+    mGeometryShaderOutputPrimitiveType = results.geometryShaderOutputPrimitiveType;
+
+    mTessControlShaderOutputVertices        = results.tessControlShaderOutputVertices;
+    mTessEvaluationShaderInputPrimitiveType = results.tessEvaluationShaderInputPrimitiveType;
+    mTessEvaluationShaderInputOrderingType  = results.tessEvaluationShaderInputOrderingType;
+    mTessEvaluationShaderInputPointType     = results.tessEvaluationShaderInputPointType;
+
+    mTessEvaluationShaderInputVertexSpacingType =
+        results.tessEvaluationShaderInputVertexSpacingType;
+
+    mHasAnyPreciseType            = results.hasAnyPreciseType;
+    mAdvancedBlendEquations       = results.advancedBlendEquations;
+    mHasPixelLocalStorageUniforms = results.hasPixelLocalStorageUniforms;
+
+    mNameMap = results.nameMap;
+    mPragma  = results.pragma;
+}
+
 bool TCompiler::initCallDag(TIntermNode *root)
 {
     mCallDag.clear();
@@ -72,6 +72,8 @@ class TShHandleBase
     virtual TranslatorMetalDirect *getAsTranslatorMetalDirect() { return nullptr; }
 #endif  // ANGLE_ENABLE_METAL
 
+    const angle::PoolAllocator &getAllocator() const { return allocator; }
+
   protected:
     // Memory allocator. Allocates and tracks memory required by the compiler.
     // Deallocates all memory when compiler is destructed.
@@ -83,6 +85,63 @@ struct TFunctionMetadata
     bool used = false;
 };
 
+// The results of a successful compilation, as queried through the ShaderLang API.  They are kept by
+// the translation cache, and given to compilers that compile the same shader again.
+struct TCompileResults
+{
+    TCompileResults();
+    ~TCompileResults();
+
+    // Approximate memory taken by the results.
+    size_t getMemorySize() const;
+
+    TInfoSink infoSink;
+    int shaderVersion;
+
+    std::vector<sh::ShaderVariable> attributes;
+    std::vector<sh::ShaderVariable> outputVariables;
+    std::vector<sh::ShaderVariable> uniforms;
+    std::vector<sh::ShaderVariable> inputVaryings;
+    std::vector<sh::ShaderVariable> outputVaryings;
+    std::vector<sh::ShaderVariable> sharedVariables;
+    std::vector<sh::InterfaceBlock> interfaceBlocks;
+    std::vector<sh::InterfaceBlock> uniformBlocks;
+    std::vector<sh::InterfaceBlock> shaderStorageBlocks;
+
+    bool earlyFragmentTestsSpecified;
+    bool hasDiscard;
+    bool enablesPerSampleShading;
+    SpecConstUsageBits specConstUsageBits;
+
+    bool computeShaderLocalSizeDeclared;
+    sh::WorkGroupSize computeShaderLocalSize;
+    int numViews;
+
+    uint8_t clipDistanceSize;
+    uint8_t cullDistanceSize;
+    bool clipDistanceRedeclared;
+    bool cullDistanceRedeclared;
+    bool clipDistanceUsed;
+
+    int geometryShaderMaxVertices;
+    int geometryShaderInvocations;
+    TLayoutPrimitiveType geometryShaderInputPrimitiveType;
+    TLayoutPrimitiveType geometryShaderOutputPrimitiveType;
+
+    int tessControlShaderOutputVertices;
+    TLayoutTessEvaluationType tessEvaluationShaderInputPrimitiveType;
+    TLayoutTessEvaluationType tessEvaluationShaderInputVertexSpacingType;
+    TLayoutTessEvaluationType tessEvaluationShaderInputOrderingType;
+    TLayoutTessEvaluationType tessEvaluationShaderInputPointType;
+
+    bool hasAnyPreciseType;
+    AdvancedBlendEquations advancedBlendEquations;
+    bool hasPixelLocalStorageUniforms;
+
+    NameMap nameMap;
+    TPragma pragma;
+};
+
 //
 // The base class for the machine dependent compiler to derive from
 // for managing object code from the compile.
@@ -124,6 +183,19 @@ class TCompiler : public TShHandleBase
     // Clears the results from the previous compilation.
     void clearResults();
 
+    // Copies the results of the last compilation, or replaces them with the results of a
+    // compilation by another compiler of the same type, spec, output and resources with the same
+    // |compileOptions|.
+    void getResults(TCompileResults *results) const;
+    void setResults(const TCompileResults &results, const ShCompileOptions &compileOptions);
+
+    // Time taken by the AST transformations of the last compilation, if the collectPassStatistics
+    // compile option was set.
+    const std::vector<sh::CompilePassStatistics> &getPassStatistics() const
+    {
+        return mPassStatistics;
+    }
+
     const std::vector<sh::ShaderVariable> &getAttributes() const { return mAttributes; }
     const std::vector<sh::ShaderVariable> &getOutputVariables() const { return mOutputVariables; }
     const std::vector<sh::ShaderVariable> &getUniforms() const { return mUniforms; }
@@ -293,6 +365,11 @@ class TCompiler : public TShHandleBase
 
     void collectInterfaceBlocks();
 
+    // Runs one of the AST transformations, unless |isNeeded| is false because the shader doesn't
+    // use anything the pass rewrites.  Its time is recorded if collectPassStatistics is set.
+    template <typename Pass>
+    [[nodiscard]] bool runPass(const char *name, bool isNeeded, Pass &&pass);
+
     bool mVariablesCollected;
 
     bool mGLPositionInitialized;
@@ -350,6 +427,9 @@ class TCompiler : public TShHandleBase
     // Fragment shader has the discard instruction
     bool mHasDiscard;
 
+    // Time taken by the AST transformations, in the order they ran.
+    std::vector<sh::CompilePassStatistics> mPassStatistics;
+
     // Whether per-sample shading is enabled by the shader.  In OpenGL, this keyword should
     // implicitly trigger per-sample shading without the API enabling it.
     bool mEnablesPerSampleShading;
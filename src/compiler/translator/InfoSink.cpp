@@ -6,6 +6,8 @@
 
 #include "compiler/translator/InfoSink.h"
 
+#include <stdio.h>
+
 #include "compiler/translator/ImmutableString.h"
 #include "compiler/translator/Symbol.h"
 #include "compiler/translator/Types.h"
@@ -35,6 +37,45 @@ TInfoSinkBase &TInfoSinkBase::operator<<(const ImmutableString &str)
     return *this;
 }
 
+TInfoSinkBase &TInfoSinkBase::operator<<(float f)
+{
+    // Make sure that at least one decimal point is written. If a number
+    // does not have a fractional part, the default precision format does
+    // not write the decimal portion which gets interpreted as integer by
+    // the compiler.
+    char formatted[64];
+    if (fractionalPart(f) == 0.0f)
+    {
+        snprintf(formatted, sizeof(formatted), "%.1f", f);
+    }
+    else
+    {
+        snprintf(formatted, sizeof(formatted), "%.8g", f);
+    }
+
+    // Like the streams imbued with the classic locale, write '.' whatever the decimal point of the
+    // current locale is.  printf doesn't group digits, so anything that is not part of a number or
+    // of "inf" and "nan" is the decimal point.
+    char output[sizeof(formatted)];
+    size_t length = 0;
+    for (const char *c = formatted; *c != '\0';)
+    {
+        if (isalnum(static_cast<unsigned char>(*c)) || *c == '-' || *c == '+')
+        {
+            output[length++] = *c++;
+            continue;
+        }
+        output[length++] = '.';
+        while (*c != '\0' && !isalnum(static_cast<unsigned char>(*c)) && *c != '-' && *c != '+')
+        {
+            ++c;
+        }
+    }
+
+    sink.append(output, length);
+    return *this;
+}
+
 TInfoSinkBase &TInfoSinkBase::operator<<(const TType &type)
 {
     if (type.isInvariant())
@@ -111,14 +152,11 @@ TInfoSinkBase &TInfoSinkBase::operator<<(const TType &type)
 
 void TInfoSinkBase::location(int file, int line)
 {
-    TPersistStringStream stream = sh::InitializeStream<TPersistStringStream>();
     if (line)
-        stream << file << ":" << line;
+        *this << file << ":" << line;
     else
-        stream << file << ":? ";
-    stream << ": ";
-
-    sink.append(stream.str());
+        *this << file << ":? ";
+    sink.append(": ");
 }
 
 }  // namespace sh
@@ -9,6 +9,7 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <type_traits>
 #include "GLSLANG/ShaderLang.h"
 #include "compiler/translator/Common.h"
 #include "compiler/translator/Severity.h"
@@ -73,29 +74,19 @@ class TInfoSinkBase
 
     TInfoSinkBase &operator<<(const TType &type);
 
+    // Integers are the most common numbers in the output, so they are formatted directly into the
+    // sink instead of through a stream.
+    TInfoSinkBase &operator<<(short i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(unsigned short i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(int i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(unsigned int i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(long i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(unsigned long i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(long long i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(unsigned long long i) { return appendInteger(i); }
+
     // Make sure floats are written with correct precision.
-    TInfoSinkBase &operator<<(float f)
-    {
-        // Make sure that at least one decimal point is written. If a number
-        // does not have a fractional part, the default precision format does
-        // not write the decimal portion which gets interpreted as integer by
-        // the compiler.
-        TPersistStringStream stream = sh::InitializeStream<TPersistStringStream>();
-        if (fractionalPart(f) == 0.0f)
-        {
-            stream.precision(1);
-            stream << std::showpoint << std::fixed << f;
-        }
-        else
-        {
-            stream.unsetf(std::ios::fixed);
-            stream.unsetf(std::ios::scientific);
-            stream.precision(8);
-            stream << f;
-        }
-        sink.append(stream.str());
-        return *this;
-    }
+    TInfoSinkBase &operator<<(float f);
     // Write boolean values as their names instead of integral value.
     TInfoSinkBase &operator<<(bool b)
     {
@@ -109,7 +100,9 @@ class TInfoSinkBase
         sink.clear();
         binarySink.clear();
     }
-    int size() { return static_cast<int>(isBinary() ? binarySink.size() : sink.size()); }
+    // Avoids growing the sink repeatedly when the size of the output can be estimated.
+    void reserve(size_t capacity) { sink.reserve(capacity); }
+    int size() const { return static_cast<int>(isBinary() ? binarySink.size() : sink.size()); }
 
     const TPersistString &str() const
     {
@@ -134,6 +127,39 @@ class TInfoSinkBase
     }
 
   private:
+    template <typename T>
+    TInfoSinkBase &appendInteger(T value)
+    {
+        using UnsignedT = typename std::make_unsigned<T>::type;
+
+        // Large enough for the digits and the sign of any 64-bit integer.
+        char buffer[24];
+        char *end        = buffer + sizeof(buffer);
+        char *begin      = end;
+        UnsignedT digits = static_cast<UnsignedT>(value);
+        bool negative    = false;
+        if constexpr (std::is_signed<T>::value)
+        {
+            negative = value < 0;
+            if (negative)
+            {
+                digits = static_cast<UnsignedT>(0) - digits;
+            }
+        }
+        do
+        {
+            *--begin = static_cast<char>('0' + digits % 10);
+            digits /= 10;
+        } while (digits != 0);
+        if (negative)
+        {
+            *--begin = '-';
+        }
+
+        sink.append(begin, end - begin);
+        return *this;
+    }
+
     // The data in the info sink is either in human readable form (|sink|) or binary (|binarySink|).
     TPersistString sink;
     BinaryBlob binarySink;
@@ -6,6 +6,7 @@
 
 #include "compiler/translator/InitializeDll.h"
 #include "compiler/translator/InitializeGlobals.h"
+#include "compiler/translator/SymbolTable.h"
 
 #include "common/platform.h"
 
@@ -27,6 +28,7 @@ bool InitProcess()
 
 void DetachProcess()
 {
+    FreeSharedBuiltInVariables();
     FreePoolIndex();
 }
 
@@ -226,6 +226,11 @@ TParseContext::TParseContext(TSymbolTable &symt,
       mFragmentPrecisionHighOnESSL1(false),
       mEarlyFragmentTestsSpecified(false),
       mHasDiscard(false),
+      mHasLoops(false),
+      mHasSwitchStatements(false),
+      mHasSequenceOperator(false),
+      mHasArrayLengthMethod(false),
+      mHasMultiDeclarations(false),
       mSampleQualifierSpecified(false),
       mPositionRedeclaredForSeparateShaderObject(false),
       mPointSizeRedeclaredForSeparateShaderObject(false),
@@ -2804,6 +2809,8 @@ TIntermNode *TParseContext::addLoop(TLoopType type,
                                     TIntermNode *body,
                                     const TSourceLoc &line)
 {
+    mHasLoops = true;
+
     TIntermNode *node       = nullptr;
     TIntermTyped *typedCond = nullptr;
     if (cond)
@@ -3567,6 +3574,8 @@ void TParseContext::parseDeclarator(TPublicType &publicType,
                                     const ImmutableString &identifier,
                                     TIntermDeclaration *declarationOut)
 {
+    mHasMultiDeclarations = true;
+
     // If the declaration starting this declarator list was empty (example: int,), some checks were
     // not performed.
     if (mDeferredNonEmptyDeclarationErrorCheck)
@@ -3609,6 +3618,8 @@ void TParseContext::parseArrayDeclarator(TPublicType &elementType,
                                          const TVector<unsigned int> &arraySizes,
                                          TIntermDeclaration *declarationOut)
 {
+    mHasMultiDeclarations = true;
+
     // If the declaration starting this declarator list was empty (example: int,), some checks were
     // not performed.
     if (mDeferredNonEmptyDeclarationErrorCheck)
@@ -3655,6 +3666,8 @@ void TParseContext::parseInitDeclarator(const TPublicType &publicType,
                                         TIntermTyped *initializer,
                                         TIntermDeclaration *declarationOut)
 {
+    mHasMultiDeclarations = true;
+
     // If the declaration starting this declarator list was empty (example: int,), some checks were
     // not performed.
     if (mDeferredNonEmptyDeclarationErrorCheck)
@@ -3688,6 +3701,8 @@ void TParseContext::parseArrayInitDeclarator(const TPublicType &elementType,
                                              TIntermTyped *initializer,
                                              TIntermDeclaration *declarationOut)
 {
+    mHasMultiDeclarations = true;
+
     // If the declaration starting this declarator list was empty (example: int,), some checks were
     // not performed.
     if (mDeferredNonEmptyDeclarationErrorCheck)
@@ -6445,6 +6460,7 @@ TIntermSwitch *TParseContext::addSwitch(TIntermTyped *init,
     }
 
     markStaticReadIfSymbol(init);
+    mHasSwitchStatements = true;
     TIntermSwitch *node = new TIntermSwitch(init, statementList);
     node->setLine(loc);
     return node;
@@ -7047,6 +7063,7 @@ TIntermTyped *TParseContext::addComma(TIntermTyped *left,
               ",");
     }
 
+    mHasSequenceOperator     = true;
     TIntermBinary *commaNode = TIntermBinary::CreateComma(left, right, mShaderVersion);
     markStaticReadIfSymbol(left);
     markStaticReadIfSymbol(right);
@@ -7541,7 +7558,8 @@ TIntermTyped *TParseContext::addMethod(TFunctionLookup *fnCall, const TSourceLoc
     }
     else
     {
-        TIntermUnary *node = new TIntermUnary(EOpArrayLength, thisNode, nullptr);
+        mHasArrayLengthMethod = true;
+        TIntermUnary *node    = new TIntermUnary(EOpArrayLength, thisNode, nullptr);
         markStaticReadIfSymbol(thisNode);
         node->setLine(loc);
         return node->fold(mDiagnostics);
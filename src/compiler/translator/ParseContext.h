@@ -77,6 +77,11 @@ class TParseContext : angle::NonCopyable
 
     bool isEarlyFragmentTestsSpecified() const { return mEarlyFragmentTestsSpecified; }
     bool hasDiscard() const { return mHasDiscard; }
+    bool hasLoops() const { return mHasLoops; }
+    bool hasSwitchStatements() const { return mHasSwitchStatements; }
+    bool hasSequenceOperator() const { return mHasSequenceOperator; }
+    bool hasArrayLengthMethod() const { return mHasArrayLengthMethod; }
+    bool hasMultiDeclarations() const { return mHasMultiDeclarations; }
     bool isSampleQualifierSpecified() const { return mSampleQualifierSpecified; }
 
     void setLoopNestingLevel(int loopNestintLevel) { mLoopNestingLevel = loopNestintLevel; }
@@ -734,6 +739,11 @@ class TParseContext : angle::NonCopyable
                                          // ESSL1.
     bool mEarlyFragmentTestsSpecified;   // true if layout(early_fragment_tests) in; is specified.
     bool mHasDiscard;                    // true if |discard| is encountered in the shader.
+    bool mHasLoops;                      // true if a for, while or do-while loop is parsed.
+    bool mHasSwitchStatements;           // true if a switch statement is parsed.
+    bool mHasSequenceOperator;           // true if the comma operator is used in an expression.
+    bool mHasArrayLengthMethod;          // true if .length() is called on an array.
+    bool mHasMultiDeclarations;          // true if a declaration has more than one declarator.
     bool mSampleQualifierSpecified;      // true if the |sample| qualifier is used
     bool mPositionRedeclaredForSeparateShaderObject;       // true if EXT_separate_shader_objects is
                                                            // enabled and gl_Position is redefined.
@@ -13,6 +13,7 @@
 
 #include "compiler/translator/Compiler.h"
 #include "compiler/translator/InitializeDll.h"
+#include "compiler/translator/TranslationCache.h"
 #include "compiler/translator/length_limits.h"
 #ifdef ANGLE_ENABLE_HLSL
 #    include "compiler/translator/TranslatorHLSL.h"
@@ -154,6 +155,7 @@ bool Finalize()
 {
     if (isInitialized)
     {
+        GetTranslationCache().clear();
         DetachProcess();
         isInitialized = false;
     }
@@ -404,6 +406,11 @@ bool Compile(const ShHandle handle,
     TCompiler *compiler = GetCompilerFromHandle(handle);
     ASSERT(compiler);
 
+    if (compileOptions.cacheTranslation)
+    {
+        return GetTranslationCache().compile(compiler, shaderStrings, numStrings, compileOptions);
+    }
+
     return compiler->compile(shaderStrings, numStrings, compileOptions);
 }
 
@@ -978,6 +985,14 @@ unsigned int GetShaderSharedMemorySize(const ShHandle handle)
     return sharedMemorySize;
 }
 
+const std::vector<CompilePassStatistics> &GetCompilePassStatistics(const ShHandle handle)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+
+    return compiler->getPassStatistics();
+}
+
 uint32_t GetAdvancedBlendEquations(const ShHandle handle)
 {
     TCompiler *compiler = GetCompilerFromHandle(handle);
@@ -986,6 +1001,16 @@ uint32_t GetAdvancedBlendEquations(const ShHandle handle)
     return compiler->getAdvancedBlendEquations().bits();
 }
 
+TranslationCacheStatistics GetTranslationCacheStatistics()
+{
+    return GetTranslationCache().getStatistics();
+}
+
+void ClearTranslationCache()
+{
+    GetTranslationCache().clear();
+}
+
 // Can't prefix with just _ because then we might introduce a double underscore, which is not safe
 // in GLSL (ESSL 3.00.6 section 3.8: All identifiers containing a double underscore are reserved for
 // use by the underlying implementation). u is short for user-defined.
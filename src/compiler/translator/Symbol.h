@@ -180,7 +180,8 @@ class TStructure : public TSymbol, public TFieldListCollection
 
   private:
     friend class TSymbolTable;
-    // For creating built-in structs.
+    // For creating built-in structs.  These are shared between compilers, so they are realized up
+    // front.
     TStructure(const TSymbolUniqueId &id,
                const ImmutableString &name,
                TExtension extension,
@@ -191,7 +192,9 @@ class TStructure : public TSymbol, public TFieldListCollection
                   std::array<TExtension, 1u>{{extension}},
                   SymbolClass::Struct),
           TFieldListCollection(fields)
-    {}
+    {
+        realize();
+    }
 
     template <size_t ExtensionCount>
     TStructure(const TSymbolUniqueId &id,
@@ -200,7 +203,9 @@ class TStructure : public TSymbol, public TFieldListCollection
                const TFieldList *fields)
         : TSymbol(id, name, SymbolType::BuiltIn, extensions, SymbolClass::Struct),
           TFieldListCollection(fields)
-    {}
+    {
+        realize();
+    }
 
     // TODO(zmo): Find a way to get rid of the const_cast in function
     // setName().  At the moment keep this function private so only
@@ -235,7 +240,8 @@ class TInterfaceBlock : public TSymbol, public TFieldListCollection
 
   private:
     friend class TSymbolTable;
-    // For creating built-in interface blocks.
+    // For creating built-in interface blocks.  These are shared between compilers, so they are
+    // realized up front.
     TInterfaceBlock(const TSymbolUniqueId &id,
                     const ImmutableString &name,
                     TExtension extension,
@@ -248,7 +254,9 @@ class TInterfaceBlock : public TSymbol, public TFieldListCollection
           TFieldListCollection(fields),
           mBlockStorage(EbsUnspecified),
           mBinding(0)
-    {}
+    {
+        realize();
+    }
 
     template <size_t ExtensionCount>
     TInterfaceBlock(const TSymbolUniqueId &id,
@@ -259,7 +267,9 @@ class TInterfaceBlock : public TSymbol, public TFieldListCollection
           TFieldListCollection(fields),
           mBlockStorage(EbsUnspecified),
           mBinding(0)
-    {}
+    {
+        realize();
+    }
 
     TLayoutBlockStorage mBlockStorage;
     int mBinding;
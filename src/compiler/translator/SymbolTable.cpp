@@ -13,6 +13,9 @@
 
 #include "compiler/translator/SymbolTable.h"
 
+#include <mutex>
+
+#include "anglebase/no_destructor.h"
 #include "angle_gl.h"
 #include "compiler/translator/ImmutableString.h"
 #include "compiler/translator/IntermNode.h"
@@ -23,6 +26,34 @@ namespace sh
 {
 namespace
 {
+// The built-in variables that depend on the resources, such as gl_MaxDrawBuffers or gl_FragData,
+// are created once per shader type, spec and resources, and shared by all compilers created with
+// them.  They are allocated from a pool of their own that is freed by sh::Finalize(), once all
+// compilers are destructed.  Everything they compute lazily is realized on creation, so they are
+// never modified afterwards and can be used by compilers on any thread.
+struct SharedBuiltInVariables
+{
+    sh::GLenum shaderType;
+    ShShaderSpec spec;
+    ShBuiltInResources resources;
+    TSymbolTableBase variables;
+};
+
+struct SharedBuiltInVariablesCache
+{
+    angle::PoolAllocator allocator;
+    std::vector<std::unique_ptr<SharedBuiltInVariables>> entries;
+};
+
+std::mutex &GetSharedBuiltInVariablesMutex()
+{
+    static angle::base::NoDestructor<std::mutex> sMutex;
+    return *sMutex;
+}
+
+// Guarded by GetSharedBuiltInVariablesMutex().
+SharedBuiltInVariablesCache *gSharedBuiltInVariables = nullptr;
+
 bool CheckShaderType(Shader expected, GLenum actual)
 {
     switch (expected)
@@ -449,10 +480,57 @@ void TSymbolTable::initializeBuiltIns(sh::GLenum type,
 
     setDefaultPrecision(EbtAtomicCounter, EbpHigh);
 
-    initializeBuiltInVariables(type, spec, resources);
+    initializeSharedBuiltInVariables(type, spec, resources);
     mUniqueIdCounter = kLastBuiltInId + 1;
 }
 
+void TSymbolTable::initializeSharedBuiltInVariables(sh::GLenum shaderType,
+                                                    ShShaderSpec spec,
+                                                    const ShBuiltInResources &resources)
+{
+    std::lock_guard<std::mutex> lock(GetSharedBuiltInVariablesMutex());
+
+    if (gSharedBuiltInVariables == nullptr)
+    {
+        gSharedBuiltInVariables = new SharedBuiltInVariablesCache;
+        gSharedBuiltInVariables->allocator.push();
+    }
+
+    for (const std::unique_ptr<SharedBuiltInVariables> &entry : gSharedBuiltInVariables->entries)
+    {
+        if (entry->shaderType == shaderType && entry->spec == spec &&
+            memcmp(&entry->resources, &resources, sizeof(resources)) == 0)
+        {
+            static_cast<TSymbolTableBase &>(*this) = entry->variables;
+            return;
+        }
+    }
+
+    angle::PoolAllocator *compilerAllocator = GetGlobalPoolAllocator();
+    SetGlobalPoolAllocator(&gSharedBuiltInVariables->allocator);
+    initializeBuiltInVariables(shaderType, spec, resources);
+    SetGlobalPoolAllocator(compilerAllocator);
+
+    std::unique_ptr<SharedBuiltInVariables> entry(new SharedBuiltInVariables);
+    entry->shaderType = shaderType;
+    entry->spec       = spec;
+    entry->resources  = resources;
+    entry->variables  = static_cast<const TSymbolTableBase &>(*this);
+    gSharedBuiltInVariables->entries.push_back(std::move(entry));
+}
+
+void FreeSharedBuiltInVariables()
+{
+    std::lock_guard<std::mutex> lock(GetSharedBuiltInVariablesMutex());
+
+    if (gSharedBuiltInVariables != nullptr)
+    {
+        gSharedBuiltInVariables->allocator.popAll();
+        delete gSharedBuiltInVariables;
+        gSharedBuiltInVariables = nullptr;
+    }
+}
+
 void TSymbolTable::initSamplerDefaultPrecision(TBasicType samplerType)
 {
     ASSERT(samplerType >= EbtGuardSamplerBegin && samplerType <= EbtGuardSamplerEnd);
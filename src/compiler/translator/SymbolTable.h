@@ -327,6 +327,11 @@ class TSymbolTable : angle::NonCopyable, TSymbolTableBase
 
     void initSamplerDefaultPrecision(TBasicType samplerType);
 
+    // Points this table to the resource-dependent built-in variables shared between compilers,
+    // creating them if no compiler with the same shader type, spec and resources did already.
+    void initializeSharedBuiltInVariables(sh::GLenum shaderType,
+                                          ShShaderSpec spec,
+                                          const ShBuiltInResources &resources);
     void initializeBuiltInVariables(sh::GLenum shaderType,
                                     ShShaderSpec spec,
                                     const ShBuiltInResources &resources);
@@ -358,6 +363,10 @@ class TSymbolTable : angle::NonCopyable, TSymbolTableBase
     TVariable *mGlInVariableWithArraySize;
 };
 
+// Frees the built-in variables shared between compilers.  Must only be called once all compilers
+// are destructed.
+void FreeSharedBuiltInVariables();
+
 }  // namespace sh
 
 #endif  // COMPILER_TRANSLATOR_SYMBOLTABLE_H_
@@ -0,0 +1,193 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslationCache.cpp: Implements the process-wide cache of shader translations.
+//
+
+#include "compiler/translator/TranslationCache.h"
+
+#include <cstring>
+
+#include "anglebase/no_destructor.h"
+#include "compiler/translator/Compiler.h"
+#include "compiler/translator/util.h"
+
+namespace sh
+{
+namespace
+{
+// Enough for the shaders of a few large WebGL applications.
+constexpr size_t kMaxTranslationCacheSize = 16 * 1024 * 1024;
+
+bool CanCacheTranslation(const TCompiler *compiler, const ShCompileOptions &compileOptions)
+{
+    // The HLSL and MSL translators keep results of their own, such as register assignments, which
+    // are not part of TCompileResults.
+    ShShaderOutput output = compiler->getOutputType();
+    if (IsOutputHLSL(output) || output == SH_MSL_METAL_OUTPUT)
+    {
+        return false;
+    }
+
+    // Pass statistics are only meaningful if the shader is actually compiled.
+    return !compileOptions.collectPassStatistics;
+}
+
+template <typename T>
+void UpdateWithValue(angle::base::SecureHashAlgorithm *sha, const T &value)
+{
+    sha->Update(&value, sizeof(value));
+}
+}  // anonymous namespace
+
+TranslationCache::TranslationCache(size_t maxSize)
+    : mEntries(angle::base::HashingMRUCache<Key, Entry, KeyHash>::NO_AUTO_EVICT),
+      mMaxSize(maxSize),
+      mSize(0),
+      mHits(0),
+      mMisses(0)
+{}
+
+TranslationCache::~TranslationCache() = default;
+
+// static
+TranslationCache::Key TranslationCache::ComputeKey(const TCompiler *compiler,
+                                                   const char *const shaderStrings[],
+                                                   size_t numStrings,
+                                                   const ShCompileOptions &compileOptions)
+{
+    angle::base::SecureHashAlgorithm sha;
+
+    // ShBuiltInResources and ShCompileOptions are zero-initialized, including their padding, so
+    // they can be hashed as a whole.
+    const ShBuiltInResources resources = compiler->getBuiltInResources();
+    UpdateWithValue(&sha, compiler->getShaderType());
+    UpdateWithValue(&sha, compiler->getShaderSpec());
+    UpdateWithValue(&sha, compiler->getOutputType());
+    UpdateWithValue(&sha, resources);
+    UpdateWithValue(&sha, compileOptions);
+
+    for (size_t stringIndex = 0; stringIndex < numStrings; ++stringIndex)
+    {
+        // Hash the length too, so splitting the same source differently gives a different key.
+        const size_t length = strlen(shaderStrings[stringIndex]);
+        UpdateWithValue(&sha, length);
+        sha.Update(shaderStrings[stringIndex], length);
+    }
+
+    sha.Final();
+    return sha.DigestAsArray();
+}
+
+bool TranslationCache::compile(TCompiler *compiler,
+                               const char *const shaderStrings[],
+                               size_t numStrings,
+                               const ShCompileOptions &compileOptions)
+{
+    ASSERT(compileOptions.cacheTranslation);
+    if (numStrings == 0 || !CanCacheTranslation(compiler, compileOptions))
+    {
+        return compiler->compile(shaderStrings, numStrings, compileOptions);
+    }
+
+    const Key key = ComputeKey(compiler, shaderStrings, numStrings, compileOptions);
+
+    std::shared_ptr<const TCompileResults> cachedResults;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto iter = mEntries.Get(key);
+        if (iter != mEntries.end())
+        {
+            cachedResults = iter->second.results;
+            ++mHits;
+        }
+        else
+        {
+            ++mMisses;
+        }
+    }
+
+    // The results are copied outside the lock; holding a reference keeps them alive even if the
+    // entry is evicted meanwhile.
+    if (cachedResults)
+    {
+        compiler->setResults(*cachedResults, compileOptions);
+        return true;
+    }
+
+    // Only successful compilations are cached.  Shaders failing to compile are not expected to be
+    // compiled repeatedly.
+    if (!compiler->compile(shaderStrings, numStrings, compileOptions))
+    {
+        return false;
+    }
+
+    auto results = std::make_shared<TCompileResults>();
+    compiler->getResults(results.get());
+    put(key, std::move(results));
+
+    return true;
+}
+
+void TranslationCache::put(const Key &key, std::shared_ptr<const TCompileResults> &&results)
+{
+    const size_t size = results->getMemorySize();
+    if (size > mMaxSize)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Another thread may have compiled the same shader meanwhile.
+    auto existing = mEntries.Peek(key);
+    if (existing != mEntries.end())
+    {
+        mSize -= existing->second.size;
+        mEntries.Erase(existing);
+    }
+
+    mEntries.Put(key, Entry{std::move(results), size});
+    mSize += size;
+
+    // Evict the least recently used translations.
+    while (mSize > mMaxSize)
+    {
+        ASSERT(!mEntries.empty());
+        auto oldest = mEntries.rbegin();
+        mSize -= oldest->second.size;
+        mEntries.Erase(oldest);
+    }
+}
+
+TranslationCacheStatistics TranslationCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    TranslationCacheStatistics statistics;
+    statistics.hits       = mHits;
+    statistics.misses     = mMisses;
+    statistics.entryCount = mEntries.size();
+    statistics.size       = mSize;
+    return statistics;
+}
+
+void TranslationCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mEntries.Clear();
+    mSize   = 0;
+    mHits   = 0;
+    mMisses = 0;
+}
+
+TranslationCache &GetTranslationCache()
+{
+    static angle::base::NoDestructor<TranslationCache> sTranslationCache(kMaxTranslationCacheSize);
+    return *sTranslationCache;
+}
+
+}  // namespace sh
@@ -0,0 +1,85 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslationCache.h: A process-wide cache of the results of compiling shaders.  Compiling the same
+// shader again with a compiler of the same type, spec, output and resources, and the same compile
+// options, copies the translated code and reflection from the cache instead of running the
+// compiler.  This is common when many contexts, e.g. WebGL contexts of pages running the same
+// engine, compile the same shaders.
+//
+
+#ifndef COMPILER_TRANSLATOR_TRANSLATIONCACHE_H_
+#define COMPILER_TRANSLATOR_TRANSLATIONCACHE_H_
+
+#include <array>
+#include <memory>
+#include <mutex>
+
+#include "GLSLANG/ShaderLang.h"
+#include "anglebase/containers/mru_cache.h"
+#include "anglebase/sha1.h"
+#include "common/angleutils.h"
+#include "common/hash_utils.h"
+
+namespace sh
+{
+class TCompiler;
+struct TCompileResults;
+
+class TranslationCache final : angle::NonCopyable
+{
+  public:
+    explicit TranslationCache(size_t maxSize);
+    ~TranslationCache();
+
+    // Compiles the shader with |compiler|, or gives it the results of an earlier compilation of the
+    // same shader if it is in the cache.  Only called for compilations with the cacheTranslation
+    // option.
+    bool compile(TCompiler *compiler,
+                 const char *const shaderStrings[],
+                 size_t numStrings,
+                 const ShCompileOptions &compileOptions);
+
+    TranslationCacheStatistics getStatistics() const;
+    void clear();
+
+  private:
+    using Key = std::array<uint8_t, angle::base::kSHA1Length>;
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const
+        {
+            return angle::ComputeGenericHash(key.data(), key.size());
+        }
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<const TCompileResults> results;
+        size_t size;
+    };
+
+    static Key ComputeKey(const TCompiler *compiler,
+                          const char *const shaderStrings[],
+                          size_t numStrings,
+                          const ShCompileOptions &compileOptions);
+
+    void put(const Key &key, std::shared_ptr<const TCompileResults> &&results);
+
+    mutable std::mutex mMutex;
+    angle::base::HashingMRUCache<Key, Entry, KeyHash> mEntries;
+    const size_t mMaxSize;
+    size_t mSize;
+    uint64_t mHits;
+    uint64_t mMisses;
+};
+
+// The cache used by sh::Compile.  Emptied by sh::Finalize.
+TranslationCache &GetTranslationCache();
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_TRANSLATIONCACHE_H_
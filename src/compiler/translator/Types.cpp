@@ -906,6 +906,13 @@ const TString &TFieldListCollection::mangledFieldList() const
     return mMangledFieldList;
 }
 
+void TFieldListCollection::realize()
+{
+    objectSize();
+    deepestNesting();
+    mangledFieldList();
+}
+
 int TFieldListCollection::calculateDeepestNesting() const
 {
     int maxNesting = 0;
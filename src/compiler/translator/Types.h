@@ -73,6 +73,9 @@ class TFieldListCollection : angle::NonCopyable
   protected:
     TFieldListCollection(const TFieldList *fields);
 
+    // Initializes all lazily-initialized members, including those of the field types.
+    void realize();
+
     const TFieldList *mFields;
 
   private:
@@ -0,0 +1,158 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// generatemip.cpp: Implements GenerateMipWithContext, which runs GenerateMip on worker threads.
+
+#include "image_util/generatemip.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "common/WorkerThread.h"
+#include "image_util/loadimage.h"
+
+namespace angle
+{
+namespace
+{
+// Levels smaller than this are generated on the calling thread, as posting tasks would cost more
+// than the filtering itself.
+constexpr size_t kMinParallelSourceBytes = 256 * 1024;
+// Smallest amount of source data given to a single task.
+constexpr size_t kMinBandSourceBytes = 64 * 1024;
+
+size_t MaxThreads()
+{
+    static const size_t numThreads =
+        std::max<size_t>(1, std::min<size_t>(16, std::thread::hardware_concurrency()));
+    return numThreads;
+}
+
+struct GenerateMipTask : public Closure
+{
+    GenerateMipTask(GenerateMipFunction generateMip,
+                    size_t sourceWidth,
+                    size_t sourceHeight,
+                    size_t sourceDepth,
+                    const uint8_t *sourceData,
+                    size_t sourceRowPitch,
+                    size_t sourceDepthPitch,
+                    uint8_t *destData,
+                    size_t destRowPitch,
+                    size_t destDepthPitch)
+        : generateMip(generateMip),
+          sourceWidth(sourceWidth),
+          sourceHeight(sourceHeight),
+          sourceDepth(sourceDepth),
+          sourceData(sourceData),
+          sourceRowPitch(sourceRowPitch),
+          sourceDepthPitch(sourceDepthPitch),
+          destData(destData),
+          destRowPitch(destRowPitch),
+          destDepthPitch(destDepthPitch)
+    {}
+
+    void operator()() override
+    {
+        generateMip(sourceWidth, sourceHeight, sourceDepth, sourceData, sourceRowPitch,
+                    sourceDepthPitch, destData, destRowPitch, destDepthPitch);
+    }
+
+    GenerateMipFunction generateMip;
+    size_t sourceWidth;
+    size_t sourceHeight;
+    size_t sourceDepth;
+    const uint8_t *sourceData;
+    size_t sourceRowPitch;
+    size_t sourceDepthPitch;
+    uint8_t *destData;
+    size_t destRowPitch;
+    size_t destDepthPitch;
+};
+}  // anonymous namespace
+
+void GenerateMipWithContext(const ImageLoadContext &context,
+                            GenerateMipFunction generateMip,
+                            size_t sourceWidth,
+                            size_t sourceHeight,
+                            size_t sourceDepth,
+                            const uint8_t *sourceData,
+                            size_t sourceRowPitch,
+                            size_t sourceDepthPitch,
+                            uint8_t *destData,
+                            size_t destRowPitch,
+                            size_t destDepthPitch)
+{
+    const std::shared_ptr<WorkerThreadPool> &threadPool = context.multiThreadPool;
+
+    // Each band is itself a valid image that the mip function is called on: its source extent along
+    // the split axis is twice its destination extent, so it keeps the same dimensionality (and
+    // filter) as the whole image. 3D images are split along depth, 2D images along rows, and single
+    // rows are not split.
+    const bool splitDepth  = sourceDepth > 1;
+    const size_t destUnits = splitDepth ? sourceDepth / 2 : sourceHeight / 2;
+    const size_t sourceBytes = (splitDepth ? sourceDepthPitch : sourceRowPitch) * 2 * destUnits;
+
+    size_t bandCount = 1;
+    if (threadPool && threadPool->isAsync() && destUnits > 1 &&
+        sourceBytes >= kMinParallelSourceBytes)
+    {
+        bandCount = std::min({MaxThreads(), destUnits, sourceBytes / kMinBandSourceBytes});
+    }
+
+    if (bandCount <= 1)
+    {
+        generateMip(sourceWidth, sourceHeight, sourceDepth, sourceData, sourceRowPitch,
+                    sourceDepthPitch, destData, destRowPitch, destDepthPitch);
+        return;
+    }
+
+    std::vector<std::shared_ptr<WaitableEvent>> waitEvents;
+    waitEvents.reserve(bandCount);
+
+    const size_t unitsPerBand = destUnits / bandCount;
+    const size_t extraUnits   = destUnits % bandCount;
+    size_t destUnit           = 0;
+    for (size_t band = 0; band < bandCount; ++band)
+    {
+        const size_t bandUnits = unitsPerBand + (band < extraUnits ? 1 : 0);
+
+        std::shared_ptr<GenerateMipTask> task;
+        if (splitDepth)
+        {
+            task = std::make_shared<GenerateMipTask>(
+                generateMip, sourceWidth, sourceHeight, bandUnits * 2,
+                sourceData + destUnit * 2 * sourceDepthPitch, sourceRowPitch, sourceDepthPitch,
+                destData + destUnit * destDepthPitch, destRowPitch, destDepthPitch);
+        }
+        else
+        {
+            task = std::make_shared<GenerateMipTask>(
+                generateMip, sourceWidth, bandUnits * 2, sourceDepth,
+                sourceData + destUnit * 2 * sourceRowPitch, sourceRowPitch, sourceDepthPitch,
+                destData + destUnit * destRowPitch, destRowPitch, destDepthPitch);
+        }
+
+        std::shared_ptr<WaitableEvent> waitEvent = threadPool->postWorkerTask(task);
+        if (waitEvent)
+        {
+            waitEvents.push_back(waitEvent);
+        }
+        else
+        {
+            // The pool could not take the task, run it here instead.
+            (*task)();
+        }
+
+        destUnit += bandUnits;
+    }
+    ASSERT(destUnit == destUnits);
+
+    WaitableEvent::WaitMany(&waitEvents);
+}
+
+}  // namespace angle
@@ -15,6 +15,7 @@
 
 namespace angle
 {
+struct ImageLoadContext;
 
 template <typename T>
 inline void GenerateMip(size_t sourceWidth,
@@ -27,6 +28,31 @@ inline void GenerateMip(size_t sourceWidth,
                         size_t destRowPitch,
                         size_t destDepthPitch);
 
+using GenerateMipFunction = void (*)(size_t sourceWidth,
+                                     size_t sourceHeight,
+                                     size_t sourceDepth,
+                                     const uint8_t *sourceData,
+                                     size_t sourceRowPitch,
+                                     size_t sourceDepthPitch,
+                                     uint8_t *destData,
+                                     size_t destRowPitch,
+                                     size_t destDepthPitch);
+
+// Generates the next mip level with |generateMip|, an instance of GenerateMip. Large images are
+// split in bands of destination rows (or slices, for 3D images) that are filtered in parallel on
+// the multi-threaded pool of |context|. Returns once the whole level is written.
+void GenerateMipWithContext(const ImageLoadContext &context,
+                            GenerateMipFunction generateMip,
+                            size_t sourceWidth,
+                            size_t sourceHeight,
+                            size_t sourceDepth,
+                            const uint8_t *sourceData,
+                            size_t sourceRowPitch,
+                            size_t sourceDepthPitch,
+                            uint8_t *destData,
+                            size_t destRowPitch,
+                            size_t destDepthPitch);
+
 }  // namespace angle
 
 #include "generatemip.inc"
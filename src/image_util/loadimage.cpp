@@ -14,6 +14,197 @@
 
 namespace angle
 {
+namespace
+{
+// The following functions convert the longest prefix of a row they can with vector instructions
+// and return the number of pixels converted. The callers convert the remaining pixels with the
+// scalar code, which is also the reference the vectorized paths are bit-exact with.
+
+size_t LoadA8ToRGBA8RowSIMD(const uint8_t *source, uint32_t *dest, size_t width)
+{
+    size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i zeroWide = _mm_setzero_si128();
+        for (; x + 15 < width; x += 16)
+        {
+            __m128i sourceData = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
+            // Interleave each byte to 16bit, make the lower byte zero
+            __m128i lo = _mm_unpacklo_epi8(zeroWide, sourceData);
+            __m128i hi = _mm_unpackhi_epi8(zeroWide, sourceData);
+            // Interleave each 16bit to 32bit, make the lower 16bit zero
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x + 0]),
+                             _mm_unpacklo_epi16(zeroWide, lo));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x + 4]),
+                             _mm_unpackhi_epi16(zeroWide, lo));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x + 8]),
+                             _mm_unpacklo_epi16(zeroWide, hi));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x + 12]),
+                             _mm_unpackhi_epi16(zeroWide, hi));
+        }
+    }
+#elif defined(ANGLE_USE_NEON)
+    const uint8x16_t zero = vdupq_n_u8(0);
+    for (; x + 15 < width; x += 16)
+    {
+        uint8x16x4_t rgba = {{zero, zero, zero, vld1q_u8(&source[x])}};
+        vst4q_u8(reinterpret_cast<uint8_t *>(&dest[x]), rgba);
+    }
+#endif
+    return x;
+}
+
+size_t LoadL8ToRGBA8RowSIMD(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+        for (; x + 15 < width; x += 16)
+        {
+            __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
+            // LL pairs and LA pairs, interleaving them gives L L L A for each pixel
+            __m128i llLo = _mm_unpacklo_epi8(l, l);
+            __m128i llHi = _mm_unpackhi_epi8(l, l);
+            __m128i laLo = _mm_unpacklo_epi8(l, alpha);
+            __m128i laHi = _mm_unpackhi_epi8(l, alpha);
+            __m128i *out = reinterpret_cast<__m128i *>(&dest[4 * x]);
+            _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(llLo, laLo));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(llLo, laLo));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(llHi, laHi));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(llHi, laHi));
+        }
+    }
+#elif defined(ANGLE_USE_NEON)
+    const uint8x16_t alpha = vdupq_n_u8(0xFF);
+    for (; x + 15 < width; x += 16)
+    {
+        uint8x16_t l      = vld1q_u8(&source[x]);
+        uint8x16x4_t rgba = {{l, l, l, alpha}};
+        vst4q_u8(&dest[4 * x], rgba);
+    }
+#endif
+    return x;
+}
+
+size_t LoadRGB8ToBGRX8RowSIMD(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    size_t x = 0;
+    // SSE2 has no byte shuffle to expand three channel pixels efficiently, only NEON's structured
+    // loads are used.
+#if defined(ANGLE_USE_NEON)
+    const uint8x16_t alpha = vdupq_n_u8(0xFF);
+    for (; x + 15 < width; x += 16)
+    {
+        uint8x16x3_t rgb  = vld3q_u8(&source[3 * x]);
+        uint8x16x4_t bgrx = {{rgb.val[2], rgb.val[1], rgb.val[0], alpha}};
+        vst4q_u8(&dest[4 * x], bgrx);
+    }
+#endif
+    return x;
+}
+
+size_t LoadRGBA8ToBGRA8RowSIMD(const uint32_t *source, uint32_t *dest, size_t width)
+{
+    size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i brMask = _mm_set1_epi32(0x00ff00ff);
+        for (; x + 3 < width; x += 4)
+        {
+            __m128i sourceData = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
+            // Mask out g and a, which don't change
+            __m128i gaComponents = _mm_andnot_si128(brMask, sourceData);
+            // Mask out b and r
+            __m128i brComponents = _mm_and_si128(sourceData, brMask);
+            // Swap b and r
+            __m128i brSwapped = _mm_shufflehi_epi16(
+                _mm_shufflelo_epi16(brComponents, _MM_SHUFFLE(2, 3, 0, 1)),
+                _MM_SHUFFLE(2, 3, 0, 1));
+            __m128i result = _mm_or_si128(gaComponents, brSwapped);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x]), result);
+        }
+    }
+#elif defined(ANGLE_USE_NEON)
+    for (; x + 15 < width; x += 16)
+    {
+        uint8x16x4_t rgba = vld4q_u8(reinterpret_cast<const uint8_t *>(&source[x]));
+        uint8x16x4_t bgra = {{rgba.val[2], rgba.val[1], rgba.val[0], rgba.val[3]}};
+        vst4q_u8(reinterpret_cast<uint8_t *>(&dest[x]), bgra);
+    }
+#endif
+    return x;
+}
+
+size_t LoadRGBA4ToRGBA8RowSIMD(const uint16_t *source, uint8_t *dest, size_t width)
+{
+    size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        const __m128i nibbleMask = _mm_set1_epi16(0x000F);
+        // Every channel is at most 0xF, multiplying the 16bit pairs by 0x11 replicates the nibble
+        // in both bytes without carrying into the neighboring channel.
+        const __m128i replicate = _mm_set1_epi16(0x11);
+        for (; x + 7 < width; x += 8)
+        {
+            __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
+            __m128i r    = _mm_and_si128(_mm_srli_epi16(rgba, 12), nibbleMask);
+            __m128i g    = _mm_and_si128(_mm_srli_epi16(rgba, 8), nibbleMask);
+            __m128i b    = _mm_and_si128(_mm_srli_epi16(rgba, 4), nibbleMask);
+            __m128i a    = _mm_and_si128(rgba, nibbleMask);
+            __m128i rg   = _mm_mullo_epi16(_mm_or_si128(r, _mm_slli_epi16(g, 8)), replicate);
+            __m128i ba   = _mm_mullo_epi16(_mm_or_si128(b, _mm_slli_epi16(a, 8)), replicate);
+            __m128i *out = reinterpret_cast<__m128i *>(&dest[4 * x]);
+            _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(rg, ba));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rg, ba));
+        }
+    }
+#elif defined(ANGLE_USE_NEON)
+    const uint8x8_t replicate = vdup_n_u8(0x11);
+    const uint8x8_t nibbleMask = vdup_n_u8(0x0F);
+    for (; x + 7 < width; x += 8)
+    {
+        uint16x8_t rgba = vld1q_u16(&source[x]);
+        uint8x8_t rg    = vmovn_u16(vshrq_n_u16(rgba, 8));
+        uint8x8_t ba    = vmovn_u16(rgba);
+        uint8x8x4_t out = {{vmul_u8(vshr_n_u8(rg, 4), replicate),
+                            vmul_u8(vand_u8(rg, nibbleMask), replicate),
+                            vmul_u8(vshr_n_u8(ba, 4), replicate),
+                            vmul_u8(vand_u8(ba, nibbleMask), replicate)}};
+        vst4_u8(&dest[4 * x], out);
+    }
+#endif
+    return x;
+}
+
+size_t LoadD24S8ToS8D24RowSIMD(const uint32_t *source, uint32_t *dest, size_t width)
+{
+    size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+    if (gl::supportsSSE2())
+    {
+        for (; x + 3 < width; x += 4)
+        {
+            __m128i d24s8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
+            __m128i s8d24 = _mm_or_si128(_mm_slli_epi32(d24s8, 24), _mm_srli_epi32(d24s8, 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x]), s8d24);
+        }
+    }
+#elif defined(ANGLE_USE_NEON)
+    for (; x + 3 < width; x += 4)
+    {
+        uint32x4_t d24s8 = vld1q_u32(&source[x]);
+        vst1q_u32(&dest[x], vorrq_u32(vshlq_n_u32(d24s8, 24), vshrq_n_u32(d24s8, 8)));
+    }
+#endif
+    return x;
+}
+}  // anonymous namespace
+
 ImageLoadContext::ImageLoadContext()                              = default;
 ImageLoadContext::~ImageLoadContext()                             = default;
 ImageLoadContext::ImageLoadContext(const ImageLoadContext &other) = default;
@@ -29,54 +220,6 @@ void LoadA8ToRGBA8(const ImageLoadContext &context,
                    size_t outputRowPitch,
                    size_t outputDepthPitch)
 {
-#if defined(ANGLE_USE_SSE)
-    if (gl::supportsSSE2())
-    {
-        __m128i zeroWide = _mm_setzero_si128();
-
-        for (size_t z = 0; z < depth; z++)
-        {
-            for (size_t y = 0; y < height; y++)
-            {
-                const uint8_t *source =
-                    priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-                uint32_t *dest = priv::OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch,
-                                                                   outputDepthPitch);
-
-                size_t x = 0;
-
-                // Make output writes aligned
-                for (; ((reinterpret_cast<intptr_t>(&dest[x]) & 0xF) != 0 && x < width); x++)
-                {
-                    dest[x] = static_cast<uint32_t>(source[x]) << 24;
-                }
-
-                for (; x + 7 < width; x += 8)
-                {
-                    __m128i sourceData =
-                        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&source[x]));
-                    // Interleave each byte to 16bit, make the lower byte to zero
-                    sourceData = _mm_unpacklo_epi8(zeroWide, sourceData);
-                    // Interleave each 16bit to 32bit, make the lower 16bit to zero
-                    __m128i lo = _mm_unpacklo_epi16(zeroWide, sourceData);
-                    __m128i hi = _mm_unpackhi_epi16(zeroWide, sourceData);
-
-                    _mm_store_si128(reinterpret_cast<__m128i *>(&dest[x]), lo);
-                    _mm_store_si128(reinterpret_cast<__m128i *>(&dest[x + 4]), hi);
-                }
-
-                // Handle the remainder
-                for (; x < width; x++)
-                {
-                    dest[x] = static_cast<uint32_t>(source[x]) << 24;
-                }
-            }
-        }
-
-        return;
-    }
-#endif
-
     for (size_t z = 0; z < depth; z++)
     {
         for (size_t y = 0; y < height; y++)
@@ -85,7 +228,7 @@ void LoadA8ToRGBA8(const ImageLoadContext &context,
                 priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint32_t *dest =
                 priv::OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+            for (size_t x = LoadA8ToRGBA8RowSIMD(source, dest, width); x < width; x++)
             {
                 dest[x] = static_cast<uint32_t>(source[x]) << 24;
             }
@@ -188,7 +331,7 @@ void LoadL8ToRGBA8(const ImageLoadContext &context,
                 priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint8_t *dest =
                 priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+            for (size_t x = LoadL8ToRGBA8RowSIMD(source, dest, width); x < width; x++)
             {
                 uint8_t sourceVal = source[x];
                 dest[4 * x + 0]   = sourceVal;
@@ -467,7 +610,7 @@ void LoadRGB8ToBGRX8(const ImageLoadContext &context,
                 priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint8_t *dest =
                 priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+            for (size_t x = LoadRGB8ToBGRX8RowSIMD(source, dest, width); x < width; x++)
             {
                 dest[4 * x + 0] = source[x * 3 + 2];
                 dest[4 * x + 1] = source[x * 3 + 1];
@@ -617,58 +760,6 @@ void LoadRGBA8ToBGRA8(const ImageLoadContext &context,
                       size_t outputRowPitch,
                       size_t outputDepthPitch)
 {
-#if defined(ANGLE_USE_SSE)
-    if (gl::supportsSSE2())
-    {
-        __m128i brMask = _mm_set1_epi32(0x00ff00ff);
-
-        for (size_t z = 0; z < depth; z++)
-        {
-            for (size_t y = 0; y < height; y++)
-            {
-                const uint32_t *source =
-                    priv::OffsetDataPointer<uint32_t>(input, y, z, inputRowPitch, inputDepthPitch);
-                uint32_t *dest = priv::OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch,
-                                                                   outputDepthPitch);
-
-                size_t x = 0;
-
-                // Make output writes aligned
-                for (; ((reinterpret_cast<intptr_t>(&dest[x]) & 15) != 0) && x < width; x++)
-                {
-                    uint32_t rgba = source[x];
-                    dest[x]       = (ANGLE_ROTL(rgba, 16) & 0x00ff00ff) | (rgba & 0xff00ff00);
-                }
-
-                for (; x + 3 < width; x += 4)
-                {
-                    __m128i sourceData =
-                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
-                    // Mask out g and a, which don't change
-                    __m128i gaComponents = _mm_andnot_si128(brMask, sourceData);
-                    // Mask out b and r
-                    __m128i brComponents = _mm_and_si128(sourceData, brMask);
-                    // Swap b and r
-                    __m128i brSwapped = _mm_shufflehi_epi16(
-                        _mm_shufflelo_epi16(brComponents, _MM_SHUFFLE(2, 3, 0, 1)),
-                        _MM_SHUFFLE(2, 3, 0, 1));
-                    __m128i result = _mm_or_si128(gaComponents, brSwapped);
-                    _mm_store_si128(reinterpret_cast<__m128i *>(&dest[x]), result);
-                }
-
-                // Perform leftover writes
-                for (; x < width; x++)
-                {
-                    uint32_t rgba = source[x];
-                    dest[x]       = (ANGLE_ROTL(rgba, 16) & 0x00ff00ff) | (rgba & 0xff00ff00);
-                }
-            }
-        }
-
-        return;
-    }
-#endif
-
     for (size_t z = 0; z < depth; z++)
     {
         for (size_t y = 0; y < height; y++)
@@ -677,7 +768,7 @@ void LoadRGBA8ToBGRA8(const ImageLoadContext &context,
                 priv::OffsetDataPointer<uint32_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint32_t *dest =
                 priv::OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+            for (size_t x = LoadRGBA8ToBGRA8RowSIMD(source, dest, width); x < width; x++)
             {
                 uint32_t rgba = source[x];
                 dest[x]       = (ANGLE_ROTL(rgba, 16) & 0x00ff00ff) | (rgba & 0xff00ff00);
@@ -831,7 +922,7 @@ void LoadRGBA4ToRGBA8(const ImageLoadContext &context,
                 priv::OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint8_t *dest =
                 priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+            for (size_t x = LoadRGBA4ToRGBA8RowSIMD(source, dest, width); x < width; x++)
             {
                 uint16_t rgba = source[x];
                 dest[4 * x + 0] =
@@ -1367,7 +1458,7 @@ void LoadD24S8ToS8D24(const ImageLoadContext &context,
                 priv::OffsetDataPointer<uint32_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint32_t *dest =
                 priv::OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+            for (size_t x = LoadD24S8ToS8D24RowSIMD(source, dest, width); x < width; x++)
             {
                 dest[x] = ANGLE_ROTL(source[x], 24);
             }
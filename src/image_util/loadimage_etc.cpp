@@ -8,7 +8,11 @@
 
 #include "image_util/loadimage.h"
 
+#include <algorithm>
+#include <functional>
+#include <thread>
 #include <type_traits>
+#include "common/WorkerThread.h"
 #include "common/mathutil.h"
 
 #include "image_util/imageformats.h"
@@ -1413,6 +1417,104 @@ static const uint8_t DefaultETCAlphaValues[4][4] =
 };
 
 // clang-format on
+
+// Images with fewer blocks than this are decoded on the calling thread (256x256 pixels).
+constexpr size_t kMinParallelDecodeBlockCount = 64 * 64;
+// Smallest number of blocks decoded by a single task.
+constexpr size_t kMinBlocksPerDecodeTask = 1024;
+
+size_t MaxDecodeThreads()
+{
+    static const size_t numThreads =
+        std::max<size_t>(1, std::min<size_t>(16, std::thread::hardware_concurrency()));
+    return numThreads;
+}
+
+using DecodeBlockRowFunction = std::function<void(size_t z, size_t y)>;
+
+class DecodeBlockRowsTask : public Closure
+{
+  public:
+    DecodeBlockRowsTask(const DecodeBlockRowFunction &decodeBlockRow,
+                        size_t blockRowsPerSlice,
+                        size_t firstBlockRow,
+                        size_t lastBlockRow)
+        : mDecodeBlockRow(decodeBlockRow),
+          mBlockRowsPerSlice(blockRowsPerSlice),
+          mFirstBlockRow(firstBlockRow),
+          mLastBlockRow(lastBlockRow)
+    {}
+
+    void operator()() override
+    {
+        for (size_t blockRow = mFirstBlockRow; blockRow < mLastBlockRow; ++blockRow)
+        {
+            mDecodeBlockRow(blockRow / mBlockRowsPerSlice, (blockRow % mBlockRowsPerSlice) * 4);
+        }
+    }
+
+  private:
+    const DecodeBlockRowFunction &mDecodeBlockRow;
+    size_t mBlockRowsPerSlice;
+    size_t mFirstBlockRow;
+    size_t mLastBlockRow;
+};
+
+// Calls |decodeBlockRow| with the slice and first pixel row of every row of 4x4 blocks in the
+// image. Block rows are independent, so large images are split in bands of block rows that are
+// decoded in parallel on the multi-threaded pool of |context|, if any. Returns once every row is
+// decoded.
+void DecodeBlockRows(const ImageLoadContext &context,
+                     size_t width,
+                     size_t height,
+                     size_t depth,
+                     const DecodeBlockRowFunction &decodeBlockRow)
+{
+    const size_t blockRowsPerSlice = (height + 3) / 4;
+    const size_t blockRowCount     = blockRowsPerSlice * depth;
+    const size_t blockCount        = blockRowCount * ((width + 3) / 4);
+
+    const std::shared_ptr<WorkerThreadPool> &threadPool = context.multiThreadPool;
+
+    size_t taskCount = 1;
+    if (threadPool && threadPool->isAsync() && blockCount >= kMinParallelDecodeBlockCount)
+    {
+        taskCount =
+            std::min({MaxDecodeThreads(), blockRowCount, blockCount / kMinBlocksPerDecodeTask});
+    }
+
+    if (taskCount <= 1)
+    {
+        DecodeBlockRowsTask(decodeBlockRow, blockRowsPerSlice, 0, blockRowCount)();
+        return;
+    }
+
+    std::vector<std::shared_ptr<WaitableEvent>> waitEvents;
+    waitEvents.reserve(taskCount);
+
+    size_t firstBlockRow = 0;
+    for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+    {
+        const size_t lastBlockRow = blockRowCount * (taskIndex + 1) / taskCount;
+        auto task                 = std::make_shared<DecodeBlockRowsTask>(
+            decodeBlockRow, blockRowsPerSlice, firstBlockRow, lastBlockRow);
+
+        std::shared_ptr<WaitableEvent> waitEvent = threadPool->postWorkerTask(task);
+        if (waitEvent)
+        {
+            waitEvents.push_back(waitEvent);
+        }
+        else
+        {
+            (*task)();
+        }
+
+        firstBlockRow = lastBlockRow;
+    }
+
+    WaitableEvent::WaitMany(&waitEvents);
+}
+
 void LoadR11EACToR8(const ImageLoadContext &context,
                     size_t width,
                     size_t height,
@@ -1425,25 +1527,21 @@ void LoadR11EACToR8(const ImageLoadContext &context,
                     size_t outputDepthPitch,
                     bool isSigned)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+    DecodeBlockRows(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow =
+            priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceBlock = sourceRow + (x / 4);
-                uint8_t *destPixels          = destRow + x;
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceBlock = sourceRow + (x / 4);
+            uint8_t *destPixels          = destRow + x;
 
-                sourceBlock->decodeAsSingleETC2Channel(destPixels, x, y, width, height, 1,
-                                                       outputRowPitch, isSigned);
-            }
+            sourceBlock->decodeAsSingleETC2Channel(destPixels, x, y, width, height, 1,
+                                                   outputRowPitch, isSigned);
         }
-    }
+    });
 }
 
 void LoadRG11EACToRG8(const ImageLoadContext &context,
@@ -1458,29 +1556,25 @@ void LoadRG11EACToRG8(const ImageLoadContext &context,
                       size_t outputDepthPitch,
                       bool isSigned)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+    DecodeBlockRows(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow =
+            priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                uint8_t *destPixelsRed          = destRow + (x * 2);
-                const ETC2Block *sourceBlockRed = sourceRow + (x / 2);
-                sourceBlockRed->decodeAsSingleETC2Channel(destPixelsRed, x, y, width, height, 2,
-                                                          outputRowPitch, isSigned);
-
-                uint8_t *destPixelsGreen          = destPixelsRed + 1;
-                const ETC2Block *sourceBlockGreen = sourceBlockRed + 1;
-                sourceBlockGreen->decodeAsSingleETC2Channel(destPixelsGreen, x, y, width, height, 2,
-                                                            outputRowPitch, isSigned);
-            }
+        for (size_t x = 0; x < width; x += 4)
+        {
+            uint8_t *destPixelsRed          = destRow + (x * 2);
+            const ETC2Block *sourceBlockRed = sourceRow + (x / 2);
+            sourceBlockRed->decodeAsSingleETC2Channel(destPixelsRed, x, y, width, height, 2,
+                                                      outputRowPitch, isSigned);
+
+            uint8_t *destPixelsGreen          = destPixelsRed + 1;
+            const ETC2Block *sourceBlockGreen = sourceBlockRed + 1;
+            sourceBlockGreen->decodeAsSingleETC2Channel(destPixelsGreen, x, y, width, height, 2,
+                                                        outputRowPitch, isSigned);
         }
-    }
+    });
 }
 
 void LoadR11EACToR16(const ImageLoadContext &context,
@@ -1496,25 +1590,21 @@ void LoadR11EACToR16(const ImageLoadContext &context,
                      bool isSigned,
                      bool isFloat)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint16_t *destRow =
-                priv::OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
+    DecodeBlockRows(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint16_t *destRow =
+            priv::OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceBlock = sourceRow + (x / 4);
-                uint16_t *destPixels         = destRow + x;
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceBlock = sourceRow + (x / 4);
+            uint16_t *destPixels         = destRow + x;
 
-                sourceBlock->decodeAsSingleEACChannel(destPixels, x, y, width, height, 1,
-                                                      outputRowPitch, isSigned, isFloat);
-            }
+            sourceBlock->decodeAsSingleEACChannel(destPixels, x, y, width, height, 1,
+                                                  outputRowPitch, isSigned, isFloat);
         }
-    }
+    });
 }
 
 void LoadRG11EACToRG16(const ImageLoadContext &context,
@@ -1530,29 +1620,25 @@ void LoadRG11EACToRG16(const ImageLoadContext &context,
                        bool isSigned,
                        bool isFloat)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint16_t *destRow =
-                priv::OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
+    DecodeBlockRows(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint16_t *destRow =
+            priv::OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                uint16_t *destPixelsRed         = destRow + (x * 2);
-                const ETC2Block *sourceBlockRed = sourceRow + (x / 2);
-                sourceBlockRed->decodeAsSingleEACChannel(destPixelsRed, x, y, width, height, 2,
-                                                         outputRowPitch, isSigned, isFloat);
-
-                uint16_t *destPixelsGreen         = destPixelsRed + 1;
-                const ETC2Block *sourceBlockGreen = sourceBlockRed + 1;
-                sourceBlockGreen->decodeAsSingleEACChannel(destPixelsGreen, x, y, width, height, 2,
-                                                           outputRowPitch, isSigned, isFloat);
-            }
+        for (size_t x = 0; x < width; x += 4)
+        {
+            uint16_t *destPixelsRed         = destRow + (x * 2);
+            const ETC2Block *sourceBlockRed = sourceRow + (x / 2);
+            sourceBlockRed->decodeAsSingleEACChannel(destPixelsRed, x, y, width, height, 2,
+                                                     outputRowPitch, isSigned, isFloat);
+
+            uint16_t *destPixelsGreen         = destPixelsRed + 1;
+            const ETC2Block *sourceBlockGreen = sourceBlockRed + 1;
+            sourceBlockGreen->decodeAsSingleEACChannel(destPixelsGreen, x, y, width, height, 2,
+                                                       outputRowPitch, isSigned, isFloat);
         }
-    }
+    });
 }
 
 void LoadETC2RGB8ToRGBA8(const ImageLoadContext &context,
@@ -1567,25 +1653,21 @@ void LoadETC2RGB8ToRGBA8(const ImageLoadContext &context,
                          size_t outputDepthPitch,
                          bool punchthroughAlpha)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+    DecodeBlockRows(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow =
+            priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceBlock = sourceRow + (x / 4);
-                uint8_t *destPixels          = destRow + (x * 4);
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceBlock = sourceRow + (x / 4);
+            uint8_t *destPixels          = destRow + (x * 4);
 
-                sourceBlock->decodeAsRGB(destPixels, x, y, width, height, outputRowPitch,
-                                         DefaultETCAlphaValues, punchthroughAlpha);
-            }
+            sourceBlock->decodeAsRGB(destPixels, x, y, width, height, outputRowPitch,
+                                     DefaultETCAlphaValues, punchthroughAlpha);
         }
-    }
+    });
 }
 
 void LoadETC2RGB8ToBC1(const ImageLoadContext &context,
@@ -1600,25 +1682,21 @@ void LoadETC2RGB8ToBC1(const ImageLoadContext &context,
                        size_t outputDepthPitch,
                        bool punchthroughAlpha)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow = priv::OffsetDataPointer<uint8_t>(output, y / 4, z, outputRowPitch,
-                                                                outputDepthPitch);
+    DecodeBlockRows(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow = priv::OffsetDataPointer<uint8_t>(output, y / 4, z, outputRowPitch,
+                                                            outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceBlock = sourceRow + (x / 4);
-                uint8_t *destPixels          = destRow + (x * 2);
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceBlock = sourceRow + (x / 4);
+            uint8_t *destPixels          = destRow + (x * 2);
 
-                sourceBlock->transcodeAsBC1(destPixels, x, y, width, height, DefaultETCAlphaValues,
-                                            punchthroughAlpha);
-            }
+            sourceBlock->transcodeAsBC1(destPixels, x, y, width, height, DefaultETCAlphaValues,
+                                        punchthroughAlpha);
         }
-    }
+    });
 }
 
 void LoadETC2RGBA8ToRGBA8(const ImageLoadContext &context,
@@ -1633,31 +1711,27 @@ void LoadETC2RGBA8ToRGBA8(const ImageLoadContext &context,
                           size_t outputDepthPitch,
                           bool srgb)
 {
-    uint8_t decodedAlphaValues[4][4];
+    DecodeBlockRows(context, width, height, depth, [&](size_t z, size_t y) {
+        uint8_t decodedAlphaValues[4][4];
 
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow =
+            priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceBlockAlpha = sourceRow + (x / 2);
-                sourceBlockAlpha->decodeAsSingleETC2Channel(
-                    reinterpret_cast<uint8_t *>(decodedAlphaValues), x, y, width, height, 1, 4,
-                    false);
-
-                uint8_t *destPixels             = destRow + (x * 4);
-                const ETC2Block *sourceBlockRGB = sourceBlockAlpha + 1;
-                sourceBlockRGB->decodeAsRGB(destPixels, x, y, width, height, outputRowPitch,
-                                            decodedAlphaValues, false);
-            }
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceBlockAlpha = sourceRow + (x / 2);
+            sourceBlockAlpha->decodeAsSingleETC2Channel(
+                reinterpret_cast<uint8_t *>(decodedAlphaValues), x, y, width, height, 1, 4,
+                false);
+
+            uint8_t *destPixels             = destRow + (x * 4);
+            const ETC2Block *sourceBlockRGB = sourceBlockAlpha + 1;
+            sourceBlockRGB->decodeAsRGB(destPixels, x, y, width, height, outputRowPitch,
+                                        decodedAlphaValues, false);
         }
-    }
+    });
 }
 
 }  // anonymous namespace
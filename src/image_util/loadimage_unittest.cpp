@@ -0,0 +1,261 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// loadimage_unittest.cpp: Unit tests for the image load functions. The functions with vectorized
+// paths are compared against straightforward per-pixel references, over widths and pointer
+// offsets that exercise both the vector loops and the scalar remainders. The block decoders that
+// can run on a thread pool are compared against their single-threaded results.
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "common/WorkerThread.h"
+#include "common/mathutil.h"
+#include "image_util/loadimage.h"
+
+using namespace angle;
+
+namespace
+{
+// Widths smaller than, equal to and straddling the vector widths of all the kernels.
+constexpr size_t kWidths[]   = {1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 64, 67};
+constexpr size_t kHeight     = 3;
+constexpr size_t kDepth      = 2;
+constexpr size_t kRowPadding = 4;
+
+using LoadFunction = void (*)(const ImageLoadContext &,
+                              size_t,
+                              size_t,
+                              size_t,
+                              const uint8_t *,
+                              size_t,
+                              size_t,
+                              uint8_t *,
+                              size_t,
+                              size_t);
+
+using ReferenceFunction = void (*)(const uint8_t *source, uint8_t *dest, size_t x);
+
+// Runs |load| over an image of random data and compares each pixel to |reference|. The input and
+// output are offset by |misalignment| bytes to exercise unaligned accesses.
+void CheckLoadFunction(LoadFunction load,
+                       ReferenceFunction reference,
+                       size_t inputPixelBytes,
+                       size_t outputPixelBytes,
+                       size_t misalignment)
+{
+    for (size_t width : kWidths)
+    {
+        const size_t inputRowPitch    = width * inputPixelBytes + kRowPadding;
+        const size_t inputDepthPitch  = inputRowPitch * kHeight;
+        const size_t outputRowPitch   = width * outputPixelBytes + kRowPadding;
+        const size_t outputDepthPitch = outputRowPitch * kHeight;
+
+        std::vector<uint8_t> input(inputDepthPitch * kDepth + misalignment);
+        uint32_t state = static_cast<uint32_t>(width * 2654435761u);
+        for (uint8_t &byte : input)
+        {
+            state = state * 1664525u + 1013904223u;
+            byte  = static_cast<uint8_t>(state >> 24);
+        }
+
+        std::vector<uint8_t> output(outputDepthPitch * kDepth + misalignment, 0);
+        load(ImageLoadContext(), width, kHeight, kDepth, input.data() + misalignment,
+             inputRowPitch, inputDepthPitch, output.data() + misalignment, outputRowPitch,
+             outputDepthPitch);
+
+        for (size_t z = 0; z < kDepth; z++)
+        {
+            for (size_t y = 0; y < kHeight; y++)
+            {
+                const uint8_t *source =
+                    input.data() + misalignment + z * inputDepthPitch + y * inputRowPitch;
+                const uint8_t *dest =
+                    output.data() + misalignment + z * outputDepthPitch + y * outputRowPitch;
+                for (size_t x = 0; x < width; x++)
+                {
+                    std::vector<uint8_t> expected(outputPixelBytes);
+                    reference(source, expected.data(), x);
+                    for (size_t byte = 0; byte < outputPixelBytes; byte++)
+                    {
+                        ASSERT_EQ(expected[byte], dest[x * outputPixelBytes + byte])
+                            << "width " << width << " pixel (" << x << ", " << y << ", " << z
+                            << ") byte " << byte << " misalignment " << misalignment;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CheckLoadFunction(LoadFunction load,
+                       ReferenceFunction reference,
+                       size_t inputPixelBytes,
+                       size_t outputPixelBytes)
+{
+    // Offsets that keep the pixels naturally aligned, but not to the vector size.
+    for (size_t misalignment : {0, 4, 8, 12})
+    {
+        CheckLoadFunction(load, reference, inputPixelBytes, outputPixelBytes, misalignment);
+    }
+}
+
+uint16_t ReadUint16(const uint8_t *data)
+{
+    uint16_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint32_t ReadUint32(const uint8_t *data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+void WriteUint32(uint8_t *data, uint32_t value)
+{
+    memcpy(data, &value, sizeof(value));
+}
+
+// Test LoadA8ToRGBA8 matches the reference.
+TEST(LoadImage, A8ToRGBA8)
+{
+    CheckLoadFunction(
+        LoadA8ToRGBA8,
+        [](const uint8_t *source, uint8_t *dest, size_t x) {
+            WriteUint32(dest, static_cast<uint32_t>(source[x]) << 24);
+        },
+        1, 4);
+}
+
+// Test LoadL8ToRGBA8 matches the reference.
+TEST(LoadImage, L8ToRGBA8)
+{
+    CheckLoadFunction(
+        LoadL8ToRGBA8,
+        [](const uint8_t *source, uint8_t *dest, size_t x) {
+            dest[0] = source[x];
+            dest[1] = source[x];
+            dest[2] = source[x];
+            dest[3] = 0xFF;
+        },
+        1, 4);
+}
+
+// Test LoadRGB8ToBGRX8 matches the reference.
+TEST(LoadImage, RGB8ToBGRX8)
+{
+    CheckLoadFunction(
+        LoadRGB8ToBGRX8,
+        [](const uint8_t *source, uint8_t *dest, size_t x) {
+            dest[0] = source[3 * x + 2];
+            dest[1] = source[3 * x + 1];
+            dest[2] = source[3 * x + 0];
+            dest[3] = 0xFF;
+        },
+        3, 4);
+}
+
+// Test LoadRGBA8ToBGRA8 matches the reference.
+TEST(LoadImage, RGBA8ToBGRA8)
+{
+    CheckLoadFunction(
+        LoadRGBA8ToBGRA8,
+        [](const uint8_t *source, uint8_t *dest, size_t x) {
+            dest[0] = source[4 * x + 2];
+            dest[1] = source[4 * x + 1];
+            dest[2] = source[4 * x + 0];
+            dest[3] = source[4 * x + 3];
+        },
+        4, 4);
+}
+
+// Test LoadRGBA4ToRGBA8 matches the reference.
+TEST(LoadImage, RGBA4ToRGBA8)
+{
+    CheckLoadFunction(
+        LoadRGBA4ToRGBA8,
+        [](const uint8_t *source, uint8_t *dest, size_t x) {
+            uint16_t rgba = ReadUint16(source + 2 * x);
+            for (size_t channel = 0; channel < 4; channel++)
+            {
+                uint8_t nibble = static_cast<uint8_t>((rgba >> (12 - 4 * channel)) & 0xF);
+                dest[channel]  = static_cast<uint8_t>(nibble << 4 | nibble);
+            }
+        },
+        2, 4);
+}
+
+// Test LoadD24S8ToS8D24 matches the reference.
+TEST(LoadImage, D24S8ToS8D24)
+{
+    CheckLoadFunction(
+        LoadD24S8ToS8D24,
+        [](const uint8_t *source, uint8_t *dest, size_t x) {
+            uint32_t d24s8 = ReadUint32(source + 4 * x);
+            WriteUint32(dest, (d24s8 << 24) | (d24s8 >> 8));
+        },
+        4, 4);
+}
+
+// Decodes random blocks of size |width|x|height|x|depth| with |load| on the calling thread and on
+// a thread pool, and checks both results match.
+void CheckThreadedBlockDecode(LoadFunction load,
+                              size_t blockBytes,
+                              size_t outputBlockRowBytes,
+                              size_t width,
+                              size_t height,
+                              size_t depth)
+{
+    const size_t blocksWide       = (width + 3) / 4;
+    const size_t blocksHigh       = (height + 3) / 4;
+    const size_t inputRowPitch    = blocksWide * blockBytes;
+    const size_t inputDepthPitch  = inputRowPitch * blocksHigh;
+    const size_t outputRowPitch   = width * outputBlockRowBytes / 4;
+    const size_t outputDepthPitch = outputRowPitch * height;
+
+    std::vector<uint8_t> input(inputDepthPitch * depth);
+    uint32_t state = 12345;
+    for (uint8_t &byte : input)
+    {
+        state = state * 1664525u + 1013904223u;
+        byte  = static_cast<uint8_t>(state >> 24);
+    }
+
+    ImageLoadContext singleThreaded;
+    singleThreaded.singleThreadPool = WorkerThreadPool::Create(1, ANGLEPlatformCurrent());
+
+    ImageLoadContext multiThreaded(singleThreaded);
+    multiThreaded.multiThreadPool = WorkerThreadPool::Create(0, ANGLEPlatformCurrent());
+
+    std::vector<uint8_t> expected(outputDepthPitch * depth, 0);
+    std::vector<uint8_t> actual(outputDepthPitch * depth, 0);
+    load(singleThreaded, width, height, depth, input.data(), inputRowPitch, inputDepthPitch,
+         expected.data(), outputRowPitch, outputDepthPitch);
+    load(multiThreaded, width, height, depth, input.data(), inputRowPitch, inputDepthPitch,
+         actual.data(), outputRowPitch, outputDepthPitch);
+
+    EXPECT_EQ(expected, actual);
+}
+
+// Test ETC2 and EAC decoding gives the same results on a thread pool as on the calling thread,
+// including for sizes that are not a multiple of the block size.
+TEST(LoadImage, ThreadedETCDecode)
+{
+    for (size_t size : {4, 6, 300, 512})
+    {
+        CheckThreadedBlockDecode(LoadETC2RGB8ToRGBA8, 8, 16, size, size, 1);
+        CheckThreadedBlockDecode(LoadETC2RGBA8ToRGBA8, 16, 16, size, size, 1);
+        CheckThreadedBlockDecode(LoadEACR11ToR8, 8, 4, size, size, 1);
+        CheckThreadedBlockDecode(LoadEACRG11SToRG16, 16, 16, size, size, 1);
+    }
+
+    // 2D array
+    CheckThreadedBlockDecode(LoadETC2RGB8ToRGBA8, 8, 16, 130, 70, 6);
+}
+
+}  // anonymous namespace
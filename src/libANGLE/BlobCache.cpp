@@ -8,7 +8,12 @@
 // disk.  MemoryProgramCache uses this to handle caching of compiled programs.
 
 #include "libANGLE/BlobCache.h"
+
+#include <limits>
+
+#include "common/hash_utils.h"
 #include "common/utilities.h"
+#include "libANGLE/BlobCacheDiskStore.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/Display.h"
 #include "libANGLE/histogram_macros.h"
@@ -20,24 +25,51 @@
 namespace egl
 {
 
+namespace
+{
+// Written in front of every compressed blob.  The first byte of the magic differs from the first
+// byte of a gzip stream, which is how blobs written without the header are recognized.
+struct BlobHeader
+{
+    uint32_t magic;
+    BlobCacheCodec codec;
+    uint8_t padding[3];
+    uint32_t uncompressedSize;
+    // Checksum of the uncompressed data, only for BlobCacheCodec::Uncompressed.  The gzip stream
+    // has its own.
+    uint32_t checksum;
+};
+static_assert(sizeof(BlobHeader) == 16, "Unexpected padding in BlobHeader");
+
+// "ANGB" in memory on little-endian machines.
+constexpr uint32_t kBlobHeaderMagic = 0x42474E41;
+constexpr uint32_t kChecksumSeed    = 0xABCDEF98;
+
+uint32_t ComputeChecksum(const uint8_t *data, size_t size)
+{
+    return XXH32(data, size, kChecksumSeed);
+}
+
 // In oder to store more cache in blob cache, compress cacheData to compressedData
 // before being stored.
-bool CompressBlobCacheData(const size_t cacheSize,
-                           const uint8_t *cacheData,
-                           angle::MemoryBuffer *compressedData)
+bool GzipCompress(const size_t cacheSize,
+                  const uint8_t *cacheData,
+                  size_t headerSize,
+                  angle::MemoryBuffer *compressedData)
 {
     uLong uncompressedSize       = static_cast<uLong>(cacheSize);
     uLong expectedCompressedSize = zlib_internal::GzipExpectedCompressedSize(uncompressedSize);
 
     // Allocate memory.
-    if (!compressedData->resize(expectedCompressedSize))
+    if (!compressedData->resize(headerSize + expectedCompressedSize))
     {
         ERR() << "Failed to allocate memory for compression";
         return false;
     }
 
-    int zResult = zlib_internal::GzipCompressHelper(compressedData->data(), &expectedCompressedSize,
-                                                    cacheData, uncompressedSize, nullptr, nullptr);
+    int zResult = zlib_internal::GzipCompressHelper(compressedData->data() + headerSize,
+                                                    &expectedCompressedSize, cacheData,
+                                                    uncompressedSize, nullptr, nullptr);
 
     if (zResult != Z_OK)
     {
@@ -46,7 +78,7 @@ bool CompressBlobCacheData(const size_t cacheSize,
     }
 
     // Resize it to expected size.
-    if (!compressedData->resize(expectedCompressedSize))
+    if (!compressedData->resize(headerSize + expectedCompressedSize))
     {
         return false;
     }
@@ -54,9 +86,9 @@ bool CompressBlobCacheData(const size_t cacheSize,
     return true;
 }
 
-bool DecompressBlobCacheData(const uint8_t *compressedData,
-                             const size_t compressedSize,
-                             angle::MemoryBuffer *uncompressedData)
+bool GzipDecompress(const uint8_t *compressedData,
+                    const size_t compressedSize,
+                    angle::MemoryBuffer *uncompressedData)
 {
     // Call zlib function to decompress.
     uint32_t uncompressedSize =
@@ -87,12 +119,131 @@ bool DecompressBlobCacheData(const uint8_t *compressedData,
 
     return true;
 }
+}  // anonymous namespace
+
+bool CompressBlobCacheData(BlobCacheCodec codec,
+                           const size_t cacheSize,
+                           const uint8_t *cacheData,
+                           angle::MemoryBuffer *compressedData)
+{
+    if (cacheSize > std::numeric_limits<uint32_t>::max())
+    {
+        ERR() << "Cache data too large to compress";
+        return false;
+    }
+
+    BlobHeader header       = {};
+    header.magic            = kBlobHeaderMagic;
+    header.codec            = codec;
+    header.uncompressedSize = static_cast<uint32_t>(cacheSize);
+
+    switch (codec)
+    {
+        case BlobCacheCodec::Gzip:
+            if (!GzipCompress(cacheSize, cacheData, sizeof(header), compressedData))
+            {
+                return false;
+            }
+            break;
+
+        case BlobCacheCodec::Uncompressed:
+            if (!compressedData->resize(sizeof(header) + cacheSize))
+            {
+                ERR() << "Failed to allocate memory for compression";
+                return false;
+            }
+            if (cacheSize > 0)
+            {
+                memcpy(compressedData->data() + sizeof(header), cacheData, cacheSize);
+            }
+            header.checksum = ComputeChecksum(compressedData->data() + sizeof(header), cacheSize);
+            break;
+
+        default:
+            UNREACHABLE();
+            return false;
+    }
+
+    memcpy(compressedData->data(), &header, sizeof(header));
+    return true;
+}
+
+bool CompressBlobCacheData(const size_t cacheSize,
+                           const uint8_t *cacheData,
+                           angle::MemoryBuffer *compressedData)
+{
+    return CompressBlobCacheData(BlobCacheCodec::Gzip, cacheSize, cacheData, compressedData);
+}
+
+bool DecompressBlobCacheData(const uint8_t *compressedData,
+                             const size_t compressedSize,
+                             angle::MemoryBuffer *uncompressedData)
+{
+    BlobHeader header;
+    if (compressedSize < sizeof(header) ||
+        memcmp(compressedData, &kBlobHeaderMagic, sizeof(kBlobHeaderMagic)) != 0)
+    {
+        // Written before the codec was recorded.
+        return GzipDecompress(compressedData, compressedSize, uncompressedData);
+    }
+
+    memcpy(&header, compressedData, sizeof(header));
+    const uint8_t *payload   = compressedData + sizeof(header);
+    const size_t payloadSize = compressedSize - sizeof(header);
+
+    switch (header.codec)
+    {
+        case BlobCacheCodec::Gzip:
+            if (!GzipDecompress(payload, payloadSize, uncompressedData))
+            {
+                return false;
+            }
+            break;
+
+        case BlobCacheCodec::Uncompressed:
+            if (!uncompressedData->resize(payloadSize))
+            {
+                ERR() << "Failed to allocate memory for decompression";
+                return false;
+            }
+            if (ComputeChecksum(payload, payloadSize) != header.checksum)
+            {
+                ERR() << "Uncompressed cache data is corrupt";
+                return false;
+            }
+            if (payloadSize > 0)
+            {
+                memcpy(uncompressedData->data(), payload, payloadSize);
+            }
+            break;
+
+        default:
+            // Possibly written by a newer version.
+            ERR() << "Unknown cache data codec: " << static_cast<uint32_t>(header.codec);
+            return false;
+    }
+
+    if (uncompressedData->size() != header.uncompressedSize)
+    {
+        ERR() << "Decompressed cache data has an unexpected size";
+        return false;
+    }
+
+    return true;
+}
 
 BlobCache::BlobCache(size_t maxCacheSizeBytes)
-    : mBlobCache(maxCacheSizeBytes), mSetBlobFunc(nullptr), mGetBlobFunc(nullptr)
+    : mCurrentSize(0),
+      mMaxSize(maxCacheSizeBytes),
+      mUseSerial(0),
+      mHasDiskStore(false),
+      mCodec(BlobCacheCodec::Gzip),
+      mSetBlobFunc(nullptr),
+      mGetBlobFunc(nullptr),
+      mBlobCacheFuncsSet(false)
 {}
 
-BlobCache::~BlobCache() {}
+BlobCache::~BlobCache() = default;
 
 void BlobCache::put(const BlobCache::Key &key, angle::MemoryBuffer &&value)
 {
@@ -104,7 +255,16 @@ void BlobCache::put(const BlobCache::Key &key, angle::MemoryBuffer &&value)
     }
     else
     {
-        populate(key, std::move(value), CacheSource::Memory);
+        if (mHasDiskStore)
+        {
+            std::scoped_lock<std::mutex> lock(mBlobCacheMutex);
+            if (mDiskStore)
+            {
+                mDiskStore->put(key, value.data(), value.size());
+            }
+        }
+        populateMemory(key, std::make_shared<angle::MemoryBuffer>(std::move(value)),
+                       CacheSource::Memory);
     }
 }
 
@@ -113,7 +273,7 @@ bool BlobCache::compressAndPut(const BlobCache::Key &key,
                                size_t *compressedSize)
 {
     angle::MemoryBuffer compressedValue;
-    if (!CompressBlobCacheData(uncompressedValue.size(), uncompressedValue.data(),
+    if (!CompressBlobCacheData(mCodec, uncompressedValue.size(), uncompressedValue.data(),
                                &compressedValue))
     {
         return false;
@@ -135,13 +295,115 @@ void BlobCache::putApplication(const BlobCache::Key &key, const angle::MemoryBuf
 
 void BlobCache::populate(const BlobCache::Key &key, angle::MemoryBuffer &&value, CacheSource source)
 {
+    populateMemory(key, std::make_shared<angle::MemoryBuffer>(std::move(value)), source);
+}
+
+void BlobCache::populateMemory(const BlobCache::Key &key, SharedValue &&value, CacheSource source)
+{
+    const size_t valueSize = value->size();
+    if (valueSize > mMaxSize)
+    {
+        return;
+    }
+
+    {
+        Shard &shard = getShard(key);
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+
+        // Check for existing key.
+        auto existing = shard.store.Peek(key);
+        if (existing != shard.store.end())
+        {
+            mCurrentSize -= existing->second.value->size();
+            shard.store.Erase(existing);
+        }
+
+        shard.store.Put(key, CacheEntry{std::move(value), source, ++mUseSerial});
+        mCurrentSize += valueSize;
+    }
+
+    if (mCurrentSize > mMaxSize)
+    {
+        evictToSize(mMaxSize);
+    }
+}
+
+void BlobCache::lockAllShards(AllShardsLock *locksOut) const
+{
+    for (size_t shardIndex = 0; shardIndex < kShardCount; ++shardIndex)
+    {
+        (*locksOut)[shardIndex] = std::unique_lock<std::mutex>(mShards[shardIndex].mutex);
+    }
+}
+
+size_t BlobCache::evictToSize(size_t limit)
+{
+    AllShardsLock locks;
+    lockAllShards(&locks);
+
+    const size_t initialSize = mCurrentSize;
+
+    while (mCurrentSize > limit)
+    {
+        // The entries of each shard are ordered by use, so the least recently used entry of the
+        // cache is at the back of one of the shards.
+        Shard *oldestShard = nullptr;
+        for (Shard &shard : mShards)
+        {
+            if (shard.store.empty())
+            {
+                continue;
+            }
+            if (oldestShard == nullptr || shard.store.rbegin()->second.lastUse <
+                                              oldestShard->store.rbegin()->second.lastUse)
+            {
+                oldestShard = &shard;
+            }
+        }
+
+        ASSERT(oldestShard != nullptr);
+        auto oldest = oldestShard->store.rbegin();
+        mCurrentSize -= oldest->second.value->size();
+        oldestShard->store.Erase(oldest);
+    }
+
+    return initialSize - mCurrentSize;
+}
+
+BlobCache::SharedValue BlobCache::getInternal(const BlobCache::Key &key)
+{
+    {
+        Shard &shard = getShard(key);
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+        auto entry = shard.store.Get(key);
+        if (entry != shard.store.end())
+        {
+            entry->second.lastUse = ++mUseSerial;
+            return entry->second.value;
+        }
+    }
+
+    // Warm this object's cache from the disk store lazily, one blob at a time as they are needed.
+    if (!mHasDiskStore)
+    {
+        return nullptr;
+    }
+
     std::scoped_lock<std::mutex> lock(mBlobCacheMutex);
-    CacheEntry newEntry;
-    newEntry.first  = std::move(value);
-    newEntry.second = source;
+    if (!mDiskStore)
+    {
+        return nullptr;
+    }
+
+    angle::MemoryBuffer diskValue;
+    if (!mDiskStore->get(key, &diskValue))
+    {
+        return nullptr;
+    }
 
-    // Cache it inside blob cache only if caching inside the application is not possible.
-    mBlobCache.put(key, std::move(newEntry), newEntry.first.size());
+    SharedValue value = std::make_shared<angle::MemoryBuffer>(std::move(diskValue));
+    populateMemory(key, SharedValue(value), CacheSource::Disk);
+    return value;
 }
 
 bool BlobCache::get(angle::ScratchBuffer *scratchBuffer,
@@ -186,31 +448,38 @@ bool BlobCache::get(angle::ScratchBuffer *scratchBuffer,
         return true;
     }
 
-    std::scoped_lock<std::mutex> lock(mBlobCacheMutex);
-    // Otherwise we are doing caching internally, so try to find it there
-    const CacheEntry *entry;
-    bool result = mBlobCache.get(key, &entry);
-
-    if (result)
+    // Otherwise we are doing caching internally, so try to find it there.  The returned value holds
+    // a reference to the blob, since other threads may evict or replace the entry at any time.
+    SharedValue value = getInternal(key);
+    if (!value)
     {
-
-        *valueOut      = BlobCache::Value(entry->first.data(), entry->first.size());
-        *bufferSizeOut = entry->first.size();
+        return false;
     }
 
-    return result;
+    *bufferSizeOut = value->size();
+    *valueOut      = BlobCache::Value(std::move(value));
+    return true;
 }
 
 bool BlobCache::getAt(size_t index, const BlobCache::Key **keyOut, BlobCache::Value *valueOut)
 {
-    std::scoped_lock<std::mutex> lock(mBlobCacheMutex);
-    const CacheEntry *valueBuf;
-    bool result = mBlobCache.getAt(index, keyOut, &valueBuf);
-    if (result)
+    AllShardsLock locks;
+    lockAllShards(&locks);
+
+    for (Shard &shard : mShards)
     {
-        *valueOut = BlobCache::Value(valueBuf->first.data(), valueBuf->first.size());
+        if (index < shard.store.size())
+        {
+            auto entry = shard.store.begin();
+            std::advance(entry, index);
+            *keyOut   = &entry->first;
+            *valueOut = BlobCache::Value(SharedValue(entry->second.value));
+            return true;
+        }
+        index -= shard.store.size();
     }
-    return result;
+
+    return false;
 }
 
 BlobCache::GetAndDecompressResult BlobCache::getAndDecompress(
@@ -220,21 +489,32 @@ BlobCache::GetAndDecompressResult BlobCache::getAndDecompress(
 {
     ASSERT(uncompressedValueOut);
 
+    // No lock is held while decompressing.  The application's blob is copied to the caller's
+    // scratch buffer, and a reference to the cached blob is held so it can't be freed meanwhile.
+    SharedValue cachedValue;
     Value compressedValue;
     size_t compressedSize;
-    if (!get(scratchBuffer, key, &compressedValue, &compressedSize))
+    if (areBlobCacheFuncsSet())
     {
-        return GetAndDecompressResult::NotFound;
+        if (!get(scratchBuffer, key, &compressedValue, &compressedSize))
+        {
+            return GetAndDecompressResult::NotFound;
+        }
     }
-
+    else
     {
-        // This needs to be locked because `DecompressBlobCacheData` is reading shared memory from
-        // `compressedValue.data()`.
-        std::scoped_lock<std::mutex> lock(mBlobCacheMutex);
-        if (!DecompressBlobCacheData(compressedValue.data(), compressedSize, uncompressedValueOut))
+        cachedValue = getInternal(key);
+        if (!cachedValue)
         {
-            return GetAndDecompressResult::DecompressFailure;
+            return GetAndDecompressResult::NotFound;
         }
+        compressedValue = Value(cachedValue->data(), cachedValue->size());
+        compressedSize  = cachedValue->size();
+    }
+
+    if (!DecompressBlobCacheData(compressedValue.data(), compressedSize, uncompressedValueOut))
+    {
+        return GetAndDecompressResult::DecompressFailure;
     }
 
     return GetAndDecompressResult::GetSuccess;
@@ -242,24 +522,105 @@ BlobCache::GetAndDecompressResult BlobCache::getAndDecompress(
 
 void BlobCache::remove(const BlobCache::Key &key)
 {
-    std::scoped_lock<std::mutex> lock(mBlobCacheMutex);
-    mBlobCache.eraseByKey(key);
+    {
+        Shard &shard = getShard(key);
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+        auto entry = shard.store.Peek(key);
+        if (entry != shard.store.end())
+        {
+            mCurrentSize -= entry->second.value->size();
+            shard.store.Erase(entry);
+        }
+    }
+
+    if (mHasDiskStore)
+    {
+        std::scoped_lock<std::mutex> lock(mBlobCacheMutex);
+        if (mDiskStore)
+        {
+            mDiskStore->remove(key);
+        }
+    }
+}
+
+void BlobCache::clear()
+{
+    AllShardsLock locks;
+    lockAllShards(&locks);
+
+    for (Shard &shard : mShards)
+    {
+        shard.store.Clear();
+    }
+    mCurrentSize = 0;
+}
+
+void BlobCache::resize(size_t maxCacheSizeBytes)
+{
+    AllShardsLock locks;
+    lockAllShards(&locks);
+
+    for (Shard &shard : mShards)
+    {
+        shard.store.Clear();
+    }
+    mCurrentSize = 0;
+    mMaxSize     = maxCacheSizeBytes;
+}
+
+size_t BlobCache::entryCount() const
+{
+    AllShardsLock locks;
+    lockAllShards(&locks);
+
+    size_t count = 0;
+    for (const Shard &shard : mShards)
+    {
+        count += shard.store.size();
+    }
+    return count;
 }
 
 void BlobCache::setBlobCacheFuncs(EGLSetBlobFuncANDROID set, EGLGetBlobFuncANDROID get)
 {
+    // Either none or both of the callbacks should be set.
+    ASSERT((set != nullptr) == (get != nullptr));
+
     std::scoped_lock<std::mutex> lock(mBlobCacheMutex);
-    mSetBlobFunc = set;
-    mGetBlobFunc = get;
+    mSetBlobFunc       = set;
+    mGetBlobFunc       = get;
+    mBlobCacheFuncsSet = set != nullptr && get != nullptr;
 }
 
 bool BlobCache::areBlobCacheFuncsSet() const
+{
+    return mBlobCacheFuncsSet;
+}
+
+bool BlobCache::openDiskStore(const std::string &path, size_t maxSizeBytes)
 {
     std::scoped_lock<std::mutex> lock(mBlobCacheMutex);
-    // Either none or both of the callbacks should be set.
-    ASSERT((mSetBlobFunc != nullptr) == (mGetBlobFunc != nullptr));
+    auto diskStore = std::make_unique<BlobCacheDiskStore>();
+    if (!diskStore->open(path, maxSizeBytes))
+    {
+        return false;
+    }
+
+    mDiskStore    = std::move(diskStore);
+    mHasDiskStore = true;
+    return true;
+}
 
-    return mSetBlobFunc != nullptr && mGetBlobFunc != nullptr;
+void BlobCache::closeDiskStore()
+{
+    std::scoped_lock<std::mutex> lock(mBlobCacheMutex);
+    mDiskStore.reset();
+    mHasDiskStore = false;
+}
+
+bool BlobCache::hasDiskStore() const
+{
+    return mHasDiskStore;
 }
 
 }  // namespace egl
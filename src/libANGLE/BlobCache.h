@@ -11,13 +11,17 @@
 #define LIBANGLE_BLOB_CACHE_H_
 
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
 
+#include <anglebase/containers/mru_cache.h>
 #include <anglebase/sha1.h>
 #include "common/MemoryBuffer.h"
 #include "common/hash_utils.h"
 #include "libANGLE/Error.h"
-#include "libANGLE/SizedMRUCache.h"
 
 namespace gl
 {
@@ -47,7 +51,25 @@ struct hash<egl::BlobCacheKey>
 
 namespace egl
 {
+class BlobCacheDiskStore;
 
+// How blobs are compressed.  The codec is recorded in a header in front of the compressed data, so
+// blobs compressed with any codec can be decompressed regardless of the codec currently in use.
+// Blobs without a header, as written before the header was introduced, are gzip streams.
+enum class BlobCacheCodec : uint8_t
+{
+    // Smallest blobs, at the cost of inflating them on every cache hit.
+    Gzip,
+    // The data is copied as is, along with a checksum to detect corruption.  Cache hits are much
+    // faster, but the blobs take more memory.
+    Uncompressed,
+};
+
+bool CompressBlobCacheData(BlobCacheCodec codec,
+                           const size_t cacheSize,
+                           const uint8_t *cacheData,
+                           angle::MemoryBuffer *compressedData);
+// Compresses with BlobCacheCodec::Gzip.
 bool CompressBlobCacheData(const size_t cacheSize,
                            const uint8_t *cacheData,
                            angle::MemoryBuffer *compressedData);
@@ -55,6 +77,11 @@ bool DecompressBlobCacheData(const uint8_t *compressedData,
                              const size_t compressedSize,
                              angle::MemoryBuffer *uncompressedData);
 
+// The blobs cached in memory are spread over shards by key, each with its own lock, so that lookups
+// of different keys from multiple threads don't serialize.  The blobs themselves are reference
+// counted, so getAndDecompress() doesn't hold any lock while decompressing.  Every put and get
+// stamps the entry with a serial that is global to the cache, so that eviction still discards the
+// least recently used blob of the whole cache, as a single MRU list would.
 class BlobCache final : angle::NonCopyable
 {
   public:
@@ -67,9 +94,14 @@ class BlobCache final : angle::NonCopyable
       public:
         Value() : mPtr(nullptr), mSize(0) {}
         Value(const uint8_t *ptr, size_t sz) : mPtr(ptr), mSize(sz) {}
+        // Holds a reference to a blob of the memory cache, so that it stays valid even if the
+        // entry is evicted or replaced by another thread in the meantime.
+        explicit Value(std::shared_ptr<const angle::MemoryBuffer> &&blob)
+            : mPtr(blob->data()), mSize(blob->size()), mBlob(std::move(blob))
+        {}
 
         // A very basic struct to hold the pointer and size together.  The objects of this class
-        // don't own the memory.
+        // don't own the memory, except for the reference to a blob of the memory cache.
         const uint8_t *data() { return mPtr; }
         size_t size() { return mSize; }
 
@@ -82,6 +114,7 @@ class BlobCache final : angle::NonCopyable
       private:
         const uint8_t *mPtr;
         size_t mSize;
+        std::shared_ptr<const angle::MemoryBuffer> mBlob;
     };
     enum class CacheSource
     {
@@ -93,11 +126,12 @@ class BlobCache final : angle::NonCopyable
     ~BlobCache();
 
     // Store a key-blob pair in the cache.  If application callbacks are set, the application cache
-    // will be used.  Otherwise the value is cached in this object.
+    // will be used.  Otherwise the value is cached in this object, and in the disk store if one is
+    // open.
     void put(const BlobCache::Key &key, angle::MemoryBuffer &&value);
 
-    // Store a key-blob pair in the cache, but compress the blob before insertion. Returns false if
-    // compression fails, returns true otherwise.
+    // Store a key-blob pair in the cache, but compress the blob with the cache's codec before
+    // insertion. Returns false if compression fails, returns true otherwise.
     bool compressAndPut(const BlobCache::Key &key,
                         angle::MemoryBuffer &&uncompressedValue,
                         size_t *compressedSize);
@@ -112,7 +146,8 @@ class BlobCache final : angle::NonCopyable
                   CacheSource source = CacheSource::Disk);
 
     // Check if the cache contains the blob corresponding to this key.  If application callbacks are
-    // set, those will be used.  Otherwise they key is looked up in this object's cache.
+    // set, those will be used.  Otherwise they key is looked up in this object's cache, then in the
+    // disk store if one is open, in which case the blob is populated into this object's cache.
     [[nodiscard]] bool get(angle::ScratchBuffer *scratchBuffer,
                            const BlobCache::Key &key,
                            BlobCache::Value *valueOut,
@@ -137,44 +172,99 @@ class BlobCache final : angle::NonCopyable
     // Evict a blob from the binary cache.
     void remove(const BlobCache::Key &key);
 
-    // Empty the cache.
-    void clear() { mBlobCache.clear(); }
+    // Empty the cache.  The disk store, if any, is left untouched.
+    void clear();
 
     // Resize the cache. Discards current contents.
-    void resize(size_t maxCacheSizeBytes) { mBlobCache.resize(maxCacheSizeBytes); }
+    void resize(size_t maxCacheSizeBytes);
 
     // Returns the number of entries in the cache.
-    size_t entryCount() const { return mBlobCache.entryCount(); }
+    size_t entryCount() const;
 
     // Reduces the current cache size and returns the number of bytes freed.
-    size_t trim(size_t limit) { return mBlobCache.shrinkToSize(limit); }
+    size_t trim(size_t limit) { return evictToSize(limit); }
 
     // Returns the current cache size in bytes.
-    size_t size() const { return mBlobCache.size(); }
+    size_t size() const { return mCurrentSize; }
 
     // Returns whether the cache is empty
-    bool empty() const { return mBlobCache.empty(); }
+    bool empty() const { return entryCount() == 0; }
 
     // Returns the maximum cache size in bytes.
-    size_t maxSize() const { return mBlobCache.maxSize(); }
+    size_t maxSize() const { return mMaxSize; }
 
     void setBlobCacheFuncs(EGLSetBlobFuncANDROID set, EGLGetBlobFuncANDROID get);
 
     bool areBlobCacheFuncsSet() const;
 
+    // Persist the blobs that are not handed to the application to the file at |path|, and look up
+    // the blobs missing from this object's cache there.  The file is limited to |maxSizeBytes|.
+    // Returns false if the file can't be used, in which case caching stays in memory only.
+    bool openDiskStore(const std::string &path, size_t maxSizeBytes);
+    void closeDiskStore();
+    bool hasDiskStore() const;
+
     bool isCachingEnabled() const { return areBlobCacheFuncsSet() || maxSize() > 0; }
 
+    // The codec used by compressAndPut(), and by the users of the cache that compress blobs
+    // themselves.
+    void setCodec(BlobCacheCodec codec) { mCodec = codec; }
+    BlobCacheCodec getCodec() const { return mCodec; }
+
     std::mutex &getMutex() { return mBlobCacheMutex; }
 
   private:
+    using SharedValue = std::shared_ptr<const angle::MemoryBuffer>;
+
     // This internal cache is used only if the application is not providing caching callbacks
-    using CacheEntry = std::pair<angle::MemoryBuffer, CacheSource>;
+    struct CacheEntry
+    {
+        SharedValue value;
+        CacheSource source;
+        // Value of mUseSerial when the entry was last put or looked up.
+        uint64_t lastUse;
+    };
+
+    static constexpr size_t kShardCount = 16;
+    struct Shard
+    {
+        std::mutex mutex;
+        angle::base::HashingMRUCache<BlobCache::Key, CacheEntry> store{
+            angle::base::HashingMRUCache<BlobCache::Key, CacheEntry>::NO_AUTO_EVICT};
+    };
+    using AllShardsLock = std::array<std::unique_lock<std::mutex>, kShardCount>;
+
+    Shard &getShard(const BlobCache::Key &key) { return mShards[key[0] % kShardCount]; }
+    // Locks the shards in order, which is the only order in which more than one is ever locked.
+    void lockAllShards(AllShardsLock *locksOut) const;
 
+    // Looks the key up in memory, then in the disk store.  Returns nullptr if not found.
+    SharedValue getInternal(const BlobCache::Key &key);
+    void populateMemory(const BlobCache::Key &key, SharedValue &&value, CacheSource source);
+    // Evicts the least recently used entries across all shards until the cache fits in |limit|,
+    // and returns the number of bytes freed.
+    size_t evictToSize(size_t limit);
+
+    // Guards the application callbacks and the disk store.  The memory cache is guarded by the
+    // shard locks.
     mutable std::mutex mBlobCacheMutex;
-    angle::SizedMRUCache<BlobCache::Key, CacheEntry> mBlobCache;
+
+    mutable std::array<Shard, kShardCount> mShards;
+    std::atomic<size_t> mCurrentSize;
+    std::atomic<size_t> mMaxSize;
+    std::atomic<uint64_t> mUseSerial;
+
+    // Used only if the application is not providing caching callbacks either.
+    std::unique_ptr<BlobCacheDiskStore> mDiskStore;
+    std::atomic<bool> mHasDiskStore;
+
+    std::atomic<BlobCacheCodec> mCodec;
 
     EGLSetBlobFuncANDROID mSetBlobFunc;
     EGLGetBlobFuncANDROID mGetBlobFunc;
+    // Mirrors whether the callbacks above are set, so the lookups of the memory cache can check it
+    // without taking mBlobCacheMutex.
+    std::atomic<bool> mBlobCacheFuncsSet;
 };
 
 }  // namespace egl
@@ -0,0 +1,460 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BlobCacheDiskStore: Persists the blobs of a BlobCache in a single append-only file.
+
+#include "libANGLE/BlobCacheDiskStore.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include "common/debug.h"
+#include "common/hash_utils.h"
+
+#if defined(ANGLE_PLATFORM_POSIX)
+#    include <fcntl.h>
+#    include <sys/file.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+
+namespace egl
+{
+namespace
+{
+constexpr char kFileMagic[8]    = {'A', 'N', 'G', 'L', 'E', 'B', 'L', 'B'};
+constexpr uint32_t kFileVersion = 1;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+constexpr uint32_t kRecordMagic  = 0x42434552;  // "RECB"
+constexpr uint32_t kChecksumSeed = 0xABCDEF98;
+
+struct RecordHeader
+{
+    uint32_t magic;
+    // Zero for a record that removes the key.
+    uint32_t valueSize;
+    uint32_t valueChecksum;
+    // Checksum of the other fields of the header, including the key.
+    uint32_t headerChecksum;
+    BlobCacheKey key;
+};
+static_assert(sizeof(RecordHeader) == 16 + kBlobCacheKeyLength, "Unexpected padding");
+
+uint32_t ComputeChecksum(const void *data, size_t size)
+{
+    return XXH32(data, size, kChecksumSeed);
+}
+
+uint32_t ComputeHeaderChecksum(RecordHeader header)
+{
+    header.headerChecksum = 0;
+    return ComputeChecksum(&header, sizeof(header));
+}
+
+size_t GetRecordSize(size_t valueSize)
+{
+    return sizeof(RecordHeader) + valueSize;
+}
+
+#if defined(ANGLE_PLATFORM_POSIX)
+bool WriteAll(int file, const void *data, size_t size, size_t offset)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    while (size > 0)
+    {
+        ssize_t written = pwrite(file, bytes, size, static_cast<off_t>(offset));
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        bytes += written;
+        offset += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool WriteFileHeader(int file)
+{
+    FileHeader header = {};
+    memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kFileVersion;
+    return ftruncate(file, 0) == 0 && WriteAll(file, &header, sizeof(header), 0);
+}
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+}  // anonymous namespace
+
+BlobCacheDiskStore::BlobCacheDiskStore()
+    : mMaxSize(0),
+      mFile(kInvalidFile),
+      mMapping(nullptr),
+      mMappedSize(0),
+      mFileSize(0),
+      mUseSerial(0)
+{}
+
+BlobCacheDiskStore::~BlobCacheDiskStore()
+{
+    close();
+}
+
+bool BlobCacheDiskStore::open(const std::string &path, size_t maxSizeBytes)
+{
+    close();
+
+    mPath    = path;
+    mMaxSize = maxSizeBytes;
+
+    if (!openFile() || !mapFile() || !loadIndex())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void BlobCacheDiskStore::close()
+{
+#if defined(ANGLE_PLATFORM_POSIX)
+    unmapFile();
+    if (mFile != kInvalidFile)
+    {
+        // Closing the file releases the lock.
+        ::close(mFile);
+        mFile = kInvalidFile;
+    }
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+
+    mFileSize = 0;
+    mIndex.clear();
+}
+
+bool BlobCacheDiskStore::get(const BlobCacheKey &key, angle::MemoryBuffer *valueOut)
+{
+    auto iter = mIndex.find(key);
+    if (iter == mIndex.end())
+    {
+        return false;
+    }
+
+    IndexEntry &entry = iter->second;
+
+    // Records appended since the file was mapped are not visible through the mapping yet.
+    if (entry.offset + entry.size > mMappedSize)
+    {
+        unmapFile();
+        if (!mapFile())
+        {
+            return false;
+        }
+    }
+
+    RecordHeader header;
+    memcpy(&header, mMapping + entry.offset - sizeof(RecordHeader), sizeof(header));
+    const uint8_t *value = mMapping + entry.offset;
+    if (header.valueChecksum != ComputeChecksum(value, entry.size))
+    {
+        WARN() << "Dropping corrupt entry from the blob cache file " << mPath;
+        mIndex.erase(iter);
+        return false;
+    }
+
+    if (!valueOut->resize(entry.size))
+    {
+        return false;
+    }
+    memcpy(valueOut->data(), value, entry.size);
+
+    entry.lastUse = ++mUseSerial;
+    return true;
+}
+
+void BlobCacheDiskStore::put(const BlobCacheKey &key, const uint8_t *value, size_t valueSize)
+{
+    // Values that could never be kept by the compaction are not stored at all.
+    if (!isOpen() || valueSize == 0 ||
+        sizeof(FileHeader) + GetRecordSize(valueSize) > mMaxSize / 2)
+    {
+        return;
+    }
+
+    const size_t recordOffset = mFileSize;
+    if (!appendRecord(key, value, valueSize))
+    {
+        return;
+    }
+
+    mIndex[key] = {recordOffset + sizeof(RecordHeader), valueSize, ++mUseSerial};
+
+    if (mFileSize > mMaxSize)
+    {
+        compact();
+    }
+}
+
+void BlobCacheDiskStore::remove(const BlobCacheKey &key)
+{
+    auto iter = mIndex.find(key);
+    if (iter == mIndex.end())
+    {
+        return;
+    }
+
+    mIndex.erase(iter);
+
+    // If the removal can't be recorded, the entry is back the next time the file is opened.
+    (void)appendRecord(key, nullptr, 0);
+}
+
+bool BlobCacheDiskStore::openFile()
+{
+#if defined(ANGLE_PLATFORM_POSIX)
+    mFile = ::open(mPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (mFile == kInvalidFile)
+    {
+        WARN() << "Failed to open the blob cache file " << mPath;
+        return false;
+    }
+
+    // Appends from two processes would corrupt each other's index, so only one process may use
+    // the file at a time.
+    if (flock(mFile, LOCK_EX | LOCK_NB) != 0)
+    {
+        WARN() << "The blob cache file " << mPath << " is in use by another process";
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(mFile, &fileStat) != 0)
+    {
+        return false;
+    }
+    mFileSize = static_cast<size_t>(fileStat.st_size);
+
+    FileHeader header = {};
+    if (mFileSize < sizeof(header) || pread(mFile, &header, sizeof(header), 0) != sizeof(header) ||
+        memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 ||
+        header.version != kFileVersion)
+    {
+        // New file, or one written by an incompatible version.  Start over.
+        if (!WriteFileHeader(mFile))
+        {
+            WARN() << "Failed to initialize the blob cache file " << mPath;
+            return false;
+        }
+        mFileSize = sizeof(header);
+    }
+
+    return true;
+#else
+    return false;
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+}
+
+bool BlobCacheDiskStore::mapFile()
+{
+#if defined(ANGLE_PLATFORM_POSIX)
+    ASSERT(mMapping == nullptr);
+
+    void *mapping = mmap(nullptr, mFileSize, PROT_READ, MAP_SHARED, mFile, 0);
+    if (mapping == MAP_FAILED)
+    {
+        WARN() << "Failed to map the blob cache file " << mPath;
+        return false;
+    }
+
+    mMapping    = static_cast<uint8_t *>(mapping);
+    mMappedSize = mFileSize;
+    return true;
+#else
+    return false;
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+}
+
+void BlobCacheDiskStore::unmapFile()
+{
+#if defined(ANGLE_PLATFORM_POSIX)
+    if (mMapping != nullptr)
+    {
+        munmap(mMapping, mMappedSize);
+        mMapping    = nullptr;
+        mMappedSize = 0;
+    }
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+}
+
+bool BlobCacheDiskStore::loadIndex()
+{
+    // Only the record headers are read here, the values are checked when they are looked up.
+    size_t offset = sizeof(FileHeader);
+    while (offset + sizeof(RecordHeader) <= mMappedSize)
+    {
+        RecordHeader header;
+        memcpy(&header, mMapping + offset, sizeof(header));
+
+        const size_t valueOffset = offset + sizeof(RecordHeader);
+        if (header.magic != kRecordMagic || header.headerChecksum != ComputeHeaderChecksum(header) ||
+            header.valueSize > mMappedSize - valueOffset)
+        {
+            break;
+        }
+
+        if (header.valueSize > 0)
+        {
+            mIndex[header.key] = {valueOffset, header.valueSize, ++mUseSerial};
+        }
+        else
+        {
+            mIndex.erase(header.key);
+        }
+
+        offset = valueOffset + header.valueSize;
+    }
+
+#if defined(ANGLE_PLATFORM_POSIX)
+    if (offset < mFileSize)
+    {
+        // The last append didn't complete.  Drop it so new records are appended after the last
+        // valid one.
+        WARN() << "Discarding " << (mFileSize - offset)
+               << " bytes of incomplete records from the blob cache file " << mPath;
+        if (ftruncate(mFile, static_cast<off_t>(offset)) != 0)
+        {
+            return false;
+        }
+        mFileSize = offset;
+    }
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+
+    return true;
+}
+
+bool BlobCacheDiskStore::appendRecord(const BlobCacheKey &key,
+                                      const uint8_t *value,
+                                      size_t valueSize)
+{
+#if defined(ANGLE_PLATFORM_POSIX)
+    RecordHeader header;
+    header.magic          = kRecordMagic;
+    header.valueSize      = static_cast<uint32_t>(valueSize);
+    header.valueChecksum  = ComputeChecksum(value, valueSize);
+    header.key            = key;
+    header.headerChecksum = ComputeHeaderChecksum(header);
+
+    if (!WriteAll(mFile, &header, sizeof(header), mFileSize) ||
+        !WriteAll(mFile, value, valueSize, mFileSize + sizeof(header)))
+    {
+        WARN() << "Failed to write to the blob cache file " << mPath;
+
+        // Don't leave a partial record behind, it would hide the records appended after it.
+        if (ftruncate(mFile, static_cast<off_t>(mFileSize)) != 0)
+        {
+            close();
+        }
+        return false;
+    }
+
+    mFileSize += GetRecordSize(valueSize);
+    return true;
+#else
+    return false;
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+}
+
+void BlobCacheDiskStore::compact()
+{
+#if defined(ANGLE_PLATFORM_POSIX)
+    if (mMappedSize < mFileSize)
+    {
+        unmapFile();
+        if (!mapFile())
+        {
+            return;
+        }
+    }
+
+    // Keep the most recently used entries that fit in half the maximum size, so the next few puts
+    // don't trigger another compaction.
+    std::vector<std::pair<BlobCacheKey, IndexEntry>> entries(mIndex.begin(), mIndex.end());
+    std::sort(entries.begin(), entries.end(),
+              [](const auto &a, const auto &b) { return a.second.lastUse > b.second.lastUse; });
+
+    size_t keptSize  = sizeof(FileHeader);
+    size_t keptCount = 0;
+    while (keptCount < entries.size() &&
+           keptSize + GetRecordSize(entries[keptCount].second.size) <= mMaxSize / 2)
+    {
+        keptSize += GetRecordSize(entries[keptCount].second.size);
+        ++keptCount;
+    }
+    entries.resize(keptCount);
+
+    // Write the oldest entries first, so the order of the records matches their recency the next
+    // time the file is opened.
+    std::reverse(entries.begin(), entries.end());
+
+    const std::string compactedPath = mPath + ".compact";
+    int compactedFile =
+        ::open(compactedPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (compactedFile == kInvalidFile)
+    {
+        WARN() << "Failed to create " << compactedPath;
+        return;
+    }
+
+    bool success  = flock(compactedFile, LOCK_EX | LOCK_NB) == 0 && WriteFileHeader(compactedFile);
+    size_t offset = sizeof(FileHeader);
+    for (auto &entry : entries)
+    {
+        const size_t recordSize    = GetRecordSize(entry.second.size);
+        const uint8_t *recordStart = mMapping + entry.second.offset - sizeof(RecordHeader);
+        success = success && WriteAll(compactedFile, recordStart, recordSize, offset);
+
+        entry.second.offset = offset + sizeof(RecordHeader);
+        offset += recordSize;
+    }
+
+    // Make sure the data reaches the disk before it replaces the old file.
+    success = success && fsync(compactedFile) == 0 &&
+              rename(compactedPath.c_str(), mPath.c_str()) == 0;
+    if (!success)
+    {
+        WARN() << "Failed to compact the blob cache file " << mPath;
+        ::close(compactedFile);
+        unlink(compactedPath.c_str());
+        return;
+    }
+
+    unmapFile();
+    ::close(mFile);
+    mFile     = compactedFile;
+    mFileSize = offset;
+
+    mIndex.clear();
+    mIndex.insert(entries.begin(), entries.end());
+
+    if (!mapFile())
+    {
+        close();
+    }
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+}
+
+}  // namespace egl
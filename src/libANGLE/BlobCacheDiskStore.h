@@ -0,0 +1,89 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BlobCacheDiskStore: Persists the blobs of a BlobCache in a single append-only file, so they
+//   survive process restarts without the application providing EGL_ANDROID_blob_cache callbacks.
+
+#ifndef LIBANGLE_BLOB_CACHE_DISK_STORE_H_
+#define LIBANGLE_BLOB_CACHE_DISK_STORE_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "common/MemoryBuffer.h"
+#include "libANGLE/BlobCache.h"
+
+namespace egl
+{
+// The file starts with a small header followed by records, each made of a record header holding
+// the key, the value size and checksums, followed by the value.  Records are only ever appended;
+// a later record for a key supersedes earlier ones and a record with an empty value removes the
+// key.  The file is memory-mapped when opened and only the record headers are read to build the
+// in-memory index, so values are not paged in until they are looked up.
+//
+// A record that is cut short by a crash during an append fails its checksums and is discarded,
+// along with everything after it, the next time the file is opened.  Once the file grows past its
+// maximum size, it is compacted by writing the most recently used entries to a new file that is
+// then renamed over the old one, so a crash during compaction leaves the old file untouched.
+//
+// The file is locked while it is open, and a second process trying to open it fails to do so.
+// Only POSIX platforms are supported; open() always fails elsewhere.
+class BlobCacheDiskStore final : angle::NonCopyable
+{
+  public:
+    BlobCacheDiskStore();
+    ~BlobCacheDiskStore();
+
+    // Opens the store at |path|, creating it if it doesn't exist.  Returns false if the file can't
+    // be created, mapped or locked.
+    bool open(const std::string &path, size_t maxSizeBytes);
+    void close();
+    bool isOpen() const { return mFile != kInvalidFile; }
+
+    // Copies the value of |key| to |valueOut|.  Returns false if the key is not found or if its
+    // record is corrupt, in which case the key is dropped.
+    bool get(const BlobCacheKey &key, angle::MemoryBuffer *valueOut);
+    void put(const BlobCacheKey &key, const uint8_t *value, size_t valueSize);
+    void remove(const BlobCacheKey &key);
+
+    size_t entryCount() const { return mIndex.size(); }
+    // The size of the file, including superseded records that are not compacted yet.
+    size_t fileSize() const { return mFileSize; }
+
+  private:
+    static constexpr int kInvalidFile = -1;
+
+    struct IndexEntry
+    {
+        // Offset of the value in the file.
+        size_t offset;
+        size_t size;
+        // Serial of the last put or get of the entry, used to keep the most recently used entries
+        // when compacting.
+        uint64_t lastUse;
+    };
+
+    bool openFile();
+    bool mapFile();
+    void unmapFile();
+    bool loadIndex();
+    bool appendRecord(const BlobCacheKey &key, const uint8_t *value, size_t valueSize);
+    void compact();
+
+    std::string mPath;
+    size_t mMaxSize;
+
+    int mFile;
+    uint8_t *mMapping;
+    size_t mMappedSize;
+    size_t mFileSize;
+
+    std::unordered_map<BlobCacheKey, IndexEntry> mIndex;
+    uint64_t mUseSerial;
+};
+
+}  // namespace egl
+
+#endif  // LIBANGLE_BLOB_CACHE_DISK_STORE_H_
@@ -6,14 +6,22 @@
 // BlobCache_unittest.h: Unit tests for the blob cache.
 
 #include <gtest/gtest.h>
+#include <thread>
 
+#include "common/system_utils.h"
 #include "libANGLE/BlobCache.h"
+#include "libANGLE/BlobCacheDiskStore.h"
+#include "util/test_utils.h"
+
+#if defined(ANGLE_PLATFORM_POSIX)
+#    include <unistd.h>
+#endif  // defined(ANGLE_PLATFORM_POSIX)
 
 namespace egl
 {
 
 // Note: this is fairly similar to SizedMRUCache_unittest, and makes sure the
-// BlobCache usage of SizedMRUCache is not broken.
+// BlobCache eviction behaves like SizedMRUCache.
 
 using BlobPut = angle::MemoryBuffer;
 using Blob    = BlobCache::Value;
@@ -131,4 +139,368 @@ TEST(BlobCacheTest, OversizeValue)
     EXPECT_FALSE(blobCache.get(nullptr, MakeKey(5), &qvalue, &blobSize));
 }
 
+// Test that the least recently used value is evicted first, even when the values are stored in
+// different shards.
+TEST(BlobCacheTest, LeastRecentlyUsedAcrossShards)
+{
+    constexpr size_t kSize = 32;
+    BlobCache blobCache(kSize);
+
+    // The keys all start with a different byte, so they are in different shards.
+    for (uint8_t value = 0; value < 4; ++value)
+    {
+        blobCache.populate(MakeKey(value), MakeBlob(kSize / 4, value));
+    }
+
+    // Use the oldest value, so the second one becomes the least recently used.
+    Blob qvalue;
+    size_t blobSize;
+    EXPECT_TRUE(blobCache.get(nullptr, MakeKey(0), &qvalue, &blobSize));
+
+    blobCache.populate(MakeKey(4), MakeBlob(kSize / 4, 4));
+    EXPECT_EQ(kSize, blobCache.size());
+    EXPECT_EQ(4u, blobCache.entryCount());
+    EXPECT_TRUE(blobCache.get(nullptr, MakeKey(0), &qvalue, &blobSize));
+    EXPECT_FALSE(blobCache.get(nullptr, MakeKey(1), &qvalue, &blobSize));
+    EXPECT_TRUE(blobCache.get(nullptr, MakeKey(2), &qvalue, &blobSize));
+
+    // Trimming also evicts in the order of use.
+    EXPECT_EQ(kSize / 4, blobCache.trim(kSize - kSize / 4));
+    EXPECT_FALSE(blobCache.get(nullptr, MakeKey(3), &qvalue, &blobSize));
+    EXPECT_TRUE(blobCache.get(nullptr, MakeKey(4), &qvalue, &blobSize));
+}
+
+// Test that a value returned by get() stays valid after its entry is replaced or evicted.
+TEST(BlobCacheTest, ValueOutlivesEntry)
+{
+    constexpr size_t kSize = 32;
+    BlobCache blobCache(kSize);
+
+    blobCache.populate(MakeKey(0), MakeBlob(kSize, 0));
+
+    Blob qvalue;
+    size_t blobSize;
+    ASSERT_TRUE(blobCache.get(nullptr, MakeKey(0), &qvalue, &blobSize));
+
+    // Replace the entry, then evict it.
+    blobCache.populate(MakeKey(0), MakeBlob(kSize, 100));
+    blobCache.populate(MakeKey(1), MakeBlob(kSize, 200));
+    EXPECT_EQ(1u, blobCache.entryCount());
+
+    ASSERT_EQ(kSize, qvalue.size());
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        EXPECT_EQ(i, qvalue[i]);
+    }
+}
+
+// Test that values are intact when several threads look up and replace them concurrently, and
+// that the cache stays within its size.
+TEST(BlobCacheTest, ConcurrentGetAndPut)
+{
+    constexpr size_t kThreadCount = 8;
+    constexpr size_t kKeyCount    = 64;
+    constexpr size_t kValueSize   = 200;
+    constexpr size_t kIterations  = 2000;
+
+    // Holds about half of the values, so that lookups and evictions race with each other.
+    BlobCache blobCache(kKeyCount / 2 * kValueSize);
+
+    std::vector<std::thread> threads;
+    for (size_t threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex]() {
+            for (size_t iteration = 0; iteration < kIterations; ++iteration)
+            {
+                const uint8_t value =
+                    static_cast<uint8_t>((iteration * 7 + threadIndex) % kKeyCount);
+                const Key key = MakeKey(value);
+
+                if (iteration % 4 == threadIndex % 4)
+                {
+                    ASSERT_TRUE(
+                        blobCache.compressAndPut(key, MakeBlob(kValueSize, value), nullptr));
+                    continue;
+                }
+
+                angle::MemoryBuffer uncompressed;
+                BlobCache::GetAndDecompressResult result =
+                    blobCache.getAndDecompress(nullptr, key, &uncompressed);
+                ASSERT_NE(BlobCache::GetAndDecompressResult::DecompressFailure, result);
+                if (result == BlobCache::GetAndDecompressResult::GetSuccess)
+                {
+                    ASSERT_EQ(kValueSize, uncompressed.size());
+                    EXPECT_EQ(value, uncompressed[0]);
+                    EXPECT_EQ(static_cast<uint8_t>(value + kValueSize - 1),
+                              uncompressed[kValueSize - 1]);
+                }
+            }
+        });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_LE(blobCache.size(), blobCache.maxSize());
+    EXPECT_GT(blobCache.entryCount(), 0u);
+}
+
+void ExpectEqualBlobs(const angle::MemoryBuffer &expected, const angle::MemoryBuffer &actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    if (expected.size() > 0)
+    {
+        EXPECT_EQ(0, memcmp(expected.data(), actual.data(), expected.size()));
+    }
+}
+
+// Test that blobs compressed with every codec decompress to the original data.
+TEST(BlobCacheTest, CodecRoundTrip)
+{
+    for (BlobCacheCodec codec : {BlobCacheCodec::Gzip, BlobCacheCodec::Uncompressed})
+    {
+        for (size_t size : {1, 200, 4096})
+        {
+            // Repeat a short sequence, so the data is compressible.
+            BlobPut original;
+            ASSERT_TRUE(original.resize(size));
+            for (size_t index = 0; index < size; ++index)
+            {
+                original[index] = static_cast<uint8_t>(index % 16);
+            }
+
+            angle::MemoryBuffer compressed;
+            ASSERT_TRUE(
+                CompressBlobCacheData(codec, original.size(), original.data(), &compressed));
+            if (codec == BlobCacheCodec::Gzip && size == 4096)
+            {
+                EXPECT_LT(compressed.size(), size);
+            }
+
+            angle::MemoryBuffer uncompressed;
+            ASSERT_TRUE(
+                DecompressBlobCacheData(compressed.data(), compressed.size(), &uncompressed));
+            ExpectEqualBlobs(original, uncompressed);
+        }
+    }
+}
+
+// Test that gzip streams without the codec header, as written by previous versions, are still
+// decompressed.
+TEST(BlobCacheTest, DecompressWithoutCodecHeader)
+{
+    BlobPut original = MakeBlob(200);
+
+    angle::MemoryBuffer compressed;
+    ASSERT_TRUE(
+        CompressBlobCacheData(BlobCacheCodec::Gzip, original.size(), original.data(), &compressed));
+
+    // Strip the header, leaving the gzip stream.
+    constexpr size_t kHeaderSize = 16;
+    angle::MemoryBuffer uncompressed;
+    ASSERT_TRUE(DecompressBlobCacheData(compressed.data() + kHeaderSize,
+                                        compressed.size() - kHeaderSize, &uncompressed));
+    ExpectEqualBlobs(original, uncompressed);
+}
+
+// Test that corrupt uncompressed blobs and blobs with an unknown codec are rejected.
+TEST(BlobCacheTest, DecompressRejectsBadBlobs)
+{
+    BlobPut original = MakeBlob(200);
+
+    angle::MemoryBuffer compressed;
+    ASSERT_TRUE(CompressBlobCacheData(BlobCacheCodec::Uncompressed, original.size(),
+                                      original.data(), &compressed));
+
+    angle::MemoryBuffer uncompressed;
+    compressed[compressed.size() - 1] ^= 1;
+    EXPECT_FALSE(DecompressBlobCacheData(compressed.data(), compressed.size(), &uncompressed));
+    compressed[compressed.size() - 1] ^= 1;
+    EXPECT_TRUE(DecompressBlobCacheData(compressed.data(), compressed.size(), &uncompressed));
+
+    // The codec is the byte after the magic.
+    compressed[4] = 0xFF;
+    EXPECT_FALSE(DecompressBlobCacheData(compressed.data(), compressed.size(), &uncompressed));
+}
+
+// Test that the cache compresses with the codec it's set to use.
+TEST(BlobCacheTest, CompressAndPutWithCodec)
+{
+    BlobCache blobCache(1024);
+    blobCache.setCodec(BlobCacheCodec::Uncompressed);
+
+    size_t compressedSize = 0;
+    ASSERT_TRUE(blobCache.compressAndPut(MakeKey(0), MakeBlob(200), &compressedSize));
+    EXPECT_GT(compressedSize, 200u);
+
+    angle::MemoryBuffer uncompressed;
+    ASSERT_EQ(BlobCache::GetAndDecompressResult::GetSuccess,
+              blobCache.getAndDecompress(nullptr, MakeKey(0), &uncompressed));
+    ExpectEqualBlobs(MakeBlob(200), uncompressed);
+}
+
+#if defined(ANGLE_PLATFORM_POSIX)
+class BlobCacheDiskStoreTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        Optional<std::string> path = angle::CreateTemporaryFile();
+        ASSERT_TRUE(path.valid());
+        mPath = path.value();
+    }
+
+    void TearDown() override
+    {
+        angle::DeleteSystemFile(mPath.c_str());
+        angle::DeleteSystemFile((mPath + ".compact").c_str());
+    }
+
+    void expectValue(BlobCacheDiskStore *store, const Key &key, size_t size, uint8_t start)
+    {
+        angle::MemoryBuffer value;
+        ASSERT_TRUE(store->get(key, &value));
+        ASSERT_EQ(size, value.size());
+        EXPECT_EQ(start, value[0]);
+        EXPECT_EQ(static_cast<uint8_t>(start + size - 1), value[size - 1]);
+    }
+
+    std::string mPath;
+};
+
+// Test that blobs put in a BlobCache are found by another one using the same file.
+TEST_F(BlobCacheDiskStoreTest, PersistsAcrossCaches)
+{
+    {
+        BlobCache blobCache(1024);
+        ASSERT_TRUE(blobCache.openDiskStore(mPath, 4096));
+        blobCache.put(MakeKey(0), MakeBlob(100, 1));
+        blobCache.put(MakeKey(1), MakeBlob(200, 2));
+        blobCache.remove(MakeKey(1));
+    }
+
+    BlobCache blobCache(1024);
+    ASSERT_TRUE(blobCache.openDiskStore(mPath, 4096));
+    EXPECT_TRUE(blobCache.empty());
+
+    Blob blob;
+    size_t blobSize;
+    ASSERT_TRUE(blobCache.get(nullptr, MakeKey(0), &blob, &blobSize));
+    EXPECT_EQ(100u, blobSize);
+    EXPECT_EQ(1u, blob[0]);
+    EXPECT_EQ(100u, blob[99]);
+
+    // The blob is now in memory too.
+    EXPECT_EQ(1u, blobCache.entryCount());
+
+    EXPECT_FALSE(blobCache.get(nullptr, MakeKey(1), &blob, &blobSize));
+}
+
+// Test that the file can't be used by two stores at the same time.
+TEST_F(BlobCacheDiskStoreTest, Exclusive)
+{
+    BlobCacheDiskStore store;
+    ASSERT_TRUE(store.open(mPath, 4096));
+
+    BlobCacheDiskStore otherStore;
+    EXPECT_FALSE(otherStore.open(mPath, 4096));
+
+    store.close();
+    EXPECT_TRUE(otherStore.open(mPath, 4096));
+}
+
+// Test that a record cut short, like by a crash during an append, is discarded along with nothing
+// else, and that records appended afterwards are found.
+TEST_F(BlobCacheDiskStoreTest, TruncatedRecord)
+{
+    size_t completeSize = 0;
+    {
+        BlobCacheDiskStore store;
+        ASSERT_TRUE(store.open(mPath, 4096));
+        store.put(MakeKey(0), MakeBlob(100, 1).data(), 100);
+        completeSize = store.fileSize();
+        store.put(MakeKey(1), MakeBlob(100, 2).data(), 100);
+    }
+
+    ASSERT_EQ(0, truncate(mPath.c_str(), completeSize + 50));
+
+    {
+        BlobCacheDiskStore store;
+        ASSERT_TRUE(store.open(mPath, 4096));
+        EXPECT_EQ(1u, store.entryCount());
+        EXPECT_EQ(completeSize, store.fileSize());
+        expectValue(&store, MakeKey(0), 100, 1);
+
+        angle::MemoryBuffer value;
+        EXPECT_FALSE(store.get(MakeKey(1), &value));
+
+        store.put(MakeKey(2), MakeBlob(100, 3).data(), 100);
+    }
+
+    BlobCacheDiskStore store;
+    ASSERT_TRUE(store.open(mPath, 4096));
+    EXPECT_EQ(2u, store.entryCount());
+    expectValue(&store, MakeKey(0), 100, 1);
+    expectValue(&store, MakeKey(2), 100, 3);
+}
+
+// Test that a value whose data is corrupt is not returned.
+TEST_F(BlobCacheDiskStoreTest, CorruptValue)
+{
+    BlobCacheDiskStore store;
+    ASSERT_TRUE(store.open(mPath, 4096));
+    store.put(MakeKey(0), MakeBlob(100, 1).data(), 100);
+    store.close();
+
+    // Flip the last byte of the value.
+    {
+        FILE *file = fopen(mPath.c_str(), "r+b");
+        ASSERT_NE(nullptr, file);
+        ASSERT_EQ(0, fseek(file, -1, SEEK_END));
+        fputc(0, file);
+        fclose(file);
+    }
+
+    ASSERT_TRUE(store.open(mPath, 4096));
+    EXPECT_EQ(1u, store.entryCount());
+
+    angle::MemoryBuffer value;
+    EXPECT_FALSE(store.get(MakeKey(0), &value));
+    EXPECT_EQ(0u, store.entryCount());
+}
+
+// Test that the file stays within its size limit, keeping the most recently used values.
+TEST_F(BlobCacheDiskStoreTest, Compaction)
+{
+    constexpr size_t kMaxSize   = 4096;
+    constexpr size_t kValueSize = 100;
+
+    BlobCacheDiskStore store;
+    ASSERT_TRUE(store.open(mPath, kMaxSize));
+
+    // Keep using the first value so it survives the compactions.
+    store.put(MakeKey(0), MakeBlob(kValueSize, 0).data(), kValueSize);
+    for (uint8_t key = 1; key < 200; ++key)
+    {
+        store.put(MakeKey(key), MakeBlob(kValueSize, key).data(), kValueSize);
+        EXPECT_LE(store.fileSize(), kMaxSize);
+        expectValue(&store, MakeKey(0), kValueSize, 0);
+    }
+
+    angle::MemoryBuffer value;
+    EXPECT_FALSE(store.get(MakeKey(1), &value));
+    expectValue(&store, MakeKey(199), kValueSize, 199);
+
+    // The compacted file is found again after reopening.
+    const size_t entryCount = store.entryCount();
+    store.close();
+    ASSERT_TRUE(store.open(mPath, kMaxSize));
+    EXPECT_EQ(entryCount, store.entryCount());
+    expectValue(&store, MakeKey(0), kValueSize, 0);
+    expectValue(&store, MakeKey(199), kValueSize, 199);
+}
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+
 }  // namespace egl
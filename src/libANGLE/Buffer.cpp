@@ -37,7 +37,8 @@ BufferState::BufferState()
       mTransformFeedbackGenericBindingCount(0),
       mImmutable(GL_FALSE),
       mStorageExtUsageFlags(0),
-      mExternal(GL_FALSE)
+      mExternal(GL_FALSE),
+      mGeneration(0)
 {}
 
 BufferState::~BufferState() {}
@@ -142,8 +143,9 @@ angle::Result Buffer::bufferDataImpl(Context *context,
         angle::Result::Stop)
     {
         // If setData fails, the buffer contents are undefined. Set a zero size to indicate that.
-        mIndexRangeCache.clear();
+        mState.mIndexRangeCache.clear();
         mState.mSize = 0;
+        ++mState.mGeneration;
 
         // Notify when storage changes.
         onStateChange(angle::SubjectMessage::SubjectChanged);
@@ -153,7 +155,8 @@ angle::Result Buffer::bufferDataImpl(Context *context,
 
     bool wholeBuffer = size == mState.mSize;
 
-    mIndexRangeCache.clear();
+    mState.mIndexRangeCache.clear();
+    ++mState.mGeneration;
     mState.mUsage                = usage;
     mState.mSize                 = size;
     mState.mImmutable            = (usage == BufferUsage::InvalidEnum);
@@ -195,8 +198,9 @@ angle::Result Buffer::bufferExternalDataImpl(Context *context,
                                      BufferUsage::InvalidEnum, flags) == angle::Result::Stop)
     {
         // If setData fails, the buffer contents are undefined. Set a zero size to indicate that.
-        mIndexRangeCache.clear();
+        mState.mIndexRangeCache.clear();
         mState.mSize = 0;
+        ++mState.mGeneration;
 
         // Notify when storage changes.
         onStateChange(angle::SubjectMessage::SubjectChanged);
@@ -204,7 +208,8 @@ angle::Result Buffer::bufferExternalDataImpl(Context *context,
         return angle::Result::Stop;
     }
 
-    mIndexRangeCache.clear();
+    mState.mIndexRangeCache.clear();
+    ++mState.mGeneration;
     mState.mUsage                = BufferUsage::InvalidEnum;
     mState.mSize                 = size;
     mState.mImmutable            = GL_TRUE;
@@ -225,8 +230,9 @@ angle::Result Buffer::bufferSubData(const Context *context,
 {
     ANGLE_TRY(mImpl->setSubData(context, target, data, size, offset));
 
-    mIndexRangeCache.invalidateRange(static_cast<unsigned int>(offset),
-                                     static_cast<unsigned int>(size));
+    mState.mIndexRangeCache.invalidateRange(static_cast<unsigned int>(offset),
+                                            static_cast<unsigned int>(size));
+    ++mState.mGeneration;
 
     // Notify when data changes.
     onContentsChange();
@@ -243,8 +249,9 @@ angle::Result Buffer::copyBufferSubData(const Context *context,
     ANGLE_TRY(
         mImpl->copySubData(context, source->getImplementation(), sourceOffset, destOffset, size));
 
-    mIndexRangeCache.invalidateRange(static_cast<unsigned int>(destOffset),
-                                     static_cast<unsigned int>(size));
+    mState.mIndexRangeCache.invalidateRange(static_cast<unsigned int>(destOffset),
+                                            static_cast<unsigned int>(size));
+    ++mState.mGeneration;
 
     // Notify when data changes.
     onContentsChange();
@@ -266,7 +273,8 @@ angle::Result Buffer::map(const Context *context, GLenum access)
     mState.mMapLength   = mState.mSize;
     mState.mAccess      = access;
     mState.mAccessFlags = GL_MAP_WRITE_BIT;
-    mIndexRangeCache.clear();
+    mState.mIndexRangeCache.clear();
+    ++mState.mGeneration;
 
     // Notify when state changes.
     onStateChange(angle::SubjectMessage::SubjectMapped);
@@ -298,9 +306,10 @@ angle::Result Buffer::mapRange(const Context *context,
 
     if ((access & GL_MAP_WRITE_BIT) > 0)
     {
-        mIndexRangeCache.invalidateRange(static_cast<unsigned int>(offset),
-                                         static_cast<unsigned int>(length));
+        mState.mIndexRangeCache.invalidateRange(static_cast<unsigned int>(offset),
+                                                static_cast<unsigned int>(length));
     }
+    ++mState.mGeneration;
 
     // Notify when state changes.
     onStateChange(angle::SubjectMessage::SubjectMapped);
@@ -321,6 +330,7 @@ angle::Result Buffer::unmap(const Context *context, GLboolean *result)
     mState.mMapLength   = 0;
     mState.mAccess      = GL_WRITE_ONLY_OES;
     mState.mAccessFlags = 0;
+    ++mState.mGeneration;
 
     // Notify when data changes.
     onStateChange(angle::SubjectMessage::SubjectUnmapped);
@@ -330,7 +340,8 @@ angle::Result Buffer::unmap(const Context *context, GLboolean *result)
 
 void Buffer::onDataChanged()
 {
-    mIndexRangeCache.clear();
+    mState.mIndexRangeCache.clear();
+    ++mState.mGeneration;
 
     // Notify when data changes.
     onContentsChange();
@@ -345,7 +356,7 @@ angle::Result Buffer::getIndexRange(const gl::Context *context,
                                     bool primitiveRestartEnabled,
                                     IndexRange *outRange) const
 {
-    if (mIndexRangeCache.findRange(type, offset, count, primitiveRestartEnabled, outRange))
+    if (mState.mIndexRangeCache.findRange(type, offset, count, primitiveRestartEnabled, outRange))
     {
         return angle::Result::Continue;
     }
@@ -353,7 +364,7 @@ angle::Result Buffer::getIndexRange(const gl::Context *context,
     ANGLE_TRY(
         mImpl->getIndexRange(context, type, offset, count, primitiveRestartEnabled, outRange));
 
-    mIndexRangeCache.addRange(type, offset, count, primitiveRestartEnabled, *outRange);
+    mState.mIndexRangeCache.addRange(type, offset, count, primitiveRestartEnabled, *outRange);
 
     return angle::Result::Continue;
 }
@@ -48,6 +48,10 @@ class BufferState final : angle::NonCopyable
     bool isBoundForTransformFeedback() const { return mTransformFeedbackIndexedBindingCount != 0; }
     std::string getLabel() const { return mLabel; }
 
+    // For the back-ends that keep the contents of the buffer on the CPU to compute index ranges
+    // with IndexRangeCache::computeRange().
+    IndexRangeCache *getIndexRangeCache() const { return &mIndexRangeCache; }
+
   private:
     friend class Buffer;
 
@@ -67,6 +71,9 @@ class BufferState final : angle::NonCopyable
     GLboolean mImmutable;
     GLbitfield mStorageExtUsageFlags;
     GLboolean mExternal;
+    uint64_t mGeneration;
+
+    mutable IndexRangeCache mIndexRangeCache;
 };
 
 // Some Vertex Array Objects track buffer data updates.
@@ -152,6 +159,9 @@ class Buffer final : public RefCountObject<BufferID>,
     GLboolean isImmutable() const { return mState.mImmutable; }
     GLbitfield getStorageExtUsageFlags() const { return mState.mStorageExtUsageFlags; }
 
+    // Incremented whenever the size, contents or mapping of the buffer may have changed.
+    uint64_t getGeneration() const { return mState.mGeneration; }
+
     // Buffers are always initialized immediately when allocated
     InitState initState() const { return InitState::Initialized; }
 
@@ -210,7 +220,6 @@ class Buffer final : public RefCountObject<BufferID>,
     angle::ObserverBinding mImplObserver;
 
     angle::FastVector<ContentsObserver, angle::kMaxFixedObservers> mContentsObservers;
-    mutable IndexRangeCache mIndexRangeCache;
 };
 
 }  // namespace gl
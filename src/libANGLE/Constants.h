@@ -19,6 +19,11 @@ namespace gl
 // The binary cache is currently left disable by default, and the application can enable it.
 const size_t kDefaultMaxProgramCacheMemoryBytes = 0;
 
+// Limits used when the binary cache is persisted to the file named by ANGLE_BLOB_CACHE_FILE.  The
+// memory cache is enabled as well in that case, as blobs are loaded from the file into it.
+const size_t kDefaultMaxBlobCacheDiskBytes              = 64 * 1024 * 1024;
+const size_t kDefaultMaxProgramCacheMemoryBytesWithDisk = 8 * 1024 * 1024;
+
 enum
 {
     // Implementation upper limits, real maximums depend on the hardware
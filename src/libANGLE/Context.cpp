@@ -880,6 +880,7 @@ egl::Error Context::makeCurrent(egl::Display *display,
 {
     mDisplay = display;
 
+    const bool isFirstMakeCurrent = !mHasBeenCurrent;
     if (!mHasBeenCurrent)
     {
         initializeDefaultResources();
@@ -921,6 +922,13 @@ egl::Error Context::makeCurrent(egl::Display *display,
         return angle::ResultToEGL(implResult);
     }
 
+    // Build the GLES1 emulation programs the first draws are likely to need in the background,
+    // while the application sets up.
+    if (isFirstMakeCurrent && mGLES1Renderer)
+    {
+        ANGLE_TRY(angle::ResultToEGL(mGLES1Renderer->precompileCommonVariants(this, &mState)));
+    }
+
     return egl::NoError();
 }
 
@@ -7159,6 +7167,7 @@ void Context::compileShader(ShaderProgramID shader)
     {
         return;
     }
+    resolveProgramLinksUsingShader(shaderObject);
     shaderObject->compile(this);
 }
 
@@ -7660,6 +7669,7 @@ void Context::shaderBinary(GLsizei n,
 {
     Shader *shaderObject = getShader(*shaders);
     ASSERT(shaderObject != nullptr);
+    resolveProgramLinksUsingShader(shaderObject);
     ANGLE_CONTEXT_TRY(shaderObject->loadShaderBinary(this, binary, length));
 }
 
@@ -7668,7 +7678,7 @@ void Context::bindFragDataLocationIndexed(ShaderProgramID program,
                                           GLuint index,
                                           const char *name)
 {
-    Program *programObject = getProgramNoResolveLink(program);
+    Program *programObject = getProgramResolveLink(program);
     programObject->bindFragmentOutputLocation(colorNumber, name);
     programObject->bindFragmentOutputIndex(index, name);
 }
@@ -9656,16 +9666,6 @@ bool Context::isProgramPipelineGenerated(ProgramPipelineID pipeline) const
     return mState.mProgramPipelineManager->isHandleGenerated(pipeline);
 }
 
-bool Context::usingDisplayTextureShareGroup() const
-{
-    return mDisplayTextureShareGroup;
-}
-
-bool Context::usingDisplaySemaphoreShareGroup() const
-{
-    return mDisplaySemaphoreShareGroup;
-}
-
 GLenum Context::getConvertedRenderbufferFormat(GLenum internalformat) const
 {
     if (isWebGL() && mState.mClientVersion.major == 2 && internalformat == GL_DEPTH_STENCIL)
@@ -9705,7 +9705,12 @@ bool Context::isGLES1() const
 
 std::shared_ptr<angle::WorkerThreadPool> Context::getShaderCompileThreadPool() const
 {
-    if (mState.mExtensions.parallelShaderCompileKHR && mState.getMaxShaderCompilerThreads() > 0)
+    // GL_KHR_parallel_shader_compile is not exposed to GLES1 contexts, but the programs emulating
+    // GLES1 are still built in parallel if the back-end supports it.
+    const bool parallelShaderCompile =
+        mState.mExtensions.parallelShaderCompileKHR ||
+        (isGLES1() && mImplementation->getNativeExtensions().parallelShaderCompileKHR);
+    if (parallelShaderCompile && mState.getMaxShaderCompilerThreads() > 0)
     {
         return mDisplay->getMultiThreadPool();
     }
@@ -9851,6 +9856,25 @@ angle::Result Context::onProgramLink(Program *programObject)
     return angle::Result::Continue;
 }
 
+// Programs may link on a worker thread, reading the compiled state of their attached shaders.
+void Context::resolveProgramLinksUsingShader(const Shader *shader)
+{
+    // Shaders that are not attached to any program are the common case.
+    if (shader->getRefCount() == 0)
+    {
+        return;
+    }
+
+    for (const auto &program : mState.mShaderProgramManager->getProgramsForCaptureAndPerf())
+    {
+        Program *programObject = program.second;
+        if (programObject != nullptr && programObject->isLinkingWithShader(shader))
+        {
+            programObject->resolveLink(this);
+        }
+    }
+}
+
 egl::Error Context::setDefaultFramebuffer(egl::Surface *drawSurface, egl::Surface *readSurface)
 {
     ASSERT(mCurrentDrawSurface == nullptr);
@@ -9931,6 +9955,8 @@ void Context::onPreSwap()
 {
     // Dump frame capture if enabled.
     getShareGroup()->getFrameCaptureShared()->onEndFrame(this);
+
+    mImplementation->onPreSwap();
 }
 
 void Context::getTexImage(TextureTarget target,
@@ -10027,8 +10053,8 @@ void Context::getPerfMonitorCounterData(GLuint monitor,
                                         GLint *bytesWritten)
 {
     using namespace angle;
-    const PerfMonitorCounterGroups &perfMonitorGroups = mImplementation->getPerfMonitorCounters();
-    GLint byteCount                                   = 0;
+    const size_t groupCount = getPerfMonitorCounterGroupCount();
+    GLint byteCount         = 0;
     switch (pname)
     {
         case GL_PERFMON_RESULT_AVAILABLE_AMD:
@@ -10040,9 +10066,10 @@ void Context::getPerfMonitorCounterData(GLuint monitor,
         case GL_PERFMON_RESULT_SIZE_AMD:
         {
             GLuint resultSize = 0;
-            for (const PerfMonitorCounterGroup &group : perfMonitorGroups)
+            for (size_t groupIndex = 0; groupIndex < groupCount; ++groupIndex)
             {
-                resultSize += sizeof(PerfMonitorTriplet) * group.counters.size();
+                resultSize += sizeof(PerfMonitorTriplet) *
+                              getPerfMonitorCounterGroup(groupIndex).counters.size();
             }
             *data = resultSize;
             byteCount += sizeof(GLuint);
@@ -10053,10 +10080,10 @@ void Context::getPerfMonitorCounterData(GLuint monitor,
             PerfMonitorTriplet *resultsOut = reinterpret_cast<PerfMonitorTriplet *>(data);
             GLsizei maxResults             = dataSize / (3 * sizeof(GLuint));
             GLsizei resultCount            = 0;
-            for (size_t groupIndex = 0;
-                 groupIndex < perfMonitorGroups.size() && resultCount < maxResults; ++groupIndex)
+            for (size_t groupIndex = 0; groupIndex < groupCount && resultCount < maxResults;
+                 ++groupIndex)
             {
-                const PerfMonitorCounterGroup &group = perfMonitorGroups[groupIndex];
+                const PerfMonitorCounterGroup &group = getPerfMonitorCounterGroup(groupIndex);
                 for (size_t counterIndex = 0;
                      counterIndex < group.counters.size() && resultCount < maxResults;
                      ++counterIndex)
@@ -10084,9 +10111,8 @@ void Context::getPerfMonitorCounterData(GLuint monitor,
 void Context::getPerfMonitorCounterInfo(GLuint group, GLuint counter, GLenum pname, void *data)
 {
     using namespace angle;
-    const PerfMonitorCounterGroups &perfMonitorGroups = mImplementation->getPerfMonitorCounters();
-    ASSERT(group < perfMonitorGroups.size());
-    const PerfMonitorCounters &counters = perfMonitorGroups[group].counters;
+    ASSERT(group < getPerfMonitorCounterGroupCount());
+    const PerfMonitorCounters &counters = getPerfMonitorCounterGroup(group).counters;
     ASSERT(counter < counters.size());
 
     switch (pname)
@@ -10116,9 +10142,8 @@ void Context::getPerfMonitorCounterString(GLuint group,
                                           GLchar *counterString)
 {
     using namespace angle;
-    const PerfMonitorCounterGroups &perfMonitorGroups = mImplementation->getPerfMonitorCounters();
-    ASSERT(group < perfMonitorGroups.size());
-    const PerfMonitorCounters &counters = perfMonitorGroups[group].counters;
+    ASSERT(group < getPerfMonitorCounterGroupCount());
+    const PerfMonitorCounters &counters = getPerfMonitorCounterGroup(group).counters;
     ASSERT(counter < counters.size());
     GetPerfMonitorString(counters[counter].name, bufSize, length, counterString);
 }
@@ -10130,9 +10155,8 @@ void Context::getPerfMonitorCounters(GLuint group,
                                      GLuint *counters)
 {
     using namespace angle;
-    const PerfMonitorCounterGroups &perfMonitorGroups = mImplementation->getPerfMonitorCounters();
-    ASSERT(group < perfMonitorGroups.size());
-    const PerfMonitorCounters &groupCounters = perfMonitorGroups[group].counters;
+    ASSERT(group < getPerfMonitorCounterGroupCount());
+    const PerfMonitorCounters &groupCounters = getPerfMonitorCounterGroup(group).counters;
 
     if (numCounters)
     {
@@ -10160,23 +10184,20 @@ void Context::getPerfMonitorGroupString(GLuint group,
                                         GLchar *groupString)
 {
     using namespace angle;
-    const PerfMonitorCounterGroups &perfMonitorGroups = mImplementation->getPerfMonitorCounters();
-    ASSERT(group < perfMonitorGroups.size());
-    GetPerfMonitorString(perfMonitorGroups[group].name, bufSize, length, groupString);
+    ASSERT(group < getPerfMonitorCounterGroupCount());
+    GetPerfMonitorString(getPerfMonitorCounterGroup(group).name, bufSize, length, groupString);
 }
 
 void Context::getPerfMonitorGroups(GLint *numGroups, GLsizei groupsSize, GLuint *groups)
 {
-    using namespace angle;
-    const PerfMonitorCounterGroups &perfMonitorGroups = mImplementation->getPerfMonitorCounters();
+    const size_t groupCount = getPerfMonitorCounterGroupCount();
 
     if (numGroups)
     {
-        *numGroups = static_cast<GLint>(perfMonitorGroups.size());
+        *numGroups = static_cast<GLint>(groupCount);
     }
 
-    GLuint maxGroupIndex =
-        std::min<GLuint>(groupsSize, static_cast<GLuint>(perfMonitorGroups.size()));
+    GLuint maxGroupIndex = std::min<GLuint>(groupsSize, static_cast<GLuint>(groupCount));
     for (GLuint groupIndex = 0; groupIndex < maxGroupIndex; ++groupIndex)
     {
         groups[groupIndex] = groupIndex;
@@ -10190,9 +10211,50 @@ void Context::selectPerfMonitorCounters(GLuint monitor,
                                         GLuint *counterList)
 {}
 
-const angle::PerfMonitorCounterGroups &Context::getPerfMonitorCounterGroups() const
+size_t Context::getPerfMonitorCounterGroupCount() const
 {
-    return mImplementation->getPerfMonitorCounters();
+    return mImplementation->getPerfMonitorCounters().size() + 1;
+}
+
+const angle::PerfMonitorCounterGroup &Context::getPerfMonitorCounterGroup(size_t group) const
+{
+    const angle::PerfMonitorCounterGroups &backendGroups =
+        mImplementation->getPerfMonitorCounters();
+    if (group < backendGroups.size())
+    {
+        return backendGroups[group];
+    }
+    ASSERT(group == backendGroups.size());
+
+    // The "frontend" group is built on first use, after which only its values are updated.
+    if (mFrontendPerfMonitorCounters.counters.empty())
+    {
+        mFrontendPerfMonitorCounters.name = "frontend";
+
+#define ANGLE_ADD_PERF_MONITOR_COUNTER(COUNTER)                   \
+    {                                                             \
+        angle::PerfMonitorCounter counter;                        \
+        counter.name  = #COUNTER;                                 \
+        counter.value = 0;                                        \
+        mFrontendPerfMonitorCounters.counters.push_back(counter); \
+    }
+
+        ANGLE_FRONTEND_PERF_COUNTERS_X(ANGLE_ADD_PERF_MONITOR_COUNTER)
+
+#undef ANGLE_ADD_PERF_MONITOR_COUNTER
+    }
+
+    const angle::FrontendPerfCounters &perfCounters = mStateCache.getPerfCounters();
+    angle::PerfMonitorCounters &counters            = mFrontendPerfMonitorCounters.counters;
+
+#define ANGLE_UPDATE_PERF_MAP(COUNTER) \
+    angle::GetPerfMonitorCounter(counters, #COUNTER).value = perfCounters.COUNTER;
+
+    ANGLE_FRONTEND_PERF_COUNTERS_X(ANGLE_UPDATE_PERF_MAP)
+
+#undef ANGLE_UPDATE_PERF_MAP
+
+    return mFrontendPerfMonitorCounters;
 }
 
 void Context::drawPixelLocalStorageEXTEnable(GLsizei n,
@@ -10283,7 +10345,9 @@ StateCache::StateCache()
       mCachedBasicDrawElementsError(kInvalidPointer),
       mCachedProgramPipelineError(kInvalidPointer),
       mCachedTransformFeedbackActiveUnpaused(false),
-      mCachedCanDraw(false)
+      mCachedCanDraw(false),
+      mValidationSerial(1),
+      mPerfCounters{}
 {
     mCachedValidDrawModes.fill(false);
 }
@@ -10343,6 +10407,8 @@ void StateCache::updateVertexElementLimitsImpl(Context *context)
 {
     ASSERT(context->isBufferAccessValidationEnabled());
 
+    ++mValidationSerial;
+
     const VertexArray *vao = context->getState().getVertexArray();
 
     mCachedNonInstancedVertexElementLimit = std::numeric_limits<GLint64>::max();
@@ -10383,16 +10449,19 @@ void StateCache::updateVertexElementLimitsImpl(Context *context)
 void StateCache::updateBasicDrawStatesError()
 {
     mCachedBasicDrawStatesError = kInvalidPointer;
+    ++mValidationSerial;
 }
 
 void StateCache::updateProgramPipelineError()
 {
     mCachedProgramPipelineError = kInvalidPointer;
+    ++mValidationSerial;
 }
 
 void StateCache::updateBasicDrawElementsError()
 {
     mCachedBasicDrawElementsError = kInvalidPointer;
+    ++mValidationSerial;
 }
 
 intptr_t StateCache::getBasicDrawStatesErrorImpl(const Context *context) const
@@ -10557,6 +10626,8 @@ void StateCache::setValidDrawModes(bool pointsOK,
 
 void StateCache::updateValidDrawModes(Context *context)
 {
+    ++mValidationSerial;
+
     const State &state = context->getState();
 
     const ProgramExecutable *programExecutable = context->getState().getProgramExecutable();
@@ -10639,12 +10710,14 @@ void StateCache::updateValidDrawElementsTypes(Context *context)
         {DrawElementsType::UnsignedShort, true},
         {DrawElementsType::UnsignedInt, supportsUint},
     }};
+    ++mValidationSerial;
 }
 
 void StateCache::updateTransformFeedbackActiveUnpaused(Context *context)
 {
     TransformFeedback *xfb                 = context->getState().getCurrentTransformFeedback();
     mCachedTransformFeedbackActiveUnpaused = xfb && xfb->isActive() && !xfb->isPaused();
+    ++mValidationSerial;
 }
 
 void StateCache::updateVertexAttribTypesValidation(Context *context)
@@ -268,6 +268,51 @@ class StateCache final : angle::NonCopyable
     // 1. onProgramExecutableChange.
     bool getCanDraw() const { return mCachedCanDraw; }
 
+    // The last non-instanced DrawElements call that passed validation with an element array buffer
+    // bound.  Repeating it passes validation too as long as none of the caches above was updated
+    // and the element array buffer is of the same generation.  Every update of the caches used by
+    // draw validation increments mValidationSerial.
+    bool isLastValidatedDrawElements(PrimitiveMode mode,
+                                     GLsizei count,
+                                     DrawElementsType type,
+                                     const void *indices,
+                                     const Buffer *elementArrayBuffer,
+                                     uint64_t elementArrayBufferGeneration) const
+    {
+        const DrawElementsValidationKey &key = mLastValidatedDrawElements;
+        if (key.validationSerial == mValidationSerial && key.mode == mode && key.type == type &&
+            key.count == count && key.indices == indices &&
+            key.elementArrayBuffer == elementArrayBuffer &&
+            key.elementArrayBufferGeneration == elementArrayBufferGeneration)
+        {
+            ++mPerfCounters.drawValidationKeyHits;
+            return true;
+        }
+
+        ++mPerfCounters.drawValidationKeyMisses;
+        return false;
+    }
+
+    void onDrawElementsValidated(PrimitiveMode mode,
+                                 GLsizei count,
+                                 DrawElementsType type,
+                                 const void *indices,
+                                 const Buffer *elementArrayBuffer,
+                                 uint64_t elementArrayBufferGeneration) const
+    {
+        ASSERT(elementArrayBuffer);
+        DrawElementsValidationKey &key   = mLastValidatedDrawElements;
+        key.mode                         = mode;
+        key.type                         = type;
+        key.count                        = count;
+        key.indices                      = indices;
+        key.elementArrayBuffer           = elementArrayBuffer;
+        key.elementArrayBufferGeneration = elementArrayBufferGeneration;
+        key.validationSerial             = mValidationSerial;
+    }
+
+    const angle::FrontendPerfCounters &getPerfCounters() const { return mPerfCounters; }
+
     // State change notifications.
     void onVertexArrayBindingChange(Context *context);
     void onProgramExecutableChange(Context *context);
@@ -359,6 +404,21 @@ class StateCache final : angle::NonCopyable
         mCachedIntegerVertexAttribTypesValidation;
 
     bool mCachedCanDraw;
+
+    struct DrawElementsValidationKey
+    {
+        PrimitiveMode mode                    = PrimitiveMode::InvalidEnum;
+        DrawElementsType type                 = DrawElementsType::InvalidEnum;
+        GLsizei count                         = 0;
+        const void *indices                   = nullptr;
+        const Buffer *elementArrayBuffer      = nullptr;
+        uint64_t elementArrayBufferGeneration = 0;
+        uint64_t validationSerial             = 0;
+    };
+
+    uint64_t mValidationSerial;
+    mutable DrawElementsValidationKey mLastValidatedDrawElements;
+    mutable angle::FrontendPerfCounters mPerfCounters;
 };
 
 using VertexArrayMap       = ResourceMap<VertexArray, VertexArrayID>;
@@ -599,8 +659,8 @@ class Context final : public egl::LabeledObject, angle::NonCopyable, public angl
     bool isProgramPipelineGenerated(ProgramPipelineID pipeline) const;
     bool isQueryGenerated(QueryID query) const;
 
-    bool usingDisplayTextureShareGroup() const;
-    bool usingDisplaySemaphoreShareGroup() const;
+    bool usingDisplayTextureShareGroup() const { return mDisplayTextureShareGroup; }
+    bool usingDisplaySemaphoreShareGroup() const { return mDisplaySemaphoreShareGroup; }
 
     // Hack for the special WebGL 1 "DEPTH_STENCIL" internal format.
     GLenum getConvertedRenderbufferFormat(GLenum internalformat) const;
@@ -674,7 +734,9 @@ class Context final : public egl::LabeledObject, angle::NonCopyable, public angl
     // Needed by capture serialization logic that works with a "const" Context pointer.
     void finishImmutable() const;
 
-    const angle::PerfMonitorCounterGroups &getPerfMonitorCounterGroups() const;
+    // The back-end's counter groups, followed by the "frontend" group.
+    size_t getPerfMonitorCounterGroupCount() const;
+    const angle::PerfMonitorCounterGroup &getPerfMonitorCounterGroup(size_t group) const;
 
     // Enables GL_SHADER_PIXEL_LOCAL_STORAGE_EXT and polyfills load operations for
     // ANGLE_shader_pixel_local_storage using a fullscreen draw.
@@ -715,6 +777,7 @@ class Context final : public egl::LabeledObject, angle::NonCopyable, public angl
     TransformFeedback *checkTransformFeedbackAllocation(TransformFeedbackID transformFeedback);
 
     angle::Result onProgramLink(Program *programObject);
+    void resolveProgramLinksUsingShader(const Shader *shader);
 
     void detachBuffer(Buffer *buffer);
     void detachTexture(TextureID texture);
@@ -820,6 +883,8 @@ class Context final : public egl::LabeledObject, angle::NonCopyable, public angl
 
     StateCache mStateCache;
 
+    mutable angle::PerfMonitorCounterGroup mFrontendPerfMonitorCounters;
+
     State::DirtyBits mAllDirtyBits;
     State::ExtendedDirtyBits mAllExtendedDirtyBits;
     State::DirtyBits mTexImageDirtyBits;
@@ -611,6 +611,55 @@ static constexpr uint32_t kScratchBufferLifetime = 64u;
 
 }  // anonymous namespace
 
+// ScopedShareGroupLock
+ScopedShareGroupLock::ScopedShareGroupLock(const gl::Context *context) : mDisplay(nullptr)
+{
+#if defined(ANGLE_ENABLE_SHARE_GROUP_LOCK)
+    if (context != nullptr)
+    {
+        mDisplay = context->getDisplay();
+        lock(context->getShareGroup());
+    }
+#endif
+}
+
+ScopedShareGroupLock::ScopedShareGroupLock(const Display *display) : mDisplay(display)
+{
+#if defined(ANGLE_ENABLE_SHARE_GROUP_LOCK)
+    std::vector<ShareGroup *> shareGroups;
+    for (gl::Context *context : display->getState().contextSet)
+    {
+        shareGroups.push_back(context->getShareGroup());
+    }
+
+    // Always lock in the same order, so that two threads locking several share groups can't
+    // deadlock.
+    std::sort(shareGroups.begin(), shareGroups.end());
+    shareGroups.erase(std::unique(shareGroups.begin(), shareGroups.end()), shareGroups.end());
+
+    for (ShareGroup *shareGroup : shareGroups)
+    {
+        lock(shareGroup);
+    }
+#endif
+}
+
+ScopedShareGroupLock::~ScopedShareGroupLock()
+{
+    for (auto iter = mShareGroups.rbegin(); iter != mShareGroups.rend(); ++iter)
+    {
+        (*iter)->getMutex().unlock();
+        (*iter)->release(mDisplay);
+    }
+}
+
+void ScopedShareGroupLock::lock(ShareGroup *shareGroup)
+{
+    shareGroup->addRef();
+    shareGroup->getMutex().lock();
+    mShareGroups.push_back(shareGroup);
+}
+
 // ShareGroup
 ShareGroup::ShareGroup(rx::EGLImplFactory *factory)
     : mRefCount(1),
@@ -1005,6 +1054,16 @@ Error Display::initialize()
         mBlobCache.resize(1024 * 1024);
     }
 
+    // Persist the cache to disk if requested.  This is opt-in, for embedders that don't implement
+    // EGL_ANDROID_blob_cache, and has no effect once the application sets its own cache functions.
+    const std::string blobCacheFile = angle::GetEnvironmentVar("ANGLE_BLOB_CACHE_FILE");
+    if (!blobCacheFile.empty() && !mBlobCache.hasDiskStore() &&
+        mBlobCache.openDiskStore(blobCacheFile, gl::kDefaultMaxBlobCacheDiskBytes) &&
+        mBlobCache.maxSize() == 0)
+    {
+        mBlobCache.resize(gl::kDefaultMaxProgramCacheMemoryBytesWithDisk);
+    }
+
     setGlobalDebugAnnotator();
 
     gl::InitializeDebugMutexIfNeeded();
@@ -1052,6 +1111,10 @@ Error Display::initialize()
         initializeFrontendFeatures();
     }
 
+    mBlobCache.setCodec(mFrontendFeatures.uncompressedBlobCache.enabled
+                            ? BlobCacheCodec::Uncompressed
+                            : BlobCacheCodec::Gzip);
+
     mFeatures.clear();
     mFrontendFeatures.populateFeatureList(&mFeatures);
     mImplementation->populateFeatureList(&mFeatures);
@@ -1236,6 +1299,7 @@ Error Display::terminate(Thread *thread, TerminateReason terminateReason)
     mMemoryProgramCache.clear();
     mMemoryShaderCache.clear();
     mBlobCache.setBlobCacheFuncs(nullptr, nullptr);
+    mBlobCache.closeDiskStore();
 
     mSingleThreadPool.reset();
     mMultiThreadPool.reset();
@@ -1431,6 +1495,8 @@ Error Display::createImage(const gl::Context *context,
         ANGLE_TRY(restoreLostDevice());
     }
 
+    ScopedShareGroupLock shareGroupLock(context);
+
     egl::ImageSibling *sibling = nullptr;
     if (IsTextureTarget(target))
     {
@@ -1553,6 +1619,8 @@ Error Display::createContext(const Config *configuration,
         shaderCachePointer = nullptr;
     }
 
+    ScopedShareGroupLock shareGroupLock(shareContext);
+
     gl::Context *context = new gl::Context(
         this, configuration, shareContext, shareTextures, shareSemaphores, programCachePointer,
         shaderCachePointer, clientType, attribs, mDisplayExtensions, GetClientExtensions());
@@ -1590,6 +1658,8 @@ Error Display::createSync(const gl::Context *currentContext,
         ANGLE_TRY(restoreLostDevice());
     }
 
+    ScopedShareGroupLock shareGroupLock(currentContext);
+
     angle::UniqueObjectPointer<egl::Sync, Display> syncPtr(
         new Sync(mImplementation, id, type, attribs), this);
 
@@ -1618,6 +1688,8 @@ Error Display::makeCurrent(Thread *thread,
     bool contextChanged = context != previousContext;
     if (previousContext != nullptr && contextChanged)
     {
+        ScopedShareGroupLock shareGroupLock(previousContext);
+
         previousContext->release();
         thread->setCurrent(nullptr);
 
@@ -1637,6 +1709,8 @@ Error Display::makeCurrent(Thread *thread,
 
     if (context != nullptr)
     {
+        ScopedShareGroupLock shareGroupLock(context);
+
         ANGLE_TRY(context->makeCurrent(this, drawSurface, readSurface));
         if (contextChanged)
         {
@@ -1704,12 +1778,23 @@ Error Display::destroySurfaceImpl(Surface *surface, SurfaceSet *surfaces)
     ASSERT(iter != surfaces->end());
     mSurfaceHandleAllocator.release(surface->id().value);
     surfaces->erase(iter);
+
+    // Destroying a surface releases the texture bound to it, which may belong to any share group.
+    std::unique_ptr<ScopedShareGroupLock> shareGroupLock;
+    if (surface->getBoundTexture() != nullptr)
+    {
+        shareGroupLock = std::make_unique<ScopedShareGroupLock>(this);
+    }
+
     ANGLE_TRY(surface->onDestroy(this));
     return NoError();
 }
 
 void Display::destroyImageImpl(Image *image, ImageSet *images)
 {
+    // The source and targets of the image may be in any share group.
+    ScopedShareGroupLock shareGroupLock(this);
+
     auto iter = images->find(image);
     ASSERT(iter != images->end());
     mImageHandleAllocator.release(image->id().value);
@@ -1736,6 +1821,9 @@ Error Display::releaseContextImpl(gl::Context *context, ContextSet *contexts)
 {
     ASSERT(context->getRefCount() == 0);
 
+    // Declared before |unique_context|, so the lock is released after the context is deleted.
+    ScopedShareGroupLock shareGroupLock(context);
+
     // Use scoped_ptr to make sure the context is always freed.
     std::unique_ptr<gl::Context> unique_context(context);
     ASSERT(contexts->find(context) != contexts->end());
@@ -1835,6 +1923,9 @@ Error Display::destroyContext(Thread *thread, gl::Context *context)
 
 void Display::destroySyncImpl(Sync *sync, SyncSet *syncs)
 {
+    // The sync may reference the context that created it, from any share group.
+    ScopedShareGroupLock shareGroupLock(this);
+
     auto iter = syncs->find(sync);
     ASSERT(iter != syncs->end());
     mSyncHandleAllocator.release((*iter)->id().value);
@@ -100,6 +100,11 @@ class ShareGroup final : angle::NonCopyable
 
     size_t getShareGroupContextCount() const { return mContexts.size(); }
 
+    // With per-share-group locking (ANGLE_ENABLE_SHARE_GROUP_LOCK), serializes the GL calls of the
+    // contexts of the share group instead of the global mutex.  It is recursive like the global
+    // mutex, since callbacks may call back into GL.
+    std::recursive_mutex &getMutex() { return mMutex; }
+
   protected:
     ~ShareGroup();
 
@@ -113,6 +118,8 @@ class ShareGroup final : angle::NonCopyable
 
     // The list of contexts within the share group
     ContextSet mContexts;
+
+    std::recursive_mutex mMutex;
 };
 
 // Constant coded here as a reasonable limit.
@@ -448,6 +455,27 @@ class Display final : public LabeledObject,
     std::shared_ptr<angle::WorkerThreadPool> mMultiThreadPool;
 };
 
+// With per-share-group locking (ANGLE_ENABLE_SHARE_GROUP_LOCK), the GL calls of shared contexts are
+// serialized by the mutex of their share group rather than by the global mutex held by EGL calls,
+// so EGL calls that access the objects of a share group lock its mutex too.  The share groups are
+// kept alive until they are unlocked, in case their last context is destroyed meanwhile.
+class [[nodiscard]] ScopedShareGroupLock final : angle::NonCopyable
+{
+  public:
+    // Locks the share group of |context|, if any.
+    explicit ScopedShareGroupLock(const gl::Context *context);
+    // Locks the share groups of all the contexts of |display|, for the objects that can be used
+    // from any share group, such as images and the textures bound to surfaces.
+    explicit ScopedShareGroupLock(const Display *display);
+    ~ScopedShareGroupLock();
+
+  private:
+    void lock(ShareGroup *shareGroup);
+
+    const Display *mDisplay;
+    std::vector<ShareGroup *> mShareGroups;
+};
+
 }  // namespace egl
 
 #endif  // LIBANGLE_DISPLAY_H_
@@ -9,10 +9,13 @@
 #include "libANGLE/GLES1Renderer.h"
 
 #include <string.h>
+#include <algorithm>
 #include <iterator>
 #include <sstream>
+#include <utility>
 #include <vector>
 
+#include "common/WorkerThread.h"
 #include "common/hash_utils.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/Context.inl.h"
@@ -45,7 +48,15 @@ GLES1ShaderState::GLES1ShaderState()  = default;
 GLES1ShaderState::~GLES1ShaderState() = default;
 GLES1ShaderState::GLES1ShaderState(const GLES1ShaderState &other)
 {
-    memcpy(this, &other, sizeof(GLES1ShaderState));
+    memcpy(static_cast<void *>(this), &other, sizeof(GLES1ShaderState));
+}
+
+GLES1ShaderState &GLES1ShaderState::operator=(const GLES1ShaderState &other)
+{
+    // Copied along with the padding, like in the copy constructor, as the states are compared
+    // with memcmp.
+    memcpy(static_cast<void *>(this), &other, sizeof(GLES1ShaderState));
+    return *this;
 }
 
 bool operator==(const GLES1ShaderState &a, const GLES1ShaderState &b)
@@ -70,11 +81,16 @@ void GLES1Renderer::onDestroy(Context *context, State *state)
     {
         (void)state->setProgram(context, 0);
 
-        for (const auto &iter : mUberShaderState)
+        for (auto &iter : mUberShaderState)
+        {
+            destroyVariant(context, &iter.second);
+        }
+        if (mGenericUberShaderState)
         {
-            const GLES1UberShaderState &UberShaderState = iter.second;
-            mShaderPrograms->deleteProgram(context, {UberShaderState.programState.program});
+            destroyVariant(context, mGenericUberShaderState.get());
+            mGenericUberShaderState.reset();
         }
+        mUberShaderState.clear();
         mShaderPrograms->release(context);
         mShaderPrograms             = nullptr;
         mRendererProgramInitialized = false;
@@ -83,7 +99,7 @@ void GLES1Renderer::onDestroy(Context *context, State *state)
 
 GLES1Renderer::~GLES1Renderer() = default;
 
-angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context, State *glState)
+void GLES1Renderer::updateShaderState(PrimitiveMode mode, Context *context, State *glState)
 {
     GLES1State &gles1State = glState->gles1();
 
@@ -240,8 +256,18 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
         mShaderState.mGLES1StateEnabled[GLES1StateEnables::LogicOpThroughFramebufferFetch] =
             gles1State.mLogicOpEnabled;
     }
+}
 
-    // All the states set before this spot affect ubershader creation
+angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context, State *glState)
+{
+    GLES1State &gles1State = glState->gles1();
+
+    // All the states set by updateShaderState affect ubershader creation
+    updateShaderState(mode, context, glState);
+
+    const bool hasLogicOpANGLE     = context->getExtensions().logicOpANGLE;
+    const bool hasFramebufferFetch = context->getExtensions().shaderFramebufferFetchEXT ||
+                                     context->getExtensions().shaderFramebufferFetchNonCoherentEXT;
 
     ANGLE_TRY(initializeRendererProgram(context, glState));
 
@@ -624,11 +650,19 @@ angle::Result GLES1Renderer::compileShader(Context *context,
     Shader *shaderObject = getShader(shader);
     ANGLE_CHECK(context, shaderObject, "Missing shader object", GL_INVALID_OPERATION);
 
+    // The compilation may continue on a worker thread, see checkShaderCompiled.
     shaderObject->setSource(context, 1, &src, nullptr);
     shaderObject->compile(context);
 
     *shaderOut = shader;
 
+    return angle::Result::Continue;
+}
+
+angle::Result GLES1Renderer::checkShaderCompiled(Context *context, ShaderProgramID shader)
+{
+    Shader *shaderObject = getShader(shader);
+
     if (!shaderObject->isCompiled(context))
     {
         GLint infoLogLength = shaderObject->getInfoLogLength(context);
@@ -636,7 +670,7 @@ angle::Result GLES1Renderer::compileShader(Context *context,
         shaderObject->getInfoLog(context, infoLogLength - 1, nullptr, infoLog.data());
 
         ERR() << "Internal GLES 1 shader compile failed. Info log: " << infoLog.data();
-        ERR() << "Shader source:" << src;
+        ERR() << "Shader source:" << shaderObject->getSourceString();
         ANGLE_CHECK(context, false, "GLES1Renderer shader compile failed.", GL_INVALID_OPERATION);
         return angle::Result::Stop;
     }
@@ -645,7 +679,6 @@ angle::Result GLES1Renderer::compileShader(Context *context,
 }
 
 angle::Result GLES1Renderer::linkProgram(Context *context,
-                                         State *glState,
                                          ShaderProgramID vertexShader,
                                          ShaderProgramID fragmentShader,
                                          const angle::HashMap<GLint, std::string> &attribLocs,
@@ -668,10 +701,20 @@ angle::Result GLES1Renderer::linkProgram(Context *context,
         programObject->bindAttributeLocation(index, name.c_str());
     }
 
+    // The link may continue on a worker thread, see checkProgramLinked.  Either way, the program
+    // goes through the program cache, so it is loaded from there by later contexts.
     ANGLE_TRY(programObject->link(context));
-    programObject->resolveLink(context);
 
-    ANGLE_TRY(glState->onProgramExecutableChange(context, programObject));
+    return angle::Result::Continue;
+}
+
+angle::Result GLES1Renderer::checkProgramLinked(Context *context,
+                                                ShaderProgramID vertexShader,
+                                                ShaderProgramID fragmentShader,
+                                                ShaderProgramID program)
+{
+    Program *programObject = getProgram(program);
+    programObject->resolveLink(context);
 
     if (!programObject->isLinked())
     {
@@ -690,9 +733,10 @@ angle::Result GLES1Renderer::linkProgram(Context *context,
     return angle::Result::Continue;
 }
 
-const char *GLES1Renderer::getShaderBool(GLES1StateEnables state)
+const char *GLES1Renderer::getShaderBool(const GLES1ShaderState &shaderState,
+                                         GLES1StateEnables state)
 {
-    if (mShaderState.mGLES1StateEnabled[state])
+    if (shaderState.mGLES1StateEnabled[state])
     {
         return "true";
     }
@@ -703,11 +747,12 @@ const char *GLES1Renderer::getShaderBool(GLES1StateEnables state)
 }
 
 void GLES1Renderer::addShaderDefine(std::stringstream &outStream,
+                                    const GLES1ShaderState &shaderState,
                                     GLES1StateEnables state,
                                     const char *enableString)
 {
     outStream << "\n";
-    outStream << "#define " << enableString << " " << getShaderBool(state);
+    outStream << "#define " << enableString << " " << getShaderBool(shaderState, state);
 }
 
 void GLES1Renderer::addShaderUint(std::stringstream &outStream, const char *name, uint16_t value)
@@ -718,7 +763,7 @@ void GLES1Renderer::addShaderUint(std::stringstream &outStream, const char *name
 
 void GLES1Renderer::addShaderUintTexArray(std::stringstream &outStream,
                                           const char *texString,
-                                          GLES1ShaderState::UintTexArray &texState)
+                                          const GLES1ShaderState::UintTexArray &texState)
 {
     outStream << "\n";
     outStream << "const uint " << texString << "[kMaxTexUnits] = uint[kMaxTexUnits](";
@@ -735,7 +780,7 @@ void GLES1Renderer::addShaderUintTexArray(std::stringstream &outStream,
 
 void GLES1Renderer::addShaderBoolTexArray(std::stringstream &outStream,
                                           const char *name,
-                                          GLES1ShaderState::BoolTexArray &value)
+                                          const GLES1ShaderState::BoolTexArray &value)
 {
     outStream << std::boolalpha;
     outStream << "\n";
@@ -753,7 +798,7 @@ void GLES1Renderer::addShaderBoolTexArray(std::stringstream &outStream,
 
 void GLES1Renderer::addShaderBoolLightArray(std::stringstream &outStream,
                                             const char *name,
-                                            GLES1ShaderState::BoolLightArray &value)
+                                            const GLES1ShaderState::BoolLightArray &value)
 {
     outStream << std::boolalpha;
     outStream << "\n";
@@ -771,7 +816,7 @@ void GLES1Renderer::addShaderBoolLightArray(std::stringstream &outStream,
 
 void GLES1Renderer::addShaderBoolClipPlaneArray(std::stringstream &outStream,
                                                 const char *name,
-                                                GLES1ShaderState::BoolClipPlaneArray &value)
+                                                const GLES1ShaderState::BoolClipPlaneArray &value)
 {
     outStream << std::boolalpha;
     outStream << "\n";
@@ -787,157 +832,159 @@ void GLES1Renderer::addShaderBoolClipPlaneArray(std::stringstream &outStream,
     outStream << ");";
 }
 
-void GLES1Renderer::addVertexShaderDefs(std::stringstream &outStream)
+void GLES1Renderer::addVertexShaderDefs(std::stringstream &outStream,
+                                        const GLES1ShaderState &shaderState)
 {
-    addShaderDefine(outStream, GLES1StateEnables::Lighting, "enable_lighting");
-    addShaderDefine(outStream, GLES1StateEnables::ColorMaterial, "enable_color_material");
-    addShaderDefine(outStream, GLES1StateEnables::DrawTexture, "enable_draw_texture");
-    addShaderDefine(outStream, GLES1StateEnables::PointRasterization, "point_rasterization");
-    addShaderDefine(outStream, GLES1StateEnables::RescaleNormal, "enable_rescale_normal");
-    addShaderDefine(outStream, GLES1StateEnables::Normalize, "enable_normalize");
-    addShaderDefine(outStream, GLES1StateEnables::LightModelTwoSided, "light_model_two_sided");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::Lighting, "enable_lighting");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::ColorMaterial,
+                    "enable_color_material");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::DrawTexture, "enable_draw_texture");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::PointRasterization,
+                    "point_rasterization");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::RescaleNormal,
+                    "enable_rescale_normal");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::Normalize, "enable_normalize");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::LightModelTwoSided,
+                    "light_model_two_sided");
 
     // bool light_enables[kMaxLights] = bool[kMaxLights](...);
-    addShaderBoolLightArray(outStream, "light_enables", mShaderState.lightEnables);
+    addShaderBoolLightArray(outStream, "light_enables", shaderState.lightEnables);
 }
 
-void GLES1Renderer::addFragmentShaderDefs(std::stringstream &outStream)
+void GLES1Renderer::addFragmentShaderDefs(std::stringstream &outStream,
+                                          const GLES1ShaderState &shaderState)
 {
-    addShaderDefine(outStream, GLES1StateEnables::Fog, "enable_fog");
-    addShaderDefine(outStream, GLES1StateEnables::ClipPlanes, "enable_clip_planes");
-    addShaderDefine(outStream, GLES1StateEnables::DrawTexture, "enable_draw_texture");
-    addShaderDefine(outStream, GLES1StateEnables::PointRasterization, "point_rasterization");
-    addShaderDefine(outStream, GLES1StateEnables::PointSprite, "point_sprite_enabled");
-    addShaderDefine(outStream, GLES1StateEnables::AlphaTest, "enable_alpha_test");
-    addShaderDefine(outStream, GLES1StateEnables::ShadeModelFlat, "shade_model_flat");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::Fog, "enable_fog");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::ClipPlanes, "enable_clip_planes");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::DrawTexture, "enable_draw_texture");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::PointRasterization,
+                    "point_rasterization");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::PointSprite, "point_sprite_enabled");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::AlphaTest, "enable_alpha_test");
+    addShaderDefine(outStream, shaderState, GLES1StateEnables::ShadeModelFlat, "shade_model_flat");
 
     // bool enable_texture_2d[kMaxTexUnits] = bool[kMaxTexUnits](...);
-    addShaderBoolTexArray(outStream, "enable_texture_2d", mShaderState.tex2DEnables);
+    addShaderBoolTexArray(outStream, "enable_texture_2d", shaderState.tex2DEnables);
 
     // bool enable_texture_cube_map[kMaxTexUnits] = bool[kMaxTexUnits](...);
-    addShaderBoolTexArray(outStream, "enable_texture_cube_map", mShaderState.texCubeEnables);
+    addShaderBoolTexArray(outStream, "enable_texture_cube_map", shaderState.texCubeEnables);
 
     // int texture_format[kMaxTexUnits] = int[kMaxTexUnits](...);
-    addShaderUintTexArray(outStream, "texture_format", mShaderState.tex2DFormats);
+    addShaderUintTexArray(outStream, "texture_format", shaderState.tex2DFormats);
 
     // bool point_sprite_coord_replace[kMaxTexUnits] = bool[kMaxTexUnits](...);
     addShaderBoolTexArray(outStream, "point_sprite_coord_replace",
-                          mShaderState.pointSpriteCoordReplaces);
+                          shaderState.pointSpriteCoordReplaces);
 
     // bool clip_plane_enables[kMaxClipPlanes] = bool[kMaxClipPlanes](...);
-    addShaderBoolClipPlaneArray(outStream, "clip_plane_enables", mShaderState.clipPlaneEnables);
+    addShaderBoolClipPlaneArray(outStream, "clip_plane_enables", shaderState.clipPlaneEnables);
 
     // int texture_format[kMaxTexUnits] = int[kMaxTexUnits](...);
-    addShaderUintTexArray(outStream, "texture_env_mode", mShaderState.texEnvModes);
+    addShaderUintTexArray(outStream, "texture_env_mode", shaderState.texEnvModes);
 
     // int combine_rgb[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "combine_rgb", mShaderState.texCombineRgbs);
+    addShaderUintTexArray(outStream, "combine_rgb", shaderState.texCombineRgbs);
 
     // int combine_alpha[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "combine_alpha", mShaderState.texCombineAlphas);
+    addShaderUintTexArray(outStream, "combine_alpha", shaderState.texCombineAlphas);
 
     // int src0_rgb[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "src0_rgb", mShaderState.texCombineSrc0Rgbs);
+    addShaderUintTexArray(outStream, "src0_rgb", shaderState.texCombineSrc0Rgbs);
 
     // int src0_alpha[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "src0_alpha", mShaderState.texCombineSrc0Alphas);
+    addShaderUintTexArray(outStream, "src0_alpha", shaderState.texCombineSrc0Alphas);
 
     // int src1_rgb[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "src1_rgb", mShaderState.texCombineSrc1Rgbs);
+    addShaderUintTexArray(outStream, "src1_rgb", shaderState.texCombineSrc1Rgbs);
 
     // int src1_alpha[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "src1_alpha", mShaderState.texCombineSrc1Alphas);
+    addShaderUintTexArray(outStream, "src1_alpha", shaderState.texCombineSrc1Alphas);
 
     // int src2_rgb[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "src2_rgb", mShaderState.texCombineSrc2Rgbs);
+    addShaderUintTexArray(outStream, "src2_rgb", shaderState.texCombineSrc2Rgbs);
 
     // int src2_alpha[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "src2_alpha", mShaderState.texCombineSrc2Alphas);
+    addShaderUintTexArray(outStream, "src2_alpha", shaderState.texCombineSrc2Alphas);
 
     // int op0_rgb[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "op0_rgb", mShaderState.texCombineOp0Rgbs);
+    addShaderUintTexArray(outStream, "op0_rgb", shaderState.texCombineOp0Rgbs);
 
     // int op0_alpha[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "op0_alpha", mShaderState.texCombineOp0Alphas);
+    addShaderUintTexArray(outStream, "op0_alpha", shaderState.texCombineOp0Alphas);
 
     // int op1_rgb[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "op1_rgb", mShaderState.texCombineOp1Rgbs);
+    addShaderUintTexArray(outStream, "op1_rgb", shaderState.texCombineOp1Rgbs);
 
     // int op1_alpha[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "op1_alpha", mShaderState.texCombineOp1Alphas);
+    addShaderUintTexArray(outStream, "op1_alpha", shaderState.texCombineOp1Alphas);
 
     // int op2_rgb[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "op2_rgb", mShaderState.texCombineOp2Rgbs);
+    addShaderUintTexArray(outStream, "op2_rgb", shaderState.texCombineOp2Rgbs);
 
     // int op2_alpha[kMaxTexUnits];
-    addShaderUintTexArray(outStream, "op2_alpha", mShaderState.texCombineOp2Alphas);
+    addShaderUintTexArray(outStream, "op2_alpha", shaderState.texCombineOp2Alphas);
 
     // int alpha_func;
     addShaderUint(outStream, "alpha_func",
-                  static_cast<uint16_t>(ToGLenum(mShaderState.alphaTestFunc)));
+                  static_cast<uint16_t>(ToGLenum(shaderState.alphaTestFunc)));
 
     // int fog_mode;
-    addShaderUint(outStream, "fog_mode", static_cast<uint16_t>(ToGLenum(mShaderState.fogMode)));
+    addShaderUint(outStream, "fog_mode", static_cast<uint16_t>(ToGLenum(shaderState.fogMode)));
 }
 
-angle::Result GLES1Renderer::initializeRendererProgram(Context *context, State *glState)
+angle::Result GLES1Renderer::compileVariant(Context *context,
+                                            const GLES1ShaderState &shaderState,
+                                            bool isGenericVariant,
+                                            GLES1UberShaderState *variant)
 {
-    // See if we have the shader for this combination of states
-    if (mUberShaderState.find(mShaderState) != mUberShaderState.end())
+    // Set the count of texture units to a minimum (at least one for simplicity), to avoid requiring
+    // unnecessary vertex attributes and take up varying slots.  The generic variant may use them
+    // all.
+    uint32_t maxTexUnitsEnabled = isGenericVariant ? kTexUnitCount : 1;
+    for (int i = 0; i < kTexUnitCount; i++)
     {
-        Program *programObject = getProgram(getUberShaderState().programState.program);
-
-        // If this is different than the current program, we need to sync everything
-        // TODO: This could be optimized to only dirty state that differs between the two programs
-        if (glState->getProgram()->id() != programObject->id())
+        if (shaderState.texCubeEnables[i] || shaderState.tex2DEnables[i])
         {
-            glState->gles1().setAllDirty();
+            maxTexUnitsEnabled = std::max<uint32_t>(maxTexUnitsEnabled, i + 1);
         }
-
-        ANGLE_TRY(glState->setProgram(context, programObject));
-        return angle::Result::Continue;
     }
 
-    if (!mRendererProgramInitialized)
+    std::stringstream GLES1DrawVShaderStateDefs;
+    if (isGenericVariant)
     {
-        mShaderPrograms = new ShaderProgramManager();
+        GLES1DrawVShaderStateDefs << kGLES1DrawVShaderGenericStateUniforms;
     }
-
-    // If we get here, we don't have a shader for this state, need to create it
-    GLES1ProgramState &programState = mUberShaderState[mShaderState].programState;
-
-    ShaderProgramID vertexShader;
-    ShaderProgramID fragmentShader;
-
-    // Set the count of texture units to a minimum (at least one for simplicity), to avoid requiring
-    // unnecessary vertex attributes and take up varying slots.
-    uint32_t maxTexUnitsEnabled = 1;
-    for (int i = 0; i < kTexUnitCount; i++)
+    else
     {
-        if (mShaderState.texCubeEnables[i] || mShaderState.tex2DEnables[i])
-        {
-            maxTexUnitsEnabled = i + 1;
-        }
+        addVertexShaderDefs(GLES1DrawVShaderStateDefs, shaderState);
     }
 
-    std::stringstream GLES1DrawVShaderStateDefs;
-    addVertexShaderDefs(GLES1DrawVShaderStateDefs);
-
     std::stringstream vertexStream;
     vertexStream << kGLES1DrawVShaderHeader;
     vertexStream << kGLES1TexUnitsDefine << maxTexUnitsEnabled << "u\n";
     vertexStream << GLES1DrawVShaderStateDefs.str();
     vertexStream << kGLES1DrawVShader;
 
-    ANGLE_TRY(
-        compileShader(context, ShaderType::Vertex, vertexStream.str().c_str(), &vertexShader));
+    ANGLE_TRY(compileShader(context, ShaderType::Vertex, vertexStream.str().c_str(),
+                            &variant->vertexShader));
 
     std::stringstream GLES1DrawFShaderStateDefs;
-    addFragmentShaderDefs(GLES1DrawFShaderStateDefs);
+    if (isGenericVariant)
+    {
+        GLES1DrawFShaderStateDefs << kGLES1DrawFShaderGenericStateUniforms;
+    }
+    else
+    {
+        addFragmentShaderDefs(GLES1DrawFShaderStateDefs, shaderState);
+    }
+
+    const bool logicOpThroughFramebufferFetch =
+        shaderState.mGLES1StateEnabled[GLES1StateEnables::LogicOpThroughFramebufferFetch];
+    ASSERT(!isGenericVariant || !logicOpThroughFramebufferFetch);
 
     std::stringstream fragmentStream;
     fragmentStream << kGLES1DrawFShaderVersion;
-    if (mShaderState.mGLES1StateEnabled[GLES1StateEnables::LogicOpThroughFramebufferFetch])
+    if (logicOpThroughFramebufferFetch)
     {
         if (context->getExtensions().shaderFramebufferFetchEXT)
         {
@@ -952,7 +999,7 @@ angle::Result GLES1Renderer::initializeRendererProgram(Context *context, State *
     fragmentStream << kGLES1TexUnitsDefine << maxTexUnitsEnabled << "u\n";
     fragmentStream << GLES1DrawFShaderStateDefs.str();
     fragmentStream << kGLES1DrawFShaderUniformDefs;
-    if (mShaderState.mGLES1StateEnabled[GLES1StateEnables::LogicOpThroughFramebufferFetch])
+    if (logicOpThroughFramebufferFetch)
     {
         if (context->getExtensions().shaderFramebufferFetchEXT)
         {
@@ -974,34 +1021,84 @@ angle::Result GLES1Renderer::initializeRendererProgram(Context *context, State *
     fragmentStream << kGLES1DrawFShaderMain;
 
     ANGLE_TRY(compileShader(context, ShaderType::Fragment, fragmentStream.str().c_str(),
-                            &fragmentShader));
+                            &variant->fragmentShader));
 
-    angle::HashMap<GLint, std::string> attribLocs;
-
-    attribLocs[(GLint)kVertexAttribIndex]    = "pos";
-    attribLocs[(GLint)kNormalAttribIndex]    = "normal";
-    attribLocs[(GLint)kColorAttribIndex]     = "color";
-    attribLocs[(GLint)kPointSizeAttribIndex] = "pointsize";
+    variant->status = VariantStatus::Compiling;
+    return angle::Result::Continue;
+}
 
-    for (int i = 0; i < kTexUnitCount; i++)
+angle::Result GLES1Renderer::updateVariantStatus(Context *context,
+                                                 GLES1UberShaderState *variant,
+                                                 bool wait)
+{
+    if (variant->status == VariantStatus::Compiling)
     {
-        std::stringstream ss;
-        ss << "texcoord" << i;
-        attribLocs[kTextureCoordAttribIndexBase + i] = ss.str();
+        if (!wait && (!getShader(variant->vertexShader)->isCompleted() ||
+                      !getShader(variant->fragmentShader)->isCompleted()))
+        {
+            return angle::Result::Continue;
+        }
+
+        ANGLE_TRY(checkShaderCompiled(context, variant->vertexShader));
+        ANGLE_TRY(checkShaderCompiled(context, variant->fragmentShader));
+
+        angle::HashMap<GLint, std::string> attribLocs;
+
+        attribLocs[(GLint)kVertexAttribIndex]    = "pos";
+        attribLocs[(GLint)kNormalAttribIndex]    = "normal";
+        attribLocs[(GLint)kColorAttribIndex]     = "color";
+        attribLocs[(GLint)kPointSizeAttribIndex] = "pointsize";
+
+        for (int i = 0; i < kTexUnitCount; i++)
+        {
+            std::stringstream ss;
+            ss << "texcoord" << i;
+            attribLocs[kTextureCoordAttribIndexBase + i] = ss.str();
+        }
+
+        ANGLE_TRY(linkProgram(context, variant->vertexShader, variant->fragmentShader, attribLocs,
+                              &variant->programState.program));
+        variant->status = VariantStatus::Linking;
     }
 
-    ANGLE_TRY(linkProgram(context, glState, vertexShader, fragmentShader, attribLocs,
-                          &programState.program));
+    if (variant->status == VariantStatus::Linking)
+    {
+        Program *programObject = getProgram(variant->programState.program);
+        if (!wait && programObject->isLinking())
+        {
+            return angle::Result::Continue;
+        }
 
-    mShaderPrograms->deleteShader(context, vertexShader);
-    mShaderPrograms->deleteShader(context, fragmentShader);
+        ANGLE_TRY(checkProgramLinked(context, variant->vertexShader, variant->fragmentShader,
+                                     variant->programState.program));
 
-    Program *programObject = getProgram(programState.program);
+        mShaderPrograms->deleteShader(context, variant->vertexShader);
+        mShaderPrograms->deleteShader(context, variant->fragmentShader);
+        variant->vertexShader   = {};
+        variant->fragmentShader = {};
 
-    programState.projMatrixLoc      = programObject->getUniformLocation("projection");
-    programState.modelviewMatrixLoc = programObject->getUniformLocation("modelview");
-    programState.textureMatrixLoc   = programObject->getUniformLocation("texture_matrix");
-    programState.modelviewInvTrLoc  = programObject->getUniformLocation("modelview_invtr");
+        initializeProgramState(programObject, &variant->programState);
+
+        GLES1ProgramState &programState = variant->programState;
+        for (int i = 0; i < kTexUnitCount; i++)
+        {
+            setUniform1i(context, programObject, programState.tex2DSamplerLocs[i], i);
+            setUniform1i(context, programObject, programState.texCubeSamplerLocs[i],
+                         i + kTexUnitCount);
+        }
+
+        variant->status = VariantStatus::Ready;
+    }
+
+    return angle::Result::Continue;
+}
+
+void GLES1Renderer::initializeProgramState(Program *programObject, GLES1ProgramState *programState)
+{
+    programState->projMatrixLoc      = programObject->getUniformLocation("projection");
+    programState->modelviewMatrixLoc = programObject->getUniformLocation("modelview");
+    programState->textureMatrixLoc   = programObject->getUniformLocation("texture_matrix");
+    programState->modelviewInvTrLoc  = programObject->getUniformLocation("modelview_invtr");
 
     for (int i = 0; i < kTexUnitCount; i++)
     {
@@ -1011,78 +1108,253 @@ angle::Result GLES1Renderer::initializeRendererProgram(Context *context, State *
         ss2d << "tex_sampler" << i;
         sscube << "tex_cube_sampler" << i;
 
-        programState.tex2DSamplerLocs[i] = programObject->getUniformLocation(ss2d.str().c_str());
-        programState.texCubeSamplerLocs[i] =
+        programState->tex2DSamplerLocs[i] = programObject->getUniformLocation(ss2d.str().c_str());
+        programState->texCubeSamplerLocs[i] =
             programObject->getUniformLocation(sscube.str().c_str());
     }
 
-    programState.textureEnvColorLoc = programObject->getUniformLocation("texture_env_color");
-    programState.rgbScaleLoc        = programObject->getUniformLocation("texture_env_rgb_scale");
-    programState.alphaScaleLoc      = programObject->getUniformLocation("texture_env_alpha_scale");
+    programState->textureEnvColorLoc = programObject->getUniformLocation("texture_env_color");
+    programState->rgbScaleLoc        = programObject->getUniformLocation("texture_env_rgb_scale");
+    programState->alphaScaleLoc      = programObject->getUniformLocation("texture_env_alpha_scale");
 
-    programState.alphaTestRefLoc = programObject->getUniformLocation("alpha_test_ref");
+    programState->alphaTestRefLoc = programObject->getUniformLocation("alpha_test_ref");
 
-    programState.materialAmbientLoc  = programObject->getUniformLocation("material_ambient");
-    programState.materialDiffuseLoc  = programObject->getUniformLocation("material_diffuse");
-    programState.materialSpecularLoc = programObject->getUniformLocation("material_specular");
-    programState.materialEmissiveLoc = programObject->getUniformLocation("material_emissive");
-    programState.materialSpecularExponentLoc =
+    programState->materialAmbientLoc  = programObject->getUniformLocation("material_ambient");
+    programState->materialDiffuseLoc  = programObject->getUniformLocation("material_diffuse");
+    programState->materialSpecularLoc = programObject->getUniformLocation("material_specular");
+    programState->materialEmissiveLoc = programObject->getUniformLocation("material_emissive");
+    programState->materialSpecularExponentLoc =
         programObject->getUniformLocation("material_specular_exponent");
 
-    programState.lightModelSceneAmbientLoc =
+    programState->lightModelSceneAmbientLoc =
         programObject->getUniformLocation("light_model_scene_ambient");
 
-    programState.lightAmbientsLoc   = programObject->getUniformLocation("light_ambients");
-    programState.lightDiffusesLoc   = programObject->getUniformLocation("light_diffuses");
-    programState.lightSpecularsLoc  = programObject->getUniformLocation("light_speculars");
-    programState.lightPositionsLoc  = programObject->getUniformLocation("light_positions");
-    programState.lightDirectionsLoc = programObject->getUniformLocation("light_directions");
-    programState.lightSpotlightExponentsLoc =
+    programState->lightAmbientsLoc   = programObject->getUniformLocation("light_ambients");
+    programState->lightDiffusesLoc   = programObject->getUniformLocation("light_diffuses");
+    programState->lightSpecularsLoc  = programObject->getUniformLocation("light_speculars");
+    programState->lightPositionsLoc  = programObject->getUniformLocation("light_positions");
+    programState->lightDirectionsLoc = programObject->getUniformLocation("light_directions");
+    programState->lightSpotlightExponentsLoc =
         programObject->getUniformLocation("light_spotlight_exponents");
-    programState.lightSpotlightCutoffAnglesLoc =
+    programState->lightSpotlightCutoffAnglesLoc =
         programObject->getUniformLocation("light_spotlight_cutoff_angles");
-    programState.lightAttenuationConstsLoc =
+    programState->lightAttenuationConstsLoc =
         programObject->getUniformLocation("light_attenuation_consts");
-    programState.lightAttenuationLinearsLoc =
+    programState->lightAttenuationLinearsLoc =
         programObject->getUniformLocation("light_attenuation_linears");
-    programState.lightAttenuationQuadraticsLoc =
+    programState->lightAttenuationQuadraticsLoc =
         programObject->getUniformLocation("light_attenuation_quadratics");
 
-    programState.fogDensityLoc = programObject->getUniformLocation("fog_density");
-    programState.fogStartLoc   = programObject->getUniformLocation("fog_start");
-    programState.fogEndLoc     = programObject->getUniformLocation("fog_end");
-    programState.fogColorLoc   = programObject->getUniformLocation("fog_color");
+    programState->fogDensityLoc = programObject->getUniformLocation("fog_density");
+    programState->fogStartLoc   = programObject->getUniformLocation("fog_start");
+    programState->fogEndLoc     = programObject->getUniformLocation("fog_end");
+    programState->fogColorLoc   = programObject->getUniformLocation("fog_color");
 
-    programState.clipPlanesLoc = programObject->getUniformLocation("clip_planes");
+    programState->clipPlanesLoc = programObject->getUniformLocation("clip_planes");
 
-    programState.logicOpLoc = programObject->getUniformLocation("logic_op");
+    programState->logicOpLoc = programObject->getUniformLocation("logic_op");
 
-    programState.pointSizeMinLoc = programObject->getUniformLocation("point_size_min");
-    programState.pointSizeMaxLoc = programObject->getUniformLocation("point_size_max");
-    programState.pointDistanceAttenuationLoc =
+    programState->pointSizeMinLoc = programObject->getUniformLocation("point_size_min");
+    programState->pointSizeMaxLoc = programObject->getUniformLocation("point_size_max");
+    programState->pointDistanceAttenuationLoc =
         programObject->getUniformLocation("point_distance_attenuation");
 
-    programState.drawTextureCoordsLoc = programObject->getUniformLocation("draw_texture_coords");
-    programState.drawTextureDimsLoc   = programObject->getUniformLocation("draw_texture_dims");
-    programState.drawTextureNormalizedCropRectLoc =
+    programState->drawTextureCoordsLoc = programObject->getUniformLocation("draw_texture_coords");
+    programState->drawTextureDimsLoc   = programObject->getUniformLocation("draw_texture_dims");
+    programState->drawTextureNormalizedCropRectLoc =
         programObject->getUniformLocation("draw_texture_normalized_crop_rect");
+}
 
-    ANGLE_TRY(glState->setProgram(context, programObject));
+void GLES1Renderer::destroyVariant(Context *context, GLES1UberShaderState *variant)
+{
+    // Objects not created yet, or already deleted, have a zero id, which is ignored.
+    mShaderPrograms->deleteProgram(context, variant->programState.program);
+    mShaderPrograms->deleteShader(context, variant->vertexShader);
+    mShaderPrograms->deleteShader(context, variant->fragmentShader);
+}
 
-    for (int i = 0; i < kTexUnitCount; i++)
+angle::Result GLES1Renderer::initializeRendererProgram(Context *context, State *glState)
+{
+    if (!mRendererProgramInitialized)
     {
-        setUniform1i(context, programObject, programState.tex2DSamplerLocs[i], i);
-        setUniform1i(context, programObject, programState.texCubeSamplerLocs[i], i + kTexUnitCount);
+        mShaderPrograms             = new ShaderProgramManager();
+        mRendererProgramInitialized = true;
     }
-    glState->setObjectDirty(GL_PROGRAM);
 
-    // We just created a new program, we need to sync everything
-    glState->gles1().setAllDirty();
+    // See if we have the shader for this combination of states, otherwise start building it
+    const bool isNewVariant       = mUberShaderState.find(mShaderState) == mUberShaderState.end();
+    GLES1UberShaderState &variant = mUberShaderState[mShaderState];
+    angle::Result result          = angle::Result::Continue;
+    if (isNewVariant)
+    {
+        result = compileVariant(context, mShaderState, false, &variant);
+    }
+
+    // While the program for this combination of states is being built in the background, draw
+    // with the generic variant, which takes the states as uniforms instead.  It doesn't do logic
+    // ops through framebuffer fetch though.
+    const bool canUseGenericVariant =
+        mGenericUberShaderState &&
+        !mShaderState.mGLES1StateEnabled[GLES1StateEnables::LogicOpThroughFramebufferFetch];
+    if (result == angle::Result::Continue)
+    {
+        result = updateVariantStatus(context, &variant, !canUseGenericVariant);
+    }
+
+    // Drop a variant that failed to build, so that it isn't used half-built by later draws.
+    if (result == angle::Result::Stop)
+    {
+        destroyVariant(context, &variant);
+        mUberShaderState.erase(mShaderState);
+        return angle::Result::Stop;
+    }
+
+    mUsingGenericVariant = variant.status != VariantStatus::Ready;
+    if (mUsingGenericVariant &&
+        updateVariantStatus(context, mGenericUberShaderState.get(), true) == angle::Result::Stop)
+    {
+        destroyVariant(context, mGenericUberShaderState.get());
+        mGenericUberShaderState.reset();
+        mUsingGenericVariant = false;
+        return angle::Result::Stop;
+    }
+
+    Program *programObject = getProgram(getUberShaderState().programState.program);
+
+    // If this is different than the current program, we need to sync everything
+    // TODO: This could be optimized to only dirty state that differs between the two programs
+    if (glState->getProgram() != programObject)
+    {
+        ANGLE_TRY(glState->setProgram(context, programObject));
+        glState->setObjectDirty(GL_PROGRAM);
+        glState->gles1().setAllDirty();
+    }
+
+    if (mUsingGenericVariant)
+    {
+        setGenericVariantUniforms(context, programObject);
+    }
 
+    return angle::Result::Continue;
+}
+
+angle::Result GLES1Renderer::precompileCommonVariants(Context *context, State *glState)
+{
+    // Without parallel shader compilation, the variants are built on the first draw that needs
+    // them instead, as precompiling them would only move the wait to context creation.
+    if (mRendererProgramInitialized || !context->getShaderCompileThreadPool()->isAsync())
+    {
+        return angle::Result::Continue;
+    }
+
+    mShaderPrograms             = new ShaderProgramManager();
     mRendererProgramInitialized = true;
+
+    mGenericUberShaderState = std::make_unique<GLES1UberShaderState>();
+    if (compileVariant(context, GLES1ShaderState(), true, mGenericUberShaderState.get()) ==
+        angle::Result::Stop)
+    {
+        destroyVariant(context, mGenericUberShaderState.get());
+        mGenericUberShaderState.reset();
+        return angle::Result::Stop;
+    }
+
+    // Untextured and textured triangles with otherwise default state, as most applications start
+    // with.
+    updateShaderState(PrimitiveMode::Triangles, context, glState);
+    GLES1ShaderState texturedShaderState(mShaderState);
+    texturedShaderState.tex2DEnables[0] = true;
+
+    for (const GLES1ShaderState &shaderState : {mShaderState, texturedShaderState})
+    {
+        GLES1UberShaderState &variant = mUberShaderState[shaderState];
+        if (compileVariant(context, shaderState, false, &variant) == angle::Result::Stop)
+        {
+            destroyVariant(context, &variant);
+            mUberShaderState.erase(shaderState);
+            return angle::Result::Stop;
+        }
+    }
+
     return angle::Result::Continue;
 }
 
+void GLES1Renderer::setGenericVariantUniforms(Context *context, Program *programObject)
+{
+    if (mGenericVariantUniformsValid && mGenericVariantShaderState == mShaderState)
+    {
+        return;
+    }
+
+    // The uniforms are named like the constants of the specialized variants, see
+    // addVertexShaderDefs and addFragmentShaderDefs.  This is only used while those are being
+    // built, so the locations are not cached.
+    constexpr std::pair<GLES1StateEnables, const char *> kEnables[] = {
+        {GLES1StateEnables::Lighting, "enable_lighting"},
+        {GLES1StateEnables::ColorMaterial, "enable_color_material"},
+        {GLES1StateEnables::DrawTexture, "enable_draw_texture"},
+        {GLES1StateEnables::PointRasterization, "point_rasterization"},
+        {GLES1StateEnables::RescaleNormal, "enable_rescale_normal"},
+        {GLES1StateEnables::Normalize, "enable_normalize"},
+        {GLES1StateEnables::LightModelTwoSided, "light_model_two_sided"},
+        {GLES1StateEnables::Fog, "enable_fog"},
+        {GLES1StateEnables::ClipPlanes, "enable_clip_planes"},
+        {GLES1StateEnables::PointSprite, "point_sprite_enabled"},
+        {GLES1StateEnables::AlphaTest, "enable_alpha_test"},
+        {GLES1StateEnables::ShadeModelFlat, "shade_model_flat"},
+    };
+    for (const auto &enable : kEnables)
+    {
+        setUniform1i(context, programObject, programObject->getUniformLocation(enable.second),
+                     mShaderState.mGLES1StateEnabled.test(enable.first));
+    }
+
+    auto setBoolArray = [&](const char *name, const bool *values, int count) {
+        std::array<GLint, kLightCount> intValues = {};
+        ASSERT(count <= kLightCount);
+        std::copy(values, values + count, intValues.begin());
+        setUniform1iv(context, programObject, programObject->getUniformLocation(name), count,
+                      intValues.data());
+    };
+    setBoolArray("light_enables", mShaderState.lightEnables, kLightCount);
+    setBoolArray("enable_texture_2d", mShaderState.tex2DEnables, kTexUnitCount);
+    setBoolArray("enable_texture_cube_map", mShaderState.texCubeEnables, kTexUnitCount);
+    setBoolArray("point_sprite_coord_replace", mShaderState.pointSpriteCoordReplaces,
+                 kTexUnitCount);
+    setBoolArray("clip_plane_enables", mShaderState.clipPlaneEnables, kClipPlaneCount);
+
+    auto setUintTexArray = [&](const char *name, const GLES1ShaderState::UintTexArray &values) {
+        std::array<GLuint, kTexUnitCount> uintValues;
+        std::copy(std::begin(values), std::end(values), uintValues.begin());
+        setUniform1uiv(programObject, programObject->getUniformLocation(name), kTexUnitCount,
+                       uintValues.data());
+    };
+    setUintTexArray("texture_format", mShaderState.tex2DFormats);
+    setUintTexArray("texture_env_mode", mShaderState.texEnvModes);
+    setUintTexArray("combine_rgb", mShaderState.texCombineRgbs);
+    setUintTexArray("combine_alpha", mShaderState.texCombineAlphas);
+    setUintTexArray("src0_rgb", mShaderState.texCombineSrc0Rgbs);
+    setUintTexArray("src0_alpha", mShaderState.texCombineSrc0Alphas);
+    setUintTexArray("src1_rgb", mShaderState.texCombineSrc1Rgbs);
+    setUintTexArray("src1_alpha", mShaderState.texCombineSrc1Alphas);
+    setUintTexArray("src2_rgb", mShaderState.texCombineSrc2Rgbs);
+    setUintTexArray("src2_alpha", mShaderState.texCombineSrc2Alphas);
+    setUintTexArray("op0_rgb", mShaderState.texCombineOp0Rgbs);
+    setUintTexArray("op0_alpha", mShaderState.texCombineOp0Alphas);
+    setUintTexArray("op1_rgb", mShaderState.texCombineOp1Rgbs);
+    setUintTexArray("op1_alpha", mShaderState.texCombineOp1Alphas);
+    setUintTexArray("op2_rgb", mShaderState.texCombineOp2Rgbs);
+    setUintTexArray("op2_alpha", mShaderState.texCombineOp2Alphas);
+
+    setUniform1ui(programObject, programObject->getUniformLocation("alpha_func"),
+                  ToGLenum(mShaderState.alphaTestFunc));
+    setUniform1ui(programObject, programObject->getUniformLocation("fog_mode"),
+                  ToGLenum(mShaderState.fogMode));
+
+    mGenericVariantShaderState   = mShaderState;
+    mGenericVariantUniformsValid = true;
+}
+
 void GLES1Renderer::setUniform1i(Context *context,
                                  Program *programObject,
                                  UniformLocation location,
@@ -1100,6 +1372,16 @@ void GLES1Renderer::setUniform1ui(Program *programObject, UniformLocation locati
     programObject->setUniform1uiv(location, 1, &value);
 }
 
+void GLES1Renderer::setUniform1uiv(Program *programObject,
+                                   UniformLocation location,
+                                   GLint count,
+                                   const GLuint *value)
+{
+    if (location.value == -1)
+        return;
+    programObject->setUniform1uiv(location, count, value);
+}
+
 void GLES1Renderer::setUniform1iv(Context *context,
                                   Program *programObject,
                                   UniformLocation location,
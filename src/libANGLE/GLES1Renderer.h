@@ -59,6 +59,7 @@ struct GLES1ShaderState
     GLES1ShaderState();
     ~GLES1ShaderState();
     GLES1ShaderState(const GLES1ShaderState &other);
+    GLES1ShaderState &operator=(const GLES1ShaderState &other);
 
     size_t hash() const;
 
@@ -128,6 +129,10 @@ class GLES1Renderer final : angle::NonCopyable
 
     angle::Result prepareForDraw(PrimitiveMode mode, Context *context, State *glState);
 
+    // Starts building the programs for the states applications commonly draw with first, and the
+    // generic program used while the others are built, if they can be built in the background.
+    angle::Result precompileCommonVariants(Context *context, State *glState);
+
     static int VertexArrayIndex(ClientVertexArrayType type, const GLES1State &gles1);
     static ClientVertexArrayType VertexArrayType(int attribIndex);
     static int TexCoordArrayIndex(unsigned int unit);
@@ -152,12 +157,17 @@ class GLES1Renderer final : angle::NonCopyable
                                 ShaderType shaderType,
                                 const char *src,
                                 ShaderProgramID *shaderOut);
+    angle::Result checkShaderCompiled(Context *context, ShaderProgramID shader);
     angle::Result linkProgram(Context *context,
-                              State *glState,
                               ShaderProgramID vshader,
                               ShaderProgramID fshader,
                               const angle::HashMap<GLint, std::string> &attribLocs,
                               ShaderProgramID *programOut);
+    angle::Result checkProgramLinked(Context *context,
+                                     ShaderProgramID vshader,
+                                     ShaderProgramID fshader,
+                                     ShaderProgramID program);
+    void updateShaderState(PrimitiveMode mode, Context *context, State *glState);
     angle::Result initializeRendererProgram(Context *context, State *glState);
 
     void setUniform1i(Context *context,
@@ -165,6 +175,10 @@ class GLES1Renderer final : angle::NonCopyable
                       UniformLocation location,
                       GLint value);
     void setUniform1ui(Program *programObject, UniformLocation location, GLuint value);
+    void setUniform1uiv(Program *programObject,
+                        UniformLocation location,
+                        GLint count,
+                        const GLuint *value);
     void setUniform1iv(Context *context,
                        Program *programObject,
                        UniformLocation location,
@@ -206,25 +220,26 @@ class GLES1Renderer final : angle::NonCopyable
 
     GLES1ShaderState mShaderState = {};
 
-    const char *getShaderBool(GLES1StateEnables state);
+    const char *getShaderBool(const GLES1ShaderState &shaderState, GLES1StateEnables state);
     void addShaderDefine(std::stringstream &outStream,
+                         const GLES1ShaderState &shaderState,
                          GLES1StateEnables state,
                          const char *enableString);
     void addShaderUint(std::stringstream &outStream, const char *name, uint16_t value);
     void addShaderUintTexArray(std::stringstream &outStream,
                                const char *texString,
-                               GLES1ShaderState::UintTexArray &texState);
+                               const GLES1ShaderState::UintTexArray &texState);
     void addShaderBoolTexArray(std::stringstream &outStream,
                                const char *texString,
-                               GLES1ShaderState::BoolTexArray &texState);
+                               const GLES1ShaderState::BoolTexArray &texState);
     void addShaderBoolLightArray(std::stringstream &outStream,
                                  const char *name,
-                                 GLES1ShaderState::BoolLightArray &value);
+                                 const GLES1ShaderState::BoolLightArray &value);
     void addShaderBoolClipPlaneArray(std::stringstream &outStream,
                                      const char *name,
-                                     GLES1ShaderState::BoolClipPlaneArray &value);
-    void addVertexShaderDefs(std::stringstream &outStream);
-    void addFragmentShaderDefs(std::stringstream &outStream);
+                                     const GLES1ShaderState::BoolClipPlaneArray &value);
+    void addVertexShaderDefs(std::stringstream &outStream, const GLES1ShaderState &shaderState);
+    void addFragmentShaderDefs(std::stringstream &outStream, const GLES1ShaderState &shaderState);
 
     struct GLES1ProgramState
     {
@@ -316,20 +331,57 @@ class GLES1Renderer final : angle::NonCopyable
         std::array<Vec4Uniform, kTexUnitCount> texCropRects;
     };
 
+    // The shaders of a variant are compiled, and its program linked, on worker threads if the
+    // back-end supports parallel shader compilation.  The program is only used once it is Ready.
+    enum class VariantStatus
+    {
+        Compiling,
+        Linking,
+        Ready,
+    };
+
     struct GLES1UberShaderState
     {
         GLES1UniformBuffers uniformBuffers;
         GLES1ProgramState programState;
+
+        VariantStatus status = VariantStatus::Compiling;
+        // Deleted once the program is linked.
+        ShaderProgramID vertexShader   = {};
+        ShaderProgramID fragmentShader = {};
     };
 
+    angle::Result compileVariant(Context *context,
+                                 const GLES1ShaderState &shaderState,
+                                 bool isGenericVariant,
+                                 GLES1UberShaderState *variant);
+    // Moves the variant on to the next status as far as it can without waiting for worker
+    // threads, or until it is Ready if |wait|.
+    angle::Result updateVariantStatus(Context *context, GLES1UberShaderState *variant, bool wait);
+    void initializeProgramState(Program *programObject, GLES1ProgramState *programState);
+    void destroyVariant(Context *context, GLES1UberShaderState *variant);
+    void setGenericVariantUniforms(Context *context, Program *programObject);
+
     GLES1UberShaderState &getUberShaderState()
     {
+        if (mUsingGenericVariant)
+        {
+            return *mGenericUberShaderState;
+        }
         ASSERT(mUberShaderState.find(mShaderState) != mUberShaderState.end());
         return mUberShaderState[mShaderState];
     }
 
     angle::HashMap<GLES1ShaderState, GLES1UberShaderState> mUberShaderState;
 
+    // The variant that takes the states the others are specialized on as uniforms.  Only created
+    // if variants are built in the background, to draw with while they are.
+    std::unique_ptr<GLES1UberShaderState> mGenericUberShaderState;
+    bool mUsingGenericVariant = false;
+    // The states last set in the uniforms of the generic variant.
+    GLES1ShaderState mGenericVariantShaderState = {};
+    bool mGenericVariantUniformsValid           = false;
+
     bool mDrawTextureEnabled      = false;
     GLfloat mDrawTextureCoords[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     GLfloat mDrawTextureDims[2]   = {0.0f, 0.0f};
@@ -10,6 +10,7 @@
 #include "libANGLE/IndexRangeCache.h"
 
 #include "common/debug.h"
+#include "common/utilities.h"
 #include "libANGLE/formatutils.h"
 
 namespace gl
@@ -53,6 +54,77 @@ bool IndexRangeCache::findRange(DrawElementsType type,
     }
 }
 
+IndexRange IndexRangeCache::computeRange(DrawElementsType type,
+                                         const uint8_t *bufferData,
+                                         size_t offset,
+                                         size_t count,
+                                         bool primitiveRestartEnabled)
+{
+    const size_t typeBytes  = GetDrawElementsTypeSize(type);
+    const size_t byteBegin  = offset;
+    const size_t byteEnd    = offset + count * typeBytes;
+    const size_t firstBlock = rx::roundUpPow2(byteBegin, kBlockSize) / kBlockSize;
+    const size_t endBlock   = byteEnd / kBlockSize;
+
+    // Small draws are scanned directly, the summaries would not save anything.  So are indices
+    // that are not aligned to their type, as ES allows outside of WebGL, since the block summaries
+    // assume the indices start at a multiple of the type size.
+    if (endBlock < firstBlock + 2 || offset % typeBytes != 0)
+    {
+        return ComputeIndexRange(type, bufferData + offset, count, primitiveRestartEnabled);
+    }
+
+    IndexRange range;
+    auto mergeRange = [&range](const IndexRange &other) {
+        if (other.vertexIndexCount == 0)
+        {
+            return;
+        }
+        if (range.vertexIndexCount == 0)
+        {
+            range = other;
+            return;
+        }
+        range.start = std::min(range.start, other.start);
+        range.end   = std::max(range.end, other.end);
+        range.vertexIndexCount += other.vertexIndexCount;
+    };
+
+    const size_t headEnd = firstBlock * kBlockSize;
+    if (byteBegin < headEnd)
+    {
+        mergeRange(ComputeIndexRange(type, bufferData + byteBegin,
+                                     (headEnd - byteBegin) / typeBytes, primitiveRestartEnabled));
+    }
+
+    std::vector<BlockRange> &blocks = mBlockRanges[type][primitiveRestartEnabled];
+    if (blocks.size() < endBlock)
+    {
+        blocks.resize(endBlock);
+    }
+
+    for (size_t block = firstBlock; block < endBlock; ++block)
+    {
+        BlockRange &blockRange = blocks[block];
+        if (!blockRange.valid)
+        {
+            blockRange.range = ComputeIndexRange(type, bufferData + block * kBlockSize,
+                                                 kBlockSize / typeBytes, primitiveRestartEnabled);
+            blockRange.valid = true;
+        }
+        mergeRange(blockRange.range);
+    }
+
+    const size_t tailBegin = endBlock * kBlockSize;
+    if (tailBegin < byteEnd)
+    {
+        mergeRange(ComputeIndexRange(type, bufferData + tailBegin,
+                                     (byteEnd - tailBegin) / typeBytes, primitiveRestartEnabled));
+    }
+
+    return range;
+}
+
 void IndexRangeCache::invalidateRange(size_t offset, size_t size)
 {
     size_t invalidateStart = offset;
@@ -74,11 +146,32 @@ void IndexRangeCache::invalidateRange(size_t offset, size_t size)
             mIndexRangeCache.erase(i++);
         }
     }
+
+    const size_t firstBlock = invalidateStart / kBlockSize;
+    const size_t endBlock   = rx::roundUpPow2(invalidateEnd, kBlockSize) / kBlockSize;
+    for (BlockRanges &blockRanges : mBlockRanges)
+    {
+        for (std::vector<BlockRange> &blocks : blockRanges)
+        {
+            for (size_t block = firstBlock; block < std::min(endBlock, blocks.size()); ++block)
+            {
+                blocks[block].valid = false;
+            }
+        }
+    }
 }
 
 void IndexRangeCache::clear()
 {
     mIndexRangeCache.clear();
+
+    for (BlockRanges &blockRanges : mBlockRanges)
+    {
+        for (std::vector<BlockRange> &blocks : blockRanges)
+        {
+            blocks.clear();
+        }
+    }
 }
 
 IndexRangeCache::IndexRangeKey::IndexRangeKey()
@@ -15,7 +15,9 @@
 #include "common/angleutils.h"
 #include "common/mathutil.h"
 
+#include <array>
 #include <map>
+#include <vector>
 
 namespace gl
 {
@@ -37,10 +39,29 @@ class IndexRangeCache
                    bool primitiveRestartEnabled,
                    IndexRange *outRange) const;
 
+    // Computes the range of |count| indices of |type| at |offset| in |bufferData|, which holds the
+    // contents of the whole buffer.  The ranges of the aligned blocks of the buffer covered by the
+    // indices are kept until the blocks are modified, so only the blocks that changed and the
+    // partial blocks at either end are scanned, whatever the offset and count of the draw.
+    IndexRange computeRange(DrawElementsType type,
+                            const uint8_t *bufferData,
+                            size_t offset,
+                            size_t count,
+                            bool primitiveRestartEnabled);
+
     void invalidateRange(size_t offset, size_t size);
     void clear();
 
   private:
+    static constexpr size_t kBlockSize = 4096;
+
+    struct BlockRange
+    {
+        IndexRange range;
+        bool valid = false;
+    };
+    using BlockRanges = std::array<std::vector<BlockRange>, 2>;
+
     struct IndexRangeKey
     {
         IndexRangeKey();
@@ -56,6 +77,9 @@ class IndexRangeCache
 
     typedef std::map<IndexRangeKey, IndexRange> IndexRangeMap;
     IndexRangeMap mIndexRangeCache;
+
+    // Ranges of the blocks of the buffer, by index type and whether primitive restart is enabled.
+    angle::PackedEnumMap<DrawElementsType, BlockRanges> mBlockRanges;
 };
 
 }  // namespace gl
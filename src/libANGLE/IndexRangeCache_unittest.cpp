@@ -0,0 +1,137 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IndexRangeCache_unittest.cpp: Unit tests for the index range cache, checking the ranges computed
+// from the block summaries match full scans of the indices as the buffer is modified.
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "common/utilities.h"
+#include "libANGLE/IndexRangeCache.h"
+
+namespace gl
+{
+namespace
+{
+// Spans several blocks of the cache, and ends in the middle of one.
+constexpr size_t kIndexCount = 20000;
+
+void ExpectEqualRanges(const IndexRange &expected, const IndexRange &actual)
+{
+    EXPECT_EQ(expected.start, actual.start);
+    EXPECT_EQ(expected.end, actual.end);
+    EXPECT_EQ(expected.vertexIndexCount, actual.vertexIndexCount);
+}
+
+class IndexRangeCacheTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        mIndices.resize(kIndexCount);
+        for (size_t index = 0; index < kIndexCount; ++index)
+        {
+            mIndices[index] = static_cast<GLushort>(1000 + (index * 7) % 5000);
+        }
+    }
+
+    const uint8_t *data() const { return reinterpret_cast<const uint8_t *>(mIndices.data()); }
+
+    // Compares the range computed by the cache with a full scan, for draws of various offsets and
+    // counts.
+    void checkRanges(bool primitiveRestartEnabled)
+    {
+        for (size_t first : {0, 1, 2047, 2048, 5000})
+        {
+            // The last count reaches the end of the buffer from the last offset.
+            for (size_t count : {1, 100, 4096, 10000, 15000})
+            {
+                IndexRange expected =
+                    ComputeIndexRange(DrawElementsType::UnsignedShort, mIndices.data() + first,
+                                      count, primitiveRestartEnabled);
+                IndexRange actual =
+                    mCache.computeRange(DrawElementsType::UnsignedShort, data(),
+                                        first * sizeof(GLushort), count, primitiveRestartEnabled);
+                ExpectEqualRanges(expected, actual);
+            }
+        }
+    }
+
+    // Modifies the indices like glBufferSubData would.
+    void setIndices(size_t first, size_t count, GLushort value)
+    {
+        std::fill(mIndices.begin() + first, mIndices.begin() + first + count, value);
+        mCache.invalidateRange(first * sizeof(GLushort), count * sizeof(GLushort));
+    }
+
+    std::vector<GLushort> mIndices;
+    IndexRangeCache mCache;
+};
+
+// Test that ranges computed from the block summaries match a full scan.
+TEST_F(IndexRangeCacheTest, ComputeRange)
+{
+    checkRanges(false);
+    checkRanges(true);
+
+    // Again, with the summaries already computed.
+    checkRanges(false);
+    checkRanges(true);
+}
+
+// Test that modifying part of the buffer updates the ranges of the draws covering it.
+TEST_F(IndexRangeCacheTest, PartialUpdates)
+{
+    checkRanges(false);
+
+    setIndices(3000, 10, 7);
+    checkRanges(false);
+
+    setIndices(9000, 1, 60000);
+    checkRanges(false);
+
+    // Restart indices in a whole block.
+    setIndices(4096, 2048, 0xFFFF);
+    checkRanges(true);
+    checkRanges(false);
+
+    // Clearing drops all the summaries.
+    std::fill(mIndices.begin(), mIndices.end(), 3);
+    mCache.clear();
+    checkRanges(false);
+}
+
+// Test that indices at an offset that isn't a multiple of their size, as allowed outside of WebGL,
+// get the same range as a full scan, even once the block summaries are computed.
+TEST_F(IndexRangeCacheTest, MisalignedOffset)
+{
+    constexpr size_t kCount = 8000;
+
+    checkRanges(false);
+
+    for (size_t offset : {1, 2049, 4095, 10001})
+    {
+        IndexRange expected = ComputeIndexRange(DrawElementsType::UnsignedShort, data() + offset,
+                                                kCount, false);
+        IndexRange actual =
+            mCache.computeRange(DrawElementsType::UnsignedShort, data(), offset, kCount, false);
+        ExpectEqualRanges(expected, actual);
+    }
+}
+
+// Test that a draw made only of primitive restart indices has no vertices, even when it covers
+// whole blocks.
+TEST_F(IndexRangeCacheTest, OnlyPrimitiveRestart)
+{
+    setIndices(0, kIndexCount, 0xFFFF);
+
+    IndexRange range = mCache.computeRange(DrawElementsType::UnsignedShort, data(), 0,
+                                           kIndexCount, true);
+    EXPECT_EQ(0u, range.vertexIndexCount);
+}
+
+}  // anonymous namespace
+}  // namespace gl
@@ -33,6 +33,7 @@
 #include "libANGLE/queryconversions.h"
 #include "libANGLE/renderer/GLImplFactory.h"
 #include "libANGLE/renderer/ProgramImpl.h"
+#include "libANGLE/trace.h"
 #include "platform/FrontendFeatures_autogen.h"
 #include "platform/PlatformMethods.h"
 
@@ -491,9 +492,56 @@ struct Program::LinkingState
 {
     std::shared_ptr<ProgramExecutable> linkedExecutable;
     ProgramLinkedResources resources;
+    ProgramMergedVaryings mergedVaryings;
     egl::BlobCache::Key programHash;
     std::unique_ptr<rx::LinkEvent> linkEvent;
     bool linkingFromBinary;
+
+    // Set if the whole link runs on a worker thread.  |linkEvent| is only set by the task, and
+    // must not be accessed before |linkTaskEvent| is ready.
+    std::shared_ptr<MainLinkTask> linkTask;
+    std::shared_ptr<angle::WaitableEvent> linkTaskEvent;
+};
+
+// Runs the frontend link and then the backend link on a worker thread, for backends that support
+// linking off the calling thread.
+class Program::MainLinkTask final : public angle::Closure
+{
+  public:
+    MainLinkTask(Program *program, const Context *context, LinkingState *linkingState)
+        : mProgram(program),
+          mContext(context),
+          mLinkingState(linkingState),
+          mInfoLog(program->mState.mExecutable->getInfoLog()),
+          mFrontendLinked(false)
+    {}
+
+    void operator()() override
+    {
+        ANGLE_TRACE_EVENT0("gpu.angle", "Program::MainLinkTask::run");
+
+        mFrontendLinked = mProgram->linkFrontend(mContext, mInfoLog, mLinkingState);
+        if (!mFrontendLinked)
+        {
+            return;
+        }
+
+        mLinkingState->linkEvent = mProgram->mProgram->linkOnWorkerThread(
+            mContext, mLinkingState->resources, mInfoLog, mLinkingState->mergedVaryings);
+
+        // Must be after linkOnWorkerThread() like in linkImpl().
+        mProgram->mState.updateProgramInterfaceInputs(mContext);
+        mProgram->mState.updateProgramInterfaceOutputs(mContext);
+    }
+
+    bool frontendLinked() const { return mFrontendLinked; }
+
+  private:
+    Program *mProgram;
+    const Context *mContext;
+    LinkingState *mLinkingState;
+    InfoLog &mInfoLog;
+    bool mFrontendLinked;
 };
 
 const char *const g_fakepath = "C:\\fakepath";
@@ -1155,7 +1203,51 @@ angle::Result Program::linkImpl(const Context *context)
     ASSERT(result);
 
     std::unique_ptr<LinkingState> linkingState(new LinkingState());
-    ProgramMergedVaryings mergedVaryings;
+    linkingState->linkingFromBinary = false;
+    linkingState->programHash       = programHash;
+
+    // With parallel shader compilation, run the rest of the link on a worker thread if the backend
+    // supports it, so glLinkProgram returns without waiting for it.  Programs that are in use are
+    // resolved right away by the context, so they are always linked on the calling thread, as are
+    // separable programs.
+    std::shared_ptr<angle::WorkerThreadPool> workerPool = context->getShaderCompileThreadPool();
+    if (workerPool->isAsync() && !isSeparable() && !isInUse() &&
+        mProgram->canLinkOnWorkerThread(context))
+    {
+        mLinkingState = std::move(linkingState);
+        mLinkingState->linkTask =
+            std::make_shared<MainLinkTask>(this, context, mLinkingState.get());
+        mLinkingState->linkTaskEvent = workerPool->postWorkerTask(mLinkingState->linkTask);
+        return angle::Result::Continue;
+    }
+
+    if (!linkFrontend(context, infoLog, linkingState.get()))
+    {
+        return angle::Result::Continue;
+    }
+
+    mLinkingState = std::move(linkingState);
+    mLinkingState->linkEvent =
+        mProgram->link(context, mLinkingState->resources, infoLog, mLinkingState->mergedVaryings);
+
+    // Must be after mProgram->link() to avoid misleading the linker about output variables.
+    mState.updateProgramInterfaceInputs(context);
+    mState.updateProgramInterfaceOutputs(context);
+
+    if (mState.mSeparable)
+    {
+        mLinkingState->linkedExecutable = mState.mExecutable;
+    }
+
+    return angle::Result::Continue;
+}
+
+// Checks the attached shaders against each other, and collects their uniforms, varyings and
+// interface blocks into |linkingState|.  Returns false if linking fails.  May run on a worker
+// thread, so it must not modify the context.
+bool Program::linkFrontend(const Context *context, InfoLog &infoLog, LinkingState *linkingState)
+{
+    ProgramMergedVaryings &mergedVaryings = linkingState->mergedVaryings;
     LinkingVariables linkingVariables(context, mState);
     ProgramLinkedResources &resources = linkingState->resources;
 
@@ -1174,7 +1266,7 @@ angle::Result Program::linkImpl(const Context *context)
         GLuint combinedImageUniforms = 0;
         if (!linkUniforms(context, &resources.unusedUniforms, &combinedImageUniforms, infoLog))
         {
-            return angle::Result::Continue;
+            return false;
         }
 
         GLuint combinedShaderStorageBlocks = 0u;
@@ -1182,7 +1274,7 @@ angle::Result Program::linkImpl(const Context *context)
                                                 mState.mExecutable->getLinkedShaderStages(),
                                                 resources, infoLog, &combinedShaderStorageBlocks))
         {
-            return angle::Result::Continue;
+            return false;
         }
 
         // [OpenGL ES 3.1] Chapter 8.22 Page 203:
@@ -1198,25 +1290,25 @@ angle::Result Program::linkImpl(const Context *context)
                    "and active fragment shader outputs exceeds "
                    "MAX_COMBINED_SHADER_OUTPUT_RESOURCES ("
                 << context->getCaps().maxCombinedShaderOutputResources << ")";
-            return angle::Result::Continue;
+            return false;
         }
     }
     else
     {
         if (!linkAttributes(context, infoLog))
         {
-            return angle::Result::Continue;
+            return false;
         }
 
         if (!linkVaryings(context, infoLog))
         {
-            return angle::Result::Continue;
+            return false;
         }
 
         GLuint combinedImageUniforms = 0;
         if (!linkUniforms(context, &resources.unusedUniforms, &combinedImageUniforms, infoLog))
         {
-            return angle::Result::Continue;
+            return false;
         }
 
         GLuint combinedShaderStorageBlocks = 0u;
@@ -1224,12 +1316,12 @@ angle::Result Program::linkImpl(const Context *context)
                                                 mState.mExecutable->getLinkedShaderStages(),
                                                 resources, infoLog, &combinedShaderStorageBlocks))
         {
-            return angle::Result::Continue;
+            return false;
         }
 
         if (!LinkValidateProgramGlobalNames(infoLog, getExecutable(), linkingVariables))
         {
-            return angle::Result::Continue;
+            return false;
         }
 
         gl::Shader *vertexShader = mState.mAttachedShaders[ShaderType::Vertex];
@@ -1250,7 +1342,7 @@ angle::Result Program::linkImpl(const Context *context)
                     fragmentShader->getShaderVersion(context), mFragmentOutputLocations,
                     mFragmentOutputIndexes))
             {
-                return angle::Result::Continue;
+                return false;
             }
 
             mState.mExecutable->mHasDiscard = fragmentShader->hasDiscard();
@@ -1264,41 +1356,52 @@ angle::Result Program::linkImpl(const Context *context)
         mergedVaryings = GetMergedVaryingsFromLinkingVariables(linkingVariables);
         if (!mState.mExecutable->linkMergedVaryings(
                 context, mergedVaryings, mState.mTransformFeedbackVaryingNames, linkingVariables,
-                isSeparable(), &resources.varyingPacking))
+                mState.mSeparable, &resources.varyingPacking))
         {
-            return angle::Result::Continue;
+            return false;
         }
     }
 
     mState.mExecutable->saveLinkedStateInfo(context, mState);
 
-    mLinkingState                    = std::move(linkingState);
-    mLinkingState->linkingFromBinary = false;
-    mLinkingState->programHash       = programHash;
-    mLinkingState->linkEvent         = mProgram->link(context, resources, infoLog, mergedVaryings);
-
-    // Must be after mProgram->link() to avoid misleading the linker about output variables.
-    mState.updateProgramInterfaceInputs(context);
-    mState.updateProgramInterfaceOutputs(context);
+    return true;
+}
 
-    if (mState.mSeparable)
+bool Program::isLinking() const
+{
+    if (!mLinkingState)
     {
-        mLinkingState->linkedExecutable = mState.mExecutable;
+        return false;
     }
-
-    return angle::Result::Continue;
+    if (mLinkingState->linkTaskEvent && !mLinkingState->linkTaskEvent->isReady())
+    {
+        return true;
+    }
+    return mLinkingState->linkEvent && mLinkingState->linkEvent->isLinking();
 }
 
-bool Program::isLinking() const
+bool Program::isLinkingWithShader(const Shader *shader) const
 {
-    return (mLinkingState.get() && mLinkingState->linkEvent &&
-            mLinkingState->linkEvent->isLinking());
+    return mLinkingState && mState.getAttachedShader(shader->getType()) == shader;
 }
 
 void Program::resolveLinkImpl(const Context *context)
 {
     ASSERT(mLinkingState.get());
 
+    if (mLinkingState->linkTaskEvent)
+    {
+        mLinkingState->linkTaskEvent->wait();
+
+        // Like when the frontend link fails on the calling thread, the program is left unlinked
+        // with the state gathered so far.
+        if (!mLinkingState->linkTask->frontendLinked())
+        {
+            mLinkingState.reset();
+            return;
+        }
+    }
+
     angle::Result result = mLinkingState->linkEvent->wait(context);
 
     mLinked                                    = result == angle::Result::Continue;
@@ -3015,7 +3118,7 @@ bool Program::linkVaryings(const Context *context, InfoLog &infoLog) const
             if (!LinkValidateShaderInterfaceMatching(
                     outputVaryings, currentShader->getInputVaryings(context), previousShaderType,
                     currentShader->getType(), previousShader->getShaderVersion(context),
-                    currentShader->getShaderVersion(context), isSeparable(), infoLog))
+                    currentShader->getShaderVersion(context), mState.mSeparable, infoLog))
             {
                 return false;
             }
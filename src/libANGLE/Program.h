@@ -463,6 +463,9 @@ class Program final : public LabeledObject, public angle::Subject
     // Peek whether there is any running linking tasks.
     bool isLinking() const;
     bool hasLinkingState() const { return mLinkingState != nullptr; }
+    // Whether a link in progress may read the compiled state of |shader|, in which case the link
+    // must be resolved before the shader is compiled again.
+    bool isLinkingWithShader(const Shader *shader) const;
 
     bool isLinked() const
     {
@@ -778,6 +781,7 @@ class Program final : public LabeledObject, public angle::Subject
 
   private:
     struct LinkingState;
+    class MainLinkTask;
 
     ~Program() override;
 
@@ -788,6 +792,7 @@ class Program final : public LabeledObject, public angle::Subject
     void deleteSelf(const Context *context);
 
     angle::Result linkImpl(const Context *context);
+    bool linkFrontend(const Context *context, InfoLog &infoLog, LinkingState *linkingState);
 
     bool linkValidateShaders(const Context *context, InfoLog &infoLog);
     bool linkAttributes(const Context *context, InfoLog &infoLog);
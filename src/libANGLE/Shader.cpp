@@ -401,6 +401,9 @@ void Shader::compile(const Context *context)
     options.objectCode       = true;
     options.variables        = true;
     options.emulateGLDrawID  = true;
+    // Shaders compiled identically by other contexts, such as the WebGL contexts of pages running
+    // the same application, are only translated once.
+    options.cacheTranslation = true;
 
     // Add default options to WebGL shaders to prevent unexpected behavior during
     // compilation.
@@ -266,6 +266,9 @@ class ContextImpl : public GLImplFactory
     // AMD_performance_monitor
     virtual const angle::PerfMonitorCounterGroups &getPerfMonitorCounters();
 
+    // Called before the draw surface is swapped, so that per-frame counters can be reset.
+    virtual void onPreSwap() {}
+
     // Enables GL_SHADER_PIXEL_LOCAL_STORAGE_EXT and polyfills load operations for
     // ANGLE_shader_pixel_local_storage using a fullscreen draw.
     //
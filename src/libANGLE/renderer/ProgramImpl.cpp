@@ -15,4 +15,19 @@ angle::Result ProgramImpl::onLabelUpdate(const gl::Context *context)
     return angle::Result::Continue;
 }
 
+bool ProgramImpl::canLinkOnWorkerThread(const gl::Context *context) const
+{
+    return false;
+}
+
+std::unique_ptr<LinkEvent> ProgramImpl::linkOnWorkerThread(
+    const gl::Context *context,
+    const gl::ProgramLinkedResources &resources,
+    gl::InfoLog &infoLog,
+    const gl::ProgramMergedVaryings &mergedVaryings)
+{
+    UNREACHABLE();
+    return std::make_unique<LinkEventDone>(angle::Result::Stop);
+}
+
 }  // namespace rx
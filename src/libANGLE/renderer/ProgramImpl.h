@@ -88,6 +88,18 @@ class ProgramImpl : angle::NonCopyable
                                             const gl::ProgramMergedVaryings &mergedVaryings) = 0;
     virtual GLboolean validate(const gl::Caps &caps, gl::InfoLog *infoLog)                   = 0;
 
+    // Backends returning true have linkOnWorkerThread() called instead of link(), when the shader
+    // compile thread pool is asynchronous.  The frontend link then runs on a worker thread too, and
+    // glLinkProgram returns without waiting for any of it.  linkOnWorkerThread() must not make
+    // calls that need the context's thread; those can be made when the returned event is waited
+    // on.
+    virtual bool canLinkOnWorkerThread(const gl::Context *context) const;
+    virtual std::unique_ptr<LinkEvent> linkOnWorkerThread(
+        const gl::Context *context,
+        const gl::ProgramLinkedResources &resources,
+        gl::InfoLog &infoLog,
+        const gl::ProgramMergedVaryings &mergedVaryings);
+
     virtual void setUniform1fv(GLint location, GLsizei count, const GLfloat *v) = 0;
     virtual void setUniform2fv(GLint location, GLsizei count, const GLfloat *v) = 0;
     virtual void setUniform3fv(GLint location, GLsizei count, const GLfloat *v) = 0;
@@ -184,7 +184,8 @@ angle::Result BufferD3D::getIndexRange(const gl::Context *context,
     const uint8_t *data = nullptr;
     ANGLE_TRY(getData(context, &data));
 
-    *outRange = gl::ComputeIndexRange(type, data + offset, count, primitiveRestartEnabled);
+    *outRange = mState.getIndexRangeCache()->computeRange(type, data, offset, count,
+                                                          primitiveRestartEnabled);
     return angle::Result::Continue;
 }
 
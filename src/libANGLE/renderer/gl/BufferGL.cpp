@@ -11,16 +11,17 @@
 #include "common/debug.h"
 #include "common/utilities.h"
 #include "libANGLE/Context.h"
+#include "libANGLE/Display.h"
 #include "libANGLE/angletypes.h"
 #include "libANGLE/formatutils.h"
 #include "libANGLE/renderer/gl/ContextGL.h"
+#include "libANGLE/renderer/gl/DisplayGL.h"
 #include "libANGLE/renderer/gl/FunctionsGL.h"
 #include "libANGLE/renderer/gl/StateManagerGL.h"
 #include "libANGLE/renderer/gl/renderergl_utils.h"
 
 namespace rx
 {
-
 // Use the GL_COPY_READ_BUFFER binding when two buffers need to be bound simultaneously.
 // GL_ELEMENT_ARRAY_BUFFER is supported on more versions but can modify the state of the currently
 // bound VAO.  Two simultaneous buffer bindings are only needed for glCopyBufferSubData which also
@@ -31,6 +32,14 @@ static constexpr gl::BufferBinding SourceBufferOperationTarget = gl::BufferBindi
 // supported GL versions and doesn't affect any current state when it changes.
 static constexpr gl::BufferBinding DestBufferOperationTarget = gl::BufferBinding::Array;
 
+namespace
+{
+ShareGroupGL *GetShareGroupGL(const gl::Context *context)
+{
+    return GetImplAs<ShareGroupGL>(context->getState().getShareGroup());
+}
+}  // anonymous namespace
+
 BufferGL::BufferGL(const gl::BufferState &state, GLuint buffer)
     : BufferImpl(state),
       mIsMapped(false),
@@ -48,6 +57,8 @@ BufferGL::~BufferGL()
 
 void BufferGL::destroy(const gl::Context *context)
 {
+    releasePendingPackConversions(context);
+
     StateManagerGL *stateManager = GetStateManagerGL(context);
     stateManager->deleteBuffer(mBufferID);
     mBufferID = 0;
@@ -64,6 +75,9 @@ angle::Result BufferGL::setData(const gl::Context *context,
     StateManagerGL *stateManager      = GetStateManagerGL(context);
     const angle::FeaturesGL &features = GetFeaturesGL(context);
 
+    // The data of the pending conversions is replaced.
+    releasePendingPackConversions(context);
+
     stateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
     ANGLE_GL_TRY(context, functions->bufferData(gl::ToGLenum(DestBufferOperationTarget), size, data,
                                                 ToGLenum(usage)));
@@ -96,6 +110,8 @@ angle::Result BufferGL::setSubData(const gl::Context *context,
     StateManagerGL *stateManager      = GetStateManagerGL(context);
     const angle::FeaturesGL &features = GetFeaturesGL(context);
 
+    ANGLE_TRY(resolvePendingPackConversions(context, offset, size));
+
     stateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
     ANGLE_GL_TRY(context, functions->bufferSubData(gl::ToGLenum(DestBufferOperationTarget), offset,
                                                    size, data));
@@ -123,6 +139,9 @@ angle::Result BufferGL::copySubData(const gl::Context *context,
 
     BufferGL *sourceGL = GetAs<BufferGL>(source);
 
+    ANGLE_TRY(sourceGL->resolvePendingPackConversions(context, sourceOffset, size));
+    ANGLE_TRY(resolvePendingPackConversions(context, destOffset, size));
+
     stateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
     stateManager->bindBuffer(SourceBufferOperationTarget, sourceGL->getBufferID());
 
@@ -148,6 +167,8 @@ angle::Result BufferGL::map(const gl::Context *context, GLenum access, void **ma
     StateManagerGL *stateManager      = GetStateManagerGL(context);
     const angle::FeaturesGL &features = GetFeaturesGL(context);
 
+    ANGLE_TRY(resolvePendingPackConversions(context, 0, mBufferSize));
+
     if (features.keepBufferShadowCopy.enabled)
     {
         *mapPtr = mShadowCopy.data();
@@ -194,6 +215,8 @@ angle::Result BufferGL::mapRange(const gl::Context *context,
     StateManagerGL *stateManager      = GetStateManagerGL(context);
     const angle::FeaturesGL &features = GetFeaturesGL(context);
 
+    ANGLE_TRY(resolvePendingPackConversions(context, offset, length));
+
     if (features.keepBufferShadowCopy.enabled)
     {
         *mapPtr = mShadowCopy.data() + offset;
@@ -266,16 +289,18 @@ angle::Result BufferGL::getIndexRange(const gl::Context *context,
 
     ASSERT(!mIsMapped);
 
+    const GLuint typeBytes = gl::GetDrawElementsTypeSize(type);
+    ANGLE_TRY(resolvePendingPackConversions(context, offset, count * typeBytes));
+
     if (features.keepBufferShadowCopy.enabled)
     {
-        *outRange = gl::ComputeIndexRange(type, mShadowCopy.data() + offset, count,
-                                          primitiveRestartEnabled);
+        *outRange = mState.getIndexRangeCache()->computeRange(type, mShadowCopy.data(), offset,
+                                                              count, primitiveRestartEnabled);
     }
     else
     {
         stateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
 
-        const GLuint typeBytes = gl::GetDrawElementsTypeSize(type);
         const uint8_t *bufferData =
             MapBufferRangeWithFallback(functions, gl::ToGLenum(DestBufferOperationTarget), offset,
                                        count * typeBytes, GL_MAP_READ_BIT);
@@ -300,4 +325,139 @@ GLuint BufferGL::getBufferID() const
 {
     return mBufferID;
 }
+
+void BufferGL::addPendingPackConversion(const gl::Context *context,
+                                        const PendingPackConversion &conversion)
+{
+    const FunctionsGL *functions = GetFunctionsGL(context);
+
+    PendingPackConversion pendingConversion = conversion;
+    pendingConversion.fence                 = nullptr;
+
+    // Without sync objects, mapping the buffer waits for the read.
+    if (nativegl::SupportsFenceSync(functions))
+    {
+        pendingConversion.fence = functions->fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    mPendingPackConversions.push_back(pendingConversion);
+
+    GetShareGroupGL(context)->onPendingPackConversionsAdded(this);
+}
+
+angle::Result BufferGL::resolvePendingPackConversions(const gl::Context *context,
+                                                      size_t offset,
+                                                      size_t size)
+{
+    const FunctionsGL *functions = GetFunctionsGL(context);
+    StateManagerGL *stateManager = GetStateManagerGL(context);
+
+    for (size_t index = 0; index < mPendingPackConversions.size();)
+    {
+        const PendingPackConversion conversion = mPendingPackConversions[index];
+        if (conversion.offset >= offset + size || offset >= conversion.offset + conversion.size)
+        {
+            ++index;
+            continue;
+        }
+        mPendingPackConversions.erase(mPendingPackConversions.begin() + index);
+
+        if (conversion.fence != nullptr)
+        {
+            functions->clientWaitSync(conversion.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                      GL_TIMEOUT_IGNORED);
+            functions->deleteSync(conversion.fence);
+        }
+
+        const size_t readSize =
+            static_cast<size_t>(conversion.readRowBytes) * conversion.extents.height;
+
+        stateManager->bindBuffer(SourceBufferOperationTarget, conversion.readBuffer);
+        const uint8_t *readPixels =
+            MapBufferRangeWithFallback(functions, gl::ToGLenum(SourceBufferOperationTarget), 0,
+                                       readSize, GL_MAP_READ_BIT);
+        if (readPixels == nullptr)
+        {
+            stateManager->deleteBuffer(conversion.readBuffer);
+        }
+        ANGLE_CHECK(GetImplAs<ContextGL>(context), readPixels != nullptr,
+                    "Failed to map the pixels read for the pixel pack buffer.", GL_OUT_OF_MEMORY);
+
+        angle::Result result = convertPackPixels(context, conversion, readPixels);
+
+        stateManager->bindBuffer(SourceBufferOperationTarget, conversion.readBuffer);
+        functions->unmapBuffer(gl::ToGLenum(SourceBufferOperationTarget));
+        stateManager->deleteBuffer(conversion.readBuffer);
+
+        ANGLE_TRY(result);
+    }
+
+    if (mPendingPackConversions.empty())
+    {
+        GetShareGroupGL(context)->onPendingPackConversionsResolved(this);
+    }
+    return angle::Result::Continue;
+}
+
+angle::Result BufferGL::resolveAllPendingPackConversions(const gl::Context *context)
+{
+    return resolvePendingPackConversions(context, 0, mBufferSize);
+}
+
+angle::Result BufferGL::convertPackPixels(const gl::Context *context,
+                                          const PendingPackConversion &conversion,
+                                          const uint8_t *readPixels)
+{
+    const FunctionsGL *functions      = GetFunctionsGL(context);
+    StateManagerGL *stateManager      = GetStateManagerGL(context);
+    const angle::FeaturesGL &features = GetFeaturesGL(context);
+
+    stateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
+
+    // The shadow copy holds the bytes between the rows, so the whole range can be uploaded from it.
+    if (features.keepBufferShadowCopy.enabled)
+    {
+        uint8_t *pixels = mShadowCopy.data() + conversion.offset;
+        RearrangeNorm16PixelsToRGBA(conversion.format, conversion.extents.width,
+                                    conversion.extents.height, readPixels, conversion.readRowBytes,
+                                    conversion.readPixelBytes, pixels, conversion.rowBytes);
+        ANGLE_GL_TRY(context,
+                     functions->bufferSubData(gl::ToGLenum(DestBufferOperationTarget),
+                                              conversion.offset, conversion.size, pixels));
+        return angle::Result::Continue;
+    }
+
+    uint8_t *pixels =
+        MapBufferRangeWithFallback(functions, gl::ToGLenum(DestBufferOperationTarget),
+                                   conversion.offset, conversion.size, GL_MAP_WRITE_BIT);
+    ANGLE_CHECK(GetImplAs<ContextGL>(context), pixels != nullptr,
+                "Failed to map the pixel pack buffer to convert the pixels read into it.",
+                GL_OUT_OF_MEMORY);
+
+    RearrangeNorm16PixelsToRGBA(conversion.format, conversion.extents.width,
+                                conversion.extents.height, readPixels, conversion.readRowBytes,
+                                conversion.readPixelBytes, pixels, conversion.rowBytes);
+
+    ANGLE_GL_TRY(context, functions->unmapBuffer(gl::ToGLenum(DestBufferOperationTarget)));
+    stateManager->bindBuffer(DestBufferOperationTarget, 0);
+
+    return angle::Result::Continue;
+}
+
+void BufferGL::releasePendingPackConversions(const gl::Context *context)
+{
+    const FunctionsGL *functions = GetFunctionsGL(context);
+    StateManagerGL *stateManager = GetStateManagerGL(context);
+
+    for (const PendingPackConversion &conversion : mPendingPackConversions)
+    {
+        if (conversion.fence != nullptr)
+        {
+            functions->deleteSync(conversion.fence);
+        }
+        stateManager->deleteBuffer(conversion.readBuffer);
+    }
+    mPendingPackConversions.clear();
+
+    GetShareGroupGL(context)->onPendingPackConversionsResolved(this);
+}
 }  // namespace rx
@@ -10,6 +10,7 @@
 #define LIBANGLE_RENDERER_GL_BUFFERGL_H_
 
 #include "common/MemoryBuffer.h"
+#include "libANGLE/angletypes.h"
 #include "libANGLE/renderer/BufferImpl.h"
 
 namespace rx
@@ -18,6 +19,28 @@ namespace rx
 class FunctionsGL;
 class StateManagerGL;
 
+// Pixels read as RED or RG by readPixels, for the EXT_texture_norm16 readback workaround, that
+// still need rearranging into the RGBA pixels the application asked for in a pixel pack buffer.
+// The pixels are read tightly packed into a separate buffer, and rearranged into the pack buffer
+// once the read has completed, before the pack buffer is next accessed by the application or read
+// by the GPU.
+struct PendingPackConversion
+{
+    // Signaled once the driver has finished the read.
+    GLsync fence;
+    // Buffer the pixels are read into, owned by the pack buffer the conversion is added to.
+    GLuint readBuffer;
+    // Offset of the first rearranged pixel in the pack buffer.
+    size_t offset;
+    // Size of the rearranged pixels, starting at |offset|.
+    size_t size;
+    GLenum format;
+    gl::Extents extents;
+    GLuint readRowBytes;
+    GLuint readPixelBytes;
+    GLuint rowBytes;
+};
+
 class BufferGL : public BufferImpl
 {
   public:
@@ -58,13 +81,33 @@ class BufferGL : public BufferImpl
 
     GLuint getBufferID() const;
 
+    // Called after readPixels has read pixels that need converting into the read buffer of
+    // |conversion|.  Inserts a fence to wait for before the conversion.
+    void addPendingPackConversion(const gl::Context *context,
+                                  const PendingPackConversion &conversion);
+    // Converts the pixels of the pending conversions that overlap the given range, waiting only for
+    // the reads of those conversions to complete.
+    angle::Result resolvePendingPackConversions(const gl::Context *context,
+                                                size_t offset,
+                                                size_t size);
+    angle::Result resolveAllPendingPackConversions(const gl::Context *context);
+    // Rearranges |readPixels| into the range of the buffer described by |conversion|, leaving the
+    // bytes between the rows untouched.
+    angle::Result convertPackPixels(const gl::Context *context,
+                                    const PendingPackConversion &conversion,
+                                    const uint8_t *readPixels);
+
   private:
+    void releasePendingPackConversions(const gl::Context *context);
+
     bool mIsMapped;
     size_t mMapOffset;
     size_t mMapSize;
 
     angle::MemoryBuffer mShadowCopy;
 
+    std::vector<PendingPackConversion> mPendingPackConversions;
+
     size_t mBufferSize;
 
     GLuint mBufferID;
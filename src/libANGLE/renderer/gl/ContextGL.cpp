@@ -11,10 +11,12 @@
 
 #include "libANGLE/Context.h"
 #include "libANGLE/Context.inl.h"
+#include "libANGLE/Display.h"
 #include "libANGLE/PixelLocalStorage.h"
 #include "libANGLE/renderer/OverlayImpl.h"
 #include "libANGLE/renderer/gl/BufferGL.h"
 #include "libANGLE/renderer/gl/CompilerGL.h"
+#include "libANGLE/renderer/gl/DisplayGL.h"
 #include "libANGLE/renderer/gl/FenceNVGL.h"
 #include "libANGLE/renderer/gl/FramebufferGL.h"
 #include "libANGLE/renderer/gl/FunctionsGL.h"
@@ -43,8 +45,26 @@ ContextGL::ContextGL(const gl::State &state,
                      RobustnessVideoMemoryPurgeStatus robustnessVideoMemoryPurgeStatus)
     : ContextImpl(state, errorSet),
       mRenderer(renderer),
-      mRobustnessVideoMemoryPurgeStatus(robustnessVideoMemoryPurgeStatus)
-{}
+      mRobustnessVideoMemoryPurgeStatus(robustnessVideoMemoryPurgeStatus),
+      mTextureUploadBuffer(gl::BufferBinding::PixelUnpack)
+{
+    angle::PerfMonitorCounterGroup openGLGroup;
+    openGLGroup.name = "opengl";
+
+#define ANGLE_ADD_PERF_MONITOR_COUNTER_GROUP(COUNTER) \
+    {                                                 \
+        angle::PerfMonitorCounter counter;            \
+        counter.name  = #COUNTER;                     \
+        counter.value = 0;                            \
+        openGLGroup.counters.push_back(counter);      \
+    }
+
+    ANGLE_GL_PERF_COUNTERS_X(ANGLE_ADD_PERF_MONITOR_COUNTER_GROUP)
+
+#undef ANGLE_ADD_PERF_MONITOR_COUNTER_GROUP
+
+    mPerfMonitorCounters.push_back(openGLGroup);
+}
 
 ContextGL::~ContextGL() {}
 
@@ -53,6 +73,11 @@ angle::Result ContextGL::initialize()
     return angle::Result::Continue;
 }
 
+void ContextGL::onDestroy(const gl::Context *context)
+{
+    mTextureUploadBuffer.destroy(context);
+}
+
 CompilerImpl *ContextGL::createCompiler()
 {
     return new CompilerGL(this);
@@ -731,6 +756,45 @@ angle::Result ContextGL::drawElementsIndirect(const gl::Context *context,
     return angle::Result::Continue;
 }
 
+bool ContextGL::canMultiDrawNatively(const gl::Context *context) const
+{
+    const angle::FeaturesGL &features = getFeaturesGL();
+    if (!features.useNativeMultiDraw.enabled || features.shiftInstancedArrayDataWithOffset.enabled)
+    {
+        return false;
+    }
+
+    // The emulated gl_DrawID is a uniform that has to be set before each sub-draw, and multiview
+    // needs each sub-draw to be instanced.
+    const gl::Program *program = context->getState().getLinkedProgram(context);
+    if (!program || program->hasDrawIDUniform() || program->usesMultiview())
+    {
+        return false;
+    }
+
+    // Client arrays are streamed for the range of each sub-draw.
+    return !context->getStateCache().hasAnyActiveClientAttrib();
+}
+
+// Does the bookkeeping the frontend does after each draw, for all the sub-draws at once.
+void ContextGL::markMultiDrawUsage(const gl::Context *context,
+                                   gl::PrimitiveMode mode,
+                                   const GLsizei *counts,
+                                   GLsizei drawcount)
+{
+    if (context->getStateCache().isTransformFeedbackActiveUnpaused())
+    {
+        for (GLsizei drawID = 0; drawID < drawcount; ++drawID)
+        {
+            if (!context->noopDraw(mode, counts[drawID]))
+            {
+                gl::MarkTransformFeedbackBufferUsage(context, counts[drawID], 1);
+            }
+        }
+    }
+    gl::MarkShaderStorageUsage(context);
+}
+
 angle::Result ContextGL::multiDrawArrays(const gl::Context *context,
                                          gl::PrimitiveMode mode,
                                          const GLint *firsts,
@@ -739,7 +803,21 @@ angle::Result ContextGL::multiDrawArrays(const gl::Context *context,
 {
     mRenderer->markWorkSubmitted();
 
-    return rx::MultiDrawArraysGeneral(this, context, mode, firsts, counts, drawcount);
+    if (!canMultiDrawNatively(context))
+    {
+        return rx::MultiDrawArraysGeneral(this, context, mode, firsts, counts, drawcount);
+    }
+
+#if defined(ANGLE_STATE_VALIDATION_ENABLED)
+    validateState();
+#endif  // ANGLE_STATE_VALIDATION_ENABLED
+
+    ANGLE_TRY(setDrawArraysState(context, 0, 0, 0));
+    ANGLE_GL_TRY(context,
+                 getFunctions()->multiDrawArrays(ToGLenum(mode), firsts, counts, drawcount));
+    markMultiDrawUsage(context, mode, counts, drawcount);
+
+    return angle::Result::Continue;
 }
 
 angle::Result ContextGL::multiDrawArraysInstanced(const gl::Context *context,
@@ -763,6 +841,15 @@ angle::Result ContextGL::multiDrawArraysIndirect(const gl::Context *context,
 {
     mRenderer->markWorkSubmitted();
 
+    // GL 4.3+, GL_ARB_multi_draw_indirect or GL_EXT_multi_draw_indirect
+    const FunctionsGL *functions = getFunctions();
+    if (getFeaturesGL().useNativeMultiDraw.enabled && functions->multiDrawArraysIndirect)
+    {
+        ANGLE_GL_TRY(context, functions->multiDrawArraysIndirect(ToGLenum(mode), indirect,
+                                                                 drawcount, stride));
+        return angle::Result::Continue;
+    }
+
     return rx::MultiDrawArraysIndirectGeneral(this, context, mode, indirect, drawcount, stride);
 }
 
@@ -775,7 +862,25 @@ angle::Result ContextGL::multiDrawElements(const gl::Context *context,
 {
     mRenderer->markWorkSubmitted();
 
-    return rx::MultiDrawElementsGeneral(this, context, mode, counts, type, indices, drawcount);
+    // Indices in client memory are streamed for each sub-draw.
+    if (!canMultiDrawNatively(context) ||
+        context->getState().getVertexArray()->getElementArrayBuffer() == nullptr)
+    {
+        return rx::MultiDrawElementsGeneral(this, context, mode, counts, type, indices, drawcount);
+    }
+
+#if defined(ANGLE_STATE_VALIDATION_ENABLED)
+    validateState();
+#endif  // ANGLE_STATE_VALIDATION_ENABLED
+
+    // With an element array buffer, the indices are only used to pick the primitive restart index.
+    const void *drawIndexPtr = nullptr;
+    ANGLE_TRY(setDrawElementsState(context, 0, type, nullptr, 0, &drawIndexPtr));
+    ANGLE_GL_TRY(context, getFunctions()->multiDrawElements(ToGLenum(mode), counts,
+                                                            ToGLenum(type), indices, drawcount));
+    markMultiDrawUsage(context, mode, counts, drawcount);
+
+    return angle::Result::Continue;
 }
 
 angle::Result ContextGL::multiDrawElementsInstanced(const gl::Context *context,
@@ -801,6 +906,15 @@ angle::Result ContextGL::multiDrawElementsIndirect(const gl::Context *context,
 {
     mRenderer->markWorkSubmitted();
 
+    // GL 4.3+, GL_ARB_multi_draw_indirect or GL_EXT_multi_draw_indirect
+    const FunctionsGL *functions = getFunctions();
+    if (getFeaturesGL().useNativeMultiDraw.enabled && functions->multiDrawElementsIndirect)
+    {
+        ANGLE_GL_TRY(context, functions->multiDrawElementsIndirect(
+                                  ToGLenum(mode), ToGLenum(type), indirect, drawcount, stride));
+        return angle::Result::Continue;
+    }
+
     return rx::MultiDrawElementsIndirectGeneral(this, context, mode, type, indirect, drawcount,
                                                 stride);
 }
@@ -890,8 +1004,55 @@ angle::Result ContextGL::syncState(const gl::Context *context,
                                    const gl::State::ExtendedDirtyBits &extendedBitMask,
                                    gl::Command command)
 {
-    return mRenderer->getStateManager()->syncState(context, dirtyBits, bitMask, extendedDirtyBits,
-                                                   extendedBitMask);
+    // Pixels read into pixel pack buffers that still need converting are converted before the GPU
+    // can read the buffers.
+    if (command == gl::Command::Draw || command == gl::Command::Dispatch)
+    {
+        ANGLE_TRY(GetImplAs<ShareGroupGL>(context->getState().getShareGroup())
+                      ->resolvePendingPackConversions(context));
+    }
+    else if (command == gl::Command::TexImage)
+    {
+        gl::Buffer *unpackBuffer =
+            context->getState().getTargetBuffer(gl::BufferBinding::PixelUnpack);
+        if (unpackBuffer != nullptr)
+        {
+            ANGLE_TRY(GetImplAs<BufferGL>(unpackBuffer)->resolveAllPendingPackConversions(context));
+        }
+    }
+
+    ANGLE_TRY(mRenderer->getStateManager()->syncState(context, dirtyBits, bitMask,
+                                                      extendedDirtyBits, extendedBitMask));
+
+    if (command == gl::Command::Draw || command == gl::Command::Dispatch)
+    {
+        flushDefaultUniforms(context);
+    }
+    return angle::Result::Continue;
+}
+
+void ContextGL::flushDefaultUniforms(const gl::Context *context)
+{
+    const gl::State &glState = context->getState();
+    if (const gl::Program *program = glState.getProgram())
+    {
+        GetImplAs<ProgramGL>(program)->flushDefaultUniforms();
+        return;
+    }
+
+    const gl::ProgramPipeline *pipeline = glState.getProgramPipeline();
+    if (pipeline == nullptr)
+    {
+        return;
+    }
+    for (gl::ShaderType shaderType : pipeline->getExecutable().getLinkedShaderStages())
+    {
+        const gl::Program *program = pipeline->getShaderProgram(shaderType);
+        if (program != nullptr)
+        {
+            GetImplAs<ProgramGL>(program)->flushDefaultUniforms();
+        }
+    }
 }
 
 GLint ContextGL::getGPUDisjoint()
@@ -1023,6 +1184,28 @@ void ContextGL::markWorkSubmitted()
     mRenderer->markWorkSubmitted();
 }
 
+const angle::PerfMonitorCounterGroups &ContextGL::getPerfMonitorCounters()
+{
+    const angle::OpenGLPerfCounters &perfCounters = getStateManager()->getPerfCounters();
+
+    angle::PerfMonitorCounters &counters =
+        angle::GetPerfMonitorCounterGroup(mPerfMonitorCounters, "opengl").counters;
+
+#define ANGLE_UPDATE_PERF_MAP(COUNTER) \
+    angle::GetPerfMonitorCounter(counters, #COUNTER).value = perfCounters.COUNTER;
+
+    ANGLE_GL_PERF_COUNTERS_X(ANGLE_UPDATE_PERF_MAP)
+
+#undef ANGLE_UPDATE_PERF_MAP
+
+    return mPerfMonitorCounters;
+}
+
+void ContextGL::onPreSwap()
+{
+    getStateManager()->resetPerFramePerfCounters();
+}
+
 void ContextGL::resetDrawStateForPixelLocalStorageEXT(const gl::Context *context)
 {
     // Since our load/store shaders require shader images, this extension should only be used if the
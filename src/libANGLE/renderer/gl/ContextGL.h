@@ -12,6 +12,7 @@
 
 #include "libANGLE/renderer/ContextImpl.h"
 #include "libANGLE/renderer/gl/RendererGL.h"
+#include "libANGLE/renderer/gl/StreamingBufferGL.h"
 
 namespace angle
 {
@@ -47,6 +48,7 @@ class ContextGL : public ContextImpl
     ~ContextGL() override;
 
     angle::Result initialize() override;
+    void onDestroy(const gl::Context *context) override;
 
     // Shader creation
     CompilerImpl *createCompiler() override;
@@ -266,6 +268,9 @@ class ContextGL : public ContextImpl
     BlitGL *getBlitter() const;
     ClearMultiviewGL *getMultiviewClearer() const;
 
+    // Ring of pixel unpack buffers that large texture uploads from client memory are staged in.
+    StreamingBufferGL *getTextureUploadBuffer() { return &mTextureUploadBuffer; }
+
     angle::Result dispatchCompute(const gl::Context *context,
                                   GLuint numGroupsX,
                                   GLuint numGroupsY,
@@ -279,6 +284,10 @@ class ContextGL : public ContextImpl
 
     void setMaxShaderCompilerThreads(GLuint count) override;
 
+    // AMD_performance_monitor
+    const angle::PerfMonitorCounterGroups &getPerfMonitorCounters() override;
+    void onPreSwap() override;
+
     void invalidateTexture(gl::TextureType target) override;
 
     void validateState() const;
@@ -311,10 +320,20 @@ class ContextGL : public ContextImpl
                                        GLsizei instanceCount,
                                        const void **outIndices);
 
+    // Whether a multi-draw can be made with a single native call instead of one draw per sub-draw.
+    bool canMultiDrawNatively(const gl::Context *context) const;
+    void markMultiDrawUsage(const gl::Context *context,
+                            gl::PrimitiveMode mode,
+                            const GLsizei *counts,
+                            GLsizei drawcount);
+
     gl::AttributesMask updateAttributesForBaseInstance(const gl::Program *program,
                                                        GLuint baseInstance);
     void resetUpdatedAttributes(gl::AttributesMask attribMask);
 
+    // Uploads the deferred uniform updates of the programs used by the next draw or dispatch.
+    void flushDefaultUniforms(const gl::Context *context);
+
     // Resets draw state prior to drawing load/store operations for EXT_shader_pixel_local_storage,
     // in order to guarantee every pixel gets updated.
     void resetDrawStateForPixelLocalStorageEXT(const gl::Context *context);
@@ -323,6 +342,10 @@ class ContextGL : public ContextImpl
     std::shared_ptr<RendererGL> mRenderer;
 
     RobustnessVideoMemoryPurgeStatus mRobustnessVideoMemoryPurgeStatus;
+
+    StreamingBufferGL mTextureUploadBuffer;
+
+    angle::PerfMonitorCounterGroups mPerfMonitorCounters;
 };
 
 }  // namespace rx
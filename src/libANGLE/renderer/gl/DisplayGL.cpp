@@ -12,6 +12,7 @@
 #include "libANGLE/Context.h"
 #include "libANGLE/Display.h"
 #include "libANGLE/Surface.h"
+#include "libANGLE/renderer/gl/BufferGL.h"
 #include "libANGLE/renderer/gl/ContextGL.h"
 #include "libANGLE/renderer/gl/RendererGL.h"
 #include "libANGLE/renderer/gl/StateManagerGL.h"
@@ -120,6 +121,37 @@ StreamProducerImpl *DisplayGL::createStreamProducerD3DTexture(
     return nullptr;
 }
 
+void ShareGroupGL::onPendingPackConversionsAdded(BufferGL *buffer)
+{
+    if (std::find(mBuffersWithPendingPackConversions.begin(),
+                  mBuffersWithPendingPackConversions.end(),
+                  buffer) == mBuffersWithPendingPackConversions.end())
+    {
+        mBuffersWithPendingPackConversions.push_back(buffer);
+    }
+}
+
+void ShareGroupGL::onPendingPackConversionsResolved(BufferGL *buffer)
+{
+    auto iter = std::find(mBuffersWithPendingPackConversions.begin(),
+                          mBuffersWithPendingPackConversions.end(), buffer);
+    if (iter != mBuffersWithPendingPackConversions.end())
+    {
+        mBuffersWithPendingPackConversions.erase(iter);
+    }
+}
+
+angle::Result ShareGroupGL::resolvePendingPackConversions(const gl::Context *context)
+{
+    // Resolving all conversions of a buffer removes it from the list.
+    while (!mBuffersWithPendingPackConversions.empty())
+    {
+        BufferGL *buffer = mBuffersWithPendingPackConversions.back();
+        ANGLE_TRY(buffer->resolveAllPendingPackConversions(context));
+    }
+    return angle::Result::Continue;
+}
+
 ShareGroupImpl *DisplayGL::createShareGroup()
 {
     return new ShareGroupGL();
@@ -20,8 +20,23 @@ class Surface;
 namespace rx
 {
 
+class BufferGL;
+
 class ShareGroupGL : public ShareGroupImpl
-{};
+{
+  public:
+    // Buffers of the share group with pixels read into them that still need converting, see
+    // BufferGL::addPendingPackConversion.
+    void onPendingPackConversionsAdded(BufferGL *buffer);
+    void onPendingPackConversionsResolved(BufferGL *buffer);
+
+    // Converts the pending pixels of all buffers of the share group, before a command that the GPU
+    // may read any of them for.
+    angle::Result resolvePendingPackConversions(const gl::Context *context);
+
+  private:
+    std::vector<BufferGL *> mBuffersWithPendingPackConversions;
+};
 
 class RendererGL;
 
@@ -18,6 +18,7 @@
 #include "libANGLE/queryconversions.h"
 #include "libANGLE/renderer/ContextImpl.h"
 #include "libANGLE/renderer/gl/BlitGL.h"
+#include "libANGLE/renderer/gl/BufferGL.h"
 #include "libANGLE/renderer/gl/ClearMultiviewGL.h"
 #include "libANGLE/renderer/gl/ContextGL.h"
 #include "libANGLE/renderer/gl/FunctionsGL.h"
@@ -262,6 +263,38 @@ bool IsEmulatedAlphaChannelTextureAttachment(const FramebufferAttachment *attach
     return textureGL->hasEmulatedAlphaChannel(attachment->getTextureImageIndex());
 }
 
+// Whether RGBA/UNSIGNED_SHORT pixels have to be read as RED or RG, and rearranged.
+bool IsEXTTextureNorm16ReadbackWorkaroundNeeded(const angle::FeaturesGL &features,
+                                                GLenum originalReadFormat,
+                                                GLenum format,
+                                                GLenum type)
+{
+    return features.readPixelsUsingImplementationColorReadFormatForNorm16.enabled &&
+           type == GL_UNSIGNED_SHORT && originalReadFormat == GL_RGBA &&
+           (format == GL_RED || format == GL_RG);
+}
+
+// Reads the pixels of |area| for a pack conversion, into |pixels| if no buffer is bound to
+// GL_PIXEL_PACK_BUFFER, or else into the bound read buffer after allocating |size| bytes for it.
+angle::Result ReadPixelsForPackConversion(const gl::Context *context,
+                                          const gl::Rectangle &area,
+                                          GLenum format,
+                                          GLenum type,
+                                          size_t size,
+                                          GLubyte *pixels)
+{
+    const FunctionsGL *functions = GetFunctionsGL(context);
+
+    if (pixels == nullptr)
+    {
+        ANGLE_GL_TRY(context, functions->bufferData(GL_PIXEL_PACK_BUFFER, size, nullptr,
+                                                    GL_STREAM_READ));
+    }
+    ANGLE_GL_TRY(context, functions->readPixels(area.x, area.y, area.width, area.height, format,
+                                                type, pixels));
+    return angle::Result::Continue;
+}
+
 class [[nodiscard]] ScopedEXTTextureNorm16ReadbackWorkaround
 {
   public:
@@ -295,9 +328,8 @@ class [[nodiscard]] ScopedEXTTextureNorm16ReadbackWorkaround
         ContextGL *contextGL              = GetImplAs<ContextGL>(context);
         const angle::FeaturesGL &features = GetFeaturesGL(context);
 
-        enabled = features.readPixelsUsingImplementationColorReadFormatForNorm16.enabled &&
-                  type == GL_UNSIGNED_SHORT && originalReadFormat == GL_RGBA &&
-                  (format == GL_RED || format == GL_RG);
+        enabled =
+            IsEXTTextureNorm16ReadbackWorkaroundNeeded(features, originalReadFormat, format, type);
 
         clientPixels = pixels;
 
@@ -366,43 +398,9 @@ angle::Result RearrangeEXTTextureNorm16Pixels(const gl::Context *context,
                         glFormatOriginal.computeSkipBytes(type, originalReadFormatRowBytes, 0, pack,
                                                           false, &originalReadFormatSkipBytes));
 
-    GLuint originalReadFormatPixelBytes = glFormatOriginal.computePixelBytes(type);
-    GLuint alphaChannelBytes            = glFormatOriginal.alphaBits / 8;
-
-    ASSERT(originalReadFormatPixelBytes > pixelBytes);
-    ASSERT(originalReadFormatPixelBytes > alphaChannelBytes);
-    ASSERT(alphaChannelBytes != 0);
-    ASSERT(glFormatOriginal.alphaBits % 8 == 0);
-
-    // Populating rearrangedPixels values from pixels
-    GLubyte *srcRowStart = tmpPixels;
-    GLubyte *dstRowStart = clientPixels;
-
-    srcRowStart += skipBytes;
-    dstRowStart += originalReadFormatSkipBytes;
-
-    for (GLint y = 0; y < area.height; ++y)
-    {
-        GLubyte *src = srcRowStart;
-        GLubyte *dst = dstRowStart;
-        for (GLint x = 0; x < area.width; ++x)
-        {
-            GLushort *srcPixel = reinterpret_cast<GLushort *>(src);
-            GLushort *dstPixel = reinterpret_cast<GLushort *>(dst);
-            dstPixel[0]        = srcPixel[0];
-            dstPixel[1]        = format == GL_RG ? srcPixel[1] : 0;
-            // Set other channel of RGBA to 0 (GB when format == GL_RED, B when format == GL_RG)
-            dstPixel[2] = 0;
-            // Set alpha channel to 1
-            dstPixel[3] = 0xFFFF;
-
-            src += pixelBytes;
-            dst += originalReadFormatPixelBytes;
-        }
-
-        srcRowStart += rowBytes;
-        dstRowStart += originalReadFormatRowBytes;
-    }
+    RearrangeNorm16PixelsToRGBA(format, area.width, area.height, tmpPixels + skipBytes, rowBytes,
+                                pixelBytes, clientPixels + originalReadFormatSkipBytes,
+                                originalReadFormatRowBytes);
 
     return angle::Result::Continue;
 }
@@ -722,6 +720,21 @@ angle::Result FramebufferGL::readPixels(const gl::Context *context,
         packState.rowLength = area.width;
     }
 
+    if (packBuffer != nullptr)
+    {
+        // Convert the pixels of earlier reads into the buffer first, as this read may overwrite
+        // them.
+        BufferGL *packBufferGL = GetImplAs<BufferGL>(packBuffer);
+        ANGLE_TRY(packBufferGL->resolvePendingPackConversions(
+            context, 0, static_cast<size_t>(packBuffer->getSize())));
+
+        if (IsEXTTextureNorm16ReadbackWorkaroundNeeded(features, format, readFormat, readType))
+        {
+            return readPixelsIntoPackBufferWithConversion(context, clippedArea, format, readFormat,
+                                                          readType, packState, packBuffer, outPtr);
+        }
+    }
+
     // We want to use rowLength, but that might not be supported.
     bool cannotSetDesiredRowLength =
         packState.rowLength && !GetImplAs<ContextGL>(context)->getNativeExtensions().packSubimageNV;
@@ -1557,6 +1570,92 @@ angle::Result FramebufferGL::readPixelsRowByRow(const gl::Context *context,
     return angle::Result::Continue;
 }
 
+angle::Result FramebufferGL::readPixelsIntoPackBufferWithConversion(
+    const gl::Context *context,
+    const gl::Rectangle &area,
+    GLenum originalReadFormat,
+    GLenum format,
+    GLenum type,
+    const gl::PixelPackState &pack,
+    gl::Buffer *packBuffer,
+    GLubyte *pixels) const
+{
+    ContextGL *contextGL              = GetImplAs<ContextGL>(context);
+    const FunctionsGL *functions      = GetFunctionsGL(context);
+    StateManagerGL *stateManager      = GetStateManagerGL(context);
+    const angle::FeaturesGL &features = GetFeaturesGL(context);
+
+    const gl::InternalFormat &glFormatOriginal =
+        gl::GetInternalFormatInfo(originalReadFormat, type);
+    const gl::InternalFormat &glFormat = gl::GetInternalFormatInfo(format, type);
+
+    GLuint rowBytes = 0;
+    ANGLE_CHECK_GL_MATH(contextGL,
+                        glFormatOriginal.computeRowPitch(type, area.width, pack.alignment,
+                                                         pack.rowLength, &rowBytes));
+    GLuint skipBytes = 0;
+    ANGLE_CHECK_GL_MATH(contextGL, glFormatOriginal.computeSkipBytes(type, rowBytes, 0, pack, false,
+                                                                     &skipBytes));
+
+    // Extent of the RGBA pixels, from the first one.
+    const size_t size = static_cast<size_t>(area.height - 1) * rowBytes +
+                        area.width * glFormatOriginal.computePixelBytes(type);
+
+    PendingPackConversion conversion;
+    conversion.fence          = nullptr;
+    conversion.readBuffer     = 0;
+    conversion.offset         = reinterpret_cast<size_t>(pixels) + skipBytes;
+    conversion.size           = size;
+    conversion.format         = format;
+    conversion.extents        = gl::Extents(area.width, area.height, 1);
+    conversion.readPixelBytes = glFormat.computePixelBytes(type);
+    conversion.readRowBytes   = area.width * conversion.readPixelBytes;
+    conversion.rowBytes       = rowBytes;
+
+    const size_t readSize = static_cast<size_t>(conversion.readRowBytes) * area.height;
+
+    gl::PixelPackState directPack;
+    directPack.alignment = 1;
+    ANGLE_TRY(stateManager->setPixelPackState(context, directPack));
+
+    BufferGL *packBufferGL = GetImplAs<BufferGL>(packBuffer);
+
+    // Without the ability to map buffers for reading, the pixels are read into client memory and
+    // converted right away.
+    if (features.keepBufferShadowCopy.enabled)
+    {
+        angle::MemoryBuffer readPixels;
+        ANGLE_CHECK_GL_ALLOC(contextGL, readPixels.resize(readSize));
+
+        ANGLE_TRY(stateManager->setPixelPackBuffer(context, nullptr));
+        angle::Result result =
+            ReadPixelsForPackConversion(context, area, format, type, readSize, readPixels.data());
+        ANGLE_TRY(stateManager->setPixelPackBuffer(context, packBuffer));
+        ANGLE_TRY(result);
+
+        return packBufferGL->convertPackPixels(context, conversion, readPixels.data());
+    }
+
+    // The RED or RG pixels are read tightly packed into a separate buffer, and rearranged into the
+    // pack buffer once the read has completed, so that the read doesn't have to be waited for here.
+    // Reading them into the pack buffer itself would overwrite the bytes between the rows.  The
+    // conversion is resolved before the pack buffer can next be observed, by the application or
+    // by the GPU.
+    ANGLE_GL_TRY(context, functions->genBuffers(1, &conversion.readBuffer));
+    stateManager->bindBuffer(gl::BufferBinding::PixelPack, conversion.readBuffer);
+    angle::Result result =
+        ReadPixelsForPackConversion(context, area, format, type, readSize, nullptr);
+    ANGLE_TRY(stateManager->setPixelPackBuffer(context, packBuffer));
+    if (result != angle::Result::Continue)
+    {
+        stateManager->deleteBuffer(conversion.readBuffer);
+        return result;
+    }
+
+    packBufferGL->addPendingPackConversion(context, conversion);
+    return angle::Result::Continue;
+}
+
 angle::Result FramebufferGL::readPixelsAllAtOnce(const gl::Context *context,
                                                  const gl::Rectangle &area,
                                                  GLenum originalReadFormat,
@@ -115,6 +115,17 @@ class FramebufferGL : public FramebufferImpl
                                      const gl::PixelPackState &pack,
                                      GLubyte *pixels) const;
 
+    // Reads pixels that need converting on the CPU into a pixel pack buffer, deferring the
+    // conversion until the buffer is accessed.
+    angle::Result readPixelsIntoPackBufferWithConversion(const gl::Context *context,
+                                                         const gl::Rectangle &area,
+                                                         GLenum originalReadFormat,
+                                                         GLenum format,
+                                                         GLenum type,
+                                                         const gl::PixelPackState &pack,
+                                                         gl::Buffer *packBuffer,
+                                                         GLubyte *pixels) const;
+
     angle::Result readPixelsAllAtOnce(const gl::Context *context,
                                       const gl::Rectangle &area,
                                       GLenum originalReadFormat,
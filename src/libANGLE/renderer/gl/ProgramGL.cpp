@@ -29,6 +29,11 @@
 
 namespace rx
 {
+namespace
+{
+// Marks uniform block bindings that are not known to be applied to the native program.
+constexpr GLuint kUnknownBinding = std::numeric_limits<GLuint>::max();
+}  // anonymous namespace
 
 ProgramGL::ProgramGL(const gl::ProgramState &data,
                      const FunctionsGL *functions,
@@ -39,6 +44,8 @@ ProgramGL::ProgramGL(const gl::ProgramState &data,
       mFunctions(functions),
       mFeatures(features),
       mStateManager(stateManager),
+      mDirtyUniformsBegin(std::numeric_limits<size_t>::max()),
+      mDirtyUniformsEnd(0),
       mHasAppliedTransformFeedbackVaryings(false),
       mClipDistanceEnabledUniformLocation(-1),
       mMultiviewBaseViewLayerIndexUniformLocation(-1),
@@ -109,6 +116,9 @@ void ProgramGL::reapplyUBOBindingsIfNeeded(const gl::Context *context)
     const angle::FeaturesGL &features = GetImplAs<ContextGL>(context)->getFeaturesGL();
     if (features.reapplyUBOBindingsAfterUsingBinaryProgram.enabled)
     {
+        // The bindings applied before can't be trusted.
+        std::fill(mUniformBlockBindings.begin(), mUniformBlockBindings.end(), kUnknownBinding);
+
         const auto &blocks = mState.getUniformBlocks();
         for (size_t blockIndex : mState.getActiveUniformBlockBindingsMask())
         {
@@ -221,6 +231,27 @@ class ProgramGL::LinkEventGL final : public LinkEvent
     PostLinkImplFunctor mPostLinkImplFunctor;
 };
 
+// The event for a link done on a worker thread along with the frontend link.  The calls that need
+// the context's thread are made when it is waited on.
+class ProgramGL::LinkEventDeferred final : public LinkEvent
+{
+  public:
+    LinkEventDeferred(std::function<angle::Result(const gl::Context *)> &&functor)
+        : mFunctor(std::move(functor))
+    {}
+
+    angle::Result wait(const gl::Context *context) override
+    {
+        ANGLE_TRACE_EVENT0("gpu.angle", "ProgramGL::LinkEventDeferred::wait");
+        return mFunctor(context);
+    }
+
+    bool isLinking() override { return false; }
+
+  private:
+    std::function<angle::Result(const gl::Context *)> mFunctor;
+};
+
 std::unique_ptr<LinkEvent> ProgramGL::link(const gl::Context *context,
                                            const gl::ProgramLinkedResources &resources,
                                            gl::InfoLog &infoLog,
@@ -228,6 +259,105 @@ std::unique_ptr<LinkEvent> ProgramGL::link(const gl::Context *context,
 {
     ANGLE_TRACE_EVENT0("gpu.angle", "ProgramGL::link");
 
+    prepareNativeLink(context);
+
+    auto workerPool = context->getShaderCompileThreadPool();
+    auto linkTask   = std::make_shared<LinkTask>([this](std::string &infoLog) {
+        std::string workerInfoLog;
+        ScopedWorkerContextGL worker(mRenderer.get(), &workerInfoLog);
+        if (!worker())
+        {
+#if !defined(NDEBUG)
+            infoLog += "bindWorkerContext failed.\n" + workerInfoLog;
+#endif
+            // Fallback to the main context.
+            return true;
+        }
+
+        mFunctions->linkProgram(mProgramID);
+
+        // Make sure the driver actually does the link job.
+        GLint linkStatus = GL_FALSE;
+        mFunctions->getProgramiv(mProgramID, GL_LINK_STATUS, &linkStatus);
+
+        return false;
+    });
+
+    auto postLinkImplTask = [this, &infoLog, &resources](bool fallbackToMainContext,
+                                                         const std::string &workerInfoLog) {
+        infoLog << workerInfoLog;
+        if (fallbackToMainContext)
+        {
+            mFunctions->linkProgram(mProgramID);
+        }
+
+        return finishLink(resources, infoLog);
+    };
+
+    if (mRenderer->hasNativeParallelCompile())
+    {
+        mFunctions->linkProgram(mProgramID);
+
+        return std::make_unique<LinkEventNativeParallel>(postLinkImplTask, mFunctions, mProgramID);
+    }
+    else if (workerPool->isAsync() &&
+             (!mFeatures.dontRelinkProgramsInParallel.enabled || !mLinkedInParallel))
+    {
+        mLinkedInParallel = true;
+        return std::make_unique<LinkEventGL>(workerPool, linkTask, postLinkImplTask);
+    }
+    else
+    {
+        return std::make_unique<LinkEventDone>(postLinkImplTask(true, std::string()));
+    }
+}
+
+bool ProgramGL::canLinkOnWorkerThread(const gl::Context *context) const
+{
+    return !mFeatures.dontRelinkProgramsInParallel.enabled || !mLinkedInParallel;
+}
+
+std::unique_ptr<LinkEvent> ProgramGL::linkOnWorkerThread(
+    const gl::Context *context,
+    const gl::ProgramLinkedResources &resources,
+    gl::InfoLog &infoLog,
+    const gl::ProgramMergedVaryings &mergedVaryings)
+{
+    ANGLE_TRACE_EVENT0("gpu.angle", "ProgramGL::linkOnWorkerThread");
+
+    std::string workerInfoLog;
+    ScopedWorkerContextGL worker(mRenderer.get(), &workerInfoLog);
+    if (!worker())
+    {
+#if !defined(NDEBUG)
+        infoLog << "bindWorkerContext failed.\n" << workerInfoLog;
+#endif
+        // Fall back to linking in the main context when the link is resolved.
+        return std::make_unique<LinkEventDeferred>(
+            [this, &resources, &infoLog, &mergedVaryings](const gl::Context *context) {
+                return link(context, resources, infoLog, mergedVaryings)->wait(context);
+            });
+    }
+
+    mLinkedInParallel = true;
+
+    prepareNativeLink(context);
+    mFunctions->linkProgram(mProgramID);
+
+    // Make sure the driver actually does the link job.
+    GLint linkStatus = GL_FALSE;
+    mFunctions->getProgramiv(mProgramID, GL_LINK_STATUS, &linkStatus);
+
+    return std::make_unique<LinkEventDeferred>(
+        [this, &resources, &infoLog](const gl::Context *context) {
+            return finishLink(resources, infoLog);
+        });
+}
+
+// Sets the state the native program is linked with: the attached shaders, transform feedback
+// varyings and attribute and fragment output locations.
+void ProgramGL::prepareNativeLink(const gl::Context *context)
+{
     preLink();
 
     if (mState.getAttachedShader(gl::ShaderType::Compute))
@@ -406,98 +536,414 @@ std::unique_ptr<LinkEvent> ProgramGL::link(const gl::Context *context,
             }
         }
     }
-    auto workerPool = context->getShaderCompileThreadPool();
-    auto linkTask   = std::make_shared<LinkTask>([this](std::string &infoLog) {
-        std::string workerInfoLog;
-        ScopedWorkerContextGL worker(mRenderer.get(), &workerInfoLog);
-        if (!worker())
+}
+
+// Verifies the native link, and gathers the native uniform locations and block bindings.
+angle::Result ProgramGL::finishLink(const gl::ProgramLinkedResources &resources,
+                                    gl::InfoLog &infoLog)
+{
+    if (mState.getAttachedShader(gl::ShaderType::Compute))
+    {
+        const ShaderGL *computeShaderGL =
+            GetImplAs<ShaderGL>(mState.getAttachedShader(gl::ShaderType::Compute));
+
+        mFunctions->detachShader(mProgramID, computeShaderGL->getShaderID());
+    }
+    else
+    {
+        for (const gl::ShaderType shaderType : gl::kAllGraphicsShaderTypes)
         {
-#if !defined(NDEBUG)
-            infoLog += "bindWorkerContext failed.\n" + workerInfoLog;
-#endif
-            // Fallback to the main context.
-            return true;
+            const ShaderGL *shaderGL =
+                rx::SafeGetImplAs<ShaderGL>(mState.getAttachedShader(shaderType));
+            if (shaderGL)
+            {
+                mFunctions->detachShader(mProgramID, shaderGL->getShaderID());
+            }
         }
+    }
+    // Verify the link
+    if (!checkLinkStatus(infoLog))
+    {
+        return angle::Result::Incomplete;
+    }
 
-        mFunctions->linkProgram(mProgramID);
+    if (mFeatures.alwaysCallUseProgramAfterLink.enabled)
+    {
+        mStateManager->forceUseProgram(mProgramID);
+    }
 
-        // Make sure the driver actually does the link job.
-        GLint linkStatus = GL_FALSE;
-        mFunctions->getProgramiv(mProgramID, GL_LINK_STATUS, &linkStatus);
+    linkResources(resources);
+    postLink();
+
+    return angle::Result::Continue;
+}
+
+GLboolean ProgramGL::validate(const gl::Caps & /*caps*/, gl::InfoLog * /*infoLog*/)
+{
+    // TODO(jmadill): implement validate
+    return true;
+}
 
+template <typename T>
+bool ProgramGL::deferUniformUpdate(GLint location, GLsizei count, GLboolean transpose, const T *v)
+{
+    if (mDeferredUniforms.empty() || mDeferredUniforms[location].size == 0)
+    {
+        // The caller makes the native call.
+        mStateManager->onUniformCallIssued();
         return false;
-    });
+    }
 
-    auto postLinkImplTask = [this, &infoLog, &resources](bool fallbackToMainContext,
-                                                         const std::string &workerInfoLog) {
-        infoLog << workerInfoLog;
-        if (fallbackToMainContext)
+    // The front-end clamps the count to the remaining elements of the array, which have
+    // consecutive locations.
+    ASSERT(location + count <= static_cast<GLint>(mDeferredUniforms.size()));
+
+    const size_t elementSize = mDeferredUniforms[location].size;
+    const uint8_t *data      = reinterpret_cast<const uint8_t *>(v);
+    for (GLsizei element = 0; element < count; ++element, data += elementSize)
+    {
+        const size_t elementLocation = location + element;
+        DeferredUniform &deferred    = mDeferredUniforms[elementLocation];
+        if (deferred.size == 0)
         {
-            mFunctions->linkProgram(mProgramID);
+            // Not active in the native program.
+            continue;
         }
+        ASSERT(deferred.size == elementSize);
 
-        if (mState.getAttachedShader(gl::ShaderType::Compute))
+        uint8_t *shadow = mDefaultUniformData.data() + deferred.offset;
+        if (deferred.status != DeferredUniformStatus::Unknown && deferred.transpose == transpose &&
+            memcmp(shadow, data, elementSize) == 0)
         {
-            const ShaderGL *computeShaderGL =
-                GetImplAs<ShaderGL>(mState.getAttachedShader(gl::ShaderType::Compute));
+            mStateManager->onUniformUpdateElided();
+            continue;
+        }
+
+        memcpy(shadow, data, elementSize);
+        deferred.transpose  = transpose;
+        deferred.status     = DeferredUniformStatus::Dirty;
+        mDirtyUniformsBegin = std::min(mDirtyUniformsBegin, elementLocation);
+        mDirtyUniformsEnd   = std::max(mDirtyUniformsEnd, elementLocation + 1);
+    }
+
+    return true;
+}
+
+void ProgramGL::flushDefaultUniforms() const
+{
+    const std::vector<gl::VariableLocation> &uniformLocations = mState.getUniformLocations();
 
-            mFunctions->detachShader(mProgramID, computeShaderGL->getShaderID());
+    size_t location = mDirtyUniformsBegin;
+    while (location < mDirtyUniformsEnd)
+    {
+        const DeferredUniform &first = mDeferredUniforms[location];
+        if (first.status != DeferredUniformStatus::Dirty)
+        {
+            ++location;
+            continue;
         }
-        else
+
+        // Upload the following dirty elements of the same array with the same call.
+        const gl::VariableLocation &firstLocation = uniformLocations[location];
+        size_t count                              = 1;
+        while (location + count < mDirtyUniformsEnd)
         {
-            for (const gl::ShaderType shaderType : gl::kAllGraphicsShaderTypes)
+            const DeferredUniform &next              = mDeferredUniforms[location + count];
+            const gl::VariableLocation &nextLocation = uniformLocations[location + count];
+            if (next.status != DeferredUniformStatus::Dirty || next.transpose != first.transpose ||
+                nextLocation.index != firstLocation.index ||
+                nextLocation.arrayIndex != firstLocation.arrayIndex + count)
             {
-                const ShaderGL *shaderGL =
-                    rx::SafeGetImplAs<ShaderGL>(mState.getAttachedShader(shaderType));
-                if (shaderGL)
-                {
-                    mFunctions->detachShader(mProgramID, shaderGL->getShaderID());
-                }
+                break;
             }
-        }
-        // Verify the link
-        if (!checkLinkStatus(infoLog))
-        {
-            return angle::Result::Incomplete;
+            ASSERT(next.offset == first.offset + count * first.size);
+            ++count;
         }
 
-        if (mFeatures.alwaysCallUseProgramAfterLink.enabled)
+        setNativeUniform(uniLoc(static_cast<GLint>(location)), static_cast<GLsizei>(count), first,
+                         mDefaultUniformData.data() + first.offset);
+
+        for (size_t element = 0; element < count; ++element)
         {
-            mStateManager->forceUseProgram(mProgramID);
+            mDeferredUniforms[location + element].status = DeferredUniformStatus::Clean;
         }
+        location += count;
+    }
 
-        linkResources(resources);
-        postLink();
-
-        return angle::Result::Continue;
-    };
-
-    if (mRenderer->hasNativeParallelCompile())
-    {
-        mFunctions->linkProgram(mProgramID);
+    mDirtyUniformsBegin = std::numeric_limits<size_t>::max();
+    mDirtyUniformsEnd   = 0;
+}
 
-        return std::make_unique<LinkEventNativeParallel>(postLinkImplTask, mFunctions, mProgramID);
-    }
-    else if (workerPool->isAsync() &&
-             (!mFeatures.dontRelinkProgramsInParallel.enabled || !mLinkedInParallel))
+void ProgramGL::setNativeUniform(GLint location,
+                                 GLsizei count,
+                                 const DeferredUniform &deferred,
+                                 const uint8_t *data) const
+{
+    // The glProgramUniform* functions are all loaded together.
+    const bool hasProgramUniform = mFunctions->programUniform1fv != nullptr;
+    if (!hasProgramUniform)
     {
-        mLinkedInParallel = true;
-        return std::make_unique<LinkEventGL>(workerPool, linkTask, postLinkImplTask);
+        mStateManager->useProgram(mProgramID);
     }
-    else
+    mStateManager->onUniformCallIssued();
+
+    const GLfloat *floats     = reinterpret_cast<const GLfloat *>(data);
+    const GLint *ints         = reinterpret_cast<const GLint *>(data);
+    const GLuint *uints       = reinterpret_cast<const GLuint *>(data);
+    const GLboolean transpose = deferred.transpose;
+
+    const gl::UniformTypeInfo &typeInfo = gl::GetUniformTypeInfo(deferred.type);
+    switch (typeInfo.isMatrixType ? deferred.type : typeInfo.componentType)
     {
-        return std::make_unique<LinkEventDone>(postLinkImplTask(true, std::string()));
+        case GL_FLOAT:
+            switch (typeInfo.componentCount)
+            {
+                case 1:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform1fv(mProgramID, location, count, floats);
+                    }
+                    else
+                    {
+                        mFunctions->uniform1fv(location, count, floats);
+                    }
+                    break;
+                case 2:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform2fv(mProgramID, location, count, floats);
+                    }
+                    else
+                    {
+                        mFunctions->uniform2fv(location, count, floats);
+                    }
+                    break;
+                case 3:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform3fv(mProgramID, location, count, floats);
+                    }
+                    else
+                    {
+                        mFunctions->uniform3fv(location, count, floats);
+                    }
+                    break;
+                case 4:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform4fv(mProgramID, location, count, floats);
+                    }
+                    else
+                    {
+                        mFunctions->uniform4fv(location, count, floats);
+                    }
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+            break;
+        case GL_INT:
+            switch (typeInfo.componentCount)
+            {
+                case 1:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform1iv(mProgramID, location, count, ints);
+                    }
+                    else
+                    {
+                        mFunctions->uniform1iv(location, count, ints);
+                    }
+                    break;
+                case 2:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform2iv(mProgramID, location, count, ints);
+                    }
+                    else
+                    {
+                        mFunctions->uniform2iv(location, count, ints);
+                    }
+                    break;
+                case 3:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform3iv(mProgramID, location, count, ints);
+                    }
+                    else
+                    {
+                        mFunctions->uniform3iv(location, count, ints);
+                    }
+                    break;
+                case 4:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform4iv(mProgramID, location, count, ints);
+                    }
+                    else
+                    {
+                        mFunctions->uniform4iv(location, count, ints);
+                    }
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+            break;
+        case GL_UNSIGNED_INT:
+            switch (typeInfo.componentCount)
+            {
+                case 1:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform1uiv(mProgramID, location, count, uints);
+                    }
+                    else
+                    {
+                        mFunctions->uniform1uiv(location, count, uints);
+                    }
+                    break;
+                case 2:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform2uiv(mProgramID, location, count, uints);
+                    }
+                    else
+                    {
+                        mFunctions->uniform2uiv(location, count, uints);
+                    }
+                    break;
+                case 3:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform3uiv(mProgramID, location, count, uints);
+                    }
+                    else
+                    {
+                        mFunctions->uniform3uiv(location, count, uints);
+                    }
+                    break;
+                case 4:
+                    if (hasProgramUniform)
+                    {
+                        mFunctions->programUniform4uiv(mProgramID, location, count, uints);
+                    }
+                    else
+                    {
+                        mFunctions->uniform4uiv(location, count, uints);
+                    }
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+            break;
+        case GL_FLOAT_MAT2:
+            if (hasProgramUniform)
+            {
+                mFunctions->programUniformMatrix2fv(mProgramID, location, count, transpose, floats);
+            }
+            else
+            {
+                mFunctions->uniformMatrix2fv(location, count, transpose, floats);
+            }
+            break;
+        case GL_FLOAT_MAT3:
+            if (hasProgramUniform)
+            {
+                mFunctions->programUniformMatrix3fv(mProgramID, location, count, transpose, floats);
+            }
+            else
+            {
+                mFunctions->uniformMatrix3fv(location, count, transpose, floats);
+            }
+            break;
+        case GL_FLOAT_MAT4:
+            if (hasProgramUniform)
+            {
+                mFunctions->programUniformMatrix4fv(mProgramID, location, count, transpose, floats);
+            }
+            else
+            {
+                mFunctions->uniformMatrix4fv(location, count, transpose, floats);
+            }
+            break;
+        case GL_FLOAT_MAT2x3:
+            if (hasProgramUniform)
+            {
+                mFunctions->programUniformMatrix2x3fv(mProgramID, location, count, transpose,
+                                                      floats);
+            }
+            else
+            {
+                mFunctions->uniformMatrix2x3fv(location, count, transpose, floats);
+            }
+            break;
+        case GL_FLOAT_MAT3x2:
+            if (hasProgramUniform)
+            {
+                mFunctions->programUniformMatrix3x2fv(mProgramID, location, count, transpose,
+                                                      floats);
+            }
+            else
+            {
+                mFunctions->uniformMatrix3x2fv(location, count, transpose, floats);
+            }
+            break;
+        case GL_FLOAT_MAT2x4:
+            if (hasProgramUniform)
+            {
+                mFunctions->programUniformMatrix2x4fv(mProgramID, location, count, transpose,
+                                                      floats);
+            }
+            else
+            {
+                mFunctions->uniformMatrix2x4fv(location, count, transpose, floats);
+            }
+            break;
+        case GL_FLOAT_MAT4x2:
+            if (hasProgramUniform)
+            {
+                mFunctions->programUniformMatrix4x2fv(mProgramID, location, count, transpose,
+                                                      floats);
+            }
+            else
+            {
+                mFunctions->uniformMatrix4x2fv(location, count, transpose, floats);
+            }
+            break;
+        case GL_FLOAT_MAT3x4:
+            if (hasProgramUniform)
+            {
+                mFunctions->programUniformMatrix3x4fv(mProgramID, location, count, transpose,
+                                                      floats);
+            }
+            else
+            {
+                mFunctions->uniformMatrix3x4fv(location, count, transpose, floats);
+            }
+            break;
+        case GL_FLOAT_MAT4x3:
+            if (hasProgramUniform)
+            {
+                mFunctions->programUniformMatrix4x3fv(mProgramID, location, count, transpose,
+                                                      floats);
+            }
+            else
+            {
+                mFunctions->uniformMatrix4x3fv(location, count, transpose, floats);
+            }
+            break;
+        default:
+            UNREACHABLE();
     }
 }
 
-GLboolean ProgramGL::validate(const gl::Caps & /*caps*/, gl::InfoLog * /*infoLog*/)
-{
-    // TODO(jmadill): implement validate
-    return true;
-}
-
 void ProgramGL::setUniform1fv(GLint location, GLsizei count, const GLfloat *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform1fv != nullptr)
     {
         mFunctions->programUniform1fv(mProgramID, uniLoc(location), count, v);
@@ -511,6 +957,11 @@ void ProgramGL::setUniform1fv(GLint location, GLsizei count, const GLfloat *v)
 
 void ProgramGL::setUniform2fv(GLint location, GLsizei count, const GLfloat *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform2fv != nullptr)
     {
         mFunctions->programUniform2fv(mProgramID, uniLoc(location), count, v);
@@ -524,6 +975,11 @@ void ProgramGL::setUniform2fv(GLint location, GLsizei count, const GLfloat *v)
 
 void ProgramGL::setUniform3fv(GLint location, GLsizei count, const GLfloat *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform3fv != nullptr)
     {
         mFunctions->programUniform3fv(mProgramID, uniLoc(location), count, v);
@@ -537,6 +993,11 @@ void ProgramGL::setUniform3fv(GLint location, GLsizei count, const GLfloat *v)
 
 void ProgramGL::setUniform4fv(GLint location, GLsizei count, const GLfloat *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform4fv != nullptr)
     {
         mFunctions->programUniform4fv(mProgramID, uniLoc(location), count, v);
@@ -550,6 +1011,11 @@ void ProgramGL::setUniform4fv(GLint location, GLsizei count, const GLfloat *v)
 
 void ProgramGL::setUniform1iv(GLint location, GLsizei count, const GLint *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform1iv != nullptr)
     {
         mFunctions->programUniform1iv(mProgramID, uniLoc(location), count, v);
@@ -563,6 +1029,11 @@ void ProgramGL::setUniform1iv(GLint location, GLsizei count, const GLint *v)
 
 void ProgramGL::setUniform2iv(GLint location, GLsizei count, const GLint *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform2iv != nullptr)
     {
         mFunctions->programUniform2iv(mProgramID, uniLoc(location), count, v);
@@ -576,6 +1047,11 @@ void ProgramGL::setUniform2iv(GLint location, GLsizei count, const GLint *v)
 
 void ProgramGL::setUniform3iv(GLint location, GLsizei count, const GLint *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform3iv != nullptr)
     {
         mFunctions->programUniform3iv(mProgramID, uniLoc(location), count, v);
@@ -589,6 +1065,11 @@ void ProgramGL::setUniform3iv(GLint location, GLsizei count, const GLint *v)
 
 void ProgramGL::setUniform4iv(GLint location, GLsizei count, const GLint *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform4iv != nullptr)
     {
         mFunctions->programUniform4iv(mProgramID, uniLoc(location), count, v);
@@ -602,6 +1083,11 @@ void ProgramGL::setUniform4iv(GLint location, GLsizei count, const GLint *v)
 
 void ProgramGL::setUniform1uiv(GLint location, GLsizei count, const GLuint *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform1uiv != nullptr)
     {
         mFunctions->programUniform1uiv(mProgramID, uniLoc(location), count, v);
@@ -615,6 +1101,11 @@ void ProgramGL::setUniform1uiv(GLint location, GLsizei count, const GLuint *v)
 
 void ProgramGL::setUniform2uiv(GLint location, GLsizei count, const GLuint *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform2uiv != nullptr)
     {
         mFunctions->programUniform2uiv(mProgramID, uniLoc(location), count, v);
@@ -628,6 +1119,11 @@ void ProgramGL::setUniform2uiv(GLint location, GLsizei count, const GLuint *v)
 
 void ProgramGL::setUniform3uiv(GLint location, GLsizei count, const GLuint *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform3uiv != nullptr)
     {
         mFunctions->programUniform3uiv(mProgramID, uniLoc(location), count, v);
@@ -641,6 +1137,11 @@ void ProgramGL::setUniform3uiv(GLint location, GLsizei count, const GLuint *v)
 
 void ProgramGL::setUniform4uiv(GLint location, GLsizei count, const GLuint *v)
 {
+    if (deferUniformUpdate(location, count, GL_FALSE, v))
+    {
+        return;
+    }
+
     if (mFunctions->programUniform4uiv != nullptr)
     {
         mFunctions->programUniform4uiv(mProgramID, uniLoc(location), count, v);
@@ -657,6 +1158,11 @@ void ProgramGL::setUniformMatrix2fv(GLint location,
                                     GLboolean transpose,
                                     const GLfloat *value)
 {
+    if (deferUniformUpdate(location, count, transpose, value))
+    {
+        return;
+    }
+
     if (mFunctions->programUniformMatrix2fv != nullptr)
     {
         mFunctions->programUniformMatrix2fv(mProgramID, uniLoc(location), count, transpose, value);
@@ -673,6 +1179,11 @@ void ProgramGL::setUniformMatrix3fv(GLint location,
                                     GLboolean transpose,
                                     const GLfloat *value)
 {
+    if (deferUniformUpdate(location, count, transpose, value))
+    {
+        return;
+    }
+
     if (mFunctions->programUniformMatrix3fv != nullptr)
     {
         mFunctions->programUniformMatrix3fv(mProgramID, uniLoc(location), count, transpose, value);
@@ -689,6 +1200,11 @@ void ProgramGL::setUniformMatrix4fv(GLint location,
                                     GLboolean transpose,
                                     const GLfloat *value)
 {
+    if (deferUniformUpdate(location, count, transpose, value))
+    {
+        return;
+    }
+
     if (mFunctions->programUniformMatrix4fv != nullptr)
     {
         mFunctions->programUniformMatrix4fv(mProgramID, uniLoc(location), count, transpose, value);
@@ -705,6 +1221,11 @@ void ProgramGL::setUniformMatrix2x3fv(GLint location,
                                       GLboolean transpose,
                                       const GLfloat *value)
 {
+    if (deferUniformUpdate(location, count, transpose, value))
+    {
+        return;
+    }
+
     if (mFunctions->programUniformMatrix2x3fv != nullptr)
     {
         mFunctions->programUniformMatrix2x3fv(mProgramID, uniLoc(location), count, transpose,
@@ -722,6 +1243,11 @@ void ProgramGL::setUniformMatrix3x2fv(GLint location,
                                       GLboolean transpose,
                                       const GLfloat *value)
 {
+    if (deferUniformUpdate(location, count, transpose, value))
+    {
+        return;
+    }
+
     if (mFunctions->programUniformMatrix3x2fv != nullptr)
     {
         mFunctions->programUniformMatrix3x2fv(mProgramID, uniLoc(location), count, transpose,
@@ -739,6 +1265,11 @@ void ProgramGL::setUniformMatrix2x4fv(GLint location,
                                       GLboolean transpose,
                                       const GLfloat *value)
 {
+    if (deferUniformUpdate(location, count, transpose, value))
+    {
+        return;
+    }
+
     if (mFunctions->programUniformMatrix2x4fv != nullptr)
     {
         mFunctions->programUniformMatrix2x4fv(mProgramID, uniLoc(location), count, transpose,
@@ -756,6 +1287,11 @@ void ProgramGL::setUniformMatrix4x2fv(GLint location,
                                       GLboolean transpose,
                                       const GLfloat *value)
 {
+    if (deferUniformUpdate(location, count, transpose, value))
+    {
+        return;
+    }
+
     if (mFunctions->programUniformMatrix4x2fv != nullptr)
     {
         mFunctions->programUniformMatrix4x2fv(mProgramID, uniLoc(location), count, transpose,
@@ -773,6 +1309,11 @@ void ProgramGL::setUniformMatrix3x4fv(GLint location,
                                       GLboolean transpose,
                                       const GLfloat *value)
 {
+    if (deferUniformUpdate(location, count, transpose, value))
+    {
+        return;
+    }
+
     if (mFunctions->programUniformMatrix3x4fv != nullptr)
     {
         mFunctions->programUniformMatrix3x4fv(mProgramID, uniLoc(location), count, transpose,
@@ -790,6 +1331,11 @@ void ProgramGL::setUniformMatrix4x3fv(GLint location,
                                       GLboolean transpose,
                                       const GLfloat *value)
 {
+    if (deferUniformUpdate(location, count, transpose, value))
+    {
+        return;
+    }
+
     if (mFunctions->programUniformMatrix4x3fv != nullptr)
     {
         mFunctions->programUniformMatrix4x3fv(mProgramID, uniLoc(location), count, transpose,
@@ -815,13 +1361,26 @@ void ProgramGL::setUniformBlockBinding(GLuint uniformBlockIndex, GLuint uniformB
                 mFunctions->getUniformBlockIndex(mProgramID, mappedNameWithIndex.c_str());
             mUniformBlockRealLocationMap.push_back(blockIndex);
         }
+        mUniformBlockBindings.assign(mUniformBlockRealLocationMap.size(), kUnknownBinding);
     }
 
     GLuint realBlockIndex = mUniformBlockRealLocationMap[uniformBlockIndex];
-    if (realBlockIndex != GL_INVALID_INDEX)
+    if (realBlockIndex == GL_INVALID_INDEX)
+    {
+        return;
+    }
+
+    // Program dirty bits are set for every glUniformBlockBinding call, including those that don't
+    // change the binding.
+    if (mUniformBlockBindings[uniformBlockIndex] == uniformBlockBinding)
     {
-        mFunctions->uniformBlockBinding(mProgramID, realBlockIndex, uniformBlockBinding);
+        mStateManager->onStateCallElided();
+        return;
     }
+
+    mFunctions->uniformBlockBinding(mProgramID, realBlockIndex, uniformBlockBinding);
+    mUniformBlockBindings[uniformBlockIndex] = uniformBlockBinding;
+    mStateManager->onStateCallIssued();
 }
 
 bool ProgramGL::getUniformBlockSize(const std::string & /* blockName */,
@@ -958,6 +1517,11 @@ void ProgramGL::preLink()
     // Reset the program state
     mUniformRealLocationMap.clear();
     mUniformBlockRealLocationMap.clear();
+    mUniformBlockBindings.clear();
+    mDeferredUniforms.clear();
+    mDefaultUniformData.clear();
+    mDirtyUniformsBegin = std::numeric_limits<size_t>::max();
+    mDirtyUniformsEnd   = 0;
 
     mClipDistanceEnabledUniformLocation         = -1;
     mMultiviewBaseViewLayerIndexUniformLocation = -1;
@@ -1033,6 +1597,8 @@ void ProgramGL::postLink()
         mUniformRealLocationMap[uniformLocation] = realLocation;
     }
 
+    initDeferredUniforms();
+
     if (mFeatures.emulateClipDistanceState.enabled && mState.getExecutable().hasClipDistance())
     {
         ASSERT(mFunctions->standard == STANDARD_GL_ES);
@@ -1049,6 +1615,47 @@ void ProgramGL::postLink()
     }
 }
 
+void ProgramGL::initDeferredUniforms()
+{
+    ASSERT(mDeferredUniforms.empty());
+    if (!mFeatures.deferDefaultUniformUpdates.enabled)
+    {
+        return;
+    }
+
+    const auto &uniformLocations = mState.getUniformLocations();
+    const auto &uniforms         = mState.getUniforms();
+    mDeferredUniforms.resize(uniformLocations.size());
+
+    // The elements of an array have consecutive locations, so they are also laid out contiguously
+    // in mDefaultUniformData.
+    size_t dataSize = 0;
+    for (size_t uniformLocation = 0; uniformLocation < uniformLocations.size(); uniformLocation++)
+    {
+        const gl::VariableLocation &entry = uniformLocations[uniformLocation];
+        if (!entry.used() || mUniformRealLocationMap[uniformLocation] == -1)
+        {
+            continue;
+        }
+
+        // Boolean uniforms can be set with both the integer and the float functions, so their
+        // values aren't stored.
+        const gl::LinkedUniform &uniform = uniforms[entry.index];
+        if (uniform.typeInfo->componentType == GL_BOOL)
+        {
+            continue;
+        }
+
+        DeferredUniform &deferred = mDeferredUniforms[uniformLocation];
+        deferred.offset           = static_cast<uint32_t>(dataSize);
+        deferred.size             = static_cast<uint32_t>(uniform.typeInfo->externalSize);
+        deferred.type             = uniform.type;
+        dataSize += deferred.size;
+    }
+
+    mDefaultUniformData.resize(dataSize);
+}
+
 void ProgramGL::updateEnabledClipDistances(uint8_t enabledClipDistancesPacked) const
 {
     ASSERT(mState.getExecutable().hasClipDistance());
@@ -1080,16 +1687,19 @@ void ProgramGL::enableLayeredRenderingPath(int baseViewIndex) const
 
 void ProgramGL::getUniformfv(const gl::Context *context, GLint location, GLfloat *params) const
 {
+    flushDefaultUniforms();
     mFunctions->getUniformfv(mProgramID, uniLoc(location), params);
 }
 
 void ProgramGL::getUniformiv(const gl::Context *context, GLint location, GLint *params) const
 {
+    flushDefaultUniforms();
     mFunctions->getUniformiv(mProgramID, uniLoc(location), params);
 }
 
 void ProgramGL::getUniformuiv(const gl::Context *context, GLint location, GLuint *params) const
 {
+    flushDefaultUniforms();
     mFunctions->getUniformuiv(mProgramID, uniLoc(location), params);
 }
 
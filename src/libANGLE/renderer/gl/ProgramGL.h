@@ -9,6 +9,7 @@
 #ifndef LIBANGLE_RENDERER_GL_PROGRAMGL_H_
 #define LIBANGLE_RENDERER_GL_PROGRAMGL_H_
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -49,6 +50,13 @@ class ProgramGL : public ProgramImpl
                                     const gl::ProgramMergedVaryings &mergedVaryings) override;
     GLboolean validate(const gl::Caps &caps, gl::InfoLog *infoLog) override;
 
+    bool canLinkOnWorkerThread(const gl::Context *context) const override;
+    std::unique_ptr<LinkEvent> linkOnWorkerThread(
+        const gl::Context *context,
+        const gl::ProgramLinkedResources &resources,
+        gl::InfoLog &infoLog,
+        const gl::ProgramMergedVaryings &mergedVaryings) override;
+
     void setUniform1fv(GLint location, GLsizei count, const GLfloat *v) override;
     void setUniform2fv(GLint location, GLsizei count, const GLfloat *v) override;
     void setUniform3fv(GLint location, GLsizei count, const GLfloat *v) override;
@@ -108,6 +116,10 @@ class ProgramGL : public ProgramImpl
 
     ANGLE_INLINE GLuint getProgramID() const { return mProgramID; }
 
+    // Uploads the default-block uniform values set since the last flush to the native program.
+    // Called before the program is used in a draw or dispatch.
+    void flushDefaultUniforms() const;
+
     void updateEnabledClipDistances(uint8_t enabledClipDistancesPacked) const;
 
     void enableSideBySideRenderingPath() const;
@@ -120,9 +132,12 @@ class ProgramGL : public ProgramImpl
     class LinkTask;
     class LinkEventNativeParallel;
     class LinkEventGL;
+    class LinkEventDeferred;
 
     void preLink();
+    void prepareNativeLink(const gl::Context *context);
     bool checkLinkStatus(gl::InfoLog &infoLog);
+    angle::Result finishLink(const gl::ProgramLinkedResources &resources, gl::InfoLog &infoLog);
     void postLink();
 
     void reapplyUBOBindingsIfNeeded(const gl::Context *context);
@@ -144,6 +159,39 @@ class ProgramGL : public ProgramImpl
     void linkResources(const gl::ProgramLinkedResources &resources);
     void setUniformBlockBinding(GLuint uniformBlockIndex, GLuint uniformBlockBinding);
 
+    // With the deferDefaultUniformUpdates feature, default-block uniform values are stored in
+    // mDefaultUniformData and only uploaded to the native program by flushDefaultUniforms().
+    enum class DeferredUniformStatus : uint8_t
+    {
+        // The native value is not known, e.g. right after linking.
+        Unknown,
+        // The native value is the one in mDefaultUniformData.
+        Clean,
+        // The value in mDefaultUniformData is not uploaded yet.
+        Dirty,
+    };
+
+    struct DeferredUniform
+    {
+        // Offset and size of the value of this location in mDefaultUniformData.  The size is zero
+        // if updates of this location are not deferred.
+        uint32_t offset              = 0;
+        uint32_t size                = 0;
+        GLenum type                  = GL_NONE;
+        GLboolean transpose          = GL_FALSE;
+        DeferredUniformStatus status = DeferredUniformStatus::Unknown;
+    };
+
+    void initDeferredUniforms();
+    // Stores the value instead of making the native call, and returns true if updates of
+    // |location| are deferred.
+    template <typename T>
+    bool deferUniformUpdate(GLint location, GLsizei count, GLboolean transpose, const T *v);
+    void setNativeUniform(GLint location,
+                          GLsizei count,
+                          const DeferredUniform &deferred,
+                          const uint8_t *data) const;
+
     // Helper function, makes it simpler to type.
     GLint uniLoc(GLint glLocation) const { return mUniformRealLocationMap[glLocation]; }
 
@@ -153,6 +201,15 @@ class ProgramGL : public ProgramImpl
 
     std::vector<GLint> mUniformRealLocationMap;
     std::vector<GLuint> mUniformBlockRealLocationMap;
+    // The bindings last applied to the native program, indexed like mUniformBlockRealLocationMap.
+    std::vector<GLuint> mUniformBlockBindings;
+
+    // Indexed by uniform location.  The dirty state is updated by flushes from const queries too.
+    mutable std::vector<DeferredUniform> mDeferredUniforms;
+    std::vector<uint8_t> mDefaultUniformData;
+    // Range of locations that may be dirty.
+    mutable size_t mDirtyUniformsBegin;
+    mutable size_t mDirtyUniformsEnd;
 
     bool mHasAppliedTransformFeedbackVaryings;
 
@@ -164,7 +221,8 @@ class ProgramGL : public ProgramImpl
 
     std::shared_ptr<RendererGL> mRenderer;
 
-    bool mLinkedInParallel;
+    // Written by links running on a worker thread, and read when the next link is started.
+    std::atomic<bool> mLinkedInParallel;
 };
 
 }  // namespace rx
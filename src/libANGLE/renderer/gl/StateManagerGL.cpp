@@ -164,7 +164,8 @@ StateManagerGL::StateManagerGL(const FunctionsGL *functions,
       mProvokingVertex(GL_LAST_VERTEX_CONVENTION),
       mMaxClipDistances(rendererCaps.maxClipDistances),
       mLogicOpEnabled(false),
-      mLogicOp(gl::LogicalOperation::Copy)
+      mLogicOp(gl::LogicalOperation::Copy),
+      mPerfCounters{}
 {
     ASSERT(mFunctions);
     ASSERT(rendererCaps.maxViews >= 1u);
@@ -407,12 +408,17 @@ void StateManagerGL::useProgram(GLuint program)
     {
         forceUseProgram(program);
     }
+    else
+    {
+        onStateCallElided();
+    }
 }
 
 void StateManagerGL::forceUseProgram(GLuint program)
 {
     mProgram = program;
     mFunctions->useProgram(mProgram);
+    onStateCallIssued();
     mLocalDirtyBits.set(gl::State::DIRTY_BIT_PROGRAM_BINDING);
 }
 
@@ -427,9 +433,14 @@ void StateManagerGL::bindVertexArray(GLuint vao, VertexArrayStateGL *vaoState)
         mBuffers[gl::BufferBinding::ElementArray] = vaoState ? vaoState->elementArrayBuffer : 0;
 
         mFunctions->bindVertexArray(vao);
+        onStateCallIssued();
 
         mLocalDirtyBits.set(gl::State::DIRTY_BIT_VERTEX_ARRAY_BINDING);
     }
+    else
+    {
+        onStateCallElided();
+    }
 }
 
 void StateManagerGL::bindBuffer(gl::BufferBinding target, GLuint buffer)
@@ -442,6 +453,11 @@ void StateManagerGL::bindBuffer(gl::BufferBinding target, GLuint buffer)
     {
         mBuffers[target] = buffer;
         mFunctions->bindBuffer(gl::ToGLenum(target), buffer);
+        onStateCallIssued();
+    }
+    else
+    {
+        onStateCallElided();
     }
 }
 
@@ -460,6 +476,11 @@ void StateManagerGL::bindBufferBase(gl::BufferBinding target, size_t index, GLui
         binding.size     = static_cast<size_t>(-1);
         mBuffers[target] = buffer;
         mFunctions->bindBufferBase(gl::ToGLenum(target), static_cast<GLuint>(index), buffer);
+        onStateCallIssued();
+    }
+    else
+    {
+        onStateCallElided();
     }
 }
 
@@ -481,6 +502,11 @@ void StateManagerGL::bindBufferRange(gl::BufferBinding target,
         mBuffers[target] = buffer;
         mFunctions->bindBufferRange(gl::ToGLenum(target), static_cast<GLuint>(index), buffer,
                                     offset, size);
+        onStateCallIssued();
+    }
+    else
+    {
+        onStateCallElided();
     }
 }
 
@@ -490,6 +516,11 @@ void StateManagerGL::activeTexture(size_t unit)
     {
         mTextureUnitIndex = unit;
         mFunctions->activeTexture(GL_TEXTURE0 + static_cast<GLenum>(mTextureUnitIndex));
+        onStateCallIssued();
+    }
+    else
+    {
+        onStateCallElided();
     }
 }
 
@@ -500,8 +531,13 @@ void StateManagerGL::bindTexture(gl::TextureType type, GLuint texture)
     {
         mTextures[nativeType][mTextureUnitIndex] = texture;
         mFunctions->bindTexture(nativegl::GetTextureBindingTarget(type), texture);
+        onStateCallIssued();
         mLocalDirtyBits.set(gl::State::DIRTY_BIT_TEXTURE_BINDINGS);
     }
+    else
+    {
+        onStateCallElided();
+    }
 }
 
 void StateManagerGL::invalidateTexture(gl::TextureType type)
@@ -519,8 +555,13 @@ void StateManagerGL::bindSampler(size_t unit, GLuint sampler)
     {
         mSamplers[unit] = sampler;
         mFunctions->bindSampler(static_cast<GLuint>(unit), sampler);
+        onStateCallIssued();
         mLocalDirtyBits.set(gl::State::DIRTY_BIT_SAMPLER_BINDINGS);
     }
+    else
+    {
+        onStateCallElided();
+    }
 }
 
 void StateManagerGL::bindImageTexture(size_t unit,
@@ -543,9 +584,22 @@ void StateManagerGL::bindImageTexture(size_t unit,
         binding.format  = format;
         mFunctions->bindImageTexture(angle::base::checked_cast<GLuint>(unit), texture, level,
                                      layered, layer, access, format);
+        onStateCallIssued();
+    }
+    else
+    {
+        onStateCallElided();
     }
 }
 
+void StateManagerGL::resetPerFramePerfCounters()
+{
+    mPerfCounters.stateCallsIssuedPerFrame     = 0;
+    mPerfCounters.stateCallsElidedPerFrame     = 0;
+    mPerfCounters.uniformCallsIssuedPerFrame   = 0;
+    mPerfCounters.uniformUpdatesElidedPerFrame = 0;
+}
+
 angle::Result StateManagerGL::setPixelUnpackState(const gl::Context *context,
                                                   const gl::PixelUnpackState &unpack)
 {
@@ -715,7 +769,14 @@ void StateManagerGL::bindFramebuffer(GLenum type, GLuint framebuffer)
             break;
     }
 
-    if (framebufferChanged && mFeatures.flushOnFramebufferChange.enabled)
+    if (!framebufferChanged)
+    {
+        onStateCallElided();
+        return;
+    }
+
+    onStateCallIssued();
+    if (mFeatures.flushOnFramebufferChange.enabled)
     {
         mFunctions->flush();
     }
@@ -728,6 +789,11 @@ void StateManagerGL::bindRenderbuffer(GLenum type, GLuint renderbuffer)
     {
         mRenderbuffer = renderbuffer;
         mFunctions->bindRenderbuffer(type, mRenderbuffer);
+        onStateCallIssued();
+    }
+    else
+    {
+        onStateCallElided();
     }
 }
 
@@ -942,6 +1008,7 @@ void StateManagerGL::updateProgramTextureBindings(const gl::Context *context)
         gl::Texture *texture        = textures[textureUnitIndex];
 
         // A nullptr texture indicates incomplete.
+        GLuint textureID = 0;
         if (texture != nullptr)
         {
             const TextureGL *textureGL = GetImplAs<TextureGL>(texture);
@@ -953,14 +1020,20 @@ void StateManagerGL::updateProgramTextureBindings(const gl::Context *context)
             ASSERT(!texture->hasAnyDirtyBitExcludingBoundAsAttachmentBit());
             ASSERT(!textureGL->hasAnyDirtyBit());
 
-            activeTexture(textureUnitIndex);
-            bindTexture(textureType, textureGL->getTextureID());
+            textureID = textureGL->getTextureID();
         }
-        else
+
+        // Switching programs still visits every unit the program samples from, but typically
+        // leaves most of them bound to the same textures.  Don't change the active texture unit
+        // for those.
+        if (mTextures[nativegl::GetNativeTextureType(textureType)][textureUnitIndex] == textureID)
         {
-            activeTexture(textureUnitIndex);
-            bindTexture(textureType, 0);
+            onStateCallElided();
+            continue;
         }
+
+        activeTexture(textureUnitIndex);
+        bindTexture(textureType, textureID);
     }
 }
 
@@ -312,6 +312,31 @@ class StateManagerGL final : angle::NonCopyable
     void syncFromNativeContext(const gl::Extensions &extensions, ExternalContextState *state);
     void restoreNativeContext(const gl::Extensions &extensions, const ExternalContextState *state);
 
+    // Counts native binding calls, and calls skipped because the object was already bound.
+    void onStateCallIssued()
+    {
+        ++mPerfCounters.stateCallsIssuedTotal;
+        ++mPerfCounters.stateCallsIssuedPerFrame;
+    }
+    void onStateCallElided()
+    {
+        ++mPerfCounters.stateCallsElidedTotal;
+        ++mPerfCounters.stateCallsElidedPerFrame;
+    }
+    void onUniformCallIssued()
+    {
+        ++mPerfCounters.uniformCallsIssuedTotal;
+        ++mPerfCounters.uniformCallsIssuedPerFrame;
+    }
+    void onUniformUpdateElided()
+    {
+        ++mPerfCounters.uniformUpdatesElidedTotal;
+        ++mPerfCounters.uniformUpdatesElidedPerFrame;
+    }
+
+    const angle::OpenGLPerfCounters &getPerfCounters() const { return mPerfCounters; }
+    void resetPerFramePerfCounters();
+
   private:
     void setTextureCubemapSeamlessEnabled(bool enabled);
 
@@ -540,6 +565,8 @@ class StateManagerGL final : angle::NonCopyable
     gl::State::DirtyBits mLocalDirtyBits;
     gl::State::ExtendedDirtyBits mLocalExtendedDirtyBits;
     gl::AttributesMask mLocalDirtyCurrentValues;
+
+    angle::OpenGLPerfCounters mPerfCounters;
 };
 
 }  // namespace rx
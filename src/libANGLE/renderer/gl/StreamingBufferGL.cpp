@@ -0,0 +1,370 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// StreamingBufferGL.cpp: Implements the class methods for StreamingBufferGL.
+
+#include "libANGLE/renderer/gl/StreamingBufferGL.h"
+
+#include "common/debug.h"
+#include "common/mathutil.h"
+#include "common/utilities.h"
+#include "libANGLE/Context.h"
+#include "libANGLE/formatutils.h"
+#include "libANGLE/renderer/gl/ContextGL.h"
+#include "libANGLE/renderer/gl/FunctionsGL.h"
+#include "libANGLE/renderer/gl/StateManagerGL.h"
+#include "libANGLE/renderer/gl/renderergl_utils.h"
+
+namespace rx
+{
+namespace
+{
+// Buffers in the ring are never smaller than this, so that typical client arrays fit many times in
+// one buffer before it has to be retired.
+constexpr size_t kMinimumRingBufferSize = 256 * 1024;
+
+// Allocations are aligned so that every vertex attribute type and index type is naturally aligned.
+constexpr size_t kAllocationAlignment = 16;
+
+// Timeout used for each wait on a retired buffer's fence. The wait is repeated until the fence is
+// signaled, this only bounds how long the driver blocks in a single call.
+constexpr GLuint64 kFenceWaitTimeoutNs = 100'000'000;
+
+bool CanUsePersistentMapping(const FunctionsGL *functions)
+{
+    return functions->bufferStorage != nullptr && functions->mapBufferRange != nullptr &&
+           nativegl::SupportsFenceSync(functions);
+}
+}  // anonymous namespace
+
+StreamingBufferGL::StreamingBufferGL(gl::BufferBinding binding) : mBinding(binding) {}
+
+StreamingBufferGL::~StreamingBufferGL()
+{
+    for (const Slot &slot : mSlots)
+    {
+        ASSERT(slot.buffer == 0 && slot.fence == nullptr);
+    }
+}
+
+void StreamingBufferGL::destroy(const gl::Context *context)
+{
+    const FunctionsGL *functions = GetFunctionsGL(context);
+    StateManagerGL *stateManager = GetStateManagerGL(context);
+
+    for (Slot &slot : mSlots)
+    {
+        if (slot.fence != nullptr)
+        {
+            functions->deleteSync(slot.fence);
+        }
+        // Deleting a buffer implicitly unmaps it.
+        stateManager->deleteBuffer(slot.buffer);
+        slot = Slot();
+    }
+
+    mCurrentSlot   = 0;
+    mCurrentOffset = 0;
+    mInitialized   = false;
+    mIsMapped      = false;
+}
+
+angle::Result StreamingBufferGL::map(const gl::Context *context,
+                                     size_t size,
+                                     Allocation *allocationOut)
+{
+    ASSERT(!mIsMapped);
+    ASSERT(size > 0);
+
+    const FunctionsGL *functions = GetFunctionsGL(context);
+    StateManagerGL *stateManager = GetStateManagerGL(context);
+
+    if (!GetFeaturesGL(context).streamClientArraysThroughRingBuffer.enabled)
+    {
+        return mapSingleBuffer(context, size, allocationOut);
+    }
+
+    if (!mInitialized)
+    {
+        mUsePersistentMapping = CanUsePersistentMapping(functions);
+        mInitialized          = true;
+    }
+
+    size_t offset = roundUpPow2(mCurrentOffset, kAllocationAlignment);
+    Slot *slot    = &mSlots[mCurrentSlot];
+    if (slot->buffer == 0 || offset + size > slot->size)
+    {
+        ANGLE_TRY(advanceSlot(context, size));
+        offset = 0;
+        slot   = &mSlots[mCurrentSlot];
+    }
+    else
+    {
+        stateManager->bindBuffer(mBinding, slot->buffer);
+    }
+
+    uint8_t *data = nullptr;
+    if (mUsePersistentMapping)
+    {
+        ASSERT(slot->persistentPointer != nullptr);
+        data = slot->persistentPointer + offset;
+    }
+    else if (functions->mapBufferRange != nullptr)
+    {
+        // The range was either never written since the buffer was (re)allocated or the fence
+        // guarding its previous contents has signaled, no synchronization is needed.
+        void *mapPointer = ANGLE_GL_TRY(
+            context, functions->mapBufferRange(gl::ToGLenum(mBinding), offset, size,
+                                               GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                                   GL_MAP_UNSYNCHRONIZED_BIT));
+        data      = static_cast<uint8_t *>(mapPointer);
+        mIsMapped = true;
+    }
+    else
+    {
+        data = MapBufferRangeWithFallback(functions, gl::ToGLenum(mBinding), offset, size,
+                                          GL_MAP_WRITE_BIT);
+        mIsMapped = true;
+    }
+    ANGLE_CHECK(GetImplAs<ContextGL>(context), data != nullptr,
+                "Failed to map the client data streaming buffer.", GL_OUT_OF_MEMORY);
+
+    mCurrentOffset = offset + size;
+
+    allocationOut->buffer = slot->buffer;
+    allocationOut->offset = offset;
+    allocationOut->data   = data;
+    return angle::Result::Continue;
+}
+
+angle::Result StreamingBufferGL::unmap(const gl::Context *context, GLboolean *resultOut)
+{
+    if (!mIsMapped)
+    {
+        // Persistently mapped buffers are coherent, there is nothing to flush.
+        *resultOut = GL_TRUE;
+        return angle::Result::Continue;
+    }
+
+    const FunctionsGL *functions = GetFunctionsGL(context);
+    StateManagerGL *stateManager = GetStateManagerGL(context);
+
+    // The buffer may have been unbound while data was written, e.g. by the
+    // shiftInstancedArrayDataWithOffset workaround reading from another buffer.
+    const Slot &slot = mSlots[mCurrentSlot];
+    stateManager->bindBuffer(mBinding, slot.buffer);
+
+    mIsMapped  = false;
+    *resultOut = ANGLE_GL_TRY(context, functions->unmapBuffer(gl::ToGLenum(mBinding)));
+    return angle::Result::Continue;
+}
+
+template <typename WriteFunc>
+angle::Result StreamingBufferGL::mapAndWrite(const gl::Context *context,
+                                             size_t size,
+                                             WriteFunc &&write,
+                                             Allocation *allocationOut)
+{
+    // Unmapping a buffer can return GL_FALSE to indicate that the system has corrupted the data
+    // somehow (such as by a screen change), retry writing the data a few times and return
+    // OUT_OF_MEMORY if that fails.
+    GLboolean unmapResult     = GL_FALSE;
+    size_t unmapRetryAttempts = 5;
+    while (unmapResult != GL_TRUE && --unmapRetryAttempts > 0)
+    {
+        ANGLE_TRY(map(context, size, allocationOut));
+
+        write(allocationOut->data);
+        ANGLE_TRY(unmap(context, &unmapResult));
+    }
+
+    ANGLE_CHECK(GetImplAs<ContextGL>(context), unmapResult == GL_TRUE,
+                "Failed to unmap the client data streaming buffer.", GL_OUT_OF_MEMORY);
+    return angle::Result::Continue;
+}
+
+angle::Result StreamingBufferGL::streamData(const gl::Context *context,
+                                            const void *data,
+                                            size_t size,
+                                            Allocation *allocationOut)
+{
+    return mapAndWrite(
+        context, size, [data, size](uint8_t *dst) { memcpy(dst, data, size); }, allocationOut);
+}
+
+angle::Result StreamingBufferGL::streamIndices(const gl::Context *context,
+                                               gl::DrawElementsType type,
+                                               const void *indices,
+                                               size_t count,
+                                               bool primitiveRestartEnabled,
+                                               gl::IndexRange *indexRangeOut,
+                                               Allocation *allocationOut)
+{
+    return mapAndWrite(
+        context, count * gl::GetDrawElementsTypeSize(type),
+        [=](uint8_t *dst) {
+            *indexRangeOut = gl::CopyIndicesAndComputeRange(type, indices, count,
+                                                            primitiveRestartEnabled, dst);
+        },
+        allocationOut);
+}
+
+angle::Result StreamingBufferGL::mapSingleBuffer(const gl::Context *context,
+                                                 size_t size,
+                                                 Allocation *allocationOut)
+{
+    const FunctionsGL *functions = GetFunctionsGL(context);
+    StateManagerGL *stateManager = GetStateManagerGL(context);
+
+    // Features are fixed at display creation, the ring is never used alongside this path.
+    ASSERT(!mInitialized);
+
+    Slot &slot = mSlots[0];
+    if (slot.buffer == 0)
+    {
+        ANGLE_GL_TRY(context, functions->genBuffers(1, &slot.buffer));
+        slot.size = 0;
+    }
+
+    stateManager->bindBuffer(mBinding, slot.buffer);
+    if (size > slot.size)
+    {
+        ANGLE_GL_TRY(context, functions->bufferData(gl::ToGLenum(mBinding), size, nullptr,
+                                                    GL_DYNAMIC_DRAW));
+        slot.size = size;
+    }
+
+    uint8_t *data =
+        MapBufferRangeWithFallback(functions, gl::ToGLenum(mBinding), 0, size, GL_MAP_WRITE_BIT);
+    ANGLE_CHECK(GetImplAs<ContextGL>(context), data != nullptr,
+                "Failed to map the client data streaming buffer.", GL_OUT_OF_MEMORY);
+    mIsMapped = true;
+
+    mCurrentSlot          = 0;
+    allocationOut->buffer = slot.buffer;
+    allocationOut->offset = 0;
+    allocationOut->data   = data;
+    return angle::Result::Continue;
+}
+
+angle::Result StreamingBufferGL::advanceSlot(const gl::Context *context, size_t size)
+{
+    const FunctionsGL *functions = GetFunctionsGL(context);
+    StateManagerGL *stateManager = GetStateManagerGL(context);
+
+    // Retire the current buffer. Every draw that reads from it has already been issued, so a fence
+    // inserted now guards all of its contents.
+    Slot &current = mSlots[mCurrentSlot];
+    if (current.buffer != 0 && nativegl::SupportsFenceSync(functions))
+    {
+        ASSERT(current.fence == nullptr);
+        current.fence = functions->fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        GetImplAs<ContextGL>(context)->markWorkSubmitted();
+    }
+
+    mCurrentSlot   = (mCurrentSlot + 1) % kRingSize;
+    mCurrentOffset = 0;
+
+    Slot &next = mSlots[mCurrentSlot];
+    if (next.buffer != 0 && size <= next.size)
+    {
+        bool reusable = false;
+        ANGLE_TRY(waitForSlot(context, &next, &reusable));
+        if (reusable)
+        {
+            stateManager->bindBuffer(mBinding, next.buffer);
+            return angle::Result::Continue;
+        }
+    }
+
+    // The buffer is either too small or its previous contents could not be waited on, give it a
+    // new data store.
+    return allocateSlotStorage(context, &next, std::max(size, kMinimumRingBufferSize));
+}
+
+angle::Result StreamingBufferGL::allocateSlotStorage(const gl::Context *context,
+                                                     Slot *slot,
+                                                     size_t size)
+{
+    const FunctionsGL *functions = GetFunctionsGL(context);
+    StateManagerGL *stateManager = GetStateManagerGL(context);
+
+    // The driver keeps the old data store alive until the GPU is done with it, the fence is not
+    // needed anymore.
+    if (slot->fence != nullptr)
+    {
+        functions->deleteSync(slot->fence);
+        slot->fence = nullptr;
+    }
+
+    if (mUsePersistentMapping)
+    {
+        // Immutable storage can't be resized, a new buffer name is required.
+        if (slot->buffer != 0)
+        {
+            stateManager->deleteBuffer(slot->buffer);
+            slot->buffer            = 0;
+            slot->persistentPointer = nullptr;
+        }
+
+        ANGLE_GL_TRY(context, functions->genBuffers(1, &slot->buffer));
+        stateManager->bindBuffer(mBinding, slot->buffer);
+
+        constexpr GLbitfield kStorageFlags =
+            GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        ANGLE_GL_TRY(context, functions->bufferStorage(gl::ToGLenum(mBinding), size, nullptr,
+                                                       kStorageFlags));
+        void *mapPointer = ANGLE_GL_TRY(
+            context, functions->mapBufferRange(gl::ToGLenum(mBinding), 0, size, kStorageFlags));
+        slot->persistentPointer = static_cast<uint8_t *>(mapPointer);
+        ANGLE_CHECK(GetImplAs<ContextGL>(context), slot->persistentPointer != nullptr,
+                    "Failed to map the client data streaming buffer.", GL_OUT_OF_MEMORY);
+    }
+    else
+    {
+        if (slot->buffer == 0)
+        {
+            ANGLE_GL_TRY(context, functions->genBuffers(1, &slot->buffer));
+        }
+        stateManager->bindBuffer(mBinding, slot->buffer);
+
+        // Orphans the previous data store of the buffer if there was one.
+        ANGLE_GL_TRY(context, functions->bufferData(gl::ToGLenum(mBinding), size, nullptr,
+                                                    GL_STREAM_DRAW));
+    }
+
+    slot->size = size;
+    return angle::Result::Continue;
+}
+
+angle::Result StreamingBufferGL::waitForSlot(const gl::Context *context,
+                                             Slot *slot,
+                                             bool *reusableOut)
+{
+    const FunctionsGL *functions = GetFunctionsGL(context);
+
+    if (slot->fence == nullptr)
+    {
+        // Without fence sync support the data store has to be orphaned instead.
+        *reusableOut = false;
+        return angle::Result::Continue;
+    }
+
+    GLenum result = GL_TIMEOUT_EXPIRED;
+    while (result == GL_TIMEOUT_EXPIRED)
+    {
+        result = ANGLE_GL_TRY(context, functions->clientWaitSync(
+                                           slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                           kFenceWaitTimeoutNs));
+    }
+
+    functions->deleteSync(slot->fence);
+    slot->fence  = nullptr;
+    *reusableOut = result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+    return angle::Result::Continue;
+}
+
+}  // namespace rx
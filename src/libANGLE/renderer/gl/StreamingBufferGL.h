@@ -0,0 +1,116 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// StreamingBufferGL.h: Defines the class interface for StreamingBufferGL, a ring of native buffers
+// that client-side vertex and index data is sub-allocated from before draws, and that large texture
+// uploads from client memory are staged in.
+
+#ifndef LIBANGLE_RENDERER_GL_STREAMINGBUFFERGL_H_
+#define LIBANGLE_RENDERER_GL_STREAMINGBUFFERGL_H_
+
+#include <array>
+
+#include "common/PackedEnums.h"
+#include "common/angleutils.h"
+#include "libANGLE/Error.h"
+#include "libANGLE/angletypes.h"
+
+namespace gl
+{
+class Context;
+}  // namespace gl
+
+namespace rx
+{
+
+// Client data used to be written to the start of a single buffer on every draw, which forces the
+// driver to wait for the previous draw that read from it. StreamingBufferGL instead hands out
+// consecutive ranges of a buffer, moving to the next buffer of a small ring once the current one is
+// full. A fence is inserted when a buffer is retired and waited on before the buffer is written
+// again, so writes never overlap data that may still be in flight and can be mapped unsynchronized.
+// When the native driver supports immutable buffer storage the buffers are persistently mapped.
+//
+// If the streamClientArraysThroughRingBuffer feature is disabled, a single buffer is written from
+// offset zero on every allocation, matching the historical behavior.  This also applies to the ring
+// texture uploads are staged in, which then waits for the previous upload on every chunk.
+class StreamingBufferGL : angle::NonCopyable
+{
+  public:
+    struct Allocation
+    {
+        // Native buffer that the data must be written to. It is left bound to the binding point
+        // the StreamingBufferGL was created with.
+        GLuint buffer = 0;
+        size_t offset = 0;
+        uint8_t *data = nullptr;
+    };
+
+    explicit StreamingBufferGL(gl::BufferBinding binding);
+    ~StreamingBufferGL();
+
+    void destroy(const gl::Context *context);
+
+    // Reserves |size| bytes and returns a CPU pointer to write them through. The allocation must be
+    // committed with unmap() before it is used by a draw call. Buffers that are too small are
+    // deleted through the StateManagerGL, which only updates the cached state of the bound vertex
+    // array, so the vertex array using the streamed data must be bound before calling this.
+    angle::Result map(const gl::Context *context, size_t size, Allocation *allocationOut);
+    // |resultOut| is GL_FALSE if the data store was corrupted while it was mapped, in which case
+    // the data must be written again through a new allocation.
+    angle::Result unmap(const gl::Context *context, GLboolean *resultOut);
+
+    // Convenience function to map, copy and unmap |size| bytes of |data|.
+    angle::Result streamData(const gl::Context *context,
+                             const void *data,
+                             size_t size,
+                             Allocation *allocationOut);
+    // Same as streamData() for |count| indices of |type|, also returning their range, which is
+    // computed while they are copied rather than in a separate pass over the client data.
+    angle::Result streamIndices(const gl::Context *context,
+                                gl::DrawElementsType type,
+                                const void *indices,
+                                size_t count,
+                                bool primitiveRestartEnabled,
+                                gl::IndexRange *indexRangeOut,
+                                Allocation *allocationOut);
+
+  private:
+    static constexpr size_t kRingSize = 3;
+
+    struct Slot
+    {
+        GLuint buffer              = 0;
+        size_t size                = 0;
+        GLsync fence               = nullptr;
+        uint8_t *persistentPointer = nullptr;
+    };
+
+    template <typename WriteFunc>
+    angle::Result mapAndWrite(const gl::Context *context,
+                              size_t size,
+                              WriteFunc &&write,
+                              Allocation *allocationOut);
+    angle::Result mapSingleBuffer(const gl::Context *context,
+                                  size_t size,
+                                  Allocation *allocationOut);
+    angle::Result advanceSlot(const gl::Context *context, size_t size);
+    angle::Result allocateSlotStorage(const gl::Context *context, Slot *slot, size_t size);
+    angle::Result waitForSlot(const gl::Context *context, Slot *slot, bool *reusableOut);
+
+    const gl::BufferBinding mBinding;
+
+    std::array<Slot, kRingSize> mSlots;
+    size_t mCurrentSlot   = 0;
+    size_t mCurrentOffset = 0;
+
+    bool mUsePersistentMapping = false;
+    bool mInitialized          = false;
+    bool mIsMapped             = false;
+};
+
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_GL_STREAMINGBUFFERGL_H_
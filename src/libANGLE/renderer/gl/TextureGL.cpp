@@ -41,6 +41,32 @@ namespace
 // For use with the uploadTextureDataInChunks feature.  See http://crbug.com/1181068
 constexpr const size_t kUploadTextureDataInChunksUploadSize = (120 * 1024) - 1;
 
+// For use with the uploadTextureDataThroughStagingBuffers feature.  Smaller uploads are left to
+// the driver, staging them would only add a copy.
+constexpr size_t kStagedUploadMinimumSize = 512 * 1024;
+constexpr size_t kStagedUploadChunkSize   = 1024 * 1024;
+
+bool ShouldStageUpload(const angle::FeaturesGL &features,
+                       const gl::Buffer *unpackBuffer,
+                       const uint8_t *pixels,
+                       const gl::Extents &size,
+                       GLenum format,
+                       GLenum type)
+{
+    if (!features.uploadTextureDataThroughStagingBuffers.enabled || unpackBuffer != nullptr ||
+        pixels == nullptr)
+    {
+        return false;
+    }
+
+    const gl::InternalFormat &glFormat = gl::GetInternalFormatInfo(format, type);
+    CheckedNumeric<size_t> dataSize    = glFormat.computePixelBytes(type);
+    dataSize *= size.width;
+    dataSize *= size.height;
+    dataSize *= size.depth;
+    return dataSize.IsValid() && dataSize.ValueOrDie() >= kStagedUploadMinimumSize;
+}
+
 size_t GetLevelInfoIndex(gl::TextureTarget target, size_t level)
 {
     return gl::IsCubeMapFaceTarget(target)
@@ -220,6 +246,16 @@ angle::Result TextureGL::setImage(const gl::Context *context,
         }
     }
 
+    if (ShouldStageUpload(features, unpackBuffer, pixels, size, format, type))
+    {
+        ANGLE_TRY(
+            reserveTexImageToBeFilled(context, target, level, internalFormat, size, format, type));
+
+        gl::Box area(0, 0, 0, size.width, size.height, size.depth);
+        return setSubImageThroughStagingBuffer(context, target, level, area, format, type, unpack,
+                                               pixels);
+    }
+
     ANGLE_TRY(setImageHelper(context, target, level, internalFormat, size, format, type, pixels));
 
     return angle::Result::Continue;
@@ -380,6 +416,15 @@ angle::Result TextureGL::setSubImage(const gl::Context *context,
         return angle::Result::Continue;
     }
 
+    if (ShouldStageUpload(features, unpackBuffer, pixels,
+                          gl::Extents(area.width, area.height, area.depth), format, type))
+    {
+        ANGLE_TRY(setSubImageThroughStagingBuffer(context, target, level, area, format, type,
+                                                  unpack, pixels));
+        contextGL->markWorkSubmitted();
+        return angle::Result::Continue;
+    }
+
     if (nativegl::UseTexImage2D(getType()))
     {
         ASSERT(area.z == 0 && area.depth == 1);
@@ -577,6 +622,102 @@ angle::Result TextureGL::setSubImagePaddingWorkaround(const gl::Context *context
     return angle::Result::Continue;
 }
 
+angle::Result TextureGL::setSubImageThroughStagingBuffer(const gl::Context *context,
+                                                         gl::TextureTarget target,
+                                                         size_t level,
+                                                         const gl::Box &area,
+                                                         GLenum format,
+                                                         GLenum type,
+                                                         const gl::PixelUnpackState &unpack,
+                                                         const uint8_t *pixels)
+{
+    ContextGL *contextGL              = GetImplAs<ContextGL>(context);
+    const FunctionsGL *functions      = GetFunctionsGL(context);
+    StateManagerGL *stateManager      = GetStateManagerGL(context);
+    const angle::FeaturesGL &features = GetFeaturesGL(context);
+
+    const gl::InternalFormat &glFormat = gl::GetInternalFormatInfo(format, type);
+    GLuint rowBytes                    = 0;
+    ANGLE_CHECK_GL_MATH(contextGL, glFormat.computeRowPitch(type, area.width, unpack.alignment,
+                                                            unpack.rowLength, &rowBytes));
+    GLuint imageBytes = 0;
+    ANGLE_CHECK_GL_MATH(contextGL, glFormat.computeDepthPitch(area.height, unpack.imageHeight,
+                                                              rowBytes, &imageBytes));
+    bool useTexImage3D = nativegl::UseTexImage3D(getType());
+    GLuint skipBytes   = 0;
+    ANGLE_CHECK_GL_MATH(contextGL, glFormat.computeSkipBytes(type, rowBytes, imageBytes, unpack,
+                                                             useTexImage3D, &skipBytes));
+
+    // Rows are tightly packed in the staging buffer.
+    const size_t stagedRowBytes =
+        static_cast<size_t>(area.width) * glFormat.computePixelBytes(type);
+    const GLint rowsPerChunk = std::min(
+        std::max(static_cast<GLint>(kStagedUploadChunkSize / stagedRowBytes), 1), area.height);
+
+    gl::PixelUnpackState stagedUnpack;
+    stagedUnpack.alignment = 1;
+    ANGLE_TRY(stateManager->setPixelUnpackState(context, stagedUnpack));
+
+    nativegl::TexSubImageFormat texSubImageFormat =
+        nativegl::GetTexSubImageFormat(functions, features, format, type);
+
+    StreamingBufferGL *uploadBuffer = contextGL->getTextureUploadBuffer();
+    const uint8_t *pixelsWithSkip   = pixels + skipBytes;
+    for (GLint image = 0; image < area.depth; ++image)
+    {
+        for (GLint row = 0; row < area.height; row += rowsPerChunk)
+        {
+            const GLint height         = std::min(rowsPerChunk, area.height - row);
+            const uint8_t *chunkPixels = pixelsWithSkip + image * imageBytes + row * rowBytes;
+            const size_t chunkSize     = stagedRowBytes * height;
+
+            // The previous chunks are still being transferred from the other buffers of the ring
+            // while this one is copied.
+            StreamingBufferGL::Allocation allocation;
+            ANGLE_TRY(uploadBuffer->map(context, chunkSize, &allocation));
+            if (rowBytes == stagedRowBytes)
+            {
+                memcpy(allocation.data, chunkPixels, chunkSize);
+            }
+            else
+            {
+                for (GLint chunkRow = 0; chunkRow < height; ++chunkRow)
+                {
+                    memcpy(allocation.data + chunkRow * stagedRowBytes,
+                           chunkPixels + chunkRow * rowBytes, stagedRowBytes);
+                }
+            }
+
+            GLboolean unmapResult = GL_FALSE;
+            ANGLE_TRY(uploadBuffer->unmap(context, &unmapResult));
+            ANGLE_CHECK(contextGL, unmapResult == GL_TRUE,
+                        "Failed to unmap the texture upload staging buffer.", GL_OUT_OF_MEMORY);
+
+            const void *offset = reinterpret_cast<const void *>(allocation.offset);
+            if (useTexImage3D)
+            {
+                ANGLE_GL_TRY(context,
+                             functions->texSubImage3D(
+                                 ToGLenum(target), static_cast<GLint>(level), area.x, row + area.y,
+                                 image + area.z, area.width, height, 1, texSubImageFormat.format,
+                                 texSubImageFormat.type, offset));
+            }
+            else
+            {
+                ASSERT(nativegl::UseTexImage2D(getType()) && area.depth == 1);
+                ANGLE_GL_TRY(context,
+                             functions->texSubImage2D(ToGLenum(target), static_cast<GLint>(level),
+                                                      area.x, row + area.y, area.width, height,
+                                                      texSubImageFormat.format,
+                                                      texSubImageFormat.type, offset));
+            }
+        }
+    }
+
+    // Uploads from client memory are made without a pixel unpack buffer bound.
+    return stateManager->setPixelUnpackBuffer(context, nullptr);
+}
+
 angle::Result TextureGL::setCompressedImage(const gl::Context *context,
                                             const gl::ImageIndex &index,
                                             GLenum internalFormat,
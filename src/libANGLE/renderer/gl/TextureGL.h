@@ -256,6 +256,18 @@ class TextureGL : public TextureImpl
                                                const gl::Buffer *unpackBuffer,
                                                const uint8_t *pixels);
 
+    // Uploads client memory in chunks through the context's ring of pixel unpack buffers, so that
+    // copying one chunk overlaps the transfer of the previous ones.  This changes the current pixel
+    // unpack state that will have to be reapplied.
+    angle::Result setSubImageThroughStagingBuffer(const gl::Context *context,
+                                                  gl::TextureTarget target,
+                                                  size_t level,
+                                                  const gl::Box &area,
+                                                  GLenum format,
+                                                  GLenum type,
+                                                  const gl::PixelUnpackState &unpack,
+                                                  const uint8_t *pixels);
+
     angle::Result syncTextureStateSwizzle(const gl::Context *context,
                                           const FunctionsGL *functions,
                                           GLenum name,
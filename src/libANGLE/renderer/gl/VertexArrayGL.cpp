@@ -108,7 +108,9 @@ VertexArrayGL::VertexArrayGL(const VertexArrayState &state, GLuint id)
     : VertexArrayImpl(state),
       mVertexArrayID(id),
       mOwnsNativeState(true),
-      mNativeState(new VertexArrayStateGL(state.getMaxAttribs(), state.getMaxBindings()))
+      mNativeState(new VertexArrayStateGL(state.getMaxAttribs(), state.getMaxBindings())),
+      mStreamingElementArrayBuffer(gl::BufferBinding::ElementArray),
+      mStreamingArrayBuffer(gl::BufferBinding::Array)
 {
     mForcedStreamingAttributesFirstOffsets.fill(0);
 }
@@ -116,7 +118,12 @@ VertexArrayGL::VertexArrayGL(const VertexArrayState &state, GLuint id)
 VertexArrayGL::VertexArrayGL(const gl::VertexArrayState &state,
                              GLuint id,
                              VertexArrayStateGL *sharedState)
-    : VertexArrayImpl(state), mVertexArrayID(id), mOwnsNativeState(false), mNativeState(sharedState)
+    : VertexArrayImpl(state),
+      mVertexArrayID(id),
+      mOwnsNativeState(false),
+      mNativeState(sharedState),
+      mStreamingElementArrayBuffer(gl::BufferBinding::ElementArray),
+      mStreamingArrayBuffer(gl::BufferBinding::Array)
 {
     ASSERT(mNativeState);
     mForcedStreamingAttributesFirstOffsets.fill(0);
@@ -141,13 +148,8 @@ void VertexArrayGL::destroy(const gl::Context *context)
         binding.set(context, nullptr);
     }
 
-    stateManager->deleteBuffer(mStreamingElementArrayBuffer);
-    mStreamingElementArrayBufferSize = 0;
-    mStreamingElementArrayBuffer     = 0;
-
-    stateManager->deleteBuffer(mStreamingArrayBuffer);
-    mStreamingArrayBufferSize = 0;
-    mStreamingArrayBuffer     = 0;
+    mStreamingElementArrayBuffer.destroy(context);
+    mStreamingArrayBuffer.destroy(context);
 
     if (mOwnsNativeState)
     {
@@ -289,52 +291,37 @@ angle::Result VertexArrayGL::syncIndexData(const gl::Context *context,
     }
     else
     {
-        const FunctionsGL *functions = GetFunctionsGL(context);
         StateManagerGL *stateManager = GetStateManagerGL(context);
 
         // Need to stream the index buffer
         // TODO: if GLES, nothing needs to be streamed
 
-        // Only compute the index range if the attributes also need to be streamed
-        if (attributesNeedStreaming)
-        {
-            *outIndexRange = ComputeIndexRange(type, indices, count, primitiveRestartEnabled);
-        }
-
-        // Allocate the streaming element array buffer
-        if (mStreamingElementArrayBuffer == 0)
-        {
-            ANGLE_GL_TRY(context, functions->genBuffers(1, &mStreamingElementArrayBuffer));
-            mStreamingElementArrayBufferSize = 0;
-        }
-
+        // The element array buffer binding is vertex array state, the vertex array must be bound
+        // before the streaming buffer
         stateManager->bindVertexArray(mVertexArrayID, mNativeState);
 
-        stateManager->bindBuffer(gl::BufferBinding::ElementArray, mStreamingElementArrayBuffer);
-        mElementArrayBuffer.set(context, nullptr);
-        mNativeState->elementArrayBuffer = mStreamingElementArrayBuffer;
-
-        // Make sure the element array buffer is large enough
-        const GLuint indexTypeBytes        = gl::GetDrawElementsTypeSize(type);
-        size_t requiredStreamingBufferSize = indexTypeBytes * count;
-        if (requiredStreamingBufferSize > mStreamingElementArrayBufferSize)
+        // Only compute the index range if the attributes also need to be streamed, in which case
+        // it is computed while the indices are copied.
+        StreamingBufferGL::Allocation allocation;
+        if (attributesNeedStreaming)
         {
-            // Copy the indices in while resizing the buffer
-            ANGLE_GL_TRY(context,
-                         functions->bufferData(GL_ELEMENT_ARRAY_BUFFER, requiredStreamingBufferSize,
-                                               indices, GL_DYNAMIC_DRAW));
-            mStreamingElementArrayBufferSize = requiredStreamingBufferSize;
+            ANGLE_TRY(mStreamingElementArrayBuffer.streamIndices(
+                context, type, indices, count, primitiveRestartEnabled, outIndexRange,
+                &allocation));
         }
         else
         {
-            // Put the indices at the beginning of the buffer
-            ANGLE_GL_TRY(context, functions->bufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0,
-                                                           requiredStreamingBufferSize, indices));
+            const GLuint indexTypeBytes = gl::GetDrawElementsTypeSize(type);
+            ANGLE_TRY(mStreamingElementArrayBuffer.streamData(
+                context, indices, indexTypeBytes * count, &allocation));
         }
 
-        // Set the index offset for the draw call to zero since the supplied index pointer is to
-        // client data
-        *outIndices = nullptr;
+        mElementArrayBuffer.set(context, nullptr);
+        mNativeState->elementArrayBuffer = allocation.buffer;
+
+        // The supplied index pointer is to client data, the draw call uses the offset of the
+        // indices in the streaming buffer instead
+        *outIndices = reinterpret_cast<const void *>(allocation.offset);
     }
 
     return angle::Result::Continue;
@@ -393,26 +380,12 @@ angle::Result VertexArrayGL::streamAttributes(
         return angle::Result::Continue;
     }
 
-    if (mStreamingArrayBuffer == 0)
-    {
-        ANGLE_GL_TRY(context, functions->genBuffers(1, &mStreamingArrayBuffer));
-        mStreamingArrayBufferSize = 0;
-    }
-
     // If first is greater than zero, a slack space needs to be left at the beginning of the buffer
     // for each attribute so that the same 'first' argument can be passed into the draw call.
     const size_t bufferEmptySpace =
         attribsToStream.count() * maxAttributeDataSize * indexRange.start;
     const size_t requiredBufferSize = streamingDataSize + bufferEmptySpace;
 
-    stateManager->bindBuffer(gl::BufferBinding::Array, mStreamingArrayBuffer);
-    if (requiredBufferSize > mStreamingArrayBufferSize)
-    {
-        ANGLE_GL_TRY(context, functions->bufferData(GL_ARRAY_BUFFER, requiredBufferSize, nullptr,
-                                                    GL_DYNAMIC_DRAW));
-        mStreamingArrayBufferSize = requiredBufferSize;
-    }
-
     stateManager->bindVertexArray(mVertexArrayID, mNativeState);
 
     // Unmapping a buffer can return GL_FALSE to indicate that the system has corrupted the data
@@ -422,8 +395,10 @@ angle::Result VertexArrayGL::streamAttributes(
     size_t unmapRetryAttempts = 5;
     while (unmapResult != GL_TRUE && --unmapRetryAttempts > 0)
     {
-        uint8_t *bufferPointer = MapBufferRangeWithFallback(functions, GL_ARRAY_BUFFER, 0,
-                                                            requiredBufferSize, GL_MAP_WRITE_BIT);
+        StreamingBufferGL::Allocation allocation;
+        ANGLE_TRY(mStreamingArrayBuffer.map(context, requiredBufferSize, &allocation));
+
+        uint8_t *bufferPointer = allocation.data;
         size_t curBufferOffset = maxAttributeDataSize * indexRange.start;
 
         const auto &attribs  = mState.getVertexAttributes();
@@ -521,11 +496,12 @@ angle::Result VertexArrayGL::streamAttributes(
             if (needsUnmapAndRebindStreamingAttributeBuffer)
             {
                 ANGLE_GL_TRY(context, functions->unmapBuffer(GL_ARRAY_BUFFER));
-                stateManager->bindBuffer(gl::BufferBinding::Array, mStreamingArrayBuffer);
+                stateManager->bindBuffer(gl::BufferBinding::Array, allocation.buffer);
             }
 
             // Compute where the 0-index vertex would be.
-            const size_t vertexStartOffset = curBufferOffset - (firstIndex * destStride);
+            const size_t vertexStartOffset =
+                allocation.offset + curBufferOffset - (firstIndex * destStride);
 
             ANGLE_TRY(callVertexAttribPointer(context, static_cast<GLuint>(idx), attrib,
                                               static_cast<GLsizei>(destStride),
@@ -540,7 +516,7 @@ angle::Result VertexArrayGL::streamAttributes(
             mNativeState->bindings[idx].stride = static_cast<GLsizei>(destStride);
             mNativeState->bindings[idx].offset = static_cast<GLintptr>(vertexStartOffset);
             mArrayBuffers[idx].set(context, nullptr);
-            mNativeState->bindings[idx].buffer = mStreamingArrayBuffer;
+            mNativeState->bindings[idx].buffer = allocation.buffer;
 
             // There's maxAttributeDataSize * indexRange.start of empty space allocated for each
             // streaming attributes
@@ -548,7 +524,7 @@ angle::Result VertexArrayGL::streamAttributes(
                 destStride * streamedVertexCount + maxAttributeDataSize * indexRange.start;
         }
 
-        unmapResult = ANGLE_GL_TRY(context, functions->unmapBuffer(GL_ARRAY_BUFFER));
+        ANGLE_TRY(mStreamingArrayBuffer.unmap(context, &unmapResult));
     }
 
     ANGLE_CHECK(GetImplAs<ContextGL>(context), unmapResult == GL_TRUE,
@@ -14,6 +14,7 @@
 #include "common/mathutil.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/renderer/gl/ContextGL.h"
+#include "libANGLE/renderer/gl/StreamingBufferGL.h"
 
 namespace rx
 {
@@ -139,11 +140,8 @@ class VertexArrayGL : public VertexArrayImpl
     mutable gl::BindingPointer<gl::Buffer> mElementArrayBuffer;
     mutable std::array<gl::BindingPointer<gl::Buffer>, gl::MAX_VERTEX_ATTRIBS> mArrayBuffers;
 
-    mutable size_t mStreamingElementArrayBufferSize = 0;
-    mutable GLuint mStreamingElementArrayBuffer     = 0;
-
-    mutable size_t mStreamingArrayBufferSize = 0;
-    mutable GLuint mStreamingArrayBuffer     = 0;
+    mutable StreamingBufferGL mStreamingElementArrayBuffer;
+    mutable StreamingBufferGL mStreamingArrayBuffer;
 
     // Used for Mac Intel instanced draw workaround
     mutable gl::AttributesMask mForcedStreamingAttributesForDrawArraysInstancedMask;
@@ -17,6 +17,7 @@
 #include "libANGLE/renderer/gl/RendererGL.h"
 #include "libANGLE/renderer/gl/egl/ContextEGL.h"
 #include "libANGLE/renderer/gl/egl/DeviceEGL.h"
+#include "libANGLE/renderer/gl/egl/DmaBufImageCacheEGL.h"
 #include "libANGLE/renderer/gl/egl/DmaBufImageSiblingEGL.h"
 #include "libANGLE/renderer/gl/egl/FunctionsEGLDL.h"
 #include "libANGLE/renderer/gl/egl/ImageEGL.h"
@@ -120,7 +121,7 @@ ImageImpl *DisplayEGL::createImage(const egl::ImageState &state,
                                    EGLenum target,
                                    const egl::AttributeMap &attribs)
 {
-    return new ImageEGL(state, context, target, attribs, mEGL);
+    return new ImageEGL(state, context, target, attribs, mEGL, mDmaBufImageCache.get());
 }
 
 EGLSyncImpl *DisplayEGL::createSync(const egl::AttributeMap &attribs)
@@ -383,6 +384,12 @@ egl::Error DisplayEGL::initialize(egl::Display *display)
 
     ANGLE_TRY(DisplayGL::initialize(display));
 
+    if (mRenderer->getFeatures().reuseDmaBufImages.enabled &&
+        mEGL->hasExtension("EGL_EXT_image_dma_buf_import"))
+    {
+        mDmaBufImageCache = std::make_unique<DmaBufImageCacheEGL>(mEGL);
+    }
+
     INFO() << "ANGLE DisplayEGL initialized: " << getRendererDescription();
 
     return egl::NoError();
@@ -408,6 +415,12 @@ void DisplayEGL::terminate()
         }
     }
 
+    if (mDmaBufImageCache)
+    {
+        mDmaBufImageCache->destroy();
+        mDmaBufImageCache.reset();
+    }
+
     mRenderer.reset();
     mVirtualizationGroups.clear();
 
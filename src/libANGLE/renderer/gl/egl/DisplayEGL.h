@@ -10,6 +10,7 @@
 #define LIBANGLE_RENDERER_GL_EGL_DISPLAYEGL_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -19,6 +20,7 @@
 namespace rx
 {
 
+class DmaBufImageCacheEGL;
 class FunctionsEGL;
 class FunctionsEGLDL;
 class RendererEGL;
@@ -181,6 +183,9 @@ class DisplayEGL : public DisplayGL
     bool mNoOpDmaBufImportModifiers     = false;
     std::vector<EGLint> mDrmFormats;
     bool mDrmFormatsInitialized = false;
+
+    // Native images created from dma_bufs, shared by all the Images that import the same buffer.
+    std::unique_ptr<DmaBufImageCacheEGL> mDmaBufImageCache;
 };
 
 }  // namespace rx
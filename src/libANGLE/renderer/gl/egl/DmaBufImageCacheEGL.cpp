@@ -0,0 +1,157 @@
+//
+// Copyright The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// DmaBufImageCacheEGL.cpp: Implements the DmaBufImageCacheEGL class.
+
+#include "libANGLE/renderer/gl/egl/DmaBufImageCacheEGL.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+
+#include "common/debug.h"
+#include "libANGLE/Error.h"
+#include "libANGLE/renderer/gl/egl/FunctionsEGL.h"
+
+namespace rx
+{
+namespace
+{
+// Number of unreferenced native images kept alive.  Enough to cover the buffer pool of a typical
+// video decoder.
+constexpr size_t kMaxUnusedImages = 8;
+
+bool IsPlaneFdAttribute(EGLint attribute)
+{
+    switch (attribute)
+    {
+        case EGL_DMA_BUF_PLANE0_FD_EXT:
+        case EGL_DMA_BUF_PLANE1_FD_EXT:
+        case EGL_DMA_BUF_PLANE2_FD_EXT:
+        case EGL_DMA_BUF_PLANE3_FD_EXT:
+            return true;
+        default:
+            return false;
+    }
+}
+}  // anonymous namespace
+
+DmaBufImageCacheEGL::DmaBufImageCacheEGL(const FunctionsEGL *egl) : mEGL(egl) {}
+
+DmaBufImageCacheEGL::~DmaBufImageCacheEGL()
+{
+    ASSERT(mEntries.empty());
+}
+
+// static
+bool DmaBufImageCacheEGL::GetKey(const EGLint *attributes, Key *outKey)
+{
+    outKey->clear();
+    for (const EGLint *attrib = attributes; attrib[0] != EGL_NONE; attrib += 2)
+    {
+        outKey->push_back(static_cast<uint64_t>(attrib[0]));
+
+        if (!IsPlaneFdAttribute(attrib[0]))
+        {
+            outKey->push_back(static_cast<uint64_t>(attrib[1]));
+            continue;
+        }
+
+        // The fd number itself is meaningless across imports; the dma_buf it refers to is
+        // identified by its inode.
+        struct stat fdStat;
+        if (fstat(attrib[1], &fdStat) != 0)
+        {
+            return false;
+        }
+        outKey->push_back(static_cast<uint64_t>(fdStat.st_dev));
+        outKey->push_back(static_cast<uint64_t>(fdStat.st_ino));
+    }
+
+    return true;
+}
+
+EGLImage DmaBufImageCacheEGL::acquire(const Key &key, const EGLint *attributes)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto iter = mEntries.find(key);
+    if (iter != mEntries.end())
+    {
+        Entry &entry = iter->second;
+        if (entry.refCount == 0)
+        {
+            auto unusedIter = std::find(mUnusedKeys.begin(), mUnusedKeys.end(), key);
+            ASSERT(unusedIter != mUnusedKeys.end());
+            mUnusedKeys.erase(unusedIter);
+        }
+
+        entry.refCount++;
+        return entry.image;
+    }
+
+    EGLImage image =
+        mEGL->createImageKHR(EGL_NO_CONTEXT, EGL_LINUX_DMA_BUF_EXT, nullptr, attributes);
+    if (image == EGL_NO_IMAGE)
+    {
+        return EGL_NO_IMAGE;
+    }
+
+    Entry entry;
+    entry.image    = image;
+    entry.refCount = 1;
+    mEntries.emplace(key, entry);
+
+    return image;
+}
+
+void DmaBufImageCacheEGL::release(const Key &key)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto iter = mEntries.find(key);
+    ASSERT(iter != mEntries.end() && iter->second.refCount > 0);
+
+    if (--iter->second.refCount == 0)
+    {
+        mUnusedKeys.push_back(key);
+        evict(kMaxUnusedImages);
+    }
+}
+
+void DmaBufImageCacheEGL::destroy()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    evict(0);
+
+    // Images still in use at this point are leaked by the front-end; destroy them anyway since
+    // the native display is about to go away.
+    for (auto &iter : mEntries)
+    {
+        mEGL->destroyImageKHR(iter.second.image);
+    }
+    mEntries.clear();
+}
+
+void DmaBufImageCacheEGL::evict(size_t maxUnusedEntries)
+{
+    while (mUnusedKeys.size() > maxUnusedEntries)
+    {
+        auto iter = mEntries.find(mUnusedKeys.front());
+        ASSERT(iter != mEntries.end() && iter->second.refCount == 0);
+
+        if (mEGL->destroyImageKHR(iter->second.image) == EGL_FALSE)
+        {
+            ERR() << "eglDestroyImage error " << egl::Error(mEGL->getError());
+        }
+
+        mEntries.erase(iter);
+        mUnusedKeys.pop_front();
+    }
+}
+
+}  // namespace rx
@@ -0,0 +1,78 @@
+//
+// Copyright The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// DmaBufImageCacheEGL.h: Defines the DmaBufImageCacheEGL class, which keeps the native EGL images
+// created from dma_buf objects alive so that re-importing the same buffer can reuse them.
+
+#ifndef LIBANGLE_RENDERER_GL_EGL_DMABUFIMAGECACHEEGL_H_
+#define LIBANGLE_RENDERER_GL_EGL_DMABUFIMAGECACHEEGL_H_
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "libANGLE/renderer/gl/egl/egl_utils.h"
+
+namespace rx
+{
+
+class FunctionsEGL;
+
+// Video pipelines typically cycle through a small set of dma_bufs and import each decoded frame
+// with a new eglCreateImage call.  Since the native image aliases the dma_buf memory, an image
+// created from an identical import can be shared instead of being recreated every frame.
+//
+// Entries are keyed on the final list of creation attributes, with every plane file descriptor
+// replaced by the identity of the dma_buf it refers to.  An entry is referenced by every ImageEGL
+// that uses it.  Once unreferenced it is kept in a small LRU list until it is evicted or the
+// cache is destroyed.  The cached native image holds a reference to the dma_buf, so its identity
+// cannot be reused by another buffer while the entry exists.
+//
+// Only the native image is shared.  Textures are still retargeted at it on every
+// glEGLImageTargetTexture2DOES, as drivers that don't sample the dma_buf memory directly only pick
+// up new contents then.
+class DmaBufImageCacheEGL final : angle::NonCopyable
+{
+  public:
+    using Key = std::vector<uint64_t>;
+
+    DmaBufImageCacheEGL(const FunctionsEGL *egl);
+    ~DmaBufImageCacheEGL();
+
+    // Builds the cache key for an EGL_NONE terminated attribute list.  Returns false if one of the
+    // plane file descriptors cannot be identified, in which case the image must not be cached.
+    static bool GetKey(const EGLint *attributes, Key *outKey);
+
+    // Returns the native image for |key|, creating it from |attributes| if needed.  Every
+    // successful call must be paired with release().
+    EGLImage acquire(const Key &key, const EGLint *attributes);
+    void release(const Key &key);
+
+    // Destroys all the cached native images.  Called when the display is terminated, after all the
+    // images that use them are gone.
+    void destroy();
+
+  private:
+    struct Entry
+    {
+        EGLImage image;
+        size_t refCount;
+    };
+
+    void evict(size_t maxUnusedEntries);
+
+    const FunctionsEGL *mEGL;
+
+    std::mutex mMutex;
+    std::map<Key, Entry> mEntries;
+    // Keys of entries that are not referenced by any image, least recently released first.
+    std::deque<Key> mUnusedKeys;
+};
+
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_GL_EGL_DMABUFIMAGECACHEEGL_H_
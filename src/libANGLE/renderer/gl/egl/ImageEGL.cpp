@@ -25,13 +25,16 @@ ImageEGL::ImageEGL(const egl::ImageState &state,
                    const gl::Context *context,
                    EGLenum target,
                    const egl::AttributeMap &attribs,
-                   const FunctionsEGL *egl)
+                   const FunctionsEGL *egl,
+                   DmaBufImageCacheEGL *dmaBufImageCache)
     : ImageGL(state),
       mEGL(egl),
       mContext(EGL_NO_CONTEXT),
       mTarget(target),
       mPreserveImage(false),
-      mImage(EGL_NO_IMAGE)
+      mImage(EGL_NO_IMAGE),
+      mDmaBufImageCache(dmaBufImageCache),
+      mIsCachedImage(false)
 {
     if (context)
     {
@@ -42,7 +45,14 @@ ImageEGL::ImageEGL(const egl::ImageState &state,
 
 ImageEGL::~ImageEGL()
 {
-    mEGL->destroyImageKHR(mImage);
+    if (mIsCachedImage)
+    {
+        mDmaBufImageCache->release(mDmaBufImageKey);
+    }
+    else
+    {
+        mEGL->destroyImageKHR(mImage);
+    }
 }
 
 egl::Error ImageEGL::initialize(const egl::Display *display)
@@ -99,7 +109,18 @@ egl::Error ImageEGL::initialize(const egl::Display *display)
 
     attributes.push_back(EGL_NONE);
 
-    mImage = mEGL->createImageKHR(mContext, mTarget, buffer, attributes.data());
+    // Re-imports of the same dma_buf with the same layout share their native image.
+    if (mTarget == EGL_LINUX_DMA_BUF_EXT && mDmaBufImageCache != nullptr &&
+        DmaBufImageCacheEGL::GetKey(attributes.data(), &mDmaBufImageKey))
+    {
+        mImage         = mDmaBufImageCache->acquire(mDmaBufImageKey, attributes.data());
+        mIsCachedImage = mImage != EGL_NO_IMAGE;
+    }
+    else
+    {
+        mImage = mEGL->createImageKHR(mContext, mTarget, buffer, attributes.data());
+    }
+
     if (mImage == EGL_NO_IMAGE)
     {
         return egl::EglBadAlloc() << "eglCreateImage failed with " << egl::Error(mEGL->getError());
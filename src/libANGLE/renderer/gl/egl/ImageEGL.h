@@ -10,6 +10,7 @@
 #define LIBANGLE_RENDERER_GL_EGL_IMAGEEGL_H_
 
 #include "libANGLE/renderer/gl/ImageGL.h"
+#include "libANGLE/renderer/gl/egl/DmaBufImageCacheEGL.h"
 
 namespace egl
 {
@@ -28,7 +29,8 @@ class ImageEGL final : public ImageGL
              const gl::Context *context,
              EGLenum target,
              const egl::AttributeMap &attribs,
-             const FunctionsEGL *egl);
+             const FunctionsEGL *egl,
+             DmaBufImageCacheEGL *dmaBufImageCache);
     ~ImageEGL() override;
 
     egl::Error initialize(const egl::Display *display) override;
@@ -54,6 +56,11 @@ class ImageEGL final : public ImageGL
     GLenum mNativeInternalFormat;
 
     EGLImage mImage;
+
+    // Set if mImage is shared through the dma_buf image cache, which then owns it.
+    DmaBufImageCacheEGL *mDmaBufImageCache;
+    DmaBufImageCacheEGL::Key mDmaBufImageKey;
+    bool mIsCachedImage;
 };
 
 }  // namespace rx
@@ -2539,6 +2539,25 @@ void InitializeFeatures(const FunctionsGL *functions, angle::FeaturesGL *feature
 
     // https://crbug.com/1356053
     ANGLE_FEATURE_CONDITION(features, bindFramebufferForTimerQueries, IsMali(functions));
+
+    // Avoid implicit synchronization with previous draws when streaming client arrays.
+    ANGLE_FEATURE_CONDITION(features, streamClientArraysThroughRingBuffer, true);
+
+    // GL 1.4+ or GL_EXT_multi_draw_arrays.
+    ANGLE_FEATURE_CONDITION(features, useNativeMultiDraw,
+                            functions->multiDrawArrays != nullptr &&
+                                functions->multiDrawElements != nullptr);
+
+    // Needs pixel buffer objects, and fences so that the ring doesn't have to orphan its buffers.
+    ANGLE_FEATURE_CONDITION(features, uploadTextureDataThroughStagingBuffers,
+                            (functions->isAtLeastGL(gl::Version(2, 1)) ||
+                             functions->isAtLeastGLES(gl::Version(3, 0))) &&
+                                nativegl::SupportsFenceSync(functions));
+
+    ANGLE_FEATURE_CONDITION(features, deferDefaultUniformUpdates, true);
+
+    // Only affects displays that import dma_bufs through EGL.
+    ANGLE_FEATURE_CONDITION(features, reuseDmaBufImages, true);
 }
 
 void InitializeFrontendFeatures(const FunctionsGL *functions, angle::FrontendFeatures *features)
@@ -2962,6 +2981,37 @@ angle::Result ShouldApplyLastRowPaddingWorkaround(ContextGL *contextGL,
     return angle::Result::Continue;
 }
 
+void RearrangeNorm16PixelsToRGBA(GLenum format,
+                                 GLsizei width,
+                                 GLsizei height,
+                                 const uint8_t *src,
+                                 GLuint srcRowBytes,
+                                 GLuint srcPixelBytes,
+                                 uint8_t *dst,
+                                 GLuint dstRowBytes)
+{
+    ASSERT(format == GL_RED || format == GL_RG);
+    constexpr GLuint kDstPixelBytes = 4 * sizeof(GLushort);
+    ASSERT(srcPixelBytes < kDstPixelBytes && srcRowBytes <= dstRowBytes);
+
+    for (GLsizei y = 0; y < height; ++y)
+    {
+        const uint8_t *srcRow = src + y * srcRowBytes;
+        uint8_t *dstRow       = dst + y * dstRowBytes;
+        for (GLsizei x = 0; x < width; ++x)
+        {
+            GLushort srcPixel[2] = {};
+            memcpy(srcPixel, srcRow + x * srcPixelBytes, srcPixelBytes);
+
+            // Set the other channels of RGBA to 0 (GB when format == GL_RED, B when format ==
+            // GL_RG), and alpha to 1.
+            const GLushort dstPixel[4] = {srcPixel[0], format == GL_RG ? srcPixel[1] : GLushort(0),
+                                          0, 0xFFFF};
+            memcpy(dstRow + x * kDstPixelBytes, dstPixel, kDstPixelBytes);
+        }
+    }
+}
+
 std::vector<ContextCreationTry> GenerateContextCreationToTry(EGLint requestedType, bool isMesaGLX)
 {
     using Type                         = ContextCreationTry::Type;
@@ -152,6 +152,17 @@ angle::Result ShouldApplyLastRowPaddingWorkaround(ContextGL *contextGL,
                                                   const void *pixels,
                                                   bool *shouldApplyOut);
 
+// Rearranges GL_UNSIGNED_SHORT pixels read as RED or RG into RGBA, for the EXT_texture_norm16
+// readback workaround.  The bytes between the rows of |dst| are left untouched.
+void RearrangeNorm16PixelsToRGBA(GLenum format,
+                                 GLsizei width,
+                                 GLsizei height,
+                                 const uint8_t *src,
+                                 GLuint srcRowBytes,
+                                 GLuint srcPixelBytes,
+                                 uint8_t *dst,
+                                 GLuint dstRowBytes);
+
 struct ContextCreationTry
 {
     enum class Type
@@ -250,9 +250,10 @@ angle::Result BufferMtl::getIndexRange(const gl::Context *context,
                                        bool primitiveRestartEnabled,
                                        gl::IndexRange *outRange)
 {
-    const uint8_t *indices = getClientShadowCopyData(mtl::GetImpl(context)) + offset;
+    const uint8_t *data = getClientShadowCopyData(mtl::GetImpl(context));
 
-    *outRange = gl::ComputeIndexRange(type, indices, count, primitiveRestartEnabled);
+    *outRange = mState.getIndexRangeCache()->computeRange(type, data, offset, count,
+                                                          primitiveRestartEnabled);
 
     return angle::Result::Continue;
 }
@@ -122,7 +122,8 @@ angle::Result BufferNULL::getIndexRange(const gl::Context *context,
                                         bool primitiveRestartEnabled,
                                         gl::IndexRange *outRange)
 {
-    *outRange = gl::ComputeIndexRange(type, mData.data() + offset, count, primitiveRestartEnabled);
+    *outRange = mState.getIndexRangeCache()->computeRange(type, mData.data(), offset, count,
+                                                          primitiveRestartEnabled);
     return angle::Result::Continue;
 }
 
@@ -279,54 +279,21 @@ gl::Rectangle ClipRectToScissor(const gl::State &glState, const gl::Rectangle &r
 // Helper method to intialize a FeatureSet with overrides from the DisplayState
 void ApplyFeatureOverrides(angle::FeatureSetBase *features, const egl::DisplayState &state);
 
-template <typename In>
-uint32_t LineLoopRestartIndexCountHelper(GLsizei indexCount, const uint8_t *srcPtr)
-{
-    constexpr In restartIndex = gl::GetPrimitiveRestartIndexFromType<In>();
-    const In *inIndices       = reinterpret_cast<const In *>(srcPtr);
-    uint32_t numIndices       = 0;
-    // See CopyLineLoopIndicesWithRestart() below for more info on how
-    // numIndices is calculated.
-    GLsizei loopStartIndex = 0;
-    for (GLsizei curIndex = 0; curIndex < indexCount; curIndex++)
-    {
-        In vertex = inIndices[curIndex];
-        if (vertex != restartIndex)
-        {
-            numIndices++;
-        }
-        else
-        {
-            if (curIndex > loopStartIndex)
-            {
-                numIndices += 2;
-            }
-            loopStartIndex = curIndex + 1;
-        }
-    }
-    if (indexCount > loopStartIndex)
-    {
-        numIndices++;
-    }
-    return numIndices;
-}
-
 inline uint32_t GetLineLoopWithRestartIndexCount(gl::DrawElementsType glIndexType,
                                                  GLsizei indexCount,
                                                  const uint8_t *srcPtr)
 {
-    switch (glIndexType)
-    {
-        case gl::DrawElementsType::UnsignedByte:
-            return LineLoopRestartIndexCountHelper<uint8_t>(indexCount, srcPtr);
-        case gl::DrawElementsType::UnsignedShort:
-            return LineLoopRestartIndexCountHelper<uint16_t>(indexCount, srcPtr);
-        case gl::DrawElementsType::UnsignedInt:
-            return LineLoopRestartIndexCountHelper<uint32_t>(indexCount, srcPtr);
-        default:
-            UNREACHABLE();
-            return 0;
-    }
+    return static_cast<uint32_t>(
+        gl::GetLineLoopWithRestartIndexCount(glIndexType, srcPtr, indexCount));
+}
+
+template <typename T>
+constexpr gl::DrawElementsType GetDrawElementsTypeFromIndexType()
+{
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4, "unknown index type");
+    return sizeof(T) == 1   ? gl::DrawElementsType::UnsignedByte
+           : sizeof(T) == 2 ? gl::DrawElementsType::UnsignedShort
+                            : gl::DrawElementsType::UnsignedInt;
 }
 
 // Writes the line-strip vertices for a line loop to outPtr,
@@ -334,35 +301,9 @@ inline uint32_t GetLineLoopWithRestartIndexCount(gl::DrawElementsType glIndexTyp
 template <typename In, typename Out>
 void CopyLineLoopIndicesWithRestart(GLsizei indexCount, const uint8_t *srcPtr, uint8_t *outPtr)
 {
-    constexpr In restartIndex     = gl::GetPrimitiveRestartIndexFromType<In>();
-    constexpr Out outRestartIndex = gl::GetPrimitiveRestartIndexFromType<Out>();
-    const In *inIndices           = reinterpret_cast<const In *>(srcPtr);
-    Out *outIndices               = reinterpret_cast<Out *>(outPtr);
-    GLsizei loopStartIndex        = 0;
-    for (GLsizei curIndex = 0; curIndex < indexCount; curIndex++)
-    {
-        In vertex = inIndices[curIndex];
-        if (vertex != restartIndex)
-        {
-            *(outIndices++) = static_cast<Out>(vertex);
-        }
-        else
-        {
-            if (curIndex > loopStartIndex)
-            {
-                // Emit an extra vertex only if the loop is not empty.
-                *(outIndices++) = inIndices[loopStartIndex];
-                // Then restart the strip.
-                *(outIndices++) = outRestartIndex;
-            }
-            loopStartIndex = curIndex + 1;
-        }
-    }
-    if (indexCount > loopStartIndex)
-    {
-        // Close the last loop if not empty.
-        *(outIndices++) = inIndices[loopStartIndex];
-    }
+    gl::CopyLineLoopIndicesWithRestart(GetDrawElementsTypeFromIndexType<In>(),
+                                       GetDrawElementsTypeFromIndexType<Out>(), srcPtr, indexCount,
+                                       outPtr);
 }
 
 void GetSamplePosition(GLsizei sampleCount, size_t index, GLfloat *xy);
@@ -4457,6 +4457,11 @@ void RendererVk::initFeatures(DisplayVk *displayVk,
                                     kRequiredSubgroupOp &&
                                 (limitsVk.maxTexelBufferElements >= kMaxTexelBufferSize));
 
+    // ETC2/EAC data that the device cannot sample natively is decoded on the CPU.  Do that on the
+    // worker threads so glCompressedTexImage* returns without waiting for the decode.
+    ANGLE_FEATURE_CONDITION(&mFeatures, asyncEtcTextureDecode,
+                            !mPhysicalDeviceFeatures.textureCompressionETC2);
+
     // Allow passthrough of EGL colorspace attributes on Android platform and for vendors that
     // are known to support wide color gamut.
     ANGLE_FEATURE_CONDITION(&mFeatures, eglColorspaceAttributePassthrough,
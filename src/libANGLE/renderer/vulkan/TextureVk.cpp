@@ -11,7 +11,8 @@
 #include <vulkan/vulkan.h>
 
 #include "common/debug.h"
-#include "image_util/generatemip.inc"
+#include "image_util/generatemip.h"
+#include "image_util/loadimage.h"
 #include "libANGLE/Config.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/Image.h"
@@ -3379,6 +3380,8 @@ angle::Result TextureVk::generateMipmapLevelsWithCPU(ContextVk *contextVk,
                                                      const size_t sourceDepthPitch,
                                                      uint8_t *sourceData)
 {
+    const angle::ImageLoadContext imageLoadContext = contextVk->getImageLoadContext();
+
     size_t previousLevelWidth      = sourceWidth;
     size_t previousLevelHeight     = sourceHeight;
     size_t previousLevelDepth      = sourceDepth;
@@ -3408,10 +3411,12 @@ angle::Result TextureVk::generateMipmapLevelsWithCPU(ContextVk *contextVk,
             gl::ImageIndex::MakeFromType(mState.getType(), currentMipLevel.get(), layer),
             mipLevelExtents, gl::Offset(), &destData, sourceFormat.id));
 
-        // Generate the mipmap into that new buffer
-        sourceFormat.mipGenerationFunction(
-            previousLevelWidth, previousLevelHeight, previousLevelDepth, previousLevelData,
-            previousLevelRowPitch, previousLevelDepthPitch, destData, destRowPitch, destDepthPitch);
+        // Generate the mipmap into that new buffer, on the worker threads for large levels.
+        angle::GenerateMipWithContext(imageLoadContext, sourceFormat.mipGenerationFunction,
+                                      previousLevelWidth, previousLevelHeight, previousLevelDepth,
+                                      previousLevelData, previousLevelRowPitch,
+                                      previousLevelDepthPitch, destData, destRowPitch,
+                                      destDepthPitch);
 
         // Swap for the next iteration
         previousLevelWidth      = mipWidth;
@@ -362,34 +362,9 @@ angle::Result VertexArrayVk::convertIndexBufferCPU(ContextVk *contextVk,
     {
         // Unsigned bytes don't have direct support in Vulkan so we have to expand the
         // memory to a GLushort.
-        const GLubyte *in     = static_cast<const GLubyte *>(sourcePointer);
-        GLushort *expandedDst = reinterpret_cast<GLushort *>(dst);
         bool primitiveRestart = contextVk->getState().isPrimitiveRestartEnabled();
-
-        constexpr GLubyte kUnsignedByteRestartValue   = 0xFF;
-        constexpr GLushort kUnsignedShortRestartValue = 0xFFFF;
-
-        if (primitiveRestart)
-        {
-            for (size_t index = 0; index < indexCount; index++)
-            {
-                GLushort value = static_cast<GLushort>(in[index]);
-                if (in[index] == kUnsignedByteRestartValue)
-                {
-                    // Convert from 8-bit restart value to 16-bit restart value
-                    value = kUnsignedShortRestartValue;
-                }
-                expandedDst[index] = value;
-            }
-        }
-        else
-        {
-            // Fast path for common case.
-            for (size_t index = 0; index < indexCount; index++)
-            {
-                expandedDst[index] = static_cast<GLushort>(in[index]);
-            }
-        }
+        gl::ConvertIndices(gl::DrawElementsType::UnsignedByte, gl::DrawElementsType::UnsignedShort,
+                           sourcePointer, indexCount, dst, primitiveRestart);
     }
     else
     {
@@ -23,6 +23,8 @@
 #include "libANGLE/renderer/vulkan/android/vk_android_utils.h"
 #include "libANGLE/renderer/vulkan/vk_utils.h"
 
+#include <thread>
+
 namespace rx
 {
 namespace vk
@@ -978,6 +980,58 @@ bool CheckSubpassCommandBufferCount(uint32_t count)
     // subpasses, therefore we do not need multiple buffers.
     return (count == 1 || !RenderPassCommandBuffer::ExecutesInline());
 }
+
+// Below this many 4x4 blocks, ETC2/EAC data is decoded on the calling thread.
+constexpr size_t kMinAsyncDecodeBlockCount = 64 * 64;
+
+// Runs the load function of a staged update over a range of block rows or slices on a worker
+// thread.  The source data is a copy shared by all the tasks of the update, as the application may
+// reuse its memory as soon as the upload call returns.
+class StagedLoadTask final : public angle::Closure
+{
+  public:
+    StagedLoadTask(LoadImageFunction loadFunction,
+                   const std::shared_ptr<std::vector<uint8_t>> &source,
+                   size_t sourceOffset,
+                   const gl::Extents &extents,
+                   size_t inputRowPitch,
+                   size_t inputDepthPitch,
+                   uint8_t *output,
+                   size_t outputRowPitch,
+                   size_t outputDepthPitch)
+        : mLoadFunction(loadFunction),
+          mSource(source),
+          mSourceOffset(sourceOffset),
+          mExtents(extents),
+          mInputRowPitch(inputRowPitch),
+          mInputDepthPitch(inputDepthPitch),
+          mOutput(output),
+          mOutputRowPitch(outputRowPitch),
+          mOutputDepthPitch(outputDepthPitch)
+    {}
+
+    void operator()() override
+    {
+        ANGLE_TRACE_EVENT0("gpu.angle", "StagedLoadTask");
+
+        // The task already runs on a worker thread, so the load function must not split the work
+        // further.
+        mLoadFunction(angle::ImageLoadContext(), mExtents.width, mExtents.height, mExtents.depth,
+                      mSource->data() + mSourceOffset, mInputRowPitch, mInputDepthPitch, mOutput,
+                      mOutputRowPitch, mOutputDepthPitch);
+    }
+
+  private:
+    LoadImageFunction mLoadFunction;
+    std::shared_ptr<std::vector<uint8_t>> mSource;
+    size_t mSourceOffset;
+    gl::Extents mExtents;
+    size_t mInputRowPitch;
+    size_t mInputDepthPitch;
+    uint8_t *mOutput;
+    size_t mOutputRowPitch;
+    size_t mOutputDepthPitch;
+};
 }  // anonymous namespace
 
 // This is an arbitrary max. We can change this later if necessary.
@@ -5279,6 +5333,7 @@ ImageHelper::ImageHelper()
 ImageHelper::~ImageHelper()
 {
     ASSERT(!valid());
+    ASSERT(mPendingStagedLoads.empty());
     ASSERT(!mAcquireNextImageSemaphore.valid());
 }
 
@@ -5738,6 +5793,8 @@ void ImageHelper::releaseStagedUpdates(RendererVk *renderer)
 {
     ASSERT(validateSubresourceUpdateRefCountsConsistent());
 
+    finishPendingStagedLoads();
+
     // Remove updates that never made it to the texture.
     for (std::vector<SubresourceUpdate> &levelUpdates : mSubresourceUpdates)
     {
@@ -7104,6 +7161,8 @@ void ImageHelper::removeSingleSubresourceStagedUpdates(ContextVk *contextVk,
 {
     mCurrentSingleClearValue.reset();
 
+    finishPendingStagedLoads();
+
     // Find any staged updates for this index and remove them from the pending list.
     std::vector<SubresourceUpdate> *levelUpdates = getLevelUpdates(levelIndexGL);
     if (levelUpdates == nullptr)
@@ -7164,6 +7223,8 @@ void ImageHelper::removeStagedUpdates(Context *context,
 {
     ASSERT(validateSubresourceUpdateRefCountsConsistent());
 
+    finishPendingStagedLoads();
+
     // Remove all updates to levels [start, end].
     for (gl::LevelIndex level = levelGLStart; level <= levelGLEnd; ++level)
     {
@@ -7326,9 +7387,74 @@ angle::Result ImageHelper::stageSubresourceUpdateImpl(ContextVk *contextVk,
 
     const uint8_t *source = pixels + static_cast<ptrdiff_t>(inputSkipBytes);
 
-    loadFunctionInfo.loadFunction(
-        contextVk->getImageLoadContext(), glExtents.width, glExtents.height, glExtents.depth,
-        source, inputRowPitch, inputDepthPitch, stagingPointer, outputRowPitch, outputDepthPitch);
+    // Large ETC2/EAC images that are decoded on the CPU are decoded on the worker threads instead.
+    // The staging buffer is not read until the update is flushed, which waits for the decode.
+    const angle::ImageLoadContext &imageLoadContext = contextVk->getImageLoadContext();
+
+    const size_t depth         = static_cast<size_t>(glExtents.depth);
+    const size_t blockRowCount = (static_cast<size_t>(glExtents.height) + 3) / 4;
+    const size_t blockCount =
+        ((static_cast<size_t>(glExtents.width) + 3) / 4) * blockRowCount * depth;
+    const bool decodeAsync =
+        contextVk->getFeatures().asyncEtcTextureDecode.enabled &&
+        (gl::IsETC1Format(formatInfo.internalFormat) ||
+         gl::IsETC2EACFormat(formatInfo.internalFormat)) &&
+        loadFunctionInfo.requiresConversion && !storageFormat.isYUV &&
+        stencilAllocationSize == 0 && imageLoadContext.multiThreadPool != nullptr &&
+        imageLoadContext.multiThreadPool->isAsync() && blockCount >= kMinAsyncDecodeBlockCount;
+
+    if (decodeAsync)
+    {
+        ANGLE_TRACE_EVENT0("gpu.angle", "ImageHelper::stageSubresourceUpdateImpl async decode");
+
+        auto sourceCopy = std::make_shared<std::vector<uint8_t>>(
+            source, source + static_cast<size_t>(inputDepthPitch) * depth);
+
+        // Split 2D images by block rows and the rest by slices.  Block formats are written one
+        // row per block row, others one row per pixel row.
+        const size_t taskCount =
+            std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                             depth > 1 ? depth : blockRowCount);
+        const size_t outputRowsPerBlockRow = storageFormat.isBlock ? 1 : 4;
+
+        for (size_t task = 0; task < taskCount; ++task)
+        {
+            gl::Extents taskExtents = glExtents;
+            size_t sourceOffset     = 0;
+            size_t outputOffset     = 0;
+            if (depth > 1)
+            {
+                const size_t firstSlice = depth * task / taskCount;
+                const size_t lastSlice  = depth * (task + 1) / taskCount;
+                taskExtents.depth       = static_cast<int>(lastSlice - firstSlice);
+                sourceOffset            = firstSlice * inputDepthPitch;
+                outputOffset            = firstSlice * outputDepthPitch;
+            }
+            else
+            {
+                const size_t firstBlockRow = blockRowCount * task / taskCount;
+                const size_t lastBlockRow  = blockRowCount * (task + 1) / taskCount;
+                taskExtents.height =
+                    static_cast<int>(std::min<size_t>(lastBlockRow * 4, glExtents.height) -
+                                     firstBlockRow * 4);
+                sourceOffset = firstBlockRow * inputRowPitch;
+                outputOffset = firstBlockRow * outputRowsPerBlockRow * outputRowPitch;
+            }
+
+            auto loadTask = std::make_shared<StagedLoadTask>(
+                loadFunctionInfo.loadFunction, sourceCopy, sourceOffset, taskExtents,
+                inputRowPitch, inputDepthPitch, stagingPointer + outputOffset, outputRowPitch,
+                outputDepthPitch);
+            mPendingStagedLoads.push_back(
+                imageLoadContext.multiThreadPool->postWorkerTask(loadTask));
+        }
+    }
+    else
+    {
+        loadFunctionInfo.loadFunction(imageLoadContext, glExtents.width, glExtents.height,
+                                      glExtents.depth, source, inputRowPitch, inputDepthPitch,
+                                      stagingPointer, outputRowPitch, outputDepthPitch);
+    }
 
     // YUV formats need special handling.
     if (storageFormat.isYUV)
@@ -7460,6 +7586,8 @@ angle::Result ImageHelper::reformatStagedBufferUpdates(ContextVk *contextVk,
     const gl::InternalFormat &dstFormatInfo =
         gl::GetSizedInternalFormatInfo(dstFormat.glInternalFormat);
 
+    finishPendingStagedLoads();
+
     for (std::vector<SubresourceUpdate> &levelUpdates : mSubresourceUpdates)
     {
         for (SubresourceUpdate &update : levelUpdates)
@@ -8375,6 +8503,8 @@ angle::Result ImageHelper::flushStagedUpdates(ContextVk *contextVk,
         return angle::Result::Continue;
     }
 
+    finishPendingStagedLoads();
+
     removeSupersededUpdates(contextVk, skipLevelsMask);
 
     // If a clear is requested and we know it was previously cleared with the same value, we drop
@@ -8855,6 +8985,18 @@ bool ImageHelper::validateSubresourceUpdateRefCountsConsistent() const
     return true;
 }
 
+void ImageHelper::finishPendingStagedLoads()
+{
+    if (mPendingStagedLoads.empty())
+    {
+        return;
+    }
+
+    ANGLE_TRACE_EVENT0("gpu.angle", "ImageHelper::finishPendingStagedLoads");
+    angle::WaitableEvent::WaitMany(&mPendingStagedLoads);
+    mPendingStagedLoads.clear();
+}
+
 void ImageHelper::pruneSupersededUpdatesForLevel(ContextVk *contextVk,
                                                  const gl::LevelIndex level,
                                                  const PruneReason reason)
@@ -8929,6 +9071,7 @@ void ImageHelper::pruneSupersededUpdatesForLevel(ContextVk *contextVk,
                                   "Dropped update that is superseded by a more recent one");
 
             // Release the superseded update
+            finishPendingStagedLoads();
             update.release(contextVk->getRenderer());
 
             // Update pruning size
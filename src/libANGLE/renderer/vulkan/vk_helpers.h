@@ -10,6 +10,7 @@
 #define LIBANGLE_RENDERER_VULKAN_VK_HELPERS_H_
 
 #include "common/MemoryBuffer.h"
+#include "common/WorkerThread.h"
 #include "libANGLE/renderer/vulkan/Suballocation.h"
 #include "libANGLE/renderer/vulkan/vk_cache_utils.h"
 #include "libANGLE/renderer/vulkan/vk_format_utils.h"
@@ -2524,6 +2525,10 @@ class ImageHelper final : public Resource, public angle::Subject
     // extents are not known).
     void removeSupersededUpdates(ContextVk *contextVk, gl::TexLevelMask skipLevelsMask);
 
+    // Waits for the worker threads still writing the staging buffers of staged updates.  Must be
+    // called before those updates are flushed, reformatted or released.
+    void finishPendingStagedLoads();
+
     void initImageMemoryBarrierStruct(Context *context,
                                       VkImageAspectFlags aspectMask,
                                       ImageLayout newLayout,
@@ -2736,6 +2741,10 @@ class ImageHelper final : public Resource, public angle::Subject
     std::vector<std::vector<SubresourceUpdate>> mSubresourceUpdates;
     VkDeviceSize mTotalStagedBufferUpdateSize;
 
+    // Decodes of staged updates that are running on the worker threads, see
+    // stageSubresourceUpdateImpl.
+    std::vector<std::shared_ptr<angle::WaitableEvent>> mPendingStagedLoads;
+
     // Optimization for repeated clear with the same value. If this pointer is not null, the entire
     // image it has been cleared to the specified clear value. If another clear call is made with
     // the exact same clear value, we will detect and skip the clear call.
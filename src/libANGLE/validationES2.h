@@ -61,7 +61,30 @@ ANGLE_INLINE bool ValidateDrawElements(const Context *context,
                                        DrawElementsType type,
                                        const void *indices)
 {
-    return ValidateDrawElementsCommon(context, entryPoint, mode, count, type, indices, 1);
+    // Draw-call-bound applications tend to repeat the same draw with nothing changed in between,
+    // in which case it is known to be valid already.
+    const StateCache &stateCache = context->getStateCache();
+    const Buffer *elementArrayBuffer =
+        context->getState().getVertexArray()->getElementArrayBuffer();
+    if (elementArrayBuffer == nullptr)
+    {
+        return ValidateDrawElementsCommon(context, entryPoint, mode, count, type, indices, 1);
+    }
+
+    const uint64_t generation = elementArrayBuffer->getGeneration();
+    if (stateCache.isLastValidatedDrawElements(mode, count, type, indices, elementArrayBuffer,
+                                               generation))
+    {
+        return true;
+    }
+
+    if (!ValidateDrawElementsCommon(context, entryPoint, mode, count, type, indices, 1))
+    {
+        return false;
+    }
+
+    stateCache.onDrawElementsValidated(mode, count, type, indices, elementArrayBuffer, generation);
+    return true;
 }
 
 ANGLE_INLINE bool ValidateVertexAttribPointer(const Context *context,
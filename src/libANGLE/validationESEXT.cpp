@@ -3670,15 +3670,13 @@ bool ValidateGetPerfMonitorCounterInfoAMD(const Context *context,
         return false;
     }
 
-    const angle::PerfMonitorCounterGroups &groups = context->getPerfMonitorCounterGroups();
-
-    if (group >= groups.size())
+    if (group >= context->getPerfMonitorCounterGroupCount())
     {
         context->validationError(entryPoint, GL_INVALID_VALUE, kInvalidPerfMonitorGroup);
         return false;
     }
 
-    if (counter >= groups[group].counters.size())
+    if (counter >= context->getPerfMonitorCounterGroup(group).counters.size())
     {
         context->validationError(entryPoint, GL_INVALID_VALUE, kInvalidPerfMonitorCounter);
         return false;
@@ -3712,15 +3710,13 @@ bool ValidateGetPerfMonitorCounterStringAMD(const Context *context,
         return false;
     }
 
-    const angle::PerfMonitorCounterGroups &groups = context->getPerfMonitorCounterGroups();
-
-    if (group >= groups.size())
+    if (group >= context->getPerfMonitorCounterGroupCount())
     {
         context->validationError(entryPoint, GL_INVALID_VALUE, kInvalidPerfMonitorGroup);
         return false;
     }
 
-    if (counter >= groups[group].counters.size())
+    if (counter >= context->getPerfMonitorCounterGroup(group).counters.size())
     {
         context->validationError(entryPoint, GL_INVALID_VALUE, kInvalidPerfMonitorCounter);
         return false;
@@ -3743,9 +3739,7 @@ bool ValidateGetPerfMonitorCountersAMD(const Context *context,
         return false;
     }
 
-    const angle::PerfMonitorCounterGroups &groups = context->getPerfMonitorCounterGroups();
-
-    if (group >= groups.size())
+    if (group >= context->getPerfMonitorCounterGroupCount())
     {
         context->validationError(entryPoint, GL_INVALID_VALUE, kInvalidPerfMonitorGroup);
         return false;
@@ -3767,9 +3761,7 @@ bool ValidateGetPerfMonitorGroupStringAMD(const Context *context,
         return false;
     }
 
-    const angle::PerfMonitorCounterGroups &groups = context->getPerfMonitorCounterGroups();
-
-    if (group >= groups.size())
+    if (group >= context->getPerfMonitorCounterGroupCount())
     {
         context->validationError(entryPoint, GL_INVALID_VALUE, kInvalidPerfMonitorGroup);
         return false;
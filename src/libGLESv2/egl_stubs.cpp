@@ -65,6 +65,8 @@ EGLBoolean BindTexImage(Thread *thread, Display *display, egl::SurfaceID surface
     gl::Context *context = thread->getContext();
     if (context && !context->isContextLost())
     {
+        ScopedShareGroupLock shareGroupLock(context);
+
         gl::TextureType type =
             egl_gl::EGLTextureTargetToTextureType(eglSurface->getTextureTarget());
         gl::Texture *textureObject = context->getTextureByType(type);
@@ -100,6 +102,10 @@ EGLint ClientWaitSync(Thread *thread,
     gl::Context *currentContext = thread->getContext();
     EGLint syncStatus           = EGL_FALSE;
     Sync *syncObject            = display->getSync(syncID);
+
+    // Waiting may flush the current context.
+    ScopedShareGroupLock shareGroupLock(currentContext);
+
     ANGLE_EGL_TRY_RETURN(
         thread, syncObject->clientWait(display, currentContext, flags, timeout, &syncStatus),
         "eglClientWaitSync", GetSyncIfValid(display, syncID), EGL_FALSE);
@@ -608,6 +614,9 @@ EGLBoolean ReleaseTexImage(Thread *thread,
 
         if (texture)
         {
+            // The texture may have been bound by a context of another share group.
+            ScopedShareGroupLock shareGroupLock(display);
+
             ANGLE_EGL_TRY_RETURN(thread, eglSurface->releaseTexImage(thread->getContext(), buffer),
                                  "eglReleaseTexImage", GetSurfaceIfValid(display, surfaceID),
                                  EGL_FALSE);
@@ -672,6 +681,8 @@ EGLBoolean SwapBuffers(Thread *thread, Display *display, egl::SurfaceID surfaceI
     ANGLE_EGL_TRY_RETURN(thread, display->prepareForCall(), "eglSwapBuffers",
                          GetDisplayIfValid(display), EGL_FALSE);
 
+    ScopedShareGroupLock shareGroupLock(thread->getContext());
+
     ANGLE_EGL_TRY_RETURN(thread, eglSurface->swap(thread->getContext()), "eglSwapBuffers",
                          GetSurfaceIfValid(display, surfaceID), EGL_FALSE);
 
@@ -724,6 +735,9 @@ EGLBoolean WaitClient(Thread *thread)
 
     ANGLE_EGL_TRY_RETURN(thread, display->prepareForCall(), "eglWaitClient",
                          GetDisplayIfValid(display), EGL_FALSE);
+
+    ScopedShareGroupLock shareGroupLock(context);
+
     ANGLE_EGL_TRY_RETURN(thread, display->waitClient(context), "eglWaitClient",
                          GetContextIfValid(display, context->id()), EGL_FALSE);
 
@@ -744,6 +758,8 @@ EGLBoolean WaitGL(Thread *thread)
     ANGLE_EGL_TRY_RETURN(thread, display->prepareForCall(), "eglWaitGL", GetDisplayIfValid(display),
                          EGL_FALSE);
 
+    ScopedShareGroupLock shareGroupLock(thread->getContext());
+
     // eglWaitGL like calling eglWaitClient with the OpenGL ES API bound. Since we only implement
     // OpenGL ES we can do the call directly.
     ANGLE_EGL_TRY_RETURN(thread, display->waitClient(thread->getContext()), "eglWaitGL",
@@ -765,6 +781,9 @@ EGLBoolean WaitNative(Thread *thread, EGLint engine)
 
     ANGLE_EGL_TRY_RETURN(thread, display->prepareForCall(), "eglWaitNative",
                          GetDisplayIfValid(display), EGL_FALSE);
+
+    ScopedShareGroupLock shareGroupLock(thread->getContext());
+
     ANGLE_EGL_TRY_RETURN(thread, display->waitNative(thread->getContext(), engine), "eglWaitNative",
                          GetThreadIfValid(thread), EGL_FALSE);
 
@@ -778,6 +797,9 @@ EGLBoolean WaitSync(Thread *thread, Display *display, SyncID syncID, EGLint flag
                          GetDisplayIfValid(display), EGL_FALSE);
     gl::Context *currentContext = thread->getContext();
     Sync *syncObject            = display->getSync(syncID);
+
+    ScopedShareGroupLock shareGroupLock(currentContext);
+
     ANGLE_EGL_TRY_RETURN(thread, syncObject->serverWait(display, currentContext, flags),
                          "eglWaitSync", GetSyncIfValid(display, syncID), EGL_FALSE);
 
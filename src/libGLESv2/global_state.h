@@ -194,6 +194,22 @@ static ANGLE_INLINE void DirtyContextIfNeeded(Context *context)
 #if !defined(ANGLE_ENABLE_SHARE_CONTEXT_LOCK)
 #    define SCOPED_SHARE_CONTEXT_LOCK(context)
 #else
+// Returns the mutex serializing the GL calls of a shared context with the other contexts it shares
+// objects with.  With per-share-group locking, that is the mutex of its share group, so contexts of
+// unrelated share groups don't block each other.  Contexts sharing the display-wide texture or
+// semaphore managers may share objects with contexts of any share group, so they still take the
+// global mutex.
+ANGLE_INLINE angle::GlobalMutex &GetShareContextMutex(Context *context)
+{
+#    if defined(ANGLE_ENABLE_SHARE_GROUP_LOCK)
+    if (!context->usingDisplayTextureShareGroup() && !context->usingDisplaySemaphoreShareGroup())
+    {
+        return context->getShareGroup()->getMutex();
+    }
+#    endif
+    return egl::GetGlobalMutex();
+}
+
 ANGLE_INLINE std::unique_lock<angle::GlobalMutex> GetContextLock(Context *context)
 {
 #    if defined(ANGLE_FORCE_CONTEXT_CHECK_EVERY_CALL)
@@ -202,7 +218,7 @@ ANGLE_INLINE std::unique_lock<angle::GlobalMutex> GetContextLock(Context *contex
     DirtyContextIfNeeded(context);
     return lock;
 #    else
-    return context->isShared() ? std::unique_lock<angle::GlobalMutex>(egl::GetGlobalMutex())
+    return context->isShared() ? std::unique_lock<angle::GlobalMutex>(GetShareContextMutex(context))
                                : std::unique_lock<angle::GlobalMutex>();
 #    endif
 }
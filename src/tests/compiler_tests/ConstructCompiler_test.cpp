@@ -44,3 +44,47 @@ TEST(ConstructCompilerTest, InvalidMaxDualSourceDrawBuffers)
                                               SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
     ASSERT_EQ(nullptr, compiler);
 }
+
+// Test that compilers created with the same resources can share built-in variables, and that
+// those created with other resources don't see them.
+TEST(ConstructCompilerTest, SharedBuiltInVariables)
+{
+    constexpr char kShader[] = R"(#extension GL_EXT_draw_buffers : require
+precision mediump float;
+void main()
+{
+    gl_FragData[3] = vec4(float(gl_MaxDrawBuffers));
+})";
+    const char *shaderStrings[] = {kShader};
+
+    ShCompileOptions options = {};
+    options.objectCode       = true;
+
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    resources.EXT_draw_buffers = 1;
+    resources.MaxDrawBuffers   = 4;
+
+    ShHandle firstCompiler =
+        sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, firstCompiler);
+    ShHandle secondCompiler =
+        sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, secondCompiler);
+
+    resources.MaxDrawBuffers = 2;
+    ShHandle fewerDrawBuffersCompiler =
+        sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, fewerDrawBuffersCompiler);
+
+    EXPECT_TRUE(sh::Compile(firstCompiler, shaderStrings, 1, options));
+    EXPECT_FALSE(sh::Compile(fewerDrawBuffersCompiler, shaderStrings, 1, options));
+
+    // The shared variables outlive the compiler that created them.
+    sh::Destruct(firstCompiler);
+    EXPECT_TRUE(sh::Compile(secondCompiler, shaderStrings, 1, options));
+    EXPECT_NE(std::string::npos, sh::GetObjectCode(secondCompiler).find("4.0"));
+
+    sh::Destruct(secondCompiler);
+    sh::Destruct(fewerDrawBuffersCompiler);
+}
@@ -8,6 +8,7 @@
 //
 
 #include <clocale>
+#include <cstring>
 #include "GLSLANG/ShaderLang.h"
 #include "angle_gl.h"
 #include "common/angleutils.h"
@@ -141,6 +142,126 @@ TEST_F(ShCompileTest, TokensSplitInShaderStrings)
     testCompile(shaderStrings, 3, true);
 }
 
+// Test that the pass statistics list the AST transformations, with the ones that only rewrite
+// constructs the shader doesn't use skipped.
+TEST_F(ShCompileTest, PassStatistics)
+{
+    const auto findPass = [this](const char *name) -> const sh::CompilePassStatistics * {
+        for (const sh::CompilePassStatistics &pass : sh::GetCompilePassStatistics(mCompiler))
+        {
+            if (strcmp(pass.name, name) == 0)
+            {
+                return &pass;
+            }
+        }
+        return nullptr;
+    };
+
+    ShCompileOptions options      = {};
+    options.objectCode            = true;
+    options.collectPassStatistics = true;
+
+    const char kStraightLineSource[] = R"(precision mediump float;
+uniform vec4 u;
+void main()
+{
+    gl_FragColor = u;
+})";
+    const char *straightLineStrings[] = {kStraightLineSource};
+    ASSERT_TRUE(sh::Compile(mCompiler, straightLineStrings, 1, options));
+
+    ASSERT_NE(nullptr, findPass("PruneNoOps"));
+    EXPECT_FALSE(findPass("PruneNoOps")->skipped);
+    ASSERT_NE(nullptr, findPass("SimplifyLoopConditions"));
+    EXPECT_TRUE(findPass("SimplifyLoopConditions")->skipped);
+    ASSERT_NE(nullptr, findPass("SeparateDeclarations"));
+    EXPECT_TRUE(findPass("SeparateDeclarations")->skipped);
+    ASSERT_NE(nullptr, findPass("SplitSequenceOperator"));
+    EXPECT_TRUE(findPass("SplitSequenceOperator")->skipped);
+
+    const char kLoopSource[] = R"(precision mediump float;
+uniform vec4 u;
+void main()
+{
+    vec4 a = u, b = u;
+    for (int i = 0; i < 4; ++i)
+    {
+        a = (b += a, a * 0.5);
+    }
+    gl_FragColor = a;
+})";
+    const char *loopStrings[] = {kLoopSource};
+    ASSERT_TRUE(sh::Compile(mCompiler, loopStrings, 1, options));
+
+    EXPECT_FALSE(findPass("SimplifyLoopConditions")->skipped);
+    EXPECT_FALSE(findPass("SeparateDeclarations")->skipped);
+    EXPECT_FALSE(findPass("SplitSequenceOperator")->skipped);
+    EXPECT_GE(findPass("SeparateDeclarations")->timeSeconds, 0.0);
+
+    // Nothing is collected without the compile option.
+    options.collectPassStatistics = false;
+    ASSERT_TRUE(sh::Compile(mCompiler, loopStrings, 1, options));
+    EXPECT_TRUE(sh::GetCompilePassStatistics(mCompiler).empty());
+}
+
+// Test that compiling a shader again with another compiler of the same kind gets the translation
+// and reflection from the translation cache, and that different options don't.
+TEST_F(ShCompileTest, TranslationCache)
+{
+    constexpr char kShader[] = R"(precision mediump float;
+uniform vec4 uColor;
+uniform sampler2D uTexture;
+varying vec2 vTexCoord;
+void main()
+{
+    gl_FragColor = texture2D(uTexture, vTexCoord) * uColor;
+})";
+    const char *shaderStrings[] = {kShader};
+
+    ShCompileOptions options = {};
+    options.objectCode       = true;
+    options.variables        = true;
+    options.cacheTranslation = true;
+
+    sh::ClearTranslationCache();
+
+    ASSERT_TRUE(sh::Compile(mCompiler, shaderStrings, 1, options));
+    const std::string objectCode = sh::GetObjectCode(mCompiler);
+
+    ShHandle otherCompiler = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC,
+                                                   SH_GLSL_COMPATIBILITY_OUTPUT, &mResources);
+    ASSERT_NE(nullptr, otherCompiler);
+    ASSERT_TRUE(sh::Compile(otherCompiler, shaderStrings, 1, options));
+
+    sh::TranslationCacheStatistics statistics = sh::GetTranslationCacheStatistics();
+    EXPECT_EQ(1u, statistics.hits);
+    EXPECT_EQ(1u, statistics.misses);
+    EXPECT_EQ(1u, statistics.entryCount);
+    EXPECT_GT(statistics.size, objectCode.size());
+
+    EXPECT_EQ(objectCode, sh::GetObjectCode(otherCompiler));
+    EXPECT_EQ(100, sh::GetShaderVersion(otherCompiler));
+    ASSERT_NE(nullptr, sh::GetUniforms(otherCompiler));
+    EXPECT_EQ(2u, sh::GetUniforms(otherCompiler)->size());
+    ASSERT_NE(nullptr, sh::GetInputVaryings(otherCompiler));
+    EXPECT_EQ(1u, sh::GetInputVaryings(otherCompiler)->size());
+
+    // Different compile options are another translation.
+    options.initOutputVariables = true;
+    ASSERT_TRUE(sh::Compile(otherCompiler, shaderStrings, 1, options));
+    statistics = sh::GetTranslationCacheStatistics();
+    EXPECT_EQ(1u, statistics.hits);
+    EXPECT_EQ(2u, statistics.misses);
+    EXPECT_EQ(2u, statistics.entryCount);
+
+    sh::Destruct(otherCompiler);
+
+    sh::ClearTranslationCache();
+    statistics = sh::GetTranslationCacheStatistics();
+    EXPECT_EQ(0u, statistics.hits);
+    EXPECT_EQ(0u, statistics.entryCount);
+}
+
 // Parsing floats in shaders can run afoul of locale settings.
 // Eg. in de_DE, `strtof("1.9")` will yield `1.0f`. (It's expecting "1,9")
 TEST_F(ShCompileTest, DecimalSepLocale)
@@ -0,0 +1,223 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DmaBufImageTest:
+//   Tests importing dma_bufs as EGL images with EGL_EXT_image_dma_buf_import, the way video
+//   playback recycles a pool of buffers.  The buffers are allocated from udmabuf or the system
+//   dma-buf heap, whichever is available.
+//
+
+#include "test_utils/ANGLETest.h"
+#include "test_utils/gl_raii.h"
+#include "util/EGLWindow.h"
+
+#include <fcntl.h>
+#include <linux/dma-buf.h>
+#include <linux/dma-heap.h>
+#include <linux/udmabuf.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+namespace angle
+{
+namespace
+{
+// A single page of RGBA8 pixels, as udmabuf requires page-aligned sizes.
+constexpr GLsizei kSize      = 32;
+constexpr size_t kBufferSize = kSize * kSize * 4;
+
+// DRM_FORMAT_ABGR8888, i.e. RGBA8 in memory order.
+constexpr EGLint kDrmFormatABGR8888 = 0x34324241;
+
+// Allocates a dma_buf backed by a memfd through udmabuf.
+int AllocateUdmabuf(size_t size)
+{
+    int deviceFd = open("/dev/udmabuf", O_RDWR | O_CLOEXEC);
+    if (deviceFd < 0)
+    {
+        return -1;
+    }
+
+    int dmaBufFd = -1;
+    int memFd    = memfd_create("angle_dma_buf_image_test", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memFd >= 0 && ftruncate(memFd, static_cast<off_t>(size)) == 0 &&
+        fcntl(memFd, F_ADD_SEALS, F_SEAL_SHRINK) == 0)
+    {
+        udmabuf_create create = {};
+        create.memfd          = static_cast<__u32>(memFd);
+        create.flags          = UDMABUF_FLAGS_CLOEXEC;
+        create.offset         = 0;
+        create.size           = size;
+        dmaBufFd              = ioctl(deviceFd, UDMABUF_CREATE, &create);
+    }
+
+    if (memFd >= 0)
+    {
+        close(memFd);
+    }
+    close(deviceFd);
+    return dmaBufFd;
+}
+
+// Allocates a dma_buf from the system dma-buf heap.
+int AllocateFromDmaHeap(size_t size)
+{
+    int heapFd = open("/dev/dma_heap/system", O_RDONLY | O_CLOEXEC);
+    if (heapFd < 0)
+    {
+        return -1;
+    }
+
+    dma_heap_allocation_data allocation = {};
+    allocation.len                      = size;
+    allocation.fd_flags                 = O_RDWR | O_CLOEXEC;
+
+    int dmaBufFd = -1;
+    if (ioctl(heapFd, DMA_HEAP_IOCTL_ALLOC, &allocation) == 0)
+    {
+        dmaBufFd = static_cast<int>(allocation.fd);
+    }
+
+    close(heapFd);
+    return dmaBufFd;
+}
+}  // anonymous namespace
+
+class DmaBufImageTest : public ANGLETest<>
+{
+  protected:
+    DmaBufImageTest()
+    {
+        setWindowWidth(kSize);
+        setWindowHeight(kSize);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    void testSetUp() override
+    {
+        mDmaBufFd = AllocateUdmabuf(kBufferSize);
+        if (mDmaBufFd < 0)
+        {
+            mDmaBufFd = AllocateFromDmaHeap(kBufferSize);
+        }
+    }
+
+    void testTearDown() override
+    {
+        if (mDmaBufFd >= 0)
+        {
+            close(mDmaBufFd);
+        }
+    }
+
+    bool hasDmaBufImportExt() const
+    {
+        return IsEGLDisplayExtensionEnabled(getEGLWindow()->getDisplay(),
+                                            "EGL_EXT_image_dma_buf_import");
+    }
+
+    // Writes |color| to every pixel of the buffer through a CPU mapping.
+    void fillBuffer(const GLColor &color)
+    {
+        void *mapping =
+            mmap(nullptr, kBufferSize, PROT_READ | PROT_WRITE, MAP_SHARED, mDmaBufFd, 0);
+        ASSERT_NE(MAP_FAILED, mapping);
+
+        dma_buf_sync sync = {};
+        sync.flags        = DMA_BUF_SYNC_START | DMA_BUF_SYNC_WRITE;
+        ioctl(mDmaBufFd, DMA_BUF_IOCTL_SYNC, &sync);
+
+        GLColor *pixels = static_cast<GLColor *>(mapping);
+        std::fill(pixels, pixels + kSize * kSize, color);
+
+        sync.flags = DMA_BUF_SYNC_END | DMA_BUF_SYNC_WRITE;
+        ioctl(mDmaBufFd, DMA_BUF_IOCTL_SYNC, &sync);
+
+        munmap(mapping, kBufferSize);
+    }
+
+    // Like a buffer received from another process, every import uses a new file descriptor.
+    EGLImageKHR importBuffer()
+    {
+        int importFd = dup(mDmaBufFd);
+
+        const EGLint attribs[] = {EGL_WIDTH,
+                                  kSize,
+                                  EGL_HEIGHT,
+                                  kSize,
+                                  EGL_LINUX_DRM_FOURCC_EXT,
+                                  kDrmFormatABGR8888,
+                                  EGL_DMA_BUF_PLANE0_FD_EXT,
+                                  importFd,
+                                  EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+                                  0,
+                                  EGL_DMA_BUF_PLANE0_PITCH_EXT,
+                                  kSize * 4,
+                                  EGL_NONE};
+
+        EGLImageKHR image = eglCreateImageKHR(getEGLWindow()->getDisplay(), EGL_NO_CONTEXT,
+                                              EGL_LINUX_DMA_BUF_EXT, nullptr, attribs);
+
+        // EGL does not take ownership of the file descriptor.
+        close(importFd);
+        return image;
+    }
+
+    int mDmaBufFd = -1;
+};
+
+// Tests that re-importing a dma_buf after writing new contents to it, and binding the new image to
+// the texture the previous import was bound to, samples the new contents.
+TEST_P(DmaBufImageTest, ReimportRecycledBuffer)
+{
+    ANGLE_SKIP_TEST_IF(!hasDmaBufImportExt());
+    ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_OES_EGL_image_external"));
+    ANGLE_SKIP_TEST_IF(mDmaBufFd < 0);
+
+    // Check that the driver can import the buffer at all.
+    EGLImageKHR image = importBuffer();
+    ANGLE_SKIP_TEST_IF(image == EGL_NO_IMAGE_KHR);
+    eglDestroyImageKHR(getEGLWindow()->getDisplay(), image);
+
+    constexpr char kFS[] = R"(#extension GL_OES_EGL_image_external : require
+precision mediump float;
+uniform samplerExternalOES tex;
+varying vec2 v_texCoord;
+void main()
+{
+    gl_FragColor = texture2D(tex, v_texCoord);
+})";
+
+    ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Texture2D(), kFS);
+
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_EXTERNAL_OES, texture);
+    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    for (const GLColor &color : {GLColor::red, GLColor::green, GLColor::blue})
+    {
+        fillBuffer(color);
+
+        image = importBuffer();
+        ASSERT_NE(EGL_NO_IMAGE_KHR, image);
+
+        glEGLImageTargetTexture2DOES(GL_TEXTURE_EXTERNAL_OES, image);
+        drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+        EXPECT_PIXEL_RECT_EQ(0, 0, kSize, kSize, color);
+
+        eglDestroyImageKHR(getEGLWindow()->getDisplay(), image);
+        ASSERT_GL_NO_ERROR();
+    }
+}
+
+ANGLE_INSTANTIATE_TEST_ES2(DmaBufImageTest);
+}  // namespace angle
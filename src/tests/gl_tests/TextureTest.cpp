@@ -3060,6 +3060,61 @@ TEST_P(Texture2DTest, TexImageUnpackRowLengthPBO)
     EXPECT_PIXEL_COLOR_EQ(0, height - 1, GLColor::blue);
 }
 
+// Test uploads from client memory large enough to be split in chunks by some back-ends, with
+// unpack parameters that the chunks have to respect.
+TEST_P(Texture2DTestES3, LargeTexSubImageUnpackParameters)
+{
+    constexpr GLsizei kWidth      = 1024;
+    constexpr GLsizei kHeight     = 1024;
+    constexpr GLint kRowLength    = kWidth + 16;
+    constexpr GLint kSkipPixels   = 5;
+    constexpr GLint kSkipRows     = 3;
+    constexpr GLsizei kDataHeight = kHeight + kSkipRows;
+
+    // Rows of the upload alternate between bands of green and blue, the rest is red.
+    std::vector<GLColor> pixels(kRowLength * kDataHeight, GLColor::red);
+    for (GLint y = 0; y < kHeight; ++y)
+    {
+        for (GLint x = 0; x < kWidth; ++x)
+        {
+            pixels[(y + kSkipRows) * kRowLength + x + kSkipPixels] =
+                (y / 64) % 2 == 0 ? GLColor::green : GLColor::blue;
+        }
+    }
+
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kWidth, kHeight);
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, kRowLength);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, kSkipPixels);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, kSkipRows);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kWidth, kHeight, GL_RGBA, GL_UNSIGNED_BYTE,
+                    pixels.data());
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    ASSERT_GL_NO_ERROR();
+
+    // A small upload afterwards must not be affected by the state used by the large one.
+    std::vector<GLColor> smallPixels(4 * 4, GLColor::yellow);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 4, 4, GL_RGBA, GL_UNSIGNED_BYTE, smallPixels.data());
+    ASSERT_GL_NO_ERROR();
+
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::yellow);
+    EXPECT_PIXEL_COLOR_EQ(3, 3, GLColor::yellow);
+    EXPECT_PIXEL_COLOR_EQ(4, 4, GLColor::green);
+    EXPECT_PIXEL_COLOR_EQ(kWidth - 1, 63, GLColor::green);
+    EXPECT_PIXEL_COLOR_EQ(0, 64, GLColor::blue);
+    EXPECT_PIXEL_COLOR_EQ(kWidth / 2, kHeight / 2, GLColor::green);
+    EXPECT_PIXEL_COLOR_EQ(kWidth - 1, kHeight - 1, GLColor::blue);
+}
+
 // Test if the KHR debug label is set and passed to D3D correctly using glCopyTexImage2D.
 TEST_P(Texture2DTest, TextureKHRDebugLabelWithCopyTexImage2D)
 {
@@ -8539,6 +8594,85 @@ class Texture2DNorm16TestES3 : public Texture2DTestES3
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
+    // Reads RGBA pixels of a norm16 framebuffer into a pixel pack buffer, at an offset and with
+    // padded rows, and checks them once the buffer is mapped, along with the padding left as is.
+    void testNorm16RenderAndReadPixelsIntoPBO(GLint internalformat, GLenum format, GLenum usage)
+    {
+        // TODO(http://anglebug.com/4089) Fails on Win Intel OpenGL driver
+        ANGLE_SKIP_TEST_IF(IsIntel() && IsOpenGL());
+        // TODO(http://anglebug.com/4245) Fails on Win AMD OpenGL driver
+        ANGLE_SKIP_TEST_IF(IsWindows() && IsAMD() && IsDesktopOpenGL());
+        ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_EXT_texture_norm16"));
+
+        constexpr GLushort kPixelValue   = 0x6A35;
+        constexpr GLushort kPaddingValue = 0xA5A5;
+        constexpr GLint kSize            = 4;
+        constexpr GLint kRowLength       = kSize + 1;
+        constexpr GLintptr kOffset       = 16;
+        constexpr GLsizeiptr kDataSize   = kRowLength * kSize * sizeof(GLColor16UI);
+
+        const GLushort imageData[] = {kPixelValue, kPixelValue, kPixelValue, kPixelValue};
+        const GLColor16UI color    = SliceFormatColor16UI(
+            format, GLColor16UI(kPixelValue, kPixelValue, kPixelValue, kPixelValue));
+
+        setUpProgram();
+
+        glBindTexture(GL_TEXTURE_2D, mTextures[1]);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalformat, kSize, kSize, 0, format, GL_UNSIGNED_SHORT,
+                     nullptr);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mTextures[1],
+                               0);
+
+        glBindTexture(GL_TEXTURE_2D, mTextures[2]);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalformat, 1, 1, 0, format, GL_UNSIGNED_SHORT,
+                     imageData);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        drawQuad(mProgram, "position", 0.5f);
+
+        GLBuffer pbo;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        const std::vector<GLushort> initialData((kOffset + kDataSize) / sizeof(GLushort),
+                                                kPaddingValue);
+        glBufferData(GL_PIXEL_PACK_BUFFER, kOffset + kDataSize, initialData.data(), usage);
+
+        glPixelStorei(GL_PACK_ROW_LENGTH, kRowLength);
+        glReadPixels(0, 0, kSize, kSize, GL_RGBA, GL_UNSIGNED_SHORT,
+                     reinterpret_cast<void *>(kOffset));
+        glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+        ASSERT_GL_NO_ERROR();
+
+        const GLushort *pixels = static_cast<const GLushort *>(
+            glMapBufferRange(GL_PIXEL_PACK_BUFFER, kOffset, kDataSize, GL_MAP_READ_BIT));
+        ASSERT_NE(nullptr, pixels);
+
+        for (GLint y = 0; y < kSize; ++y)
+        {
+            for (GLint x = 0; x < kSize; ++x)
+            {
+                const GLushort *pixel = pixels + (y * kRowLength + x) * 4;
+                EXPECT_EQ(color.R, pixel[0]) << x << ", " << y;
+                EXPECT_EQ(color.G, pixel[1]) << x << ", " << y;
+                EXPECT_EQ(color.B, pixel[2]) << x << ", " << y;
+                EXPECT_EQ(color.A, pixel[3]) << x << ", " << y;
+            }
+
+            const GLushort *padding = pixels + (y * kRowLength + kSize) * 4;
+            for (GLint channel = 0; channel < 4; ++channel)
+            {
+                EXPECT_EQ(kPaddingValue, padding[channel]) << y;
+            }
+        }
+
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        ASSERT_GL_NO_ERROR();
+    }
+
     GLuint mTextures[3];
     GLuint mFBO;
     GLuint mRenderbuffer;
@@ -8614,6 +8748,76 @@ TEST_P(Texture2DNorm16TestES3, TextureNorm16RGBA16RenderTest)
     testNorm16RenderAndReadPixels(GL_RGBA16_EXT, GL_RGBA, GL_UNSIGNED_SHORT);
 }
 
+// Test reading RGBA pixels of an R16 framebuffer into a pixel pack buffer meant for readback.
+TEST_P(Texture2DNorm16TestES3, TextureNorm16R16RenderReadPixelsIntoPBO)
+{
+    // http://anglebug.com/5153
+    ANGLE_SKIP_TEST_IF(IsOSX() && IsOpenGL() && IsNVIDIA());
+
+    testNorm16RenderAndReadPixelsIntoPBO(GL_R16_EXT, GL_RED, GL_STREAM_READ);
+}
+
+// Test reading RGBA pixels of an RG16 framebuffer into a pixel pack buffer not meant for readback.
+TEST_P(Texture2DNorm16TestES3, TextureNorm16RG16RenderReadPixelsIntoPBO)
+{
+    // http://anglebug.com/5153
+    ANGLE_SKIP_TEST_IF(IsOSX() && IsOpenGL() && IsNVIDIA());
+
+    testNorm16RenderAndReadPixelsIntoPBO(GL_RG16_EXT, GL_RG, GL_STATIC_DRAW);
+}
+
+// Test that RGBA pixels read from an RG16 framebuffer into a pixel pack buffer meant for readback
+// are in the buffer when it is then used to upload a texture, before it is ever mapped.
+TEST_P(Texture2DNorm16TestES3, TextureNorm16RG16ReadPixelsIntoPBOThenTexSubImage)
+{
+    // TODO(http://anglebug.com/4089) Fails on Win Intel OpenGL driver
+    ANGLE_SKIP_TEST_IF(IsIntel() && IsOpenGL());
+    // TODO(http://anglebug.com/4245) Fails on Win AMD OpenGL driver
+    ANGLE_SKIP_TEST_IF(IsWindows() && IsAMD() && IsDesktopOpenGL());
+    // http://anglebug.com/5153
+    ANGLE_SKIP_TEST_IF(IsOSX() && IsOpenGL() && IsNVIDIA());
+    ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_EXT_texture_norm16"));
+
+    constexpr GLint kSize          = 4;
+    constexpr GLsizeiptr kDataSize = kSize * kSize * sizeof(GLColor16UI);
+
+    setUpProgram();
+
+    glBindTexture(GL_TEXTURE_2D, mTextures[1]);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16_EXT, kSize, kSize, 0, GL_RG, GL_UNSIGNED_SHORT,
+                 nullptr);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mTextures[1], 0);
+    glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // Stale contents of the buffer would upload transparent black.
+    GLBuffer pbo;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+    const std::vector<GLushort> initialData(kDataSize / sizeof(GLushort), 0);
+    glBufferData(GL_PIXEL_PACK_BUFFER, kDataSize, initialData.data(), GL_STREAM_READ);
+    glReadPixels(0, 0, kSize, kSize, GL_RGBA, GL_UNSIGNED_SHORT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    ASSERT_GL_NO_ERROR();
+
+    glBindTexture(GL_TEXTURE_2D, mTextures[2]);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16_EXT, kSize, kSize, 0, GL_RGBA, GL_UNSIGNED_SHORT,
+                 nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kSize, kSize, GL_RGBA, GL_UNSIGNED_SHORT, nullptr);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    ASSERT_GL_NO_ERROR();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+    drawQuad(mProgram, "position", 0.5f);
+    EXPECT_PIXEL_RECT_EQ(0, 0, getWindowWidth(), getWindowHeight(), GLColor::red);
+    ASSERT_GL_NO_ERROR();
+}
+
 class Texture2DRGTest : public Texture2DTest
 {
   protected:
@@ -1153,6 +1153,63 @@ TEST_P(UniformTestES3, BooleanUniformAsIfAndForCondition)
     EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
 }
 
+// Tests that uniform values set between draws, including partial array updates and values set
+// again unchanged, are used by the following draws and returned by queries.
+TEST_P(UniformTestES3, UpdatesBetweenDraws)
+{
+    constexpr char kFS[] = R"(#version 300 es
+precision mediump float;
+uniform vec4 colors[3];
+uniform float scale;
+out vec4 result;
+void main()
+{
+    result = (colors[0] + colors[1] + colors[2]) * scale;
+})";
+
+    ANGLE_GL_PROGRAM(program, essl3_shaders::vs::Simple(), kFS);
+    glUseProgram(program);
+
+    GLint colorsLocation  = glGetUniformLocation(program, "colors");
+    GLint colors0Location = glGetUniformLocation(program, "colors[0]");
+    GLint colors1Location = glGetUniformLocation(program, "colors[1]");
+    GLint scaleLocation   = glGetUniformLocation(program, "scale");
+    ASSERT_NE(-1, colorsLocation);
+    ASSERT_NE(-1, colors0Location);
+    ASSERT_NE(-1, colors1Location);
+    ASSERT_NE(-1, scaleLocation);
+
+    const GLfloat kColors[] = {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+    glUniform4fv(colorsLocation, 3, kColors);
+    glUniform1f(scaleLocation, 1.0f);
+    drawQuad(program, essl3_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+
+    // Update the middle element only, and set the scale to the value it already has.
+    const GLfloat kGreen[] = {0, 1, 0, 0};
+    glUniform4fv(colors1Location, 1, kGreen);
+    glUniform1f(scaleLocation, 1.0f);
+
+    // The new value is returned before any draw uses it.
+    GLfloat queried[4] = {};
+    glGetUniformfv(program, colors1Location, queried);
+    EXPECT_EQ(0.0f, queried[0]);
+    EXPECT_EQ(1.0f, queried[1]);
+
+    drawQuad(program, essl3_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::yellow);
+
+    // Change the scale and change it back before drawing.
+    const GLfloat kZero[] = {0, 0, 0, 0};
+    glUniform4fv(colors0Location, 1, kZero);
+    glUniform1f(scaleLocation, 0.0f);
+    glUniform1f(scaleLocation, 1.0f);
+    drawQuad(program, essl3_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+
+    ASSERT_GL_NO_ERROR();
+}
+
 class UniformTestES31 : public ANGLETest<>
 {
   protected:
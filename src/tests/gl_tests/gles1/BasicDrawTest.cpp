@@ -80,6 +80,54 @@ TEST_P(BasicDrawTest, EnableDisableTexture)
     EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
 }
 
+// Checks that draws are correct when the states they need a new program for change on every draw,
+// whether the program for them is already built or not.
+TEST_P(BasicDrawTest, StateChangesBetweenDraws)
+{
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    // Green
+    GLubyte textureData[] = {
+        0x00,
+        0xff,
+        0x00,
+    };
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, textureData);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, mPositions.data());
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    for (int iteration = 0; iteration < 3; ++iteration)
+    {
+        // Texturing is disabled; red.
+        glClear(GL_COLOR_BUFFER_BIT);
+        glColor4f(1.0f, 0.0f, 0.0f, 1.0f);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+
+        // Texturing enabled; green (provided modulate w/ white).
+        glClear(GL_COLOR_BUFFER_BIT);
+        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+        glEnable(GL_TEXTURE_2D);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+
+        // Alpha test never passes; nothing drawn.
+        glClear(GL_COLOR_BUFFER_BIT);
+        glEnable(GL_ALPHA_TEST);
+        glAlphaFunc(GL_NEVER, 0.0f);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::transparentBlack);
+
+        glDisable(GL_ALPHA_TEST);
+        glDisable(GL_TEXTURE_2D);
+    }
+
+    EXPECT_GL_NO_ERROR();
+}
+
 // Check that glClearColorx, glClearDepthx, glLineWidthx, glPolygonOffsetx can work.
 TEST_P(BasicDrawTest, DepthTest)
 {
@@ -0,0 +1,145 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BlobCachePerf: Performance test for concurrent lookups in the blob cache, as done by the program
+// and shader caches when several contexts link programs at the same time. Each step looks up and
+// decompresses a fixed number of blobs, split between the threads, so the time per step is the
+// inverse of the lookup throughput.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <thread>
+
+#include "libANGLE/BlobCache.h"
+
+using namespace testing;
+
+namespace
+{
+constexpr size_t kBlobCount      = 256;
+constexpr size_t kBlobSize       = 16 * 1024;
+constexpr size_t kLookupsPerStep = 1024;
+
+struct BlobCacheParams
+{
+    BlobCacheParams(size_t threadCount, bool sameKey) : threadCount(threadCount), sameKey(sameKey)
+    {}
+
+    size_t threadCount;
+    // Whether all threads look up the same blob, instead of each going through all the blobs.
+    bool sameKey;
+};
+
+std::ostream &operator<<(std::ostream &os, const BlobCacheParams &params)
+{
+    os << params.threadCount << "_threads" << (params.sameKey ? "_same_key" : "_all_keys");
+    return os;
+}
+
+class BlobCachePerfTest : public ANGLEPerfTest, public WithParamInterface<BlobCacheParams>
+{
+  public:
+    BlobCachePerfTest();
+
+    void step() override;
+
+    std::string getName();
+
+  private:
+    void lookUp(size_t threadIndex, size_t lookupCount);
+
+    egl::BlobCache mBlobCache;
+    std::vector<egl::BlobCache::Key> mKeys;
+};
+
+BlobCachePerfTest::BlobCachePerfTest()
+    : ANGLEPerfTest(getName(), "", "_run", 1, "us"), mBlobCache(kBlobCount * kBlobSize)
+{
+    for (size_t blobIndex = 0; blobIndex < kBlobCount; ++blobIndex)
+    {
+        egl::BlobCache::Key key;
+        for (size_t byte = 0; byte < key.size(); ++byte)
+        {
+            key[byte] = static_cast<uint8_t>(blobIndex * 31 + byte);
+        }
+        mKeys.push_back(key);
+
+        // Fill the blob with somewhat repetitive data, so it compresses like a program binary.
+        angle::MemoryBuffer blob;
+        EXPECT_TRUE(blob.resize(kBlobSize));
+        for (size_t byte = 0; byte < kBlobSize; ++byte)
+        {
+            blob[byte] = static_cast<uint8_t>((byte % 64) * (blobIndex + 1) + byte / 1024);
+        }
+
+        EXPECT_TRUE(mBlobCache.compressAndPut(key, std::move(blob), nullptr));
+    }
+}
+
+void BlobCachePerfTest::lookUp(size_t threadIndex, size_t lookupCount)
+{
+    const BlobCacheParams &params = GetParam();
+
+    angle::MemoryBuffer uncompressed;
+    for (size_t lookup = 0; lookup < lookupCount; ++lookup)
+    {
+        const size_t blobIndex = params.sameKey ? 0 : (threadIndex * 37 + lookup) % kBlobCount;
+        egl::BlobCache::GetAndDecompressResult result =
+            mBlobCache.getAndDecompress(nullptr, mKeys[blobIndex], &uncompressed);
+        ASSERT_EQ(egl::BlobCache::GetAndDecompressResult::GetSuccess, result);
+    }
+}
+
+void BlobCachePerfTest::step()
+{
+    const BlobCacheParams &params = GetParam();
+    const size_t lookupsPerThread = kLookupsPerStep / params.threadCount;
+
+    if (params.threadCount == 1)
+    {
+        lookUp(0, lookupsPerThread);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t threadIndex = 0; threadIndex < params.threadCount; ++threadIndex)
+    {
+        threads.emplace_back([this, threadIndex, lookupsPerThread]() {
+            lookUp(threadIndex, lookupsPerThread);
+        });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+std::string BlobCachePerfTest::getName()
+{
+    std::stringstream ss;
+    ss << UnitTest::GetInstance()->current_test_case()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+// Measures the time to look up and decompress blobs from one or more threads.
+TEST_P(BlobCachePerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         BlobCachePerfTest,
+                         Values(BlobCacheParams(1, false),
+                                BlobCacheParams(2, false),
+                                BlobCacheParams(4, false),
+                                BlobCacheParams(8, false),
+                                BlobCacheParams(1, true),
+                                BlobCacheParams(4, true),
+                                BlobCacheParams(8, true)),
+                         PrintToStringParamName());
+
+}  // anonymous namespace
@@ -0,0 +1,225 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ClientArrayStreamingPerf:
+//   Performance test for draws sourcing vertex attributes and indices from client memory, as
+//   WebGL 1 content frequently does. Each iteration is one draw, so the reported time per
+//   iteration is the inverse of the client-array draws per second. The GL back-end is measured
+//   both with streaming buffers sub-allocated from a ring and with the single re-uploaded buffer.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "util/shader_utils.h"
+
+namespace angle
+{
+constexpr unsigned int kIterationsPerStep = 256;
+
+// Each draw renders a small batch of quads, like a UI or sprite layer drawn with client arrays.
+constexpr size_t kQuadsPerDraw    = 64;
+constexpr size_t kVerticesPerQuad = 4;
+constexpr size_t kIndicesPerQuad  = 6;
+
+struct ClientArrayStreamingParams final : public RenderTestParams
+{
+    ClientArrayStreamingParams()
+    {
+        iterationsPerStep = kIterationsPerStep;
+
+        // Common default params
+        majorVersion = 2;
+        minorVersion = 0;
+        windowWidth  = 256;
+        windowHeight = 256;
+    }
+
+    std::string story() const override;
+
+    bool indexed    = false;
+    bool ringBuffer = true;
+};
+
+std::ostream &operator<<(std::ostream &os, const ClientArrayStreamingParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+std::string ClientArrayStreamingParams::story() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::story();
+    strstr << (indexed ? "_draw_elements" : "_draw_arrays");
+    if (!ringBuffer)
+    {
+        strstr << "_single_streaming_buffer";
+    }
+
+    return strstr.str();
+}
+
+class ClientArrayStreamingBenchmark
+    : public ANGLERenderTest,
+      public ::testing::WithParamInterface<ClientArrayStreamingParams>
+{
+  public:
+    ClientArrayStreamingBenchmark() : ANGLERenderTest("ClientArrayStreaming", GetParam()) {}
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    GLuint mProgram = 0;
+    std::vector<GLfloat> mPositions;
+    std::vector<GLubyte> mColors;
+    std::vector<GLushort> mIndices;
+    size_t mFrame = 0;
+};
+
+void ClientArrayStreamingBenchmark::initializeBenchmark()
+{
+    constexpr char kVS[] = R"(attribute vec2 aPosition;
+attribute vec4 aColor;
+varying vec4 vColor;
+void main()
+{
+    vColor = aColor;
+    gl_Position = vec4(aPosition, 0, 1);
+})";
+
+    constexpr char kFS[] = R"(precision mediump float;
+varying vec4 vColor;
+void main()
+{
+    gl_FragColor = vColor;
+})";
+
+    mProgram = CompileProgram(kVS, kFS);
+    ASSERT_NE(0u, mProgram);
+    glUseProgram(mProgram);
+
+    const size_t vertexCount = kQuadsPerDraw * kVerticesPerQuad;
+    mPositions.resize(vertexCount * 2);
+    mColors.resize(vertexCount * 4);
+    mIndices.reserve(kQuadsPerDraw * kIndicesPerQuad);
+
+    // Lay the quads out on a grid covering the viewport.
+    const size_t gridSize = 8;
+    const float quadSize  = 2.0f / gridSize;
+    for (size_t quad = 0; quad < kQuadsPerDraw; ++quad)
+    {
+        const float x0 = -1.0f + quadSize * static_cast<float>(quad % gridSize);
+        const float y0 = -1.0f + quadSize * static_cast<float>(quad / gridSize);
+        const float corners[kVerticesPerQuad][2] = {
+            {x0, y0}, {x0 + quadSize, y0}, {x0, y0 + quadSize}, {x0 + quadSize, y0 + quadSize}};
+
+        for (size_t corner = 0; corner < kVerticesPerQuad; ++corner)
+        {
+            const size_t vertex = quad * kVerticesPerQuad + corner;
+
+            mPositions[vertex * 2 + 0] = corners[corner][0];
+            mPositions[vertex * 2 + 1] = corners[corner][1];
+        }
+
+        const GLushort base = static_cast<GLushort>(quad * kVerticesPerQuad);
+        for (GLushort index : {0, 1, 2, 2, 1, 3})
+        {
+            mIndices.push_back(base + index);
+        }
+    }
+
+    GLint positionLocation = glGetAttribLocation(mProgram, "aPosition");
+    GLint colorLocation    = glGetAttribLocation(mProgram, "aColor");
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glVertexAttribPointer(positionLocation, 2, GL_FLOAT, GL_FALSE, 0, mPositions.data());
+    glVertexAttribPointer(colorLocation, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, mColors.data());
+    glEnableVertexAttribArray(positionLocation);
+    glEnableVertexAttribArray(colorLocation);
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void ClientArrayStreamingBenchmark::destroyBenchmark()
+{
+    glDeleteProgram(mProgram);
+}
+
+void ClientArrayStreamingBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        // Change the client data every draw so that nothing can be cached across draws.
+        const GLubyte shade = static_cast<GLubyte>(mFrame++);
+        for (size_t vertex = 0; vertex < mColors.size() / 4; ++vertex)
+        {
+            mColors[vertex * 4 + 0] = shade;
+            mColors[vertex * 4 + 1] = static_cast<GLubyte>(vertex);
+            mColors[vertex * 4 + 2] = static_cast<GLubyte>(255 - shade);
+            mColors[vertex * 4 + 3] = 255;
+        }
+
+        if (params.indexed)
+        {
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mIndices.size()), GL_UNSIGNED_SHORT,
+                           mIndices.data());
+        }
+        else
+        {
+            // Draws the quads' triangle strips back to back, the result does not matter.
+            glDrawArrays(GL_TRIANGLE_STRIP, 0,
+                         static_cast<GLsizei>(kQuadsPerDraw * kVerticesPerQuad));
+        }
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+ClientArrayStreamingParams ClientArrayStreamingOpenGLParams(bool indexed, bool ringBuffer)
+{
+    ClientArrayStreamingParams params;
+    params.eglParameters = egl_platform::OPENGL_OR_GLES();
+    if (!ringBuffer)
+    {
+        params.eglParameters.disable(Feature::StreamClientArraysThroughRingBuffer);
+    }
+    params.indexed    = indexed;
+    params.ringBuffer = ringBuffer;
+    return params;
+}
+
+ClientArrayStreamingParams ClientArrayStreamingVulkanParams(bool indexed)
+{
+    ClientArrayStreamingParams params;
+    params.eglParameters = egl_platform::VULKAN();
+    params.indexed       = indexed;
+    return params;
+}
+
+// Measures the number of client-array draws per second.
+TEST_P(ClientArrayStreamingBenchmark, Run)
+{
+    run();
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ClientArrayStreamingBenchmark);
+ANGLE_INSTANTIATE_TEST(ClientArrayStreamingBenchmark,
+                       ClientArrayStreamingOpenGLParams(false, true),
+                       ClientArrayStreamingOpenGLParams(false, false),
+                       ClientArrayStreamingOpenGLParams(true, true),
+                       ClientArrayStreamingOpenGLParams(true, false),
+                       ClientArrayStreamingVulkanParams(false),
+                       ClientArrayStreamingVulkanParams(true));
+
+}  // namespace angle
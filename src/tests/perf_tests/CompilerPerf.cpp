@@ -6,12 +6,19 @@
 // CompilerPerfTest:
 //   Performance test for the shader translator. The test initializes the compiler once and then
 //   compiles the same shader repeatedly. There are different variations of the tests using
-//   different shaders.
+//   different shaders.  Besides the time per compile, the translation throughput is reported in
+//   bytes of translated output per second.
+//
+// ConstructCompilerPerfTest:
+//   Performance test for creating compilers, as done for each shader type of each context.  Each
+//   step constructs a number of compilers with the same resources and then destructs them.  The
+//   memory each compiler adds to the process is reported as well.
 //
 
 #include "ANGLEPerfTest.h"
 
 #include "GLSLANG/ShaderLang.h"
+#include "common/system_utils.h"
 #include "compiler/translator/Compiler.h"
 #include "compiler/translator/InitializeGlobals.h"
 #include "compiler/translator/PoolAlloc.h"
@@ -164,6 +171,9 @@ const char *kTrickyESSL300Id = "TrickyESSL300";
 
 constexpr int kNumIterationsPerStep = 4;
 
+// Number of compilers alive at the same time in each step of ConstructCompilerPerfTest.
+constexpr unsigned int kCompilersPerStep = 32;
+
 struct CompilerParameters
 {
     CompilerParameters() { output = SH_HLSL_4_1_OUTPUT; }
@@ -253,6 +263,9 @@ class CompilerPerfTest : public ANGLEPerfTest,
     void SetUp() override;
     void TearDown() override;
 
+    void recordTranslationThroughput();
+    void recordPoolAllocatorStatistics();
+
   protected:
     void setTestShader(const char *str) { mTestShader = str; }
 
@@ -262,6 +275,10 @@ class CompilerPerfTest : public ANGLEPerfTest,
     ShBuiltInResources mResources;
     angle::PoolAllocator mAllocator;
     sh::TCompiler *mTranslator;
+
+    // Size of the translated output, and time spent translating, over all the compiles.
+    size_t mTranslatedBytes = 0;
+    double mTranslateTime   = 0.0;
 };
 
 CompilerPerfTest::CompilerPerfTest()
@@ -320,15 +337,46 @@ void CompilerPerfTest::step()
     }
 #endif
 
+    double startTime = angle::GetCurrentSystemTime();
     for (unsigned int iteration = 0; iteration < kNumIterationsPerStep; ++iteration)
     {
         mTranslator->compile(shaderStrings, 1, compileOptions);
+        mTranslatedBytes += static_cast<size_t>(mTranslator->getInfoSink().obj.size());
     }
+    mTranslateTime += angle::GetCurrentSystemTime() - startTime;
+}
+
+void CompilerPerfTest::recordTranslationThroughput()
+{
+    if (mSkipTest || mTranslateTime == 0.0)
+    {
+        return;
+    }
+
+    recordDoubleMetric(".translation_throughput", mTranslatedBytes / mTranslateTime,
+                       "bytesPerSecond");
+}
+
+void CompilerPerfTest::recordPoolAllocatorStatistics()
+{
+    if (mSkipTest || mTranslator == nullptr)
+    {
+        return;
+    }
+
+    // The most memory used by the compiler's pool allocator, and how many of its pages were reused
+    // instead of being allocated again.
+    const angle::PoolAllocatorStatistics &statistics = mTranslator->getAllocator().getStatistics();
+    recordIntegerMetric(".pool_high_water_mark", statistics.highWaterMark, "sizeInBytes");
+    recordIntegerMetric(".pool_pages_allocated", statistics.pagesAllocated, "count");
+    recordIntegerMetric(".pool_pages_recycled", statistics.pagesRecycled, "count");
 }
 
 TEST_P(CompilerPerfTest, Run)
 {
     run();
+    recordTranslationThroughput();
+    recordPoolAllocatorStatistics();
 }
 
 ANGLE_INSTANTIATE_TEST(
@@ -348,4 +396,125 @@ ANGLE_INSTANTIATE_TEST(
     CompilerPerfParameters(SH_ESSL_OUTPUT, kRealWorldESSL100FragSource, kRealWorldESSL100Id),
     CompilerPerfParameters(SH_ESSL_OUTPUT, kTrickyESSL300FragSource, kTrickyESSL300Id));
 
+struct ConstructCompilerParameters final : public CompilerParameters
+{
+    ConstructCompilerParameters(ShShaderOutput output, GLenum shaderType)
+        : CompilerParameters(output), shaderType(shaderType)
+    {
+        testId = shaderType == GL_VERTEX_SHADER ? "vertex_" : "fragment_";
+        testId += CompilerParameters::str();
+    }
+
+    GLenum shaderType;
+    std::string testId;
+};
+
+std::ostream &operator<<(std::ostream &stream, const ConstructCompilerParameters &p)
+{
+    stream << p.testId;
+    return stream;
+}
+
+class ConstructCompilerPerfTest : public ANGLEPerfTest,
+                                  public ::testing::WithParamInterface<ConstructCompilerParameters>
+{
+  public:
+    ConstructCompilerPerfTest();
+
+    void step() override;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    void recordMemoryPerCompiler();
+
+  private:
+    ShBuiltInResources mResources;
+    std::vector<ShHandle> mCompilers;
+
+    // Growth of the process memory while the compilers of a step are alive, over all the steps.
+    uint64_t mCompilersMemoryKB = 0;
+    uint64_t mCompilerCount     = 0;
+};
+
+ConstructCompilerPerfTest::ConstructCompilerPerfTest()
+    : ANGLEPerfTest("ConstructCompilerPerf", "", GetParam().testId, kCompilersPerStep)
+{}
+
+void ConstructCompilerPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    ASSERT_TRUE(sh::Initialize());
+
+    sh::InitBuiltInResources(&mResources);
+    mResources.FragmentPrecisionHigh    = true;
+    mResources.MaxDrawBuffers           = 8;
+    mResources.EXT_draw_buffers         = 1;
+    mResources.OES_standard_derivatives = 1;
+
+    mCompilers.reserve(kCompilersPerStep);
+}
+
+void ConstructCompilerPerfTest::TearDown()
+{
+    sh::Finalize();
+
+    ANGLEPerfTest::TearDown();
+}
+
+void ConstructCompilerPerfTest::step()
+{
+    const ConstructCompilerParameters &params = GetParam();
+
+    uint64_t memoryBeforeKB = angle::GetProcessMemoryUsageKB();
+    for (unsigned int iteration = 0; iteration < kCompilersPerStep; ++iteration)
+    {
+        ShHandle compiler =
+            sh::ConstructCompiler(params.shaderType, SH_WEBGL2_SPEC, params.output, &mResources);
+        ASSERT_NE(nullptr, compiler);
+        mCompilers.push_back(compiler);
+    }
+    uint64_t memoryAfterKB = angle::GetProcessMemoryUsageKB();
+
+    if (memoryAfterKB > memoryBeforeKB)
+    {
+        mCompilersMemoryKB += memoryAfterKB - memoryBeforeKB;
+    }
+    mCompilerCount += mCompilers.size();
+
+    for (ShHandle compiler : mCompilers)
+    {
+        sh::Destruct(compiler);
+    }
+    mCompilers.clear();
+}
+
+void ConstructCompilerPerfTest::recordMemoryPerCompiler()
+{
+    if (mSkipTest || mCompilerCount == 0)
+    {
+        return;
+    }
+
+    recordIntegerMetric(".memory_per_compiler",
+                        static_cast<size_t>(mCompilersMemoryKB * 1024 / mCompilerCount),
+                        "sizeInBytes");
+}
+
+// Measures the time to construct a compiler, and the memory it takes.
+TEST_P(ConstructCompilerPerfTest, Run)
+{
+    run();
+    recordMemoryPerCompiler();
+}
+
+ANGLE_INSTANTIATE_TEST(ConstructCompilerPerfTest,
+                       ConstructCompilerParameters(SH_HLSL_4_1_OUTPUT, GL_VERTEX_SHADER),
+                       ConstructCompilerParameters(SH_HLSL_4_1_OUTPUT, GL_FRAGMENT_SHADER),
+                       ConstructCompilerParameters(SH_GLSL_450_CORE_OUTPUT, GL_VERTEX_SHADER),
+                       ConstructCompilerParameters(SH_GLSL_450_CORE_OUTPUT, GL_FRAGMENT_SHADER),
+                       ConstructCompilerParameters(SH_ESSL_OUTPUT, GL_VERTEX_SHADER),
+                       ConstructCompilerParameters(SH_ESSL_OUTPUT, GL_FRAGMENT_SHADER));
+
 }  // anonymous namespace
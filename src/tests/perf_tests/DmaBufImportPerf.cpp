@@ -0,0 +1,310 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DmaBufImportPerf:
+//   Performance test for importing dma_bufs as EGL images every frame, the way video playback
+//   hands decoded frames from a small pool of recycled buffers to the compositor.  Each iteration
+//   imports the next buffer of the pool through a freshly duplicated file descriptor, binds it to
+//   an external texture, draws with it and destroys the image.  The GL back-end is measured both
+//   with and without reusing the native images of buffers that were imported before.
+//   The buffers are allocated from udmabuf or the system dma-buf heap, whichever is available.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <fcntl.h>
+#include <linux/dma-heap.h>
+#include <linux/udmabuf.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <sstream>
+
+#include "util/shader_utils.h"
+
+namespace angle
+{
+constexpr unsigned int kIterationsPerStep = 16;
+
+// Number of buffers a decoder typically recycles.
+constexpr size_t kBufferCount = 4;
+constexpr size_t kBufferSize  = 256;
+
+// DRM_FORMAT_ABGR8888, i.e. RGBA8 in memory order.
+constexpr EGLint kDrmFormatABGR8888 = 0x34324241;
+
+namespace
+{
+// Allocates a dma_buf backed by a memfd through udmabuf.
+int AllocateUdmabuf(size_t size)
+{
+    int deviceFd = open("/dev/udmabuf", O_RDWR | O_CLOEXEC);
+    if (deviceFd < 0)
+    {
+        return -1;
+    }
+
+    int dmaBufFd = -1;
+    int memFd    = memfd_create("angle_dma_buf_import_perf", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memFd >= 0 && ftruncate(memFd, static_cast<off_t>(size)) == 0 &&
+        fcntl(memFd, F_ADD_SEALS, F_SEAL_SHRINK) == 0)
+    {
+        udmabuf_create create = {};
+        create.memfd          = static_cast<__u32>(memFd);
+        create.flags          = UDMABUF_FLAGS_CLOEXEC;
+        create.offset         = 0;
+        create.size           = size;
+        dmaBufFd              = ioctl(deviceFd, UDMABUF_CREATE, &create);
+    }
+
+    if (memFd >= 0)
+    {
+        close(memFd);
+    }
+    close(deviceFd);
+    return dmaBufFd;
+}
+
+// Allocates a dma_buf from the system dma-buf heap.
+int AllocateFromDmaHeap(size_t size)
+{
+    int heapFd = open("/dev/dma_heap/system", O_RDONLY | O_CLOEXEC);
+    if (heapFd < 0)
+    {
+        return -1;
+    }
+
+    dma_heap_allocation_data allocation = {};
+    allocation.len                      = size;
+    allocation.fd_flags                 = O_RDWR | O_CLOEXEC;
+
+    int dmaBufFd = -1;
+    if (ioctl(heapFd, DMA_HEAP_IOCTL_ALLOC, &allocation) == 0)
+    {
+        dmaBufFd = static_cast<int>(allocation.fd);
+    }
+
+    close(heapFd);
+    return dmaBufFd;
+}
+}  // anonymous namespace
+
+struct DmaBufImportParams final : public RenderTestParams
+{
+    DmaBufImportParams()
+    {
+        iterationsPerStep = kIterationsPerStep;
+
+        // Common default params
+        majorVersion = 2;
+        minorVersion = 0;
+        windowWidth  = 256;
+        windowHeight = 256;
+    }
+
+    std::string story() const override;
+
+    bool reuseImages = true;
+};
+
+std::ostream &operator<<(std::ostream &os, const DmaBufImportParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+std::string DmaBufImportParams::story() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::story();
+    if (!reuseImages)
+    {
+        strstr << "_no_image_reuse";
+    }
+
+    return strstr.str();
+}
+
+class DmaBufImportBenchmark : public ANGLERenderTest,
+                              public ::testing::WithParamInterface<DmaBufImportParams>
+{
+  public:
+    DmaBufImportBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    EGLImageKHR importBuffer(int dmaBufFd);
+
+    GLuint mProgram      = 0;
+    GLuint mTexture      = 0;
+    GLuint mVertexBuffer = 0;
+    std::vector<int> mDmaBufs;
+    size_t mFrame = 0;
+};
+
+DmaBufImportBenchmark::DmaBufImportBenchmark() : ANGLERenderTest("DmaBufImport", GetParam())
+{
+    addExtensionPrerequisite("GL_OES_EGL_image_external");
+}
+
+void DmaBufImportBenchmark::initializeBenchmark()
+{
+    EGLDisplay display = eglGetCurrentDisplay();
+    if (!IsEGLDisplayExtensionEnabled(display, "EGL_EXT_image_dma_buf_import"))
+    {
+        skipTest("EGL_EXT_image_dma_buf_import not supported");
+        return;
+    }
+
+    const size_t bufferBytes = kBufferSize * kBufferSize * 4;
+    for (size_t buffer = 0; buffer < kBufferCount; ++buffer)
+    {
+        int dmaBufFd = AllocateUdmabuf(bufferBytes);
+        if (dmaBufFd < 0)
+        {
+            dmaBufFd = AllocateFromDmaHeap(bufferBytes);
+        }
+        if (dmaBufFd < 0)
+        {
+            skipTest("Neither udmabuf nor the system dma-buf heap is available");
+            return;
+        }
+        mDmaBufs.push_back(dmaBufFd);
+    }
+
+    // Check that the driver can import the buffers at all.
+    EGLImageKHR image = importBuffer(mDmaBufs[0]);
+    if (image == EGL_NO_IMAGE_KHR)
+    {
+        skipTest("Importing the dma-buf stand-in failed");
+        return;
+    }
+    getGLWindow()->destroyImageKHR(image);
+
+    constexpr char kFS[] = R"(#extension GL_OES_EGL_image_external : require
+precision mediump float;
+uniform samplerExternalOES tex;
+varying vec2 v_texCoord;
+void main()
+{
+    gl_FragColor = texture2D(tex, v_texCoord);
+})";
+
+    mProgram = CompileProgram(essl1_shaders::vs::Texture2D(), kFS);
+    ASSERT_NE(0u, mProgram);
+    glUseProgram(mProgram);
+
+    // A single triangle covering the viewport.
+    const GLfloat kVertices[] = {-1.0f, -1.0f, 3.0f, -1.0f, -1.0f, 3.0f};
+    glGenBuffers(1, &mVertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(kVertices), kVertices, GL_STATIC_DRAW);
+
+    GLint positionLocation = glGetAttribLocation(mProgram, essl1_shaders::PositionAttrib());
+    glVertexAttribPointer(positionLocation, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glEnableVertexAttribArray(positionLocation);
+
+    glGenTextures(1, &mTexture);
+    glBindTexture(GL_TEXTURE_EXTERNAL_OES, mTexture);
+    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void DmaBufImportBenchmark::destroyBenchmark()
+{
+    glDeleteTextures(1, &mTexture);
+    glDeleteBuffers(1, &mVertexBuffer);
+    glDeleteProgram(mProgram);
+
+    for (int dmaBufFd : mDmaBufs)
+    {
+        close(dmaBufFd);
+    }
+    mDmaBufs.clear();
+}
+
+EGLImageKHR DmaBufImportBenchmark::importBuffer(int dmaBufFd)
+{
+    // Like a buffer received from another process, every import uses a new file descriptor.
+    int importFd = dup(dmaBufFd);
+
+    const EGLint attribs[] = {EGL_WIDTH,
+                              static_cast<EGLint>(kBufferSize),
+                              EGL_HEIGHT,
+                              static_cast<EGLint>(kBufferSize),
+                              EGL_LINUX_DRM_FOURCC_EXT,
+                              kDrmFormatABGR8888,
+                              EGL_DMA_BUF_PLANE0_FD_EXT,
+                              importFd,
+                              EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+                              0,
+                              EGL_DMA_BUF_PLANE0_PITCH_EXT,
+                              static_cast<EGLint>(kBufferSize * 4),
+                              EGL_NONE};
+
+    EGLImageKHR image = getGLWindow()->createImageKHR(nullptr, EGL_LINUX_DMA_BUF_EXT, nullptr,
+                                                      attribs);
+
+    // EGL does not take ownership of the file descriptor.
+    close(importFd);
+    return image;
+}
+
+void DmaBufImportBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        EGLImageKHR image = importBuffer(mDmaBufs[mFrame++ % kBufferCount]);
+        glEGLImageTargetTexture2DOES(GL_TEXTURE_EXTERNAL_OES, image);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        getGLWindow()->destroyImageKHR(image);
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+DmaBufImportParams DmaBufImportOpenGLParams(bool reuseImages)
+{
+    DmaBufImportParams params;
+    params.eglParameters = egl_platform::OPENGL_OR_GLES();
+    if (!reuseImages)
+    {
+        params.eglParameters.disable(Feature::ReuseDmaBufImages);
+    }
+    params.reuseImages = reuseImages;
+    return params;
+}
+
+DmaBufImportParams DmaBufImportVulkanParams()
+{
+    DmaBufImportParams params;
+    params.eglParameters = egl_platform::VULKAN();
+    return params;
+}
+
+// Measures the number of dma_buf imports and draws per second.
+TEST_P(DmaBufImportBenchmark, Run)
+{
+    run();
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(DmaBufImportBenchmark);
+ANGLE_INSTANTIATE_TEST(DmaBufImportBenchmark,
+                       DmaBufImportOpenGLParams(true),
+                       DmaBufImportOpenGLParams(false),
+                       DmaBufImportVulkanParams());
+
+}  // namespace angle
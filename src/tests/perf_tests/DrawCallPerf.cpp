@@ -4,7 +4,8 @@
 // found in the LICENSE file.
 //
 // DrawCallPerf:
-//   Performance tests for ANGLE draw call overhead.
+//   Performance tests for ANGLE draw call overhead.  Draws without state changes are also
+//   measured in contexts created with KHR_no_error, to compare with the cost of validation.
 //
 
 #include "ANGLEPerfTest.h"
@@ -27,6 +28,7 @@ enum class StateChange
     Scissor,
     ManyTextureDraw,
     Uniform,
+    NoChangeElements,
     InvalidEnum,
     EnumCount = InvalidEnum,
 };
@@ -42,6 +44,8 @@ struct DrawArraysPerfParams : public DrawCallPerfParams
     std::string story() const override;
 
     StateChange stateChange = StateChange::NoChange;
+    // Whether the context is created with KHR_no_error, so draws are not validated.
+    bool noError = false;
 };
 
 std::string DrawArraysPerfParams::story() const
@@ -79,10 +83,18 @@ std::string DrawArraysPerfParams::story() const
         case StateChange::Uniform:
             strstr << "_uniform";
             break;
+        case StateChange::NoChangeElements:
+            strstr << "_elements";
+            break;
         default:
             break;
     }
 
+    if (noError)
+    {
+        strstr << "_no_error";
+    }
+
     return strstr.str();
 }
 
@@ -132,7 +144,12 @@ class DrawCallPerfBenchmark : public ANGLERenderTest,
     void destroyBenchmark() override;
     void drawBenchmark() override;
 
+    void recordValidationKeyHitRate();
+
   private:
+    // Returns false if the validation key counters are not available.
+    bool getValidationKeyCounts(uint64_t *hitsOut, uint64_t *missesOut) const;
+
     GLuint mProgram1   = 0;
     GLuint mProgram2   = 0;
     GLuint mProgram3   = 0;
@@ -143,10 +160,40 @@ class DrawCallPerfBenchmark : public ANGLERenderTest,
     std::vector<GLuint> mTextures;
     int mNumTris = GetParam().numTris;
     std::vector<GLuint> mVBOPool;
-    size_t mCurrentVBO = 0;
+    size_t mCurrentVBO  = 0;
+    GLuint mIndexBuffer = 0;
+
+    bool mHasValidationKeyCounts = false;
+    uint64_t mStartHits          = 0;
+    uint64_t mStartMisses        = 0;
+    uint64_t mEndHits            = 0;
+    uint64_t mEndMisses          = 0;
 };
 
-DrawCallPerfBenchmark::DrawCallPerfBenchmark() : ANGLERenderTest("DrawCallPerf", GetParam()) {}
+DrawCallPerfBenchmark::DrawCallPerfBenchmark() : ANGLERenderTest("DrawCallPerf", GetParam())
+{
+    setNoErrorEnabled(GetParam().noError);
+}
+
+bool DrawCallPerfBenchmark::getValidationKeyCounts(uint64_t *hitsOut, uint64_t *missesOut) const
+{
+    if (!IsGLExtensionEnabled("GL_AMD_performance_monitor"))
+    {
+        return false;
+    }
+
+    CounterNameToValueMap counters = BuildCounterNameToValueMap();
+    auto hits                      = counters.find("drawValidationKeyHits");
+    auto misses                    = counters.find("drawValidationKeyMisses");
+    if (hits == counters.end() || misses == counters.end())
+    {
+        return false;
+    }
+
+    *hitsOut   = hits->second;
+    *missesOut = misses->second;
+    return true;
+}
 
 void DrawCallPerfBenchmark::initializeBenchmark()
 {
@@ -281,6 +328,22 @@ void main()
         mTextures.emplace_back(CreateSimpleTexture2D());
     }
 
+    if (params.stateChange == StateChange::NoChangeElements)
+    {
+        std::vector<GLushort> indices(3 * mNumTris);
+        // Unsigned short indices.
+        ASSERT_LE(indices.size(), 0x10000u);
+        for (size_t index = 0; index < indices.size(); ++index)
+        {
+            indices[index] = static_cast<GLushort>(index);
+        }
+
+        glGenBuffers(1, &mIndexBuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(indices[0]), indices.data(),
+                     GL_STATIC_DRAW);
+    }
+
     if (params.stateChange == StateChange::Program)
     {
         // Bind the textures as appropriate, they are not modified during the test.
@@ -321,10 +384,18 @@ void main()
     }
 
     ASSERT_GL_NO_ERROR();
+
+    mHasValidationKeyCounts = getValidationKeyCounts(&mStartHits, &mStartMisses);
 }
 
 void DrawCallPerfBenchmark::destroyBenchmark()
 {
+    if (mHasValidationKeyCounts)
+    {
+        getValidationKeyCounts(&mEndHits, &mEndMisses);
+    }
+
+    glDeleteBuffers(1, &mIndexBuffer);
     glDeleteProgram(mProgram1);
     glDeleteProgram(mProgram2);
     glDeleteProgram(mProgram3);
@@ -358,6 +429,24 @@ void JustDraw(unsigned int iterations, GLsizei numElements)
     }
 }
 
+void ClearThenDrawElements(unsigned int iterations, GLsizei numElements)
+{
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    for (unsigned int it = 0; it < iterations; it++)
+    {
+        glDrawElements(GL_TRIANGLES, numElements, GL_UNSIGNED_SHORT, nullptr);
+    }
+}
+
+void JustDrawElements(unsigned int iterations, GLsizei numElements)
+{
+    for (unsigned int it = 0; it < iterations; it++)
+    {
+        glDrawElements(GL_TRIANGLES, numElements, GL_UNSIGNED_SHORT, nullptr);
+    }
+}
+
 template <int kArrayBufferCount>
 void ChangeVertexAttribThenDraw(unsigned int iterations, GLsizei numElements, GLuint buffer)
 {
@@ -565,6 +654,9 @@ void DrawCallPerfBenchmark::drawBenchmark()
     const auto &eglParams = GetParam().eglParameters;
     const auto &params    = GetParam();
     GLsizei numElements   = static_cast<GLsizei>(3 * mNumTris);
+    bool clearBeforeDraws = eglParams.deviceType != EGL_PLATFORM_ANGLE_DEVICE_TYPE_NULL_ANGLE ||
+                            (eglParams.renderer != EGL_PLATFORM_ANGLE_TYPE_OPENGL_ANGLE &&
+                             eglParams.renderer != EGL_PLATFORM_ANGLE_TYPE_OPENGLES_ANGLE);
 
     switch (params.stateChange)
     {
@@ -587,9 +679,7 @@ void DrawCallPerfBenchmark::drawBenchmark()
             ChangeProgramThenDraw(params.iterationsPerStep, numElements, mProgram1, mProgram2);
             break;
         case StateChange::NoChange:
-            if (eglParams.deviceType != EGL_PLATFORM_ANGLE_DEVICE_TYPE_NULL_ANGLE ||
-                (eglParams.renderer != EGL_PLATFORM_ANGLE_TYPE_OPENGL_ANGLE &&
-                 eglParams.renderer != EGL_PLATFORM_ANGLE_TYPE_OPENGLES_ANGLE))
+            if (clearBeforeDraws)
             {
                 ClearThenDraw(params.iterationsPerStep, numElements);
             }
@@ -613,6 +703,16 @@ void DrawCallPerfBenchmark::drawBenchmark()
         case StateChange::Uniform:
             UpdateUniformThenDraw(params.iterationsPerStep, numElements);
             break;
+        case StateChange::NoChangeElements:
+            if (clearBeforeDraws)
+            {
+                ClearThenDrawElements(params.iterationsPerStep, numElements);
+            }
+            else
+            {
+                JustDrawElements(params.iterationsPerStep, numElements);
+            }
+            break;
         case StateChange::InvalidEnum:
             ADD_FAILURE() << "Invalid state change.";
             break;
@@ -621,9 +721,23 @@ void DrawCallPerfBenchmark::drawBenchmark()
     ASSERT_GL_NO_ERROR();
 }
 
+void DrawCallPerfBenchmark::recordValidationKeyHitRate()
+{
+    const uint64_t hits   = mEndHits - mStartHits;
+    const uint64_t misses = mEndMisses - mStartMisses;
+    if (!mHasValidationKeyCounts || hits + misses == 0)
+    {
+        return;
+    }
+
+    recordDoubleMetric(".validation_key_hit_rate",
+                       static_cast<double>(hits) / static_cast<double>(hits + misses), "ratio");
+}
+
 TEST_P(DrawCallPerfBenchmark, Run)
 {
     run();
+    recordValidationKeyHitRate();
 }
 
 using namespace params;
@@ -644,8 +758,24 @@ DrawArraysPerfParams CombineStateChange(const DrawArraysPerfParams &in, StateCha
 
 using P = DrawArraysPerfParams;
 
-std::vector<P> gTestsWithStateChange =
-    CombineWithValues({P()}, angle::AllEnums<StateChange>(), CombineStateChange);
+std::vector<P> AddNoErrorVariants(const std::vector<P> &in)
+{
+    std::vector<P> out = in;
+    for (const P &params : in)
+    {
+        if (params.stateChange == StateChange::NoChange ||
+            params.stateChange == StateChange::NoChangeElements)
+        {
+            P noErrorParams       = params;
+            noErrorParams.noError = true;
+            out.push_back(noErrorParams);
+        }
+    }
+    return out;
+}
+
+std::vector<P> gTestsWithStateChange = AddNoErrorVariants(
+    CombineWithValues({P()}, angle::AllEnums<StateChange>(), CombineStateChange));
 std::vector<P> gTestsWithRenderer =
     CombineWithFuncs(gTestsWithStateChange, {D3D11<P>, GL<P>, Metal<P>, Vulkan<P>, WGL<P>});
 std::vector<P> gTestsWithDevice =
@@ -46,6 +46,11 @@ struct DrawElementsPerfParams final : public DrawCallPerfParams
             strstr << "_index_buffer_changed";
         }
 
+        if (indexBufferPartiallyChanged)
+        {
+            strstr << "_index_buffer_partially_changed";
+        }
+
         if (type == GL_UNSIGNED_SHORT)
         {
             strstr << "_ushort";
@@ -56,6 +61,8 @@ struct DrawElementsPerfParams final : public DrawCallPerfParams
 
     GLenum type             = GL_UNSIGNED_INT;
     bool indexBufferChanged = false;
+    // Whether a single triangle of a large index buffer is changed before each draw.
+    bool indexBufferPartiallyChanged = false;
 };
 
 std::ostream &operator<<(std::ostream &os, const DrawElementsPerfParams &params)
@@ -75,13 +82,14 @@ class DrawElementsPerfBenchmark : public ANGLERenderTest,
     void drawBenchmark() override;
 
   private:
-    GLuint mProgram     = 0;
-    GLuint mBuffer      = 0;
-    GLuint mIndexBuffer = 0;
-    GLuint mFBO         = 0;
-    GLuint mTexture     = 0;
-    GLsizei mBufferSize = 0;
-    int mCount          = 3 * GetParam().numTris;
+    GLuint mProgram      = 0;
+    GLuint mBuffer       = 0;
+    GLuint mIndexBuffer  = 0;
+    GLuint mFBO          = 0;
+    GLuint mTexture      = 0;
+    GLsizei mBufferSize  = 0;
+    int mCount           = 3 * GetParam().numTris;
+    int mChangedTriangle = 0;
     std::vector<GLuint> mIntIndexData;
     std::vector<GLushort> mShortIndexData;
 };
@@ -191,6 +199,22 @@ void DrawElementsPerfBenchmark::drawBenchmark()
             glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mCount), params.type, 0);
         }
     }
+    else if (params.indexBufferPartiallyChanged)
+    {
+        // Only the index range of the changed part of the buffer needs to be scanned again.
+        const GLsizei triangleSize = 3 * ElementTypeSize(params.type);
+        const uint8_t *bufferData  = (params.type == GL_UNSIGNED_INT)
+                                         ? reinterpret_cast<uint8_t *>(mIntIndexData.data())
+                                         : reinterpret_cast<uint8_t *>(mShortIndexData.data());
+        for (unsigned int it = 0; it < params.iterationsPerStep; it++)
+        {
+            const GLintptr offset = mChangedTriangle * triangleSize;
+            mChangedTriangle      = (mChangedTriangle + 7919) % params.numTris;
+
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, triangleSize, bufferData + offset);
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mCount), params.type, 0);
+        }
+    }
     else
     {
         for (unsigned int it = 0; it < params.iterationsPerStep; it++)
@@ -230,14 +254,43 @@ P CombineIndexBufferChanged(const P &in, bool indexBufferChanged)
     return out;
 }
 
+P CombineIndexBufferPartiallyChanged(const P &in, bool indexBufferPartiallyChanged)
+{
+    P out                           = in;
+    out.indexBufferPartiallyChanged = indexBufferPartiallyChanged;
+
+    // Use a buffer large enough for rescanning it to dominate the draw, that can still be indexed
+    // with unsigned shorts.
+    if (indexBufferPartiallyChanged)
+    {
+        out.numTris = 20000;
+        out.iterationsPerStep /= 100;
+    }
+
+    return out;
+}
+
 std::vector<GLenum> gIndexTypes = {GL_UNSIGNED_INT, GL_UNSIGNED_SHORT};
 std::vector<P> gWithIndexType   = CombineWithValues({P()}, gIndexTypes, CombineIndexType);
 std::vector<P> gWithRenderer =
     CombineWithFuncs(gWithIndexType, {D3D11<P>, GL<P>, Metal<P>, Vulkan<P>, WGL<P>});
 std::vector<P> gWithChange =
     CombineWithValues(gWithRenderer, {false, true}, CombineIndexBufferChanged);
+std::vector<P> gWithPartialChange =
+    CombineWithValues(gWithRenderer, {true}, CombineIndexBufferPartiallyChanged);
 std::vector<P> gWithDevice = CombineWithFuncs(gWithChange, {Passthrough<P>, NullDevice<P>});
+std::vector<P> gWithPartialChangeDevice =
+    CombineWithFuncs(gWithPartialChange, {Passthrough<P>, NullDevice<P>});
+
+std::vector<P> CombineAll()
+{
+    std::vector<P> out = gWithDevice;
+    out.insert(out.end(), gWithPartialChangeDevice.begin(), gWithPartialChangeDevice.end());
+    return out;
+}
+
+std::vector<P> gAll = CombineAll();
 
-ANGLE_INSTANTIATE_TEST_ARRAY(DrawElementsPerfBenchmark, gWithDevice);
+ANGLE_INSTANTIATE_TEST_ARRAY(DrawElementsPerfBenchmark, gAll);
 
 }  // anonymous namespace
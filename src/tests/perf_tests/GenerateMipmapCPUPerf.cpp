@@ -0,0 +1,159 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// GenerateMipmapCPUPerf: Performance test for the CPU mipmap generation used by back-ends when the
+// driver cannot generate mipmaps of a format. Each step generates the full mip chain of an image,
+// without any GL calls, either on the calling thread or split across a thread pool.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include "common/WorkerThread.h"
+#include "image_util/generatemip.h"
+#include "image_util/loadimage.h"
+
+using namespace testing;
+
+namespace
+{
+using angle::GenerateMipFunction;
+using angle::WorkerThreadPool;
+
+struct GenerateMipmapCPUParams
+{
+    GenerateMipmapCPUParams(const char *formatName,
+                            GenerateMipFunction generateMip,
+                            size_t pixelBytes,
+                            size_t size,
+                            bool multiThreaded)
+        : formatName(formatName),
+          generateMip(generateMip),
+          pixelBytes(pixelBytes),
+          size(size),
+          multiThreaded(multiThreaded)
+    {}
+
+    const char *formatName;
+    GenerateMipFunction generateMip;
+    size_t pixelBytes;
+    size_t size;
+    bool multiThreaded;
+};
+
+std::ostream &operator<<(std::ostream &os, const GenerateMipmapCPUParams &params)
+{
+    os << params.formatName << "_" << params.size << "x" << params.size
+       << (params.multiThreaded ? "_multi_thread" : "_single_thread");
+    return os;
+}
+
+class GenerateMipmapCPUPerfTest : public ANGLEPerfTest,
+                                  public WithParamInterface<GenerateMipmapCPUParams>
+{
+  public:
+    GenerateMipmapCPUPerfTest();
+
+    void step() override;
+
+    std::string getName();
+
+  private:
+    angle::ImageLoadContext mContext;
+    std::vector<std::vector<uint8_t>> mLevels;
+};
+
+GenerateMipmapCPUPerfTest::GenerateMipmapCPUPerfTest()
+    : ANGLEPerfTest(getName(), "", "_run", 1, "us")
+{
+    const GenerateMipmapCPUParams &params = GetParam();
+
+    mContext.singleThreadPool = WorkerThreadPool::Create(1, ANGLEPlatformCurrent());
+    if (params.multiThreaded)
+    {
+        mContext.multiThreadPool = WorkerThreadPool::Create(0, ANGLEPlatformCurrent());
+    }
+
+    for (size_t levelSize = params.size; levelSize > 0; levelSize >>= 1)
+    {
+        mLevels.emplace_back(levelSize * levelSize * params.pixelBytes);
+    }
+
+    // Fill the base level with a gradient so that the data is not trivially uniform.
+    std::vector<uint8_t> &baseLevel = mLevels[0];
+    for (size_t index = 0; index < baseLevel.size(); ++index)
+    {
+        baseLevel[index] = static_cast<uint8_t>(index * 7 + index / 4096);
+    }
+}
+
+void GenerateMipmapCPUPerfTest::step()
+{
+    const GenerateMipmapCPUParams &params = GetParam();
+
+    size_t sourceSize = params.size;
+    for (size_t level = 1; level < mLevels.size(); ++level)
+    {
+        const size_t sourceRowPitch = sourceSize * params.pixelBytes;
+        const size_t destSize       = sourceSize >> 1;
+        const size_t destRowPitch   = destSize * params.pixelBytes;
+
+        angle::GenerateMipWithContext(mContext, params.generateMip, sourceSize, sourceSize, 1,
+                                      mLevels[level - 1].data(), sourceRowPitch,
+                                      sourceRowPitch * sourceSize, mLevels[level].data(),
+                                      destRowPitch, destRowPitch * destSize);
+        sourceSize = destSize;
+    }
+}
+
+std::string GenerateMipmapCPUPerfTest::getName()
+{
+    std::stringstream ss;
+    ss << UnitTest::GetInstance()->current_test_case()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+// Measures the time to generate a full mip chain on the CPU.
+TEST_P(GenerateMipmapCPUPerfTest, Run)
+{
+    run();
+}
+
+GenerateMipmapCPUParams RGBA8Params(size_t size, bool multiThreaded)
+{
+    return GenerateMipmapCPUParams("rgba8", angle::GenerateMip<angle::R8G8B8A8>, 4, size,
+                                   multiThreaded);
+}
+
+GenerateMipmapCPUParams R8Params(size_t size, bool multiThreaded)
+{
+    return GenerateMipmapCPUParams("r8", angle::GenerateMip<angle::R8>, 1, size, multiThreaded);
+}
+
+GenerateMipmapCPUParams RGB8Params(size_t size, bool multiThreaded)
+{
+    return GenerateMipmapCPUParams("rgb8", angle::GenerateMip<angle::R8G8B8>, 3, size,
+                                   multiThreaded);
+}
+
+GenerateMipmapCPUParams RGBA16FParams(size_t size, bool multiThreaded)
+{
+    return GenerateMipmapCPUParams("rgba16f", angle::GenerateMip<angle::R16G16B16A16F>, 8, size,
+                                   multiThreaded);
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         GenerateMipmapCPUPerfTest,
+                         Values(RGBA8Params(1024, false),
+                                RGBA8Params(4096, false),
+                                RGBA8Params(4096, true),
+                                R8Params(4096, false),
+                                R8Params(4096, true),
+                                RGB8Params(4096, false),
+                                RGB8Params(4096, true),
+                                RGBA16FParams(2048, false),
+                                RGBA16FParams(2048, true)),
+                         PrintToStringParamName());
+
+}  // anonymous namespace
@@ -4,10 +4,12 @@
 // found in the LICENSE file.
 //
 // IndexConversionPerf:
-//   Performance tests for ANGLE index conversion in D3D11.
+//   Performance tests for ANGLE index conversion in D3D11, and for the index conversion kernels
+//   shared by the back-ends, compared with converting one index at a time.
 //
 
 #include "ANGLEPerfTest.h"
+#include "common/utilities.h"
 #include "tests/test_utils/draw_call_perf_utils.h"
 
 #include <sstream>
@@ -222,4 +224,274 @@ ANGLE_INSTANTIATE_TEST(IndexConversionPerfTest,
 
 // This test suite is not instantiated on some OSes.
 GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(IndexConversionPerfTest);
+
+constexpr size_t kKernelIndexCount = 256 * 1024;
+
+enum class IndexKernel
+{
+    ComputeRange,
+    CopyAndComputeRange,
+    WidenUnsignedByte,
+    RewriteRestartIndex,
+    FindRestartIndex,
+    LineLoopWithRestart,
+};
+
+struct IndexKernelParams
+{
+    IndexKernelParams(IndexKernel kernel, bool scalar) : kernel(kernel), scalar(scalar) {}
+
+    IndexKernel kernel;
+    // Whether to run the one index at a time reference instead of the shared kernel.
+    bool scalar;
+};
+
+std::ostream &operator<<(std::ostream &os, const IndexKernelParams &params)
+{
+    switch (params.kernel)
+    {
+        case IndexKernel::ComputeRange:
+            os << "compute_range";
+            break;
+        case IndexKernel::CopyAndComputeRange:
+            os << "copy_and_compute_range";
+            break;
+        case IndexKernel::WidenUnsignedByte:
+            os << "widen_ubyte";
+            break;
+        case IndexKernel::RewriteRestartIndex:
+            os << "rewrite_restart_index";
+            break;
+        case IndexKernel::FindRestartIndex:
+            os << "find_restart_index";
+            break;
+        case IndexKernel::LineLoopWithRestart:
+            os << "line_loop_with_restart";
+            break;
+    }
+    os << (params.scalar ? "_scalar" : "_vector");
+    return os;
+}
+
+template <typename In, typename Out>
+void ConvertIndicesScalar(const In *input, size_t count, bool rewriteRestartIndex, Out *output)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        output[i] = rewriteRestartIndex && input[i] == std::numeric_limits<In>::max()
+                        ? std::numeric_limits<Out>::max()
+                        : static_cast<Out>(input[i]);
+    }
+}
+
+gl::IndexRange CopyIndicesAndComputeRangeScalar(const GLushort *input,
+                                                size_t count,
+                                                GLushort *output)
+{
+    GLushort minIndex  = std::numeric_limits<GLushort>::max();
+    GLushort maxIndex  = 0;
+    size_t vertexCount = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (output != nullptr)
+        {
+            output[i] = input[i];
+        }
+        if (input[i] == std::numeric_limits<GLushort>::max())
+        {
+            continue;
+        }
+        minIndex = std::min(minIndex, input[i]);
+        maxIndex = std::max(maxIndex, input[i]);
+        vertexCount++;
+    }
+    return gl::IndexRange(minIndex, maxIndex, vertexCount);
+}
+
+size_t CopyLineLoopIndicesWithRestartScalar(const GLushort *input, size_t count, GLushort *output)
+{
+    constexpr GLushort kRestartIndex = std::numeric_limits<GLushort>::max();
+    GLushort *outputStart            = output;
+    size_t loopStart                 = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (input[i] != kRestartIndex)
+        {
+            *(output++) = input[i];
+        }
+        else
+        {
+            if (i > loopStart)
+            {
+                *(output++) = input[loopStart];
+                *(output++) = kRestartIndex;
+            }
+            loopStart = i + 1;
+        }
+    }
+    if (count > loopStart)
+    {
+        *(output++) = input[loopStart];
+    }
+    return output - outputStart;
+}
+
+class IndexKernelPerfTest : public ANGLEPerfTest,
+                            public ::testing::WithParamInterface<IndexKernelParams>
+{
+  public:
+    IndexKernelPerfTest();
+
+    void step() override;
+
+    std::string getName();
+
+  private:
+    std::vector<GLubyte> mUnsignedByteIndices;
+    std::vector<GLushort> mUnsignedShortIndices;
+    std::vector<GLuint> mOutput;
+    size_t mResult = 0;
+};
+
+IndexKernelPerfTest::IndexKernelPerfTest()
+    : ANGLEPerfTest(getName(), "", "_run", 1, "us"),
+      mUnsignedByteIndices(kKernelIndexCount),
+      mUnsignedShortIndices(kKernelIndexCount),
+      mOutput(kKernelIndexCount * 2)
+{
+    // Strips of 62 indices separated by primitive restart indices, except for FindRestartIndex,
+    // which scans indices that have none, as when checking whether a buffer needs conversion.
+    const bool withRestart = GetParam().kernel != IndexKernel::FindRestartIndex;
+    for (size_t i = 0; i < kKernelIndexCount; i++)
+    {
+        const bool isRestart     = withRestart && i % 63 == 62;
+        mUnsignedByteIndices[i]  = isRestart ? 0xFF : static_cast<GLubyte>(i % 251);
+        mUnsignedShortIndices[i] = isRestart ? 0xFFFF : static_cast<GLushort>((i * 7) % 65521);
+    }
+}
+
+void IndexKernelPerfTest::step()
+{
+    const IndexKernelParams &params = GetParam();
+    const GLushort *indices         = mUnsignedShortIndices.data();
+    GLushort *output16              = reinterpret_cast<GLushort *>(mOutput.data());
+
+    switch (params.kernel)
+    {
+        case IndexKernel::ComputeRange:
+            if (params.scalar)
+            {
+                mResult +=
+                    CopyIndicesAndComputeRangeScalar(indices, kKernelIndexCount, nullptr).end;
+            }
+            else
+            {
+                mResult += gl::ComputeIndexRange(gl::DrawElementsType::UnsignedShort, indices,
+                                                 kKernelIndexCount, true)
+                               .end;
+            }
+            break;
+        case IndexKernel::CopyAndComputeRange:
+            if (params.scalar)
+            {
+                mResult +=
+                    CopyIndicesAndComputeRangeScalar(indices, kKernelIndexCount, output16).end;
+            }
+            else
+            {
+                mResult += gl::CopyIndicesAndComputeRange(gl::DrawElementsType::UnsignedShort,
+                                                          indices, kKernelIndexCount, true,
+                                                          output16)
+                               .end;
+            }
+            break;
+        case IndexKernel::WidenUnsignedByte:
+            if (params.scalar)
+            {
+                ConvertIndicesScalar(mUnsignedByteIndices.data(), kKernelIndexCount, true,
+                                     output16);
+            }
+            else
+            {
+                gl::ConvertIndices(gl::DrawElementsType::UnsignedByte,
+                                   gl::DrawElementsType::UnsignedShort,
+                                   mUnsignedByteIndices.data(), kKernelIndexCount, output16, true);
+            }
+            break;
+        case IndexKernel::RewriteRestartIndex:
+            if (params.scalar)
+            {
+                ConvertIndicesScalar(indices, kKernelIndexCount, true, mOutput.data());
+            }
+            else
+            {
+                gl::ConvertIndices(gl::DrawElementsType::UnsignedShort,
+                                   gl::DrawElementsType::UnsignedInt, indices, kKernelIndexCount,
+                                   mOutput.data(), true);
+            }
+            break;
+        case IndexKernel::FindRestartIndex:
+            if (params.scalar)
+            {
+                mResult += std::find(indices, indices + kKernelIndexCount, 0xFFFF) - indices;
+            }
+            else
+            {
+                mResult += gl::FindPrimitiveRestartIndex(gl::DrawElementsType::UnsignedShort,
+                                                         indices, kKernelIndexCount);
+            }
+            break;
+        case IndexKernel::LineLoopWithRestart:
+            if (params.scalar)
+            {
+                mResult += CopyLineLoopIndicesWithRestartScalar(indices, kKernelIndexCount,
+                                                                output16);
+            }
+            else
+            {
+                mResult += gl::GetLineLoopWithRestartIndexCount(
+                    gl::DrawElementsType::UnsignedShort, indices, kKernelIndexCount);
+                gl::CopyLineLoopIndicesWithRestart(gl::DrawElementsType::UnsignedShort,
+                                                   gl::DrawElementsType::UnsignedShort, indices,
+                                                   kKernelIndexCount, output16);
+            }
+            break;
+    }
+}
+
+std::string IndexKernelPerfTest::getName()
+{
+    std::stringstream ss;
+    ss << ::testing::UnitTest::GetInstance()->current_test_case()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+// Measures the time for each index conversion kernel to process 256K indices.
+TEST_P(IndexKernelPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         IndexKernelPerfTest,
+                         ::testing::Values(IndexKernelParams(IndexKernel::ComputeRange, false),
+                                           IndexKernelParams(IndexKernel::ComputeRange, true),
+                                           IndexKernelParams(IndexKernel::CopyAndComputeRange,
+                                                             false),
+                                           IndexKernelParams(IndexKernel::CopyAndComputeRange,
+                                                             true),
+                                           IndexKernelParams(IndexKernel::WidenUnsignedByte,
+                                                             false),
+                                           IndexKernelParams(IndexKernel::WidenUnsignedByte, true),
+                                           IndexKernelParams(IndexKernel::RewriteRestartIndex,
+                                                             false),
+                                           IndexKernelParams(IndexKernel::RewriteRestartIndex,
+                                                             true),
+                                           IndexKernelParams(IndexKernel::FindRestartIndex, false),
+                                           IndexKernelParams(IndexKernel::FindRestartIndex, true),
+                                           IndexKernelParams(IndexKernel::LineLoopWithRestart,
+                                                             false),
+                                           IndexKernelParams(IndexKernel::LineLoopWithRestart,
+                                                             true)),
+                         ::testing::PrintToStringParamName());
 }  // namespace
@@ -4,13 +4,15 @@
 // found in the LICENSE file.
 //
 // LinkProgramPerfTest:
-//   Performance tests compiling a lot of shaders.
+//   Performance tests compiling a lot of shaders.  The link call only variant measures the time
+//   glLinkProgram takes on the calling thread, with the shaders compiled beforehand.
 //
 
 #include "ANGLEPerfTest.h"
 
 #include <array>
 
+#include "common/system_utils.h"
 #include "common/vector_utils.h"
 #include "util/shader_utils.h"
 
@@ -18,11 +20,22 @@ using namespace angle;
 
 namespace
 {
+constexpr char kVertexShader[] =
+    "attribute vec2 position;\n"
+    "void main() {\n"
+    "    gl_Position = vec4(position, 0, 1);\n"
+    "}";
+constexpr char kFragmentShader[] =
+    "precision mediump float;\n"
+    "void main() {\n"
+    "    gl_FragColor = vec4(1, 0, 0, 1);\n"
+    "}";
 
 enum class TaskOption
 {
     CompileOnly,
     CompileAndLink,
+    LinkCallOnly,
 
     Unspecified
 };
@@ -62,6 +75,10 @@ struct LinkProgramParams final : public RenderTestParams
         {
             strstr << "_compile_and_link";
         }
+        else if (taskOption == TaskOption::LinkCallOnly)
+        {
+            strstr << "_link_call_only";
+        }
 
         if (threadOption == ThreadOption::SingleThread)
         {
@@ -100,8 +117,20 @@ class LinkProgramBenchmark : public ANGLERenderTest,
     void destroyBenchmark() override;
     void drawBenchmark() override;
 
+    void recordLinkCallTime();
+
   protected:
+    void linkCallOnly();
+
     GLuint mVertexBuffer = 0;
+
+    // Shaders compiled once for the link call only variant.
+    GLuint mVertexShader   = 0;
+    GLuint mFragmentShader = 0;
+
+    // Time spent in glLinkProgram on the calling thread.
+    double mLinkCallTime    = 0.0;
+    uint32_t mLinkCallCount = 0;
 };
 
 LinkProgramBenchmark::LinkProgramBenchmark() : ANGLERenderTest("LinkProgram", GetParam()) {}
@@ -129,27 +158,33 @@ void LinkProgramBenchmark::initializeBenchmark()
     glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vector3), vertices.data(),
                  GL_STATIC_DRAW);
+
+    if (GetParam().taskOption == TaskOption::LinkCallOnly)
+    {
+        mVertexShader   = CompileShader(GL_VERTEX_SHADER, kVertexShader);
+        mFragmentShader = CompileShader(GL_FRAGMENT_SHADER, kFragmentShader);
+        ASSERT_NE(0u, mVertexShader);
+        ASSERT_NE(0u, mFragmentShader);
+    }
 }
 
 void LinkProgramBenchmark::destroyBenchmark()
 {
     glDeleteBuffers(1, &mVertexBuffer);
+    glDeleteShader(mVertexShader);
+    glDeleteShader(mFragmentShader);
 }
 
 void LinkProgramBenchmark::drawBenchmark()
 {
-    static const char *vertexShader =
-        "attribute vec2 position;\n"
-        "void main() {\n"
-        "    gl_Position = vec4(position, 0, 1);\n"
-        "}";
-    static const char *fragmentShader =
-        "precision mediump float;\n"
-        "void main() {\n"
-        "    gl_FragColor = vec4(1, 0, 0, 1);\n"
-        "}";
-    GLuint vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+    if (GetParam().taskOption == TaskOption::LinkCallOnly)
+    {
+        linkCallOnly();
+        return;
+    }
+
+    GLuint vs = CompileShader(GL_VERTEX_SHADER, kVertexShader);
+    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, kFragmentShader);
 
     ASSERT_NE(0u, vs);
     ASSERT_NE(0u, fs);
@@ -180,6 +215,37 @@ void LinkProgramBenchmark::drawBenchmark()
     glDeleteProgram(program);
 }
 
+void LinkProgramBenchmark::linkCallOnly()
+{
+    GLuint program = glCreateProgram();
+    ASSERT_NE(0u, program);
+
+    glAttachShader(program, mVertexShader);
+    glAttachShader(program, mFragmentShader);
+
+    double startTime = GetCurrentSystemTime();
+    glLinkProgram(program);
+    mLinkCallTime += GetCurrentSystemTime() - startTime;
+    mLinkCallCount++;
+
+    // Wait for the link to finish, so links don't pile up in the worker threads.
+    GLint linkStatus = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+    ASSERT_EQ(GL_TRUE, linkStatus);
+
+    glDeleteProgram(program);
+}
+
+void LinkProgramBenchmark::recordLinkCallTime()
+{
+    if (mSkipTest || mLinkCallCount == 0)
+    {
+        return;
+    }
+
+    recordDoubleMetric(".link_call_time", mLinkCallTime * 1e6 / mLinkCallCount, "microseconds");
+}
+
 using namespace egl_platform;
 
 LinkProgramParams LinkProgramD3D11Params(TaskOption taskOption, ThreadOption threadOption)
@@ -213,6 +279,7 @@ LinkProgramParams LinkProgramVulkanParams(TaskOption taskOption, ThreadOption th
 TEST_P(LinkProgramBenchmark, Run)
 {
     run();
+    recordLinkCallTime();
 }
 
 ANGLE_INSTANTIATE_TEST(
@@ -232,6 +299,10 @@ ANGLE_INSTANTIATE_TEST(
     LinkProgramD3D11Params(TaskOption::CompileAndLink, ThreadOption::SingleThread),
     LinkProgramMetalParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
     LinkProgramOpenGLOrGLESParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
-    LinkProgramVulkanParams(TaskOption::CompileAndLink, ThreadOption::SingleThread));
+    LinkProgramVulkanParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
+    LinkProgramOpenGLOrGLESParams(TaskOption::LinkCallOnly, ThreadOption::MultiThread),
+    LinkProgramVulkanParams(TaskOption::LinkCallOnly, ThreadOption::MultiThread),
+    LinkProgramOpenGLOrGLESParams(TaskOption::LinkCallOnly, ThreadOption::SingleThread),
+    LinkProgramVulkanParams(TaskOption::LinkCallOnly, ThreadOption::SingleThread));
 
 }  // anonymous namespace
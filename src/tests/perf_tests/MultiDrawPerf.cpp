@@ -0,0 +1,236 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MultiDrawPerf:
+//   Performance test for GL_ANGLE_multi_draw calls made of many small sub-draws, like WebGL
+//   scenes using WEBGL_multi_draw.  Compares forwarding the calls to the native multi-draw
+//   functions with making one draw per sub-draw, with and without gl_DrawID in the shader.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "util/shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+// Number of sub-draws per multi-draw call, each drawing one triangle.
+constexpr GLsizei kSubDrawCount = 1024;
+
+enum class MultiDrawType
+{
+    Arrays,
+    Elements,
+};
+
+struct MultiDrawParams final : public RenderTestParams
+{
+    MultiDrawParams()
+    {
+        iterationsPerStep = 16;
+
+        majorVersion = 2;
+        minorVersion = 0;
+        windowWidth  = 256;
+        windowHeight = 256;
+    }
+
+    std::string story() const override
+    {
+        std::stringstream strstr;
+        strstr << RenderTestParams::story();
+        strstr << (drawType == MultiDrawType::Arrays ? "_arrays" : "_elements");
+        if (usesDrawID)
+        {
+            strstr << "_draw_id";
+        }
+        if (!nativeMultiDraw)
+        {
+            strstr << "_draw_loop";
+        }
+        return strstr.str();
+    }
+
+    MultiDrawType drawType = MultiDrawType::Arrays;
+    // Whether the shader reads gl_DrawID.
+    bool usesDrawID = false;
+    // Whether the backend may forward the call to the native multi-draw functions.
+    bool nativeMultiDraw = true;
+};
+
+std::ostream &operator<<(std::ostream &os, const MultiDrawParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+class MultiDrawBenchmark : public ANGLERenderTest,
+                           public ::testing::WithParamInterface<MultiDrawParams>
+{
+  public:
+    MultiDrawBenchmark() : ANGLERenderTest("MultiDraw", GetParam())
+    {
+        addExtensionPrerequisite("GL_ANGLE_multi_draw");
+    }
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    GLuint mProgram      = 0;
+    GLuint mVertexBuffer = 0;
+    GLuint mIndexBuffer  = 0;
+
+    std::vector<GLint> mFirsts;
+    std::vector<GLsizei> mCounts;
+    std::vector<const GLvoid *> mIndexOffsets;
+};
+
+void MultiDrawBenchmark::initializeBenchmark()
+{
+    const MultiDrawParams &params = GetParam();
+
+    constexpr char kVS[] = R"(attribute vec2 aPosition;
+varying vec4 vColor;
+void main()
+{
+    vColor = vec4(0.2, 0.4, 0.6, 1.0);
+    gl_Position = vec4(aPosition, 0, 1);
+})";
+
+    constexpr char kDrawIDVS[] = R"(#extension GL_ANGLE_multi_draw : require
+attribute vec2 aPosition;
+varying vec4 vColor;
+void main()
+{
+    vColor = vec4(float(gl_DrawID) / 1024.0, 0.4, 0.6, 1.0);
+    gl_Position = vec4(aPosition, 0, 1);
+})";
+
+    constexpr char kFS[] = R"(precision mediump float;
+varying vec4 vColor;
+void main()
+{
+    gl_FragColor = vColor;
+})";
+
+    mProgram = CompileProgram(params.usesDrawID ? kDrawIDVS : kVS, kFS);
+    ASSERT_NE(0u, mProgram);
+    glUseProgram(mProgram);
+
+    // One small triangle per sub-draw, laid out in a grid.
+    constexpr GLsizei kGridSize = 32;
+    constexpr float kCellSize   = 2.0f / kGridSize;
+    std::vector<GLfloat> vertices;
+    std::vector<GLushort> indices;
+    for (GLsizei drawID = 0; drawID < kSubDrawCount; ++drawID)
+    {
+        float x = -1.0f + (drawID % kGridSize) * kCellSize;
+        float y = -1.0f + (drawID / kGridSize) * kCellSize;
+        vertices.insert(vertices.end(), {x, y, x + kCellSize, y, x, y + kCellSize});
+
+        GLushort firstIndex = static_cast<GLushort>(drawID * 3);
+        indices.insert(indices.end(), {firstIndex, static_cast<GLushort>(firstIndex + 1),
+                                       static_cast<GLushort>(firstIndex + 2)});
+
+        mFirsts.push_back(drawID * 3);
+        mCounts.push_back(3);
+        mIndexOffsets.push_back(reinterpret_cast<const GLvoid *>(drawID * 3 * sizeof(GLushort)));
+    }
+
+    glGenBuffers(1, &mVertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(),
+                 GL_STATIC_DRAW);
+
+    GLint positionLocation = glGetAttribLocation(mProgram, "aPosition");
+    glVertexAttribPointer(positionLocation, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glEnableVertexAttribArray(positionLocation);
+
+    glGenBuffers(1, &mIndexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(),
+                 GL_STATIC_DRAW);
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void MultiDrawBenchmark::destroyBenchmark()
+{
+    glDeleteProgram(mProgram);
+    glDeleteBuffers(1, &mVertexBuffer);
+    glDeleteBuffers(1, &mIndexBuffer);
+}
+
+void MultiDrawBenchmark::drawBenchmark()
+{
+    const MultiDrawParams &params = GetParam();
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        if (params.drawType == MultiDrawType::Arrays)
+        {
+            glMultiDrawArraysANGLE(GL_TRIANGLES, mFirsts.data(), mCounts.data(), kSubDrawCount);
+        }
+        else
+        {
+            glMultiDrawElementsANGLE(GL_TRIANGLES, mCounts.data(), GL_UNSIGNED_SHORT,
+                                     mIndexOffsets.data(), kSubDrawCount);
+        }
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+MultiDrawParams MultiDrawOpenGLOrGLESParams(MultiDrawType drawType,
+                                            bool usesDrawID,
+                                            bool nativeMultiDraw)
+{
+    MultiDrawParams params;
+    params.eglParameters = egl_platform::OPENGL_OR_GLES();
+    if (!nativeMultiDraw)
+    {
+        params.eglParameters.disable(Feature::UseNativeMultiDraw);
+    }
+    params.drawType        = drawType;
+    params.usesDrawID      = usesDrawID;
+    params.nativeMultiDraw = nativeMultiDraw;
+    return params;
+}
+
+MultiDrawParams MultiDrawVulkanParams(MultiDrawType drawType, bool usesDrawID)
+{
+    MultiDrawParams params;
+    params.eglParameters = egl_platform::VULKAN();
+    params.drawType      = drawType;
+    params.usesDrawID    = usesDrawID;
+    return params;
+}
+
+// Measures the time to make multi-draw calls of many one-triangle sub-draws.
+TEST_P(MultiDrawBenchmark, Run)
+{
+    run();
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(MultiDrawBenchmark);
+ANGLE_INSTANTIATE_TEST(MultiDrawBenchmark,
+                       MultiDrawOpenGLOrGLESParams(MultiDrawType::Arrays, false, true),
+                       MultiDrawOpenGLOrGLESParams(MultiDrawType::Arrays, false, false),
+                       MultiDrawOpenGLOrGLESParams(MultiDrawType::Elements, false, true),
+                       MultiDrawOpenGLOrGLESParams(MultiDrawType::Elements, false, false),
+                       MultiDrawOpenGLOrGLESParams(MultiDrawType::Arrays, true, true),
+                       MultiDrawOpenGLOrGLESParams(MultiDrawType::Elements, true, true),
+                       MultiDrawVulkanParams(MultiDrawType::Arrays, false),
+                       MultiDrawVulkanParams(MultiDrawType::Elements, false),
+                       MultiDrawVulkanParams(MultiDrawType::Arrays, true));
+
+}  // anonymous namespace
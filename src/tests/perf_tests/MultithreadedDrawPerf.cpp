@@ -0,0 +1,279 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MultithreadedDrawPerf:
+//   Performance test for draw calls made by several threads at the same time, each with its own
+//   context.  Each step makes a fixed number of draw calls, split between the threads, so the time
+//   per step shows how draw calls scale with the thread count.  The contexts of the threads are
+//   either in separate share groups, like a compositor and unrelated worker contexts, or all in the
+//   same share group.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+#include <thread>
+
+#include "test_utils/ANGLETest.h"
+#include "util/shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+constexpr unsigned int kDrawsPerStep = 8192;
+constexpr GLsizei kFramebufferSize   = 64;
+
+struct MultithreadedDrawParams final : public RenderTestParams
+{
+    MultithreadedDrawParams()
+    {
+        iterationsPerStep = 1;
+
+        majorVersion = 2;
+        minorVersion = 0;
+        windowWidth  = 64;
+        windowHeight = 64;
+    }
+
+    std::string story() const override
+    {
+        std::stringstream strstr;
+        strstr << RenderTestParams::story();
+        strstr << "_" << threadCount << "_threads";
+        strstr << (sameShareGroup ? "_same_share_group" : "_separate_share_groups");
+        return strstr.str();
+    }
+
+    unsigned int threadCount = 1;
+    // Whether the contexts of all threads share objects, instead of each thread's context only
+    // sharing objects with a context that is not current.
+    bool sameShareGroup = false;
+};
+
+std::ostream &operator<<(std::ostream &os, const MultithreadedDrawParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+class MultithreadedDrawBenchmark : public ANGLERenderTest,
+                                   public ::testing::WithParamInterface<MultithreadedDrawParams>
+{
+  public:
+    MultithreadedDrawBenchmark() : ANGLERenderTest("MultithreadedDraw", GetParam()) {}
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    struct ThreadState
+    {
+        EGLContext context = EGL_NO_CONTEXT;
+        // A context that the thread's context shares objects with, so the thread's context is
+        // shared without sharing objects with the other threads.
+        EGLContext shareContext = EGL_NO_CONTEXT;
+    };
+
+    EGLContext createContext(EGLContext shareContext);
+    void initializeThreadContext();
+    void draw(const ThreadState &state, unsigned int drawCount);
+
+    EGLDisplay mDisplay = EGL_NO_DISPLAY;
+    EGLConfig mConfig   = nullptr;
+    std::vector<ThreadState> mThreads;
+};
+
+EGLContext MultithreadedDrawBenchmark::createContext(EGLContext shareContext)
+{
+    const EGLint attribs[] = {EGL_CONTEXT_CLIENT_VERSION, GetParam().majorVersion, EGL_NONE};
+    EGLContext context     = eglCreateContext(mDisplay, mConfig, shareContext, attribs);
+    EXPECT_NE(EGL_NO_CONTEXT, context);
+    return context;
+}
+
+void MultithreadedDrawBenchmark::initializeBenchmark()
+{
+    const MultithreadedDrawParams &params = GetParam();
+
+    mDisplay = eglGetCurrentDisplay();
+    if (!IsEGLDisplayExtensionEnabled(mDisplay, "EGL_KHR_surfaceless_context"))
+    {
+        skipTest("EGL_KHR_surfaceless_context is not supported");
+        return;
+    }
+
+    EGLContext mainContext = eglGetCurrentContext();
+    EGLSurface mainSurface = eglGetCurrentSurface(EGL_DRAW);
+
+    EGLint configID   = 0;
+    EGLint numConfigs = 0;
+    ASSERT_EGL_TRUE(eglQueryContext(mDisplay, mainContext, EGL_CONFIG_ID, &configID));
+    const EGLint configAttribs[] = {EGL_CONFIG_ID, configID, EGL_NONE};
+    ASSERT_EGL_TRUE(eglChooseConfig(mDisplay, configAttribs, &mConfig, 1, &numConfigs));
+    ASSERT_EQ(1, numConfigs);
+
+    mThreads.resize(params.threadCount);
+    for (ThreadState &state : mThreads)
+    {
+        if (params.sameShareGroup)
+        {
+            state.context = createContext(mainContext);
+        }
+        else
+        {
+            state.shareContext = createContext(EGL_NO_CONTEXT);
+            state.context      = createContext(state.shareContext);
+        }
+        ASSERT_NE(EGL_NO_CONTEXT, state.context);
+
+        ASSERT_EGL_TRUE(eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, state.context));
+        initializeThreadContext();
+    }
+
+    ASSERT_EGL_TRUE(eglMakeCurrent(mDisplay, mainSurface, mainSurface, mainContext));
+    ASSERT_GL_NO_ERROR();
+}
+
+void MultithreadedDrawBenchmark::initializeThreadContext()
+{
+    constexpr char kVS[] = R"(attribute vec2 aPosition;
+void main()
+{
+    gl_Position = vec4(aPosition, 0, 1);
+})";
+
+    constexpr char kFS[] = R"(precision mediump float;
+uniform vec4 uColor;
+void main()
+{
+    gl_FragColor = uColor;
+})";
+
+    // The objects are deleted along with the contexts.
+    GLuint program = CompileProgram(kVS, kFS);
+    ASSERT_NE(0u, program);
+    glUseProgram(program);
+    glUniform4f(glGetUniformLocation(program, "uColor"), 0.2f, 0.4f, 0.6f, 1.0f);
+
+    constexpr GLfloat kVertices[] = {-1.0f, -1.0f, 1.0f, -1.0f, 0.0f, 1.0f};
+    GLuint buffer                 = 0;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(kVertices), kVertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glEnableVertexAttribArray(0);
+
+    GLuint renderbuffer = 0;
+    glGenRenderbuffers(1, &renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA4, kFramebufferSize, kFramebufferSize);
+
+    GLuint framebuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffer);
+    ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+
+    glViewport(0, 0, kFramebufferSize, kFramebufferSize);
+    ASSERT_GL_NO_ERROR();
+}
+
+void MultithreadedDrawBenchmark::destroyBenchmark()
+{
+    for (ThreadState &state : mThreads)
+    {
+        eglDestroyContext(mDisplay, state.context);
+        if (state.shareContext != EGL_NO_CONTEXT)
+        {
+            eglDestroyContext(mDisplay, state.shareContext);
+        }
+    }
+    mThreads.clear();
+}
+
+void MultithreadedDrawBenchmark::draw(const ThreadState &state, unsigned int drawCount)
+{
+    EXPECT_EGL_TRUE(eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, state.context));
+
+    for (unsigned int drawIndex = 0; drawIndex < drawCount; ++drawIndex)
+    {
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    glFlush();
+    EXPECT_GL_NO_ERROR();
+
+    EXPECT_EGL_TRUE(eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT));
+}
+
+void MultithreadedDrawBenchmark::drawBenchmark()
+{
+    const MultithreadedDrawParams &params = GetParam();
+    const unsigned int drawsPerThread =
+        kDrawsPerStep * params.iterationsPerStep / params.threadCount;
+
+    std::vector<std::thread> threads;
+    for (const ThreadState &state : mThreads)
+    {
+        threads.emplace_back([this, &state, drawsPerThread]() { draw(state, drawsPerThread); });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+MultithreadedDrawParams MultithreadedDrawParamsForBackend(const EGLPlatformParameters &eglParams,
+                                                          unsigned int threadCount,
+                                                          bool sameShareGroup)
+{
+    MultithreadedDrawParams params;
+    params.eglParameters  = eglParams;
+    params.threadCount    = threadCount;
+    params.sameShareGroup = sameShareGroup;
+    return params;
+}
+
+MultithreadedDrawParams OpenGLOrGLESParams(unsigned int threadCount, bool sameShareGroup)
+{
+    return MultithreadedDrawParamsForBackend(egl_platform::OPENGL_OR_GLES(), threadCount,
+                                             sameShareGroup);
+}
+
+MultithreadedDrawParams VulkanParams(unsigned int threadCount, bool sameShareGroup)
+{
+    return MultithreadedDrawParamsForBackend(egl_platform::VULKAN(), threadCount, sameShareGroup);
+}
+
+MultithreadedDrawParams VulkanNullParams(unsigned int threadCount, bool sameShareGroup)
+{
+    return MultithreadedDrawParamsForBackend(egl_platform::VULKAN_NULL(), threadCount,
+                                             sameShareGroup);
+}
+
+// Measures the time for a number of draw calls split between threads.
+TEST_P(MultithreadedDrawBenchmark, Run)
+{
+    run();
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(MultithreadedDrawBenchmark);
+ANGLE_INSTANTIATE_TEST(MultithreadedDrawBenchmark,
+                       OpenGLOrGLESParams(1, false),
+                       OpenGLOrGLESParams(2, false),
+                       OpenGLOrGLESParams(4, false),
+                       OpenGLOrGLESParams(4, true),
+                       VulkanParams(1, false),
+                       VulkanParams(2, false),
+                       VulkanParams(4, false),
+                       VulkanParams(8, false),
+                       VulkanParams(4, true),
+                       VulkanNullParams(1, false),
+                       VulkanNullParams(4, false),
+                       VulkanNullParams(4, true));
+
+}  // anonymous namespace
@@ -0,0 +1,149 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PreprocessorPerf: Performance test for the GLSL preprocessor, on generated shaders that either
+// make heavy use of object-like and function-like macros, or have no directives at all.  Each step
+// preprocesses the whole shader.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/DirectiveHandlerBase.h"
+#include "compiler/preprocessor/Preprocessor.h"
+#include "compiler/preprocessor/Token.h"
+
+using namespace testing;
+
+namespace
+{
+// Number of statements in the generated shaders.
+constexpr int kStatementCount = 2000;
+
+class NullDiagnostics : public angle::pp::Diagnostics
+{
+  protected:
+    void print(ID id, const angle::pp::SourceLocation &loc, const std::string &text) override {}
+};
+
+class NullDirectiveHandler : public angle::pp::DirectiveHandler
+{
+  public:
+    void handleError(const angle::pp::SourceLocation &loc, const std::string &msg) override {}
+    void handlePragma(const angle::pp::SourceLocation &loc,
+                      const std::string &name,
+                      const std::string &value,
+                      bool stdgl) override
+    {}
+    void handleExtension(const angle::pp::SourceLocation &loc,
+                         const std::string &name,
+                         const std::string &behavior) override
+    {}
+    void handleVersion(const angle::pp::SourceLocation &loc,
+                       int version,
+                       ShShaderSpec spec,
+                       angle::pp::MacroSet *macro_set) override
+    {}
+};
+
+struct PreprocessorParams
+{
+    PreprocessorParams(bool usesMacros) : usesMacros(usesMacros) {}
+
+    // Whether the shader is written with macros, instead of having no directives.
+    bool usesMacros;
+};
+
+std::ostream &operator<<(std::ostream &os, const PreprocessorParams &params)
+{
+    os << (params.usesMacros ? "macros" : "no_directives");
+    return os;
+}
+
+std::string GenerateShader(bool usesMacros)
+{
+    std::stringstream shader;
+    if (usesMacros)
+    {
+        shader << "#define SCALE 0.5\n";
+        shader << "#define OFFSET(v) ((v) + vec4(SCALE))\n";
+        shader << "#define MAD(a, b, c) ((a) * (b) + (c))\n";
+        shader << "#define BLEND(a, b, t) MAD(OFFSET(a), vec4(t), (b) * (1.0 - (t)))\n";
+    }
+    shader << "precision mediump float;\n";
+    shader << "uniform vec4 u0;\nuniform vec4 u1;\n";
+    shader << "void main()\n{\n    vec4 color = u0;\n";
+    for (int statement = 0; statement < kStatementCount; ++statement)
+    {
+        float t = static_cast<float>(statement % 10) / 10.0f;
+        if (usesMacros)
+        {
+            shader << "    color = BLEND(color, u1, " << t << ");\n";
+        }
+        else
+        {
+            shader << "    color = ((color + vec4(0.5)) * vec4(" << t << ") + (u1) * (1.0 - ("
+                   << t << ")));\n";
+        }
+    }
+    shader << "    gl_FragColor = color;\n}\n";
+    return shader.str();
+}
+
+class PreprocessorPerfTest : public ANGLEPerfTest, public WithParamInterface<PreprocessorParams>
+{
+  public:
+    PreprocessorPerfTest();
+
+    void step() override;
+
+    std::string getName();
+
+  private:
+    std::string mShader;
+};
+
+PreprocessorPerfTest::PreprocessorPerfTest()
+    : ANGLEPerfTest(getName(), "", "_run", 1), mShader(GenerateShader(GetParam().usesMacros))
+{}
+
+void PreprocessorPerfTest::step()
+{
+    NullDiagnostics diagnostics;
+    NullDirectiveHandler directiveHandler;
+    angle::pp::Preprocessor preprocessor(&diagnostics, &directiveHandler,
+                                         angle::pp::PreprocessorSettings(SH_WEBGL_SPEC));
+
+    const char *shaderStrings[] = {mShader.c_str()};
+    ASSERT_TRUE(preprocessor.init(1, shaderStrings, nullptr));
+
+    angle::pp::Token token;
+    do
+    {
+        preprocessor.lex(&token);
+    } while (token.type != angle::pp::Token::LAST);
+}
+
+std::string PreprocessorPerfTest::getName()
+{
+    std::stringstream ss;
+    ss << UnitTest::GetInstance()->current_test_case()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+// Measures the time to preprocess a shader.
+TEST_P(PreprocessorPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         PreprocessorPerfTest,
+                         Values(PreprocessorParams(true), PreprocessorParams(false)),
+                         PrintToStringParamName());
+
+}  // anonymous namespace
@@ -0,0 +1,216 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ProgramCacheHitPerf:
+//   Performance test for linking programs that are found in the memory program cache, with the
+//   program binaries stored by each of the blob cache codecs.  Besides the time per link, the size
+//   of the cache holding all the programs is reported, to compare the memory each codec takes.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "util/shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+// Number of different programs linked in turn.
+constexpr size_t kProgramCount = 32;
+
+// Large enough to hold all the programs uncompressed.
+constexpr EGLint kProgramCacheSize = 32 * 1024 * 1024;
+
+struct ProgramCacheHitParams final : public RenderTestParams
+{
+    ProgramCacheHitParams()
+    {
+        iterationsPerStep = 1;
+
+        majorVersion = 3;
+        minorVersion = 0;
+        windowWidth  = 256;
+        windowHeight = 256;
+    }
+
+    std::string story() const override
+    {
+        std::stringstream strstr;
+        strstr << RenderTestParams::story();
+        strstr << (uncompressed ? "_uncompressed" : "_gzip");
+        return strstr.str();
+    }
+
+    bool uncompressed = false;
+};
+
+std::ostream &operator<<(std::ostream &os, const ProgramCacheHitParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+class ProgramCacheHitBenchmark : public ANGLERenderTest,
+                                 public ::testing::WithParamInterface<ProgramCacheHitParams>
+{
+  public:
+    ProgramCacheHitBenchmark() : ANGLERenderTest("ProgramCacheHit", GetParam()) {}
+
+    void initializeBenchmark() override;
+    void drawBenchmark() override;
+
+    void recordProgramCacheSize();
+
+  private:
+    GLuint linkProgram(size_t index);
+
+    size_t mNextProgram      = 0;
+    EGLint mProgramCacheSize = 0;
+};
+
+void ProgramCacheHitBenchmark::initializeBenchmark()
+{
+    EGLDisplay display = eglGetCurrentDisplay();
+    if (!IsEGLDisplayExtensionEnabled(display, "EGL_ANGLE_program_cache_control"))
+    {
+        skipTest("EGL_ANGLE_program_cache_control is not supported");
+        return;
+    }
+
+    // The memory cache is disabled by default.
+    eglProgramCacheResizeANGLE(display, kProgramCacheSize, EGL_PROGRAM_CACHE_RESIZE_ANGLE);
+
+    for (size_t index = 0; index < kProgramCount; ++index)
+    {
+        glDeleteProgram(linkProgram(index));
+    }
+
+    mProgramCacheSize = eglProgramCacheGetAttribANGLE(display, EGL_PROGRAM_CACHE_SIZE_ANGLE);
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+GLuint ProgramCacheHitBenchmark::linkProgram(size_t index)
+{
+    constexpr char kVS[] = R"(#version 300 es
+in vec4 aPosition;
+in vec3 aNormal;
+in vec2 aTexCoord;
+uniform mat4 uModelViewProjection;
+uniform mat3 uNormalMatrix;
+out vec3 vNormal;
+out vec2 vTexCoord;
+void main()
+{
+    vNormal = normalize(uNormalMatrix * aNormal);
+    vTexCoord = aTexCoord;
+    gl_Position = uModelViewProjection * aPosition;
+})";
+
+    // A lit and textured material, with different constants in each program so they all hash
+    // differently.
+    std::stringstream fragmentShader;
+    fragmentShader << R"(#version 300 es
+precision highp float;
+in vec3 vNormal;
+in vec2 vTexCoord;
+uniform sampler2D uAlbedo;
+uniform sampler2D uNormalMap;
+uniform vec3 uLightDirections[4];
+uniform vec3 uLightColors[4];
+uniform float uRoughness;
+out vec4 fragColor;
+void main()
+{
+    vec3 normal = normalize(vNormal + texture(uNormalMap, vTexCoord).xyz * 2.0 - 1.0);
+    vec3 albedo = texture(uAlbedo, vTexCoord).rgb;
+    vec3 color = vec3(0.0);
+    for (int i = 0; i < 4; ++i)
+    {
+        float diffuse = max(dot(normal, normalize(uLightDirections[i])), 0.0);
+        vec3 halfVector = normalize(uLightDirections[i] + vec3(0.0, 0.0, 1.0));
+        float specular = pow(max(dot(normal, halfVector), 0.0), 1.0 / (uRoughness + 0.01));
+        color += uLightColors[i] * (albedo * diffuse + specular / )"
+                   << (index + 2) << R"(.0);
+    }
+    fragColor = vec4(color, 1.0);
+})";
+
+    GLuint program = CompileProgram(kVS, fragmentShader.str().c_str());
+    EXPECT_NE(0u, program);
+    return program;
+}
+
+void ProgramCacheHitBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        GLuint program = linkProgram(mNextProgram);
+        mNextProgram   = (mNextProgram + 1) % kProgramCount;
+
+        glUseProgram(program);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glDeleteProgram(program);
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void ProgramCacheHitBenchmark::recordProgramCacheSize()
+{
+    if (mSkipTest)
+    {
+        return;
+    }
+
+    recordIntegerMetric(".program_cache_size", static_cast<size_t>(mProgramCacheSize),
+                        "sizeInBytes");
+}
+
+ProgramCacheHitParams ProgramCacheHitOpenGLOrGLESParams(bool uncompressed)
+{
+    ProgramCacheHitParams params;
+    params.eglParameters = egl_platform::OPENGL_OR_GLES();
+    if (uncompressed)
+    {
+        params.eglParameters.enable(Feature::UncompressedBlobCache);
+    }
+    params.uncompressed = uncompressed;
+    return params;
+}
+
+ProgramCacheHitParams ProgramCacheHitVulkanParams(bool uncompressed)
+{
+    ProgramCacheHitParams params;
+    params.eglParameters = egl_platform::VULKAN();
+    if (uncompressed)
+    {
+        params.eglParameters.enable(Feature::UncompressedBlobCache);
+    }
+    params.uncompressed = uncompressed;
+    return params;
+}
+
+// Measures the time to link a program found in the program cache, and draw with it.
+TEST_P(ProgramCacheHitBenchmark, Run)
+{
+    run();
+    recordProgramCacheSize();
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ProgramCacheHitBenchmark);
+ANGLE_INSTANTIATE_TEST(ProgramCacheHitBenchmark,
+                       ProgramCacheHitOpenGLOrGLESParams(false),
+                       ProgramCacheHitOpenGLOrGLESParams(true),
+                       ProgramCacheHitVulkanParams(false),
+                       ProgramCacheHitVulkanParams(true));
+
+}  // anonymous namespace
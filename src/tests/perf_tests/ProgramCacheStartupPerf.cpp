@@ -0,0 +1,207 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ProgramCacheStartupPerf:
+//   Performance test for the first link and draw of programs after the process starts, with the
+//   blob cache persisted to the file named by ANGLE_BLOB_CACHE_FILE and filled by a previous run
+//   (warm), or not persisted at all (cold).  The memory cache is emptied before every link, so the
+//   warm case measures loading the program binaries from the file.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "common/system_utils.h"
+#include "util/shader_utils.h"
+#include "util/test_utils.h"
+
+using namespace angle;
+
+namespace
+{
+// Number of different programs linked in turn.
+constexpr size_t kProgramCount = 64;
+
+constexpr char kBlobCacheFileEnvVar[] = "ANGLE_BLOB_CACHE_FILE";
+
+struct ProgramCacheStartupParams final : public RenderTestParams
+{
+    ProgramCacheStartupParams()
+    {
+        iterationsPerStep = 1;
+
+        majorVersion = 2;
+        minorVersion = 0;
+        windowWidth  = 256;
+        windowHeight = 256;
+    }
+
+    std::string story() const override
+    {
+        std::stringstream strstr;
+        strstr << RenderTestParams::story();
+        strstr << (warmDiskCache ? "_warm_disk_cache" : "_cold_cache");
+        return strstr.str();
+    }
+
+    bool warmDiskCache = false;
+};
+
+std::ostream &operator<<(std::ostream &os, const ProgramCacheStartupParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+class ProgramCacheStartupBenchmark : public ANGLERenderTest,
+                                     public ::testing::WithParamInterface<ProgramCacheStartupParams>
+{
+  public:
+    ProgramCacheStartupBenchmark();
+    ~ProgramCacheStartupBenchmark() override;
+
+    void initializeBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    GLuint linkProgram(size_t index);
+
+    std::string mBlobCacheFile;
+    size_t mNextProgram = 0;
+};
+
+ProgramCacheStartupBenchmark::ProgramCacheStartupBenchmark()
+    : ANGLERenderTest("ProgramCacheStartup", GetParam())
+{
+    // The file must be named before the display is initialized.
+    if (GetParam().warmDiskCache)
+    {
+        Optional<std::string> blobCacheFile = CreateTemporaryFile();
+        if (!blobCacheFile.valid())
+        {
+            skipTest("Failed to create the blob cache file");
+            return;
+        }
+
+        mBlobCacheFile = blobCacheFile.value();
+        SetEnvironmentVar(kBlobCacheFileEnvVar, mBlobCacheFile.c_str());
+    }
+}
+
+ProgramCacheStartupBenchmark::~ProgramCacheStartupBenchmark()
+{
+    if (!mBlobCacheFile.empty())
+    {
+        UnsetEnvironmentVar(kBlobCacheFileEnvVar);
+        DeleteSystemFile(mBlobCacheFile.c_str());
+    }
+}
+
+void ProgramCacheStartupBenchmark::initializeBenchmark()
+{
+    if (!IsEGLDisplayExtensionEnabled(eglGetCurrentDisplay(), "EGL_ANGLE_program_cache_control"))
+    {
+        skipTest("EGL_ANGLE_program_cache_control is not supported");
+        return;
+    }
+
+    // Fill the file like a previous run of the application would have.
+    if (GetParam().warmDiskCache)
+    {
+        for (size_t index = 0; index < kProgramCount; ++index)
+        {
+            glDeleteProgram(linkProgram(index));
+        }
+    }
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+GLuint ProgramCacheStartupBenchmark::linkProgram(size_t index)
+{
+    constexpr char kVS[] = R"(attribute vec2 aPosition;
+varying vec2 vTexCoord;
+void main()
+{
+    vTexCoord = aPosition * 0.5 + 0.5;
+    gl_Position = vec4(aPosition, 0, 1);
+})";
+
+    // Each program uses different constants, so they all hash differently.
+    std::stringstream fragmentShader;
+    fragmentShader << R"(precision mediump float;
+varying vec2 vTexCoord;
+uniform vec3 uLightDirection;
+void main()
+{
+    vec3 normal = normalize(vec3(vTexCoord * 2.0 - 1.0, 1.0));
+    float diffuse = max(dot(normal, normalize(uLightDirection)), 0.0);
+    vec3 color = vec3(0.0);
+    for (int i = 0; i < 4; ++i)
+    {
+        color += vec3(diffuse * float(i + 1) / )"
+                   << (index + 5) << R"(.0);
+    }
+    gl_FragColor = vec4(color, 1.0);
+})";
+
+    GLuint program = CompileProgram(kVS, fragmentShader.str().c_str());
+    EXPECT_NE(0u, program);
+    return program;
+}
+
+void ProgramCacheStartupBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        // Start from an empty memory cache, like a new process would.
+        eglProgramCacheResizeANGLE(eglGetCurrentDisplay(), 0, EGL_PROGRAM_CACHE_TRIM_ANGLE);
+
+        GLuint program = linkProgram(mNextProgram);
+        mNextProgram   = (mNextProgram + 1) % kProgramCount;
+
+        glUseProgram(program);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glDeleteProgram(program);
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+ProgramCacheStartupParams ProgramCacheStartupOpenGLOrGLESParams(bool warmDiskCache)
+{
+    ProgramCacheStartupParams params;
+    params.eglParameters = egl_platform::OPENGL_OR_GLES();
+    params.warmDiskCache = warmDiskCache;
+    return params;
+}
+
+ProgramCacheStartupParams ProgramCacheStartupVulkanParams(bool warmDiskCache)
+{
+    ProgramCacheStartupParams params;
+    params.eglParameters = egl_platform::VULKAN();
+    params.warmDiskCache = warmDiskCache;
+    return params;
+}
+
+// Measures the time to link and first draw with a program in a new process.
+TEST_P(ProgramCacheStartupBenchmark, Run)
+{
+    run();
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ProgramCacheStartupBenchmark);
+ANGLE_INSTANTIATE_TEST(ProgramCacheStartupBenchmark,
+                       ProgramCacheStartupOpenGLOrGLESParams(false),
+                       ProgramCacheStartupOpenGLOrGLESParams(true),
+                       ProgramCacheStartupVulkanParams(false),
+                       ProgramCacheStartupVulkanParams(true));
+
+}  // anonymous namespace
@@ -0,0 +1,267 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ProgramSwitchPerf:
+//   Performance test for switching programs on every draw, with the textures and uniform buffer
+//   the programs use either left bound or rebound before each draw.  Redundant native state calls
+//   made by the back-end show up here.  On back-ends that count them, the native binding calls
+//   issued and elided per draw are reported too.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <array>
+#include <sstream>
+
+#include "util/shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+constexpr size_t kProgramCount = 8;
+constexpr size_t kTextureCount = 8;
+// Number of textures sampled by each program.
+constexpr size_t kSamplerCount = 4;
+
+struct ProgramSwitchParams final : public RenderTestParams
+{
+    ProgramSwitchParams()
+    {
+        iterationsPerStep = 256;
+
+        majorVersion = 3;
+        minorVersion = 0;
+        windowWidth  = 64;
+        windowHeight = 64;
+    }
+
+    std::string story() const override
+    {
+        std::stringstream strstr;
+        strstr << RenderTestParams::story();
+        strstr << (rebindState ? "_rebind_state" : "_static_state");
+        return strstr.str();
+    }
+
+    // Whether the textures and uniform buffer are bound again before each draw, with the same
+    // objects.
+    bool rebindState = false;
+};
+
+std::ostream &operator<<(std::ostream &os, const ProgramSwitchParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+class ProgramSwitchBenchmark : public ANGLERenderTest,
+                               public ::testing::WithParamInterface<ProgramSwitchParams>
+{
+  public:
+    ProgramSwitchBenchmark() : ANGLERenderTest("ProgramSwitch", GetParam()) {}
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+    void recordStateCallCounts();
+
+  private:
+    // Returns false if the back-end doesn't count native binding calls.
+    bool getStateCallCounts(uint64_t *issuedOut, uint64_t *elidedOut) const;
+
+    std::array<GLuint, kProgramCount> mPrograms = {};
+    std::array<GLuint, kTextureCount> mTextures = {};
+    GLuint mUniformBuffer                       = 0;
+
+    size_t mDrawCount          = 0;
+    bool mHasStateCallCounts   = false;
+    uint64_t mStartIssuedCalls = 0;
+    uint64_t mStartElidedCalls = 0;
+    uint64_t mEndIssuedCalls   = 0;
+    uint64_t mEndElidedCalls   = 0;
+};
+
+bool ProgramSwitchBenchmark::getStateCallCounts(uint64_t *issuedOut, uint64_t *elidedOut) const
+{
+    if (!IsGLExtensionEnabled("GL_AMD_performance_monitor"))
+    {
+        return false;
+    }
+
+    CounterNameToValueMap counters = BuildCounterNameToValueMap();
+    auto issued                    = counters.find("stateCallsIssuedTotal");
+    auto elided                    = counters.find("stateCallsElidedTotal");
+    if (issued == counters.end() || elided == counters.end())
+    {
+        return false;
+    }
+
+    *issuedOut = issued->second;
+    *elidedOut = elided->second;
+    return true;
+}
+
+void ProgramSwitchBenchmark::initializeBenchmark()
+{
+    constexpr char kVS[] = R"(#version 300 es
+in vec4 a_position;
+void main()
+{
+    gl_Position = a_position;
+})";
+
+    // Each program samples its textures from a different range of texture units.
+    for (size_t programIndex = 0; programIndex < kProgramCount; ++programIndex)
+    {
+        std::stringstream fs;
+        fs << "#version 300 es\n"
+              "precision mediump float;\n"
+              "uniform Block { vec4 u_tint; };\n";
+        for (size_t sampler = 0; sampler < kSamplerCount; ++sampler)
+        {
+            fs << "uniform sampler2D u_texture" << sampler << ";\n";
+        }
+        fs << "out vec4 color;\n"
+              "void main()\n"
+              "{\n"
+              "    color = u_tint";
+        for (size_t sampler = 0; sampler < kSamplerCount; ++sampler)
+        {
+            fs << " + texture(u_texture" << sampler << ", vec2(0.5))";
+        }
+        fs << ";\n}\n";
+
+        GLuint program = CompileProgram(kVS, fs.str().c_str());
+        ASSERT_NE(0u, program);
+
+        glUseProgram(program);
+        for (size_t sampler = 0; sampler < kSamplerCount; ++sampler)
+        {
+            std::string name = "u_texture" + std::to_string(sampler);
+            GLint location   = glGetUniformLocation(program, name.c_str());
+            ASSERT_NE(-1, location);
+            glUniform1i(location, static_cast<GLint>((programIndex + sampler) % kTextureCount));
+        }
+        glUniformBlockBinding(program, glGetUniformBlockIndex(program, "Block"), 0);
+
+        mPrograms[programIndex] = program;
+    }
+
+    const std::array<GLubyte, 4> kColor = {64, 128, 192, 255};
+    glGenTextures(static_cast<GLsizei>(mTextures.size()), mTextures.data());
+    for (size_t unit = 0; unit < kTextureCount; ++unit)
+    {
+        glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+        glBindTexture(GL_TEXTURE_2D, mTextures[unit]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                     kColor.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+
+    const std::array<GLfloat, 4> kTint = {0.1f, 0.1f, 0.1f, 0.0f};
+    glGenBuffers(1, &mUniformBuffer);
+    glBindBufferBase(GL_UNIFORM_BUFFER, 0, mUniformBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(kTint), kTint.data(), GL_STATIC_DRAW);
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+
+    mHasStateCallCounts = getStateCallCounts(&mStartIssuedCalls, &mStartElidedCalls);
+}
+
+void ProgramSwitchBenchmark::destroyBenchmark()
+{
+    if (mHasStateCallCounts)
+    {
+        getStateCallCounts(&mEndIssuedCalls, &mEndElidedCalls);
+    }
+
+    for (GLuint program : mPrograms)
+    {
+        glDeleteProgram(program);
+    }
+    glDeleteTextures(static_cast<GLsizei>(mTextures.size()), mTextures.data());
+    glDeleteBuffers(1, &mUniformBuffer);
+}
+
+void ProgramSwitchBenchmark::drawBenchmark()
+{
+    const ProgramSwitchParams &params = GetParam();
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        const size_t programIndex = mDrawCount % kProgramCount;
+        glUseProgram(mPrograms[programIndex]);
+
+        if (params.rebindState)
+        {
+            for (size_t sampler = 0; sampler < kSamplerCount; ++sampler)
+            {
+                const size_t unit = (programIndex + sampler) % kTextureCount;
+                glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+                glBindTexture(GL_TEXTURE_2D, mTextures[unit]);
+            }
+            glBindBufferBase(GL_UNIFORM_BUFFER, 0, mUniformBuffer);
+            glUniformBlockBinding(mPrograms[programIndex], 0, 0);
+        }
+
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        ++mDrawCount;
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void ProgramSwitchBenchmark::recordStateCallCounts()
+{
+    if (!mHasStateCallCounts || mDrawCount == 0)
+    {
+        return;
+    }
+
+    const double drawCount = static_cast<double>(mDrawCount);
+    recordDoubleMetric(".state_calls_issued_per_draw",
+                       static_cast<double>(mEndIssuedCalls - mStartIssuedCalls) / drawCount,
+                       "count");
+    recordDoubleMetric(".state_calls_elided_per_draw",
+                       static_cast<double>(mEndElidedCalls - mStartElidedCalls) / drawCount,
+                       "count");
+}
+
+ProgramSwitchParams ProgramSwitchOpenGLOrGLESParams(bool rebindState)
+{
+    ProgramSwitchParams params;
+    params.eglParameters = egl_platform::OPENGL_OR_GLES();
+    params.rebindState   = rebindState;
+    return params;
+}
+
+ProgramSwitchParams ProgramSwitchVulkanParams(bool rebindState)
+{
+    ProgramSwitchParams params;
+    params.eglParameters = egl_platform::VULKAN();
+    params.rebindState   = rebindState;
+    return params;
+}
+
+// Measures the time to switch programs and draw.
+TEST_P(ProgramSwitchBenchmark, Run)
+{
+    run();
+    recordStateCallCounts();
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ProgramSwitchBenchmark);
+ANGLE_INSTANTIATE_TEST(ProgramSwitchBenchmark,
+                       ProgramSwitchOpenGLOrGLESParams(false),
+                       ProgramSwitchOpenGLOrGLESParams(true),
+                       ProgramSwitchVulkanParams(false),
+                       ProgramSwitchVulkanParams(true));
+
+}  // anonymous namespace
@@ -0,0 +1,232 @@
+//
+// Copyright 2023 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ReadPixelsPerf:
+//   Performance test for reading back a framebuffer every frame, like video capture of a WebGL
+//   canvas.  Compares synchronous reads into client memory with asynchronous reads into a ring of
+//   pixel pack buffers, each mapped a few frames later once its fence is signaled.  Covers RGBA8
+//   and RGBA16 (GL_EXT_texture_norm16) framebuffers.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <array>
+#include <sstream>
+
+using namespace angle;
+
+namespace
+{
+// Number of pixel pack buffers read into in turn in asynchronous mode.
+constexpr size_t kPackBufferCount = 3;
+
+struct ReadPixelsParams final : public RenderTestParams
+{
+    ReadPixelsParams()
+    {
+        iterationsPerStep = 4;
+
+        majorVersion = 3;
+        minorVersion = 0;
+        windowWidth  = 512;
+        windowHeight = 512;
+    }
+
+    std::string story() const override
+    {
+        std::stringstream strstr;
+        strstr << RenderTestParams::story();
+        strstr << (norm16 ? "_rgba16" : "_rgba8");
+        strstr << (async ? "_async" : "_sync");
+        return strstr.str();
+    }
+
+    // Whether the framebuffer is GL_RGBA16_EXT instead of GL_RGBA8.
+    bool norm16 = false;
+    // Whether pixels are read into pixel pack buffers instead of client memory.
+    bool async = false;
+};
+
+std::ostream &operator<<(std::ostream &os, const ReadPixelsParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+class ReadPixelsBenchmark : public ANGLERenderTest,
+                            public ::testing::WithParamInterface<ReadPixelsParams>
+{
+  public:
+    ReadPixelsBenchmark() : ANGLERenderTest("ReadPixels", GetParam())
+    {
+        if (GetParam().norm16)
+        {
+            addExtensionPrerequisite("GL_EXT_texture_norm16");
+        }
+    }
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    GLenum getReadType() const;
+    size_t getImageSize() const;
+
+    GLuint mTexture     = 0;
+    GLuint mFramebuffer = 0;
+
+    std::vector<uint8_t> mPixels;
+
+    std::array<GLuint, kPackBufferCount> mPackBuffers = {};
+    std::array<GLsync, kPackBufferCount> mFences      = {};
+    size_t mNextPackBuffer                            = 0;
+    unsigned int mFrame                               = 0;
+};
+
+GLenum ReadPixelsBenchmark::getReadType() const
+{
+    return GetParam().norm16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE;
+}
+
+size_t ReadPixelsBenchmark::getImageSize() const
+{
+    const ReadPixelsParams &params = GetParam();
+    const size_t pixelBytes        = params.norm16 ? 8 : 4;
+    return params.windowWidth * params.windowHeight * pixelBytes;
+}
+
+void ReadPixelsBenchmark::initializeBenchmark()
+{
+    const ReadPixelsParams &params = GetParam();
+
+    glGenTextures(1, &mTexture);
+    glBindTexture(GL_TEXTURE_2D, mTexture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, params.norm16 ? GL_RGBA16_EXT : GL_RGBA8, params.windowWidth,
+                   params.windowHeight);
+
+    glGenFramebuffers(1, &mFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mTexture, 0);
+    ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+
+    if (params.async)
+    {
+        glGenBuffers(static_cast<GLsizei>(mPackBuffers.size()), mPackBuffers.data());
+        for (GLuint packBuffer : mPackBuffers)
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, packBuffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, getImageSize(), nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    else
+    {
+        mPixels.resize(getImageSize());
+    }
+
+    glViewport(0, 0, params.windowWidth, params.windowHeight);
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void ReadPixelsBenchmark::destroyBenchmark()
+{
+    for (GLsync fence : mFences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+    }
+    if (GetParam().async)
+    {
+        glDeleteBuffers(static_cast<GLsizei>(mPackBuffers.size()), mPackBuffers.data());
+    }
+    glDeleteFramebuffers(1, &mFramebuffer);
+    glDeleteTextures(1, &mTexture);
+}
+
+void ReadPixelsBenchmark::drawBenchmark()
+{
+    const ReadPixelsParams &params = GetParam();
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        // Change the framebuffer contents every frame, like a rendered canvas.
+        const float shade = static_cast<float>(mFrame++ % 256) / 255.0f;
+        glClearColor(shade, 0.5f, 1.0f - shade, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        if (!params.async)
+        {
+            glReadPixels(0, 0, params.windowWidth, params.windowHeight, GL_RGBA, getReadType(),
+                         mPixels.data());
+            continue;
+        }
+
+        // Consume the oldest read before reusing its buffer.
+        GLuint packBuffer = mPackBuffers[mNextPackBuffer];
+        GLsync &fence     = mFences[mNextPackBuffer];
+        mNextPackBuffer   = (mNextPackBuffer + 1) % kPackBufferCount;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, packBuffer);
+        if (fence)
+        {
+            glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            glDeleteSync(fence);
+            fence = 0;
+
+            void *pixels =
+                glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, getImageSize(), GL_MAP_READ_BIT);
+            ASSERT_NE(nullptr, pixels);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+
+        glReadPixels(0, 0, params.windowWidth, params.windowHeight, GL_RGBA, getReadType(),
+                     nullptr);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+ReadPixelsParams ReadPixelsOpenGLOrGLESParams(bool norm16, bool async)
+{
+    ReadPixelsParams params;
+    params.eglParameters = egl_platform::OPENGL_OR_GLES();
+    params.norm16        = norm16;
+    params.async         = async;
+    return params;
+}
+
+ReadPixelsParams ReadPixelsVulkanParams(bool norm16, bool async)
+{
+    ReadPixelsParams params;
+    params.eglParameters = egl_platform::VULKAN();
+    params.norm16        = norm16;
+    params.async         = async;
+    return params;
+}
+
+// Measures the time to render and read back frames.
+TEST_P(ReadPixelsBenchmark, Run)
+{
+    run();
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ReadPixelsBenchmark);
+ANGLE_INSTANTIATE_TEST(ReadPixelsBenchmark,
+                       ReadPixelsOpenGLOrGLESParams(false, false),
+                       ReadPixelsOpenGLOrGLESParams(false, true),
+                       ReadPixelsOpenGLOrGLESParams(true, false),
+                       ReadPixelsOpenGLOrGLESParams(true, true),
+                       ReadPixelsVulkanParams(false, false),
+                       ReadPixelsVulkanParams(false, true),
+                       ReadPixelsVulkanParams(true, false),
+                       ReadPixelsVulkanParams(true, true));
+
+}  // anonymous namespace
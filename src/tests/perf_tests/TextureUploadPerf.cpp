@@ -22,6 +22,10 @@ namespace
 {
 constexpr unsigned int kIterationsPerStep = 2;
 
+// Size of the video frames uploaded by TextureUploadFrameBenchmark.
+constexpr GLsizei kFrameWidth  = 3840;
+constexpr GLsizei kFrameHeight = 2160;
+
 struct TextureUploadParams final : public RenderTestParams
 {
     TextureUploadParams()
@@ -33,6 +37,9 @@ struct TextureUploadParams final : public RenderTestParams
         subImageSize = 64;
 
         webgl = false;
+
+        uploadFormat = GL_RGBA;
+        uploadType   = GL_UNSIGNED_BYTE;
     }
 
     std::string story() const override;
@@ -41,6 +48,11 @@ struct TextureUploadParams final : public RenderTestParams
     GLsizei subImageSize;
 
     bool webgl;
+
+    // Client format of the data uploaded by TextureUploadFormatBenchmark.
+    GLenum uploadFormat;
+    GLenum uploadType;
+    std::string uploadFormatName;
 };
 
 std::ostream &operator<<(std::ostream &os, const TextureUploadParams &params)
@@ -60,6 +72,11 @@ std::string TextureUploadParams::story() const
         strstr << "_webgl";
     }
 
+    if (!uploadFormatName.empty())
+    {
+        strstr << "_" << uploadFormatName;
+    }
+
     return strstr.str();
 }
 
@@ -107,6 +124,101 @@ class TextureUploadSubImageBenchmark : public TextureUploadBenchmarkBase
     void drawBenchmark() override;
 };
 
+// Uploads sub-images in formats that have to be converted on the CPU by at least some back-ends,
+// and reports the resulting throughput of client data in MB/s.
+class TextureUploadFormatBenchmark : public TextureUploadBenchmarkBase
+{
+  public:
+    TextureUploadFormatBenchmark() : TextureUploadBenchmarkBase("TexSubImageFormat") {}
+
+    void initializeBenchmark() override
+    {
+        TextureUploadBenchmarkBase::initializeBenchmark();
+
+        const auto &params = GetParam();
+        glTexImage2D(GL_TEXTURE_2D, 0, params.uploadFormat, params.baseSize, params.baseSize, 0,
+                     params.uploadFormat, params.uploadType, nullptr);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        ASSERT_GL_NO_ERROR();
+    }
+
+    void drawBenchmark() override;
+
+    void recordThroughput();
+};
+
+// Uploads whole ETC2 images to several textures before drawing with them, and reports the time
+// spent in glCompressedTexImage2D itself.  Back-ends that decode ETC2 on the CPU can return from
+// the call before the decode is done, which this measures.
+class CompressedTexImageBenchmark : public TextureUploadBenchmarkBase
+{
+  public:
+    CompressedTexImageBenchmark() : TextureUploadBenchmarkBase("CompressedTexImage") {}
+
+    void initializeBenchmark() override
+    {
+        TextureUploadBenchmarkBase::initializeBenchmark();
+
+        const auto &params = GetParam();
+        mCompressedData.resize(params.baseSize * params.baseSize / 2, 0x5A);
+
+        mTextures.resize(params.iterationsPerStep);
+        glGenTextures(static_cast<GLsizei>(mTextures.size()), mTextures.data());
+        for (GLuint texture : mTextures)
+        {
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        }
+
+        ASSERT_GL_NO_ERROR();
+    }
+
+    void destroyBenchmark() override
+    {
+        glDeleteTextures(static_cast<GLsizei>(mTextures.size()), mTextures.data());
+        TextureUploadBenchmarkBase::destroyBenchmark();
+    }
+
+    void drawBenchmark() override;
+
+    void recordUploadCallTime();
+
+  private:
+    std::vector<uint8_t> mCompressedData;
+    std::vector<GLuint> mTextures;
+    Timer mUploadTimer;
+    double mUploadSeconds = 0.0;
+    size_t mUploadCount   = 0;
+};
+
+// Uploads whole 4K RGBA frames from client memory, like a video player, and reports the resulting
+// throughput in MB/s.  Back-ends can split such uploads in chunks and pipeline them.
+class TextureUploadFrameBenchmark : public TextureUploadBenchmarkBase
+{
+  public:
+    TextureUploadFrameBenchmark() : TextureUploadBenchmarkBase("TexSubImageFrame") {}
+
+    void initializeBenchmark() override
+    {
+        TextureUploadBenchmarkBase::initializeBenchmark();
+
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kFrameWidth, kFrameHeight);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+        mFrameData.resize(kFrameWidth * kFrameHeight * 4, 0x80);
+
+        ASSERT_GL_NO_ERROR();
+    }
+
+    void drawBenchmark() override;
+
+    void recordThroughput();
+
+  private:
+    std::vector<uint8_t> mFrameData;
+};
+
 class TextureUploadFullMipBenchmark : public TextureUploadBenchmarkBase
 {
   public:
@@ -267,6 +379,131 @@ void TextureUploadSubImageBenchmark::drawBenchmark()
     ASSERT_GL_NO_ERROR();
 }
 
+void TextureUploadFormatBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    startGpuTimer();
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, rand() % (params.baseSize - params.subImageSize),
+                        rand() % (params.baseSize - params.subImageSize), params.subImageSize,
+                        params.subImageSize, params.uploadFormat, params.uploadType,
+                        mTextureData.data());
+
+        // Perform a draw just so the texture data is flushed.  With the position attributes not
+        // set, a constant default value is used, resulting in a very cheap draw.
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    stopGpuTimer();
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void TextureUploadFormatBenchmark::recordThroughput()
+{
+    const double seconds = mTrialTimer.getElapsedWallClockTime();
+    if (mSkipTest || getNumStepsPerformed() == 0 || seconds <= 0.0)
+    {
+        return;
+    }
+
+    const auto &params = GetParam();
+    size_t pixelBytes  = 0;
+    switch (params.uploadType)
+    {
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+            pixelBytes = 2;
+            break;
+        default:
+            ASSERT(params.uploadType == GL_UNSIGNED_BYTE);
+            pixelBytes = params.uploadFormat == GL_RGBA  ? 4
+                         : params.uploadFormat == GL_RGB ? 3
+                                                         : 1;
+            break;
+    }
+
+    // Throughput of the last trial, in client bytes uploaded.
+    const double bytes = static_cast<double>(getNumStepsPerformed()) * params.iterationsPerStep *
+                         params.subImageSize * params.subImageSize * pixelBytes;
+    recordDoubleMetric(".upload_throughput", bytes / seconds / (1024.0 * 1024.0), "MB/s");
+}
+
+void CompressedTexImageBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    startGpuTimer();
+    for (GLuint texture : mTextures)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+
+        mUploadTimer.start();
+        glCompressedTexImage2D(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGB8_ETC2, params.baseSize,
+                               params.baseSize, 0, static_cast<GLsizei>(mCompressedData.size()),
+                               mCompressedData.data());
+        mUploadTimer.stop();
+
+        mUploadSeconds += mUploadTimer.getElapsedWallClockTime();
+        ++mUploadCount;
+    }
+
+    // Draw with every texture once all of them are uploaded, so the decodes of one step can
+    // overlap each other.
+    for (GLuint texture : mTextures)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    stopGpuTimer();
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void CompressedTexImageBenchmark::recordUploadCallTime()
+{
+    if (mSkipTest || mUploadCount == 0)
+    {
+        return;
+    }
+
+    recordDoubleMetric(".upload_call_time", mUploadSeconds * 1e6 / mUploadCount, "us");
+}
+
+void TextureUploadFrameBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    startGpuTimer();
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kFrameWidth, kFrameHeight, GL_RGBA,
+                        GL_UNSIGNED_BYTE, mFrameData.data());
+
+        // Draw with the frame, like a video player would.
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    stopGpuTimer();
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void TextureUploadFrameBenchmark::recordThroughput()
+{
+    const double seconds = mTrialTimer.getElapsedWallClockTime();
+    if (mSkipTest || getNumStepsPerformed() == 0 || seconds <= 0.0)
+    {
+        return;
+    }
+
+    // Throughput of the last trial, in client bytes uploaded.
+    const double bytes = static_cast<double>(getNumStepsPerformed()) *
+                         GetParam().iterationsPerStep * mFrameData.size();
+    recordDoubleMetric(".upload_throughput", bytes / seconds / (1024.0 * 1024.0), "MB/s");
+}
+
 void TextureUploadFullMipBenchmark::drawBenchmark()
 {
     const auto &params = GetParam();
@@ -363,6 +600,50 @@ TextureUploadParams VulkanParams(bool webglCompat)
     return params;
 }
 
+TextureUploadParams FormatParams(const EGLPlatformParameters &eglParameters,
+                                 GLenum uploadFormat,
+                                 GLenum uploadType,
+                                 const char *uploadFormatName)
+{
+    TextureUploadParams params;
+    params.eglParameters    = eglParameters;
+    params.subImageSize     = 512;
+    params.uploadFormat     = uploadFormat;
+    params.uploadType       = uploadType;
+    params.uploadFormatName = uploadFormatName;
+    return params;
+}
+
+TextureUploadParams VulkanCompressedParams(bool asyncDecode)
+{
+    TextureUploadParams params;
+    params.eglParameters     = egl_platform::VULKAN();
+    params.majorVersion      = 3;
+    params.minorVersion      = 0;
+    params.iterationsPerStep = 4;
+    params.uploadFormatName  = asyncDecode ? "etc2_async_decode" : "etc2_sync_decode";
+    if (!asyncDecode)
+    {
+        params.eglParameters.disable(Feature::AsyncEtcTextureDecode);
+    }
+    return params;
+}
+
+TextureUploadParams FrameParams(const EGLPlatformParameters &eglParameters, bool stagedUpload)
+{
+    TextureUploadParams params;
+    params.eglParameters    = eglParameters;
+    params.majorVersion     = 3;
+    params.minorVersion     = 0;
+    params.trackGpuTime     = false;
+    params.uploadFormatName = stagedUpload ? "staged" : "direct";
+    if (!stagedUpload)
+    {
+        params.eglParameters.disable(Feature::UploadTextureDataThroughStagingBuffers);
+    }
+    return params;
+}
+
 TextureUploadParams MetalPBOParams(GLsizei baseSize, GLsizei subImageSize)
 {
     TextureUploadParams params;
@@ -405,6 +686,24 @@ TEST_P(TextureUploadSubImageBenchmark, Run)
     run();
 }
 
+TEST_P(TextureUploadFormatBenchmark, Run)
+{
+    run();
+    recordThroughput();
+}
+
+TEST_P(CompressedTexImageBenchmark, Run)
+{
+    run();
+    recordUploadCallTime();
+}
+
+TEST_P(TextureUploadFrameBenchmark, Run)
+{
+    run();
+    recordThroughput();
+}
+
 TEST_P(TextureUploadFullMipBenchmark, Run)
 {
     run();
@@ -433,6 +732,31 @@ ANGLE_INSTANTIATE_TEST(TextureUploadSubImageBenchmark,
                        NullDevice(VulkanParams(false)),
                        VulkanParams(true));
 
+#define ANGLE_TEXTURE_UPLOAD_FORMAT_PARAMS(eglParameters)                         \
+    FormatParams(eglParameters, GL_ALPHA, GL_UNSIGNED_BYTE, "a8"),                \
+        FormatParams(eglParameters, GL_LUMINANCE, GL_UNSIGNED_BYTE, "l8"),        \
+        FormatParams(eglParameters, GL_RGB, GL_UNSIGNED_BYTE, "rgb8"),            \
+        FormatParams(eglParameters, GL_RGBA, GL_UNSIGNED_BYTE, "rgba8"),          \
+        FormatParams(eglParameters, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, "rgba4")
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(TextureUploadFormatBenchmark);
+ANGLE_INSTANTIATE_TEST(TextureUploadFormatBenchmark,
+                       ANGLE_TEXTURE_UPLOAD_FORMAT_PARAMS(egl_platform::D3D11()),
+                       ANGLE_TEXTURE_UPLOAD_FORMAT_PARAMS(egl_platform::METAL()),
+                       ANGLE_TEXTURE_UPLOAD_FORMAT_PARAMS(egl_platform::OPENGL_OR_GLES()),
+                       ANGLE_TEXTURE_UPLOAD_FORMAT_PARAMS(egl_platform::VULKAN()));
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(CompressedTexImageBenchmark);
+ANGLE_INSTANTIATE_TEST(CompressedTexImageBenchmark,
+                       VulkanCompressedParams(false),
+                       VulkanCompressedParams(true));
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(TextureUploadFrameBenchmark);
+ANGLE_INSTANTIATE_TEST(TextureUploadFrameBenchmark,
+                       FrameParams(egl_platform::OPENGL_OR_GLES(), true),
+                       FrameParams(egl_platform::OPENGL_OR_GLES(), false),
+                       FrameParams(egl_platform::VULKAN(), true));
+
 ANGLE_INSTANTIATE_TEST(TextureUploadFullMipBenchmark,
                        D3D11Params(false),
                        D3D11Params(true),
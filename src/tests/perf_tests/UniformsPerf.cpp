@@ -75,6 +75,9 @@ struct UniformsParams final : public RenderTestParams
     DataMode dataMode         = DataMode::REPEAT;
     MatrixLayout matrixLayout = MatrixLayout::NO_TRANSPOSE;
     ProgramMode programMode   = ProgramMode::SINGLE;
+
+    // Whether the GL back-end defers uniform updates to draw time.
+    bool deferUniformUpdates = true;
 };
 
 std::ostream &operator<<(std::ostream &os, const UniformsParams &params)
@@ -121,6 +124,11 @@ std::string UniformsParams::story() const
         strstr << "_repeating";
     }
 
+    if (!deferUniformUpdates)
+    {
+        strstr << "_immediate";
+    }
+
     return strstr.str();
 }
 
@@ -134,9 +142,14 @@ class UniformsBenchmark : public ANGLERenderTest,
     void destroyBenchmark() override;
     void drawBenchmark() override;
 
+    void recordUniformCallCounts();
+
   private:
     void initShaders();
 
+    // Returns false if the back-end doesn't count native uniform calls.
+    bool getUniformCallCounts(uint64_t *issuedOut, uint64_t *elidedOut) const;
+
     template <bool MultiProgram, typename SetUniformFunc>
     void drawLoop(const SetUniformFunc &setUniformsFunc);
 
@@ -145,6 +158,13 @@ class UniformsBenchmark : public ANGLERenderTest,
 
     using MatrixData = std::array<std::vector<Matrix4>, 2>;
     MatrixData mMatrixData;
+
+    size_t mDrawCount          = 0;
+    bool mHasUniformCallCounts = false;
+    uint64_t mStartIssuedCalls = 0;
+    uint64_t mStartElidedCalls = 0;
+    uint64_t mEndIssuedCalls   = 0;
+    uint64_t mEndElidedCalls   = 0;
 };
 
 std::vector<Matrix4> GenMatrixData(size_t count, int parity)
@@ -255,6 +275,44 @@ void UniformsBenchmark::initializeBenchmark()
     glVertexAttrib4f(attribLocation, 1.0f, 0.0f, 0.0f, 1.0f);
 
     ASSERT_GL_NO_ERROR();
+
+    mHasUniformCallCounts = getUniformCallCounts(&mStartIssuedCalls, &mStartElidedCalls);
+}
+
+bool UniformsBenchmark::getUniformCallCounts(uint64_t *issuedOut, uint64_t *elidedOut) const
+{
+    if (!IsGLExtensionEnabled("GL_AMD_performance_monitor"))
+    {
+        return false;
+    }
+
+    CounterNameToValueMap counters = BuildCounterNameToValueMap();
+    auto issued                    = counters.find("uniformCallsIssuedTotal");
+    auto elided                    = counters.find("uniformUpdatesElidedTotal");
+    if (issued == counters.end() || elided == counters.end())
+    {
+        return false;
+    }
+
+    *issuedOut = issued->second;
+    *elidedOut = elided->second;
+    return true;
+}
+
+void UniformsBenchmark::recordUniformCallCounts()
+{
+    if (!mHasUniformCallCounts || mDrawCount == 0)
+    {
+        return;
+    }
+
+    const double drawCount = static_cast<double>(mDrawCount);
+    recordDoubleMetric(".uniform_calls_issued_per_draw",
+                       static_cast<double>(mEndIssuedCalls - mStartIssuedCalls) / drawCount,
+                       "count");
+    recordDoubleMetric(".uniform_updates_elided_per_draw",
+                       static_cast<double>(mEndElidedCalls - mStartElidedCalls) / drawCount,
+                       "count");
 }
 
 std::string GetUniformLocationName(size_t idx, bool vertexShader)
@@ -374,6 +432,11 @@ void UniformsBenchmark::initShaders()
 
 void UniformsBenchmark::destroyBenchmark()
 {
+    if (mHasUniformCallCounts)
+    {
+        getUniformCallCounts(&mEndIssuedCalls, &mEndElidedCalls);
+    }
+
     glDeleteProgram(mPrograms[0]);
     glDeleteProgram(mPrograms[1]);
 }
@@ -400,6 +463,7 @@ void UniformsBenchmark::drawLoop(const SetUniformFunc &setUniformsFunc)
             }
         }
         glDrawArrays(GL_TRIANGLES, 0, 3);
+        ++mDrawCount;
     }
 }
 
@@ -500,11 +564,21 @@ UniformsParams MatrixUniforms(const EGLPlatformParameters &egl,
     return params;
 }
 
+// Makes the GL back-end forward every glUniform call to the driver.
+UniformsParams ImmediateUpdates(const UniformsParams &paramsIn)
+{
+    UniformsParams params      = paramsIn;
+    params.deferUniformUpdates = false;
+    params.eglParameters.disable(Feature::DeferDefaultUniformUpdates);
+    return params;
+}
+
 }  // anonymous namespace
 
 TEST_P(UniformsBenchmark, Run)
 {
     run();
+    recordUniformCallCounts();
 }
 
 ANGLE_INSTANTIATE_TEST(
@@ -517,12 +591,19 @@ ANGLE_INSTANTIATE_TEST(
     VectorUniforms(OPENGL_OR_GLES(), DataMode::UPDATE),
     VectorUniforms(OPENGL_OR_GLES(), DataMode::REPEAT),
     VectorUniforms(OPENGL_OR_GLES_NULL(), DataMode::UPDATE),
+    ImmediateUpdates(VectorUniforms(OPENGL_OR_GLES(), DataMode::UPDATE)),
+    VectorUniforms(OPENGL_OR_GLES(), DataMode::UPDATE, ProgramMode::MULTIPLE),
+    ImmediateUpdates(VectorUniforms(OPENGL_OR_GLES(), DataMode::UPDATE, ProgramMode::MULTIPLE)),
     MatrixUniforms(D3D11(), DataMode::UPDATE, DataType::MAT4x4, MatrixLayout::NO_TRANSPOSE),
     MatrixUniforms(METAL(), DataMode::UPDATE, DataType::MAT4x4, MatrixLayout::NO_TRANSPOSE),
     MatrixUniforms(OPENGL_OR_GLES(),
                    DataMode::UPDATE,
                    DataType::MAT4x4,
                    MatrixLayout::NO_TRANSPOSE),
+    ImmediateUpdates(MatrixUniforms(OPENGL_OR_GLES(),
+                                    DataMode::UPDATE,
+                                    DataType::MAT4x4,
+                                    MatrixLayout::NO_TRANSPOSE)),
     MatrixUniforms(VULKAN_NULL(), DataMode::UPDATE, DataType::MAT4x4, MatrixLayout::NO_TRANSPOSE),
     MatrixUniforms(VULKAN_NULL(), DataMode::UPDATE, DataType::MAT4x4, MatrixLayout::TRANSPOSE),
     MatrixUniforms(VULKAN_NULL(), DataMode::REPEAT, DataType::MAT4x4, MatrixLayout::NO_TRANSPOSE),
@@ -1113,4 +1113,23 @@ TEST_F(DefineTest, LongMacroInvocationChain)
     preprocess(inputStream.str().c_str(), settings);
 }
 
+// Test that parameters used several times in the replacement list, next to identifiers that are
+// not parameters, are all replaced, including when the macro is redefined identically.
+TEST_F(DefineTest, RepeatedParameters)
+{
+    const char *input =
+        "#define f(x, y) x + y * x + xy + y\n"
+        "#define f(x, y) x + y * x + xy + y\n"
+        "#define g(y) f(y, 2)\n"
+        "f(a, b)\n"
+        "g(c) g(d)\n";
+    const char *expected =
+        "\n"
+        "\n"
+        "\n"
+        "a + b * a + xy + b\n"
+        "c + 2 * c + xy + 2 d + 2 * d + xy + 2\n";
+    preprocess(input, expected);
+}
+
 }  // namespace angle
@@ -43,6 +43,7 @@ constexpr PackedEnumMap<Feature, const char *> kFeatureNames = {{
     {Feature::AppendAliasedMemoryDecorationsToSsbo, "appendAliasedMemoryDecorationsToSsbo"},
     {Feature::AsyncCommandBufferReset, "asyncCommandBufferReset"},
     {Feature::AsyncCommandQueue, "asyncCommandQueue"},
+    {Feature::AsyncEtcTextureDecode, "asyncEtcTextureDecode"},
     {Feature::Avoid1BitAlphaTextureFormats, "avoid1BitAlphaTextureFormats"},
     {Feature::AvoidStencilTextureSwizzle, "avoidStencilTextureSwizzle"},
     {Feature::BindFramebufferForTimerQueries, "bindFramebufferForTimerQueries"},
@@ -65,6 +66,7 @@ constexpr PackedEnumMap<Feature, const char *> kFeatureNames = {{
      "copyIOSurfaceToNonIOSurfaceForReadOptimization"},
     {Feature::CopyTextureToBufferForReadOptimization, "copyTextureToBufferForReadOptimization"},
     {Feature::DecodeEncodeSRGBForGenerateMipmap, "decodeEncodeSRGBForGenerateMipmap"},
+    {Feature::DeferDefaultUniformUpdates, "deferDefaultUniformUpdates"},
     {Feature::DeferFlushUntilEndRenderPass, "deferFlushUntilEndRenderPass"},
     {Feature::DepthClamping, "depthClamping"},
     {Feature::DepthStencilBlitExtraCopy, "depthStencilBlitExtraCopy"},
@@ -231,6 +233,7 @@ constexpr PackedEnumMap<Feature, const char *> kFeatureNames = {{
     {Feature::RemoveInvariantAndCentroidForESSL3, "removeInvariantAndCentroidForESSL3"},
     {Feature::ResetTexImage2DBaseLevel, "resetTexImage2DBaseLevel"},
     {Feature::RetainSPIRVDebugInfo, "retainSPIRVDebugInfo"},
+    {Feature::ReuseDmaBufImages, "reuseDmaBufImages"},
     {Feature::RewriteFloatUnaryMinusOperator, "rewriteFloatUnaryMinusOperator"},
     {Feature::RewriteRepeatedAssignToSwizzled, "rewriteRepeatedAssignToSwizzled"},
     {Feature::RewriteRowMajorMatrices, "rewriteRowMajorMatrices"},
@@ -251,6 +254,7 @@ constexpr PackedEnumMap<Feature, const char *> kFeatureNames = {{
     {Feature::SlowAsyncCommandQueueForTesting, "slowAsyncCommandQueueForTesting"},
     {Feature::SlowDownMonolithicPipelineCreationForTesting,
      "slowDownMonolithicPipelineCreationForTesting"},
+    {Feature::StreamClientArraysThroughRingBuffer, "streamClientArraysThroughRingBuffer"},
     {Feature::SupportsAndroidHardwareBuffer, "supportsAndroidHardwareBuffer"},
     {Feature::SupportsAndroidNativeFenceSync, "supportsAndroidNativeFenceSync"},
     {Feature::SupportsBindMemory2, "supportsBindMemory2"},
@@ -342,6 +346,7 @@ constexpr PackedEnumMap<Feature, const char *> kFeatureNames = {{
     {Feature::SyncMonolithicPipelinesToBlobCache, "syncMonolithicPipelinesToBlobCache"},
     {Feature::SyncVertexArraysToDefault, "syncVertexArraysToDefault"},
     {Feature::UnbindFBOBeforeSwitchingContext, "unbindFBOBeforeSwitchingContext"},
+    {Feature::UncompressedBlobCache, "uncompressedBlobCache"},
     {Feature::UnfoldShortCircuits, "unfoldShortCircuits"},
     {Feature::UnpackLastRowSeparatelyForPaddingInclusion,
      "unpackLastRowSeparatelyForPaddingInclusion"},
@@ -350,8 +355,10 @@ constexpr PackedEnumMap<Feature, const char *> kFeatureNames = {{
     {Feature::UnsizedSRGBReadPixelsDoesntTransform, "unsizedSRGBReadPixelsDoesntTransform"},
     {Feature::UploadDataToIosurfacesWithStagingBuffers, "uploadDataToIosurfacesWithStagingBuffers"},
     {Feature::UploadTextureDataInChunks, "uploadTextureDataInChunks"},
+    {Feature::UploadTextureDataThroughStagingBuffers, "uploadTextureDataThroughStagingBuffers"},
     {Feature::UseInstancedPointSpriteEmulation, "useInstancedPointSpriteEmulation"},
     {Feature::UseMultipleDescriptorsForExternalFormats, "useMultipleDescriptorsForExternalFormats"},
+    {Feature::UseNativeMultiDraw, "useNativeMultiDraw"},
     {Feature::UseNonZeroStencilWriteMaskStaticState, "useNonZeroStencilWriteMaskStaticState"},
     {Feature::UseResetCommandBufferBitForSecondaryPools,
      "useResetCommandBufferBitForSecondaryPools"},
@@ -42,6 +42,7 @@ enum class Feature
     AppendAliasedMemoryDecorationsToSsbo,
     AsyncCommandBufferReset,
     AsyncCommandQueue,
+    AsyncEtcTextureDecode,
     Avoid1BitAlphaTextureFormats,
     AvoidStencilTextureSwizzle,
     BindFramebufferForTimerQueries,
@@ -62,6 +63,7 @@ enum class Feature
     CopyIOSurfaceToNonIOSurfaceForReadOptimization,
     CopyTextureToBufferForReadOptimization,
     DecodeEncodeSRGBForGenerateMipmap,
+    DeferDefaultUniformUpdates,
     DeferFlushUntilEndRenderPass,
     DepthClamping,
     DepthStencilBlitExtraCopy,
@@ -217,6 +219,7 @@ enum class Feature
     RemoveInvariantAndCentroidForESSL3,
     ResetTexImage2DBaseLevel,
     RetainSPIRVDebugInfo,
+    ReuseDmaBufImages,
     RewriteFloatUnaryMinusOperator,
     RewriteRepeatedAssignToSwizzled,
     RewriteRowMajorMatrices,
@@ -235,6 +238,7 @@ enum class Feature
     SkipVSConstantRegisterZero,
     SlowAsyncCommandQueueForTesting,
     SlowDownMonolithicPipelineCreationForTesting,
+    StreamClientArraysThroughRingBuffer,
     SupportsAndroidHardwareBuffer,
     SupportsAndroidNativeFenceSync,
     SupportsBindMemory2,
@@ -318,14 +322,17 @@ enum class Feature
     SyncMonolithicPipelinesToBlobCache,
     SyncVertexArraysToDefault,
     UnbindFBOBeforeSwitchingContext,
+    UncompressedBlobCache,
     UnfoldShortCircuits,
     UnpackLastRowSeparatelyForPaddingInclusion,
     UnpackOverlappingRowsSeparatelyUnpackBuffer,
     UnsizedSRGBReadPixelsDoesntTransform,
     UploadDataToIosurfacesWithStagingBuffers,
     UploadTextureDataInChunks,
+    UploadTextureDataThroughStagingBuffers,
     UseInstancedPointSpriteEmulation,
     UseMultipleDescriptorsForExternalFormats,
+    UseNativeMultiDraw,
     UseNonZeroStencilWriteMaskStaticState,
     UseResetCommandBufferBitForSecondaryPools,
     UseSystemMemoryForConstantBuffers,
@@ -460,17 +460,22 @@ angle::VulkanPerfCounters GetPerfCounters(const CounterNameToIndexMap &indexMap)
 
 CounterNameToValueMap BuildCounterNameToValueMap()
 {
-    CounterNameToIndexMap indexMap                     = BuildCounterNameToIndexMap();
     std::vector<angle::PerfMonitorTriplet> perfResults = GetPerfMonitorTriplets();
 
     CounterNameToValueMap valueMap;
 
-    for (const auto &iter : indexMap)
+    // Unlike BuildCounterNameToIndexMap, this covers the counters of all groups.
+    for (const angle::PerfMonitorTriplet &triplet : perfResults)
     {
-        const std::string &name = iter.first;
-        GLuint index            = iter.second;
+        static constexpr size_t kBufSize = 1000;
+        char buffer[kBufSize]            = {};
+        glGetPerfMonitorCounterStringAMD(triplet.group, triplet.counter, kBufSize, nullptr, buffer);
+        if (glGetError() != GL_NO_ERROR)
+        {
+            return {};
+        }
 
-        valueMap[name] = perfResults[index].value;
+        valueMap[buffer] = triplet.value;
     }
 
     return valueMap;